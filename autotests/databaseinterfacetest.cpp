@@ -21,6 +21,7 @@
 #include <QDir>
 #include <QFile>
 #include <QTemporaryFile>
+#include <QJsonArray>
 
 #include <QDebug>
 
@@ -992,6 +993,52 @@ private Q_SLOTS:
         QCOMPARE(musicDbErrorSpy.count(), 0);
     }
 
+    void tracksDataFromFileNames()
+    {
+        QTemporaryFile databaseFile;
+        databaseFile.open();
+
+        qDebug() << "tracksDataFromFileNames" << databaseFile.fileName();
+
+        DatabaseInterface musicDb;
+
+        QSignalSpy musicDbTrackAddedSpy(&musicDb, &DatabaseInterface::tracksAdded);
+        QSignalSpy musicDbErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        musicDb.init(QStringLiteral("testDb"), databaseFile.fileName());
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers);
+
+        musicDbTrackAddedSpy.wait(300);
+
+        QCOMPARE(musicDbErrorSpy.count(), 0);
+
+        auto allFileNames = QList<QUrl>{};
+        for (const auto &oneTrack : mNewTracks) {
+            if (!allFileNames.contains(oneTrack.resourceURI())) {
+                allFileNames.push_back(oneTrack.resourceURI());
+            }
+        }
+
+        auto requestedFileNames = allFileNames;
+        requestedFileNames.push_back(QUrl::fromLocalFile(QStringLiteral("/unknownFile.ogg")));
+
+        const auto tracks = musicDb.tracksDataFromFileNames(requestedFileNames);
+
+        QCOMPARE(musicDbErrorSpy.count(), 0);
+        QCOMPARE(tracks.count(), allFileNames.count());
+
+        for (const auto &oneTrack : tracks) {
+            QVERIFY(allFileNames.contains(oneTrack.resourceURI()));
+            QVERIFY(oneTrack.databaseId() != 0);
+            QVERIFY(!oneTrack.title().isEmpty());
+        }
+
+        QCOMPARE(musicDb.tracksDataFromFileNames({allFileNames.first()}).count(), 1);
+        QCOMPARE(musicDb.tracksDataFromFileNames({}).count(), 0);
+        QCOMPARE(musicDbErrorSpy.count(), 0);
+    }
+
     void addTwiceSameTracksWithDatabaseFile()
     {
         QTemporaryFile myTempDatabase;
@@ -4694,6 +4741,58 @@ private Q_SLOTS:
         QCOMPARE(frequentlyPlayedTracksData[4].resourceURI(), QUrl::fromLocalFile(QStringLiteral("/$9")));
     }
 
+    void readRadiosHistory()
+    {
+        DatabaseInterface musicDb;
+
+        musicDb.init(QStringLiteral("testDb"));
+
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        const auto allRadios = musicDb.allRadiosData();
+        QVERIFY(allRadios.count() >= 2);
+
+        const auto &firstRadio = allRadios[0];
+        const auto &secondRadio = allRadios[1];
+
+        auto historyEntries = DataTypes::ListTrackDataType{};
+        for (int i = 0; i < 105; ++i) {
+            historyEntries.push_back({{DataTypes::ResourceRole, firstRadio.resourceURI()},
+                                      {DataTypes::TitleRole, QStringLiteral("title %1").arg(i)},
+                                      {DataTypes::ArtistRole, QStringLiteral("artist %1").arg(i)},
+                                      {DataTypes::LastPlayDate, QDateTime::fromSecsSinceEpoch(1553279650 + i)}});
+        }
+        historyEntries.push_back({{DataTypes::ResourceRole, secondRadio.resourceURI()},
+                                  {DataTypes::TitleRole, QStringLiteral("other title")},
+                                  {DataTypes::ArtistRole, QStringLiteral("other artist")},
+                                  {DataTypes::LastPlayDate, QDateTime::fromSecsSinceEpoch(1553279650)}});
+        historyEntries.push_back({{DataTypes::ResourceRole, QUrl(QStringLiteral("http://127.0.0.1/unknown"))},
+                                  {DataTypes::TitleRole, QStringLiteral("unknown title")},
+                                  {DataTypes::LastPlayDate, QDateTime::fromSecsSinceEpoch(1553279650)}});
+
+        musicDb.insertRadiosHistory(historyEntries);
+
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+
+        auto firstRadioHistory = musicDb.radioHistory(firstRadio.databaseId(), 200);
+
+        QCOMPARE(firstRadioHistory.count(), 100);
+        QCOMPARE(firstRadioHistory[0].title(), QStringLiteral("title 104"));
+        QCOMPARE(firstRadioHistory[0].artist(), QStringLiteral("artist 104"));
+        QCOMPARE(firstRadioHistory[0][DataTypes::LastPlayDate].toDateTime(), QDateTime::fromSecsSinceEpoch(1553279754));
+        QCOMPARE(firstRadioHistory[99].title(), QStringLiteral("title 5"));
+
+        auto secondRadioHistory = musicDb.radioHistory(secondRadio.databaseId(), 10);
+
+        QCOMPARE(secondRadioHistory.count(), 1);
+        QCOMPARE(secondRadioHistory[0].title(), QStringLiteral("other title"));
+
+        musicDb.removeRadio(firstRadio.databaseId());
+
+        QCOMPARE(musicDb.radioHistory(firstRadio.databaseId(), 200).count(), 0);
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+    }
+
     void readAllGenresData()
     {
         DatabaseInterface musicDb;
@@ -4749,6 +4848,358 @@ private Q_SLOTS:
         QCOMPARE(allGenresData[3].title(), QStringLiteral("genre4"));
     }
 
+    void readSortedAndFilteredData()
+    {
+        DatabaseInterface musicDb;
+
+        musicDb.init(QStringLiteral("testDb"));
+
+        QSignalSpy musicDbTrackAddedSpy(&musicDb, &DatabaseInterface::tracksAdded);
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers);
+
+        musicDbTrackAddedSpy.wait(300);
+
+        QCOMPARE(musicDb.allTracksData().count(), 22);
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+
+        auto parameters = DataTypes::SortFilterParameters{};
+        parameters.mSortRole = DataTypes::RatingRole;
+        parameters.mSortOrder = Qt::DescendingOrder;
+        parameters.mFilterRating = 5;
+
+        auto ratedTracks = musicDb.allTracksData(parameters);
+
+        QCOMPARE(ratedTracks.count(), 4);
+        QCOMPARE(ratedTracks[0].title(), QStringLiteral("track9"));
+        QCOMPARE(ratedTracks[0].rating(), 9);
+        for (const auto &oneTrack : ratedTracks) {
+            QVERIFY(oneTrack.rating() >= 5);
+        }
+
+        parameters = DataTypes::SortFilterParameters{};
+        parameters.mFilterText = QStringLiteral("TRACK9");
+
+        auto filteredTracks = musicDb.allTracksData(parameters);
+
+        QCOMPARE(filteredTracks.count(), 1);
+        QCOMPARE(filteredTracks[0].resourceURI(), QUrl::fromLocalFile(QStringLiteral("/$22")));
+
+        parameters = DataTypes::SortFilterParameters{};
+        parameters.mSortOrder = Qt::DescendingOrder;
+
+        auto sortedAlbums = musicDb.allAlbumsData(parameters);
+
+        QCOMPARE(sortedAlbums.count(), 5);
+        QCOMPARE(sortedAlbums[0].title(), QStringLiteral("album4"));
+        QCOMPARE(sortedAlbums[4].title(), QStringLiteral("album1"));
+
+        parameters.mFilterText = QStringLiteral("artist7");
+
+        auto filteredAlbums = musicDb.allAlbumsData(parameters);
+
+        QCOMPARE(filteredAlbums.count(), 1);
+        QCOMPARE(filteredAlbums[0].title(), QStringLiteral("album3"));
+        QCOMPARE(filteredAlbums[0].artist(), QStringLiteral("artist7"));
+
+        parameters = DataTypes::SortFilterParameters{};
+        parameters.mFilterText = QStringLiteral("artist1");
+
+        auto filteredArtists = musicDb.allArtistsData(parameters);
+
+        QCOMPARE(filteredArtists.count(), 2);
+        QCOMPARE(filteredArtists[0].name(), QStringLiteral("artist1"));
+        QCOMPARE(filteredArtists[1].name(), QStringLiteral("artist1 and artist2"));
+
+        parameters = DataTypes::SortFilterParameters{};
+        parameters.mSortOrder = Qt::DescendingOrder;
+
+        auto sortedGenres = musicDb.allGenresData(parameters);
+
+        QCOMPARE(sortedGenres.count(), 4);
+        QCOMPARE(sortedGenres[0].title(), QStringLiteral("genre4"));
+        QCOMPARE(sortedGenres[3].title(), QStringLiteral("genre1"));
+
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+    }
+
+    void sortAndFilterNonAsciiNames()
+    {
+        DatabaseInterface musicDb;
+
+        musicDb.init(QStringLiteral("testDb"));
+
+        QSignalSpy musicDbTrackAddedSpy(&musicDb, &DatabaseInterface::tracksAdded);
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        auto newTracks = DataTypes::ListTrackDataType{
+            {true, QStringLiteral("$23"), QStringLiteral("0"), QStringLiteral("Ébène"),
+             QStringLiteral("Ørjan"), QStringLiteral("Été"), QStringLiteral("Ørjan"),
+             1, 1, QTime::fromMSecsSinceStartOfDay(23), {QUrl::fromLocalFile(QStringLiteral("/$23"))},
+             QDateTime::fromMSecsSinceEpoch(23), {QUrl::fromLocalFile(QStringLiteral("album1"))}, 5, true,
+             QStringLiteral("genre1"), QStringLiteral("composer1"), QStringLiteral("lyricist1"), false},
+            {true, QStringLiteral("$24"), QStringLiteral("0"), QStringLiteral("ébauche"),
+             QStringLiteral("Ørjan"), QStringLiteral("Été"), QStringLiteral("Ørjan"),
+             2, 1, QTime::fromMSecsSinceStartOfDay(24), {QUrl::fromLocalFile(QStringLiteral("/$24"))},
+             QDateTime::fromMSecsSinceEpoch(24), {QUrl::fromLocalFile(QStringLiteral("album1"))}, 5, true,
+             QStringLiteral("genre1"), QStringLiteral("composer1"), QStringLiteral("lyricist1"), false},
+        };
+
+        musicDb.insertTracksList(newTracks, mNewCovers);
+
+        musicDbTrackAddedSpy.wait(300);
+
+        QCOMPARE(musicDb.allTracksData().count(), 2);
+
+        auto parameters = DataTypes::SortFilterParameters{};
+
+        auto sortedTracks = musicDb.allTracksData(parameters);
+
+        QCOMPARE(sortedTracks.count(), 2);
+        QCOMPARE(sortedTracks[0].title(), QStringLiteral("ébauche"));
+        QCOMPARE(sortedTracks[1].title(), QStringLiteral("Ébène"));
+
+        parameters.mFilterText = QStringLiteral("ÉBAUCHE");
+
+        auto filteredTracks = musicDb.allTracksData(parameters);
+
+        QCOMPARE(filteredTracks.count(), 1);
+        QCOMPARE(filteredTracks[0].title(), QStringLiteral("ébauche"));
+
+        parameters.mFilterText = QStringLiteral("ørjan");
+
+        QCOMPARE(musicDb.allTracksData(parameters).count(), 2);
+        QCOMPARE(musicDb.allArtistsData(parameters).count(), 1);
+
+        parameters.mFilterText = QStringLiteral("été");
+
+        auto filteredAlbums = musicDb.allAlbumsData(parameters);
+
+        QCOMPARE(filteredAlbums.count(), 1);
+        QCOMPARE(filteredAlbums[0].title(), QStringLiteral("Été"));
+
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+    }
+
+    void readChangesSinceGeneration()
+    {
+        DatabaseInterface musicDb;
+
+        musicDb.init(QStringLiteral("testDb"));
+
+        QSignalSpy musicDbTrackAddedSpy(&musicDb, &DatabaseInterface::tracksAdded);
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        QCOMPARE(musicDb.currentGeneration(), qulonglong{0});
+        QVERIFY(musicDb.changesSince(0).isEmpty());
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers);
+
+        musicDbTrackAddedSpy.wait(300);
+
+        QCOMPARE(musicDb.allTracksData().count(), 22);
+
+        auto allChanges = musicDb.changesSince(0);
+
+        QCOMPARE(allChanges.mNeedFullReload, false);
+        QCOMPARE(allChanges.mInsertedIds[ElisaUtils::Track].count(), 22);
+        QCOMPARE(allChanges.mInsertedIds[ElisaUtils::Album].count(), musicDb.allAlbumsData().count());
+        QCOMPARE(allChanges.mRemovedIds[ElisaUtils::Track].count(), 0);
+        QCOMPARE(allChanges.mGeneration, musicDb.currentGeneration());
+
+        const auto insertGeneration = musicDb.currentGeneration();
+
+        QVERIFY(musicDb.changesSince(insertGeneration).isEmpty());
+
+        auto removedTrackId = musicDb.trackIdFromFileName(QUrl::fromLocalFile(QStringLiteral("/$22")));
+        QVERIFY(removedTrackId != 0);
+
+        musicDb.removeTracksList({QUrl::fromLocalFile(QStringLiteral("/$22"))});
+
+        auto removeChanges = musicDb.changesSince(insertGeneration);
+
+        QVERIFY(removeChanges.mGeneration > insertGeneration);
+        QCOMPARE(removeChanges.mInsertedIds[ElisaUtils::Track].count(), 0);
+        QCOMPARE(removeChanges.mRemovedIds[ElisaUtils::Track], QList<qulonglong>{removedTrackId});
+
+        allChanges = musicDb.changesSince(0);
+
+        QCOMPARE(allChanges.mInsertedIds[ElisaUtils::Track].count(), 21);
+        QVERIFY(!allChanges.mInsertedIds[ElisaUtils::Track].contains(removedTrackId));
+        QCOMPARE(allChanges.mRemovedIds[ElisaUtils::Track], QList<qulonglong>{removedTrackId});
+
+        const auto removeGeneration = musicDb.currentGeneration();
+
+        musicDb.clearData();
+
+        auto clearChanges = musicDb.changesSince(removeGeneration);
+
+        QCOMPARE(clearChanges.mNeedFullReload, true);
+        QVERIFY(clearChanges.mGeneration > removeGeneration);
+
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+    }
+
+    void statementsStatisticsTest()
+    {
+        DatabaseInterface musicDb;
+
+        musicDb.init(QStringLiteral("testDb"));
+
+        QSignalSpy musicDbTrackAddedSpy(&musicDb, &DatabaseInterface::tracksAdded);
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        auto initialStatistics = musicDb.statementsStatistics();
+
+        QVERIFY(!initialStatistics.isEmpty());
+        QVERIFY(std::any_of(initialStatistics.begin(), initialStatistics.end(),
+                            [](const auto &oneStatistics) {return !oneStatistics.mIsPrepared;}));
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers);
+
+        musicDbTrackAddedSpy.wait(300);
+
+        QCOMPARE(musicDb.allTracksData().count(), 22);
+
+        auto statistics = musicDb.statementsStatistics();
+
+        QCOMPARE(statistics.count(), initialStatistics.count());
+
+        auto totalExecutions = qulonglong{0};
+        for (const auto &oneStatistics : statistics) {
+            QVERIFY(oneStatistics.mIsPrepared || oneStatistics.mExecutionCount == 0);
+            totalExecutions += oneStatistics.mExecutionCount;
+        }
+
+        QVERIFY(totalExecutions > 22);
+        QVERIFY(statistics[0].mCumulativeExecutionTime >= statistics.last().mCumulativeExecutionTime);
+
+        musicDb.setSlowQueryThreshold(1);
+
+        QCOMPARE(musicDb.allTracksData(DataTypes::SortFilterParameters{}).count(), 22);
+
+        statistics = musicDb.statementsStatistics();
+
+        auto sortFilterStatistics = std::find_if(statistics.begin(), statistics.end(), [](const auto &oneStatistics) {
+            return oneStatistics.mQueryText.contains(QStringLiteral("ORDER BY")) && oneStatistics.mRowsReturned == 22;
+        });
+
+        QVERIFY(sortFilterStatistics != statistics.end());
+        QCOMPARE(sortFilterStatistics->mExecutionCount, qulonglong{1});
+        QCOMPARE(sortFilterStatistics->mRowsHistogram.mCount, qulonglong{1});
+        QCOMPARE(sortFilterStatistics->mRowsHistogram.mTotal, qint64{22});
+        QCOMPARE(sortFilterStatistics->mStepTimeHistogram.mCount, qulonglong{1});
+
+        const auto statisticsJson = musicDb.statementsStatisticsToJson();
+
+        QVERIFY(!statisticsJson[QStringLiteral("statements")].toArray().isEmpty());
+        QVERIFY(statisticsJson[QStringLiteral("lockWait")].toObject()[QStringLiteral("count")].toInt() > 0);
+        QCOMPARE(statisticsJson[QStringLiteral("slowQueryThreshold")].toInt(), 1000000);
+
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+    }
+
+    void mergeAndCompactChangeJournal()
+    {
+        DatabaseInterface musicDb;
+
+        musicDb.init(QStringLiteral("testDb"));
+
+        QSignalSpy musicDbTrackAddedSpy(&musicDb, &DatabaseInterface::tracksAdded);
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers);
+
+        musicDbTrackAddedSpy.wait(300);
+
+        QCOMPARE(musicDb.allTracksData().count(), 22);
+
+        auto playedTrackId = musicDb.trackIdFromFileName(QUrl::fromLocalFile(QStringLiteral("/$9")));
+        QVERIFY(playedTrackId != 0);
+
+        musicDb.trackHasStartedPlaying(QUrl::fromLocalFile(QStringLiteral("/$9")), QDateTime::fromSecsSinceEpoch(1534689));
+
+        auto allChanges = musicDb.changesSince(0);
+
+        QVERIFY(allChanges.mInsertedIds[ElisaUtils::Track].contains(playedTrackId));
+        QCOMPARE(allChanges.mModifiedIds[ElisaUtils::Track].count(), 0);
+
+        auto unreadTrackId = musicDb.trackIdFromFileName(QUrl::fromLocalFile(QStringLiteral("/$22")));
+        QVERIFY(unreadTrackId != 0);
+
+        musicDb.removeTracksList({QUrl::fromLocalFile(QStringLiteral("/$22"))});
+
+        allChanges = musicDb.changesSince(0);
+
+        QCOMPARE(allChanges.mInsertedIds[ElisaUtils::Track].count(), 21);
+        QVERIFY(!allChanges.mInsertedIds[ElisaUtils::Track].contains(unreadTrackId));
+        QCOMPARE(allChanges.mRemovedIds[ElisaUtils::Track], QList<qulonglong>{unreadTrackId});
+
+        const auto firstReadGeneration = musicDb.currentGeneration();
+
+        musicDb.acknowledgeChanges(QStringLiteral("slowConsumer"), firstReadGeneration);
+        musicDb.acknowledgeChanges(QStringLiteral("fastConsumer"), firstReadGeneration);
+
+        musicDb.trackHasStartedPlaying(QUrl::fromLocalFile(QStringLiteral("/$9")), QDateTime::fromSecsSinceEpoch(1534692));
+
+        auto modifyChanges = musicDb.changesSince(firstReadGeneration);
+
+        QCOMPARE(modifyChanges.mInsertedIds[ElisaUtils::Track].count(), 0);
+        QCOMPARE(modifyChanges.mModifiedIds[ElisaUtils::Track], QList<qulonglong>{playedTrackId});
+
+        auto removedTrackId = musicDb.trackIdFromFileName(QUrl::fromLocalFile(QStringLiteral("/$21")));
+        QVERIFY(removedTrackId != 0);
+
+        musicDb.removeTracksList({QUrl::fromLocalFile(QStringLiteral("/$21"))});
+
+        auto removeChanges = musicDb.changesSince(firstReadGeneration);
+
+        QCOMPARE(removeChanges.mRemovedIds[ElisaUtils::Track], QList<qulonglong>{removedTrackId});
+
+        musicDb.acknowledgeChanges(QStringLiteral("fastConsumer"), removeChanges.mGeneration);
+
+        QCOMPARE(musicDb.changesSince(firstReadGeneration).mRemovedIds[ElisaUtils::Track], QList<qulonglong>{removedTrackId});
+
+        musicDb.acknowledgeChanges(QStringLiteral("slowConsumer"), removeChanges.mGeneration);
+
+        QCOMPARE(musicDb.changesSince(firstReadGeneration).mRemovedIds[ElisaUtils::Track].count(), 0);
+
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+    }
+
+    void removeTrackReadWithoutAcknowledgement()
+    {
+        DatabaseInterface musicDb;
+
+        musicDb.init(QStringLiteral("testDb"));
+
+        QSignalSpy musicDbTrackAddedSpy(&musicDb, &DatabaseInterface::tracksAdded);
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers);
+
+        musicDbTrackAddedSpy.wait(300);
+
+        QCOMPARE(musicDb.allTracksData().count(), 22);
+
+        auto removedTrackId = musicDb.trackIdFromFileName(QUrl::fromLocalFile(QStringLiteral("/$22")));
+        QVERIFY(removedTrackId != 0);
+
+        const auto insertChanges = musicDb.changesSince(0);
+
+        QVERIFY(insertChanges.mInsertedIds[ElisaUtils::Track].contains(removedTrackId));
+
+        musicDb.removeTracksList({QUrl::fromLocalFile(QStringLiteral("/$22"))});
+
+        const auto removeChanges = musicDb.changesSince(insertChanges.mGeneration);
+
+        QCOMPARE(removeChanges.mInsertedIds[ElisaUtils::Track].count(), 0);
+        QCOMPARE(removeChanges.mRemovedIds[ElisaUtils::Track], QList<qulonglong>{removedTrackId});
+
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+    }
+
     void clearDataTest()
     {
         DatabaseInterface musicDb;
@@ -4840,6 +5291,12 @@ private Q_SLOTS:
         QCOMPARE(musicDb.allAlbumsData().count(), 5);
         QCOMPARE(musicDb.allArtistsData().count(), 7);
         QCOMPARE(musicDb.allTracksData().count(), 22);
+
+        auto parameters = DataTypes::SortFilterParameters{};
+        parameters.mFilterText = QStringLiteral("TRACK");
+
+        QVERIFY(!musicDb.allTracksData(parameters).isEmpty());
+
         QCOMPARE(musicDbArtistAddedSpy.count(), 0);
         QCOMPARE(musicDbAlbumAddedSpy.count(), 0);
         QCOMPARE(musicDbTrackAddedSpy.count(), 0);
@@ -0,0 +1,107 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "elisatrace.h"
+
+#include <QObject>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <QThread>
+
+#include <QtTest>
+
+class ElisaTraceTest: public QObject
+{
+    Q_OBJECT
+
+public:
+
+    explicit ElisaTraceTest(QObject *aParent = nullptr) : QObject(aParent)
+    {
+    }
+
+private:
+
+    QTemporaryDir mTraceDirectory;
+
+private Q_SLOTS:
+
+    void initTestCase()
+    {
+        QVERIFY(mTraceDirectory.isValid());
+
+        qputenv("ELISA_TRACE_FILE", mTraceDirectory.filePath(QStringLiteral("exit.json")).toUtf8());
+
+        QVERIFY(ElisaTrace::isEnabled());
+    }
+
+    void spansFromSeveralThreads()
+    {
+        {
+            ElisaTraceSpan span("test", "mainThreadSpan", QStringLiteral("main detail"));
+            QThread::msleep(2);
+        }
+
+        ElisaTrace::addInstantEvent("test", "instantEvent");
+
+        auto workerThread = QThread::create([]() {
+            ElisaTraceSpan span("test", "workerThreadSpan");
+        });
+        workerThread->setObjectName(QStringLiteral("worker"));
+        workerThread->start();
+        QVERIFY(workerThread->wait());
+        delete workerThread;
+
+        const auto traceFileName = mTraceDirectory.filePath(QStringLiteral("trace.json"));
+        QVERIFY(ElisaTrace::writeTraceFile(traceFileName));
+
+        QFile traceFile(traceFileName);
+        QVERIFY(traceFile.open(QIODevice::ReadOnly));
+
+        const auto traceDocument = QJsonDocument::fromJson(traceFile.readAll());
+        QVERIFY(traceDocument.isObject());
+
+        const auto traceEvents = traceDocument.object()[QStringLiteral("traceEvents")].toArray();
+
+        auto threadNames = QHash<int, QString>{};
+        auto spans = QHash<QString, QJsonObject>{};
+        for (const auto &oneValue : traceEvents) {
+            const auto oneEvent = oneValue.toObject();
+            const auto phase = oneEvent[QStringLiteral("ph")].toString();
+
+            if (phase == QStringLiteral("M")) {
+                threadNames[oneEvent[QStringLiteral("tid")].toInt()] = oneEvent[QStringLiteral("args")].toObject()[QStringLiteral("name")].toString();
+            } else {
+                spans[oneEvent[QStringLiteral("name")].toString()] = oneEvent;
+            }
+        }
+
+        QVERIFY(spans.contains(QStringLiteral("mainThreadSpan")));
+        QVERIFY(spans.contains(QStringLiteral("workerThreadSpan")));
+        QVERIFY(spans.contains(QStringLiteral("instantEvent")));
+
+        const auto mainSpan = spans[QStringLiteral("mainThreadSpan")];
+        QCOMPARE(mainSpan[QStringLiteral("ph")].toString(), QStringLiteral("X"));
+        QCOMPARE(mainSpan[QStringLiteral("cat")].toString(), QStringLiteral("test"));
+        QVERIFY(mainSpan[QStringLiteral("dur")].toDouble() >= 1000.);
+        QCOMPARE(mainSpan[QStringLiteral("args")].toObject()[QStringLiteral("detail")].toString(), QStringLiteral("main detail"));
+        QCOMPARE(threadNames[mainSpan[QStringLiteral("tid")].toInt()], QStringLiteral("main"));
+
+        const auto workerSpan = spans[QStringLiteral("workerThreadSpan")];
+        QCOMPARE(threadNames[workerSpan[QStringLiteral("tid")].toInt()], QStringLiteral("worker"));
+
+        QCOMPARE(spans[QStringLiteral("instantEvent")][QStringLiteral("ph")].toString(), QStringLiteral("i"));
+    }
+
+};
+
+QTEST_GUILESS_MAIN(ElisaTraceTest)
+
+
+#include "elisatracetest.moc"
@@ -0,0 +1,115 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "models/filebrowserproxymodel.h"
+
+#include "datatypes.h"
+#include "elisautils.h"
+
+#include <QObject>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QUrl>
+
+#include <QtTest>
+
+#include <algorithm>
+
+class FileBrowserProxyModelTest: public QObject
+{
+    Q_OBJECT
+
+public:
+
+    explicit FileBrowserProxyModelTest(QObject *aParent = nullptr) : QObject(aParent)
+    {
+    }
+
+private Q_SLOTS:
+
+    void initTestCase()
+    {
+        qRegisterMetaType<DataTypes::EntryDataList>("DataTypes::EntryDataList");
+        qRegisterMetaType<ElisaUtils::PlayListEnqueueMode>("ElisaUtils::PlayListEnqueueMode");
+        qRegisterMetaType<ElisaUtils::PlayListEnqueueTriggerPlay>("ElisaUtils::PlayListEnqueueTriggerPlay");
+    }
+
+    void enqueueFolderWithReservedCharacters_data()
+    {
+        QTest::addColumn<QString>("folderName");
+
+        QTest::newRow("plain") << QStringLiteral("Music");
+        QTest::newRow("percent") << QStringLiteral("100% Hits");
+        QTest::newRow("hash") << QStringLiteral("Album #2");
+        QTest::newRow("encoded-looking") << QStringLiteral("a%20b");
+        QTest::newRow("non-ascii") << QStringLiteral("Été");
+    }
+
+    void enqueueFolderWithReservedCharacters()
+    {
+        QFETCH(QString, folderName);
+
+        QTemporaryDir rootDirectory;
+        QVERIFY(rootDirectory.isValid());
+
+        const auto folderPath = rootDirectory.path() + QLatin1Char('/') + folderName;
+        QVERIFY(QDir().mkpath(folderPath + QStringLiteral("/CD 1?")));
+
+        const auto audioFiles = QStringList{
+            QStringLiteral("/50% off.mp3"),
+            QStringLiteral("/track #1.flac"),
+            QStringLiteral("/a%20b.mp3"),
+            QStringLiteral("/CD 1?/[disc] 01;x=y.flac"),
+        };
+
+        for (const auto &oneFile : audioFiles) {
+            QFile audioFile(folderPath + oneFile);
+            QVERIFY(audioFile.open(QIODevice::WriteOnly));
+        }
+
+        QFile coverFile(folderPath + QStringLiteral("/cover 100%.jpg"));
+        QVERIFY(coverFile.open(QIODevice::WriteOnly));
+
+        FileBrowserProxyModel myProxyModel;
+
+        QSignalSpy entriesToEnqueueSpy(&myProxyModel, &FileBrowserProxyModel::entriesToEnqueue);
+
+        myProxyModel.enqueue({{DataTypes::ElementTypeRole, ElisaUtils::Container},
+                              {DataTypes::FilePathRole, QUrl::fromLocalFile(folderPath)}},
+                             {}, ElisaUtils::AppendPlayList, ElisaUtils::DoNotTriggerPlay);
+
+        QVERIFY(myProxyModel.enqueueInProgress());
+        QTRY_VERIFY_WITH_TIMEOUT(!myProxyModel.enqueueInProgress(), 10000);
+
+        auto enqueuedUrls = QList<QUrl>{};
+        for (const auto &oneSignal : entriesToEnqueueSpy) {
+            const auto entries = oneSignal.at(0).value<DataTypes::EntryDataList>();
+            for (const auto &oneEntry : entries) {
+                enqueuedUrls.push_back(std::get<0>(oneEntry)[DataTypes::ResourceRole].toUrl());
+            }
+        }
+
+        auto expectedUrls = QList<QUrl>{};
+        for (const auto &oneFile : audioFiles) {
+            expectedUrls.push_back(QUrl::fromLocalFile(folderPath + oneFile));
+        }
+
+        std::sort(enqueuedUrls.begin(), enqueuedUrls.end());
+        std::sort(expectedUrls.begin(), expectedUrls.end());
+
+        QCOMPARE(enqueuedUrls, expectedUrls);
+
+        for (const auto &oneUrl : enqueuedUrls) {
+            QVERIFY(QFile::exists(oneUrl.toLocalFile()));
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(FileBrowserProxyModelTest)
+
+
+#include "filebrowserproxymodeltest.moc"
@@ -75,6 +75,19 @@ private Q_SLOTS:
 
     }
 
+    void testLongTextScan()
+    {
+        FileScanner fileScanner;
+        const auto testFileUrl = QUrl::fromLocalFile(QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music/test.ogg"));
+
+        auto scannedTrack = fileScanner.scanOneFile(testFileUrl);
+        QCOMPARE(scannedTrack.contains(DataTypes::LyricsRole), false);
+
+        auto longText = fileScanner.scanLongTextProperties(testFileUrl);
+        QCOMPARE(longText.comment(), QStringLiteral("Comment"));
+        QCOMPARE(longText.contains(DataTypes::TitleRole), false);
+    }
+
     void testFindCoverInDirectory()
     {
         FileScanner fileScanner;
@@ -0,0 +1,126 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "loudnessanalyzer.h"
+
+#include "datatypes.h"
+
+#include <QObject>
+#include <QSignalSpy>
+#include <QUrl>
+
+#include <QtTest>
+
+#include <algorithm>
+
+class LoudnessAnalyzerTest: public QObject
+{
+    Q_OBJECT
+
+public:
+
+    explicit LoudnessAnalyzerTest(QObject *aParent = nullptr) : QObject(aParent)
+    {
+    }
+
+private:
+
+    static DataTypes::ListTrackDataType remoteTracks(qulonglong firstId, int count)
+    {
+        auto result = DataTypes::ListTrackDataType{};
+
+        // tracks that are not local files are not decoded and get a neutral gain at once
+        for (int trackIndex = 0; trackIndex < count; ++trackIndex) {
+            auto oneTrack = DataTypes::TrackDataType{};
+            oneTrack[DataTypes::DatabaseIdRole] = firstId + trackIndex;
+            oneTrack[DataTypes::ResourceRole] = QUrl(QStringLiteral("http://localhost/track%1.ogg").arg(firstId + trackIndex));
+            oneTrack[DataTypes::AlbumIdRole] = firstId + trackIndex;
+            result.push_back(oneTrack);
+        }
+
+        return result;
+    }
+
+private Q_SLOTS:
+
+    void initTestCase()
+    {
+        qRegisterMetaType<DataTypes::ListTrackDataType>("DataTypes::ListTrackDataType");
+    }
+
+    void restartAfterStop()
+    {
+        if (!LoudnessAnalyzer::isAvailable()) {
+            QSKIP("no audio decoder available");
+        }
+
+        LoudnessAnalyzer analyzer;
+
+        QSignalSpy askTracksSpy(&analyzer, &LoudnessAnalyzer::askTracksPendingAnalysis);
+        QSignalSpy tracksAnalyzedSpy(&analyzer, &LoudnessAnalyzer::tracksAnalyzed);
+
+        analyzer.start();
+
+        QCOMPARE(askTracksSpy.count(), 1);
+
+        analyzer.analyzeTracks(remoteTracks(1, 4));
+        analyzer.stop();
+
+        QVERIFY(!analyzer.isActive());
+
+        analyzer.start();
+
+        QCOMPARE(askTracksSpy.count(), 2);
+
+        analyzer.analyzeTracks(remoteTracks(100, 2));
+
+        // the next batch is only requested once all the jobs of the current session are done
+        QVERIFY(askTracksSpy.wait());
+        QCOMPARE(askTracksSpy.count(), 3);
+
+        auto analyzedIds = QList<qulonglong>{};
+        for (const auto &oneSignal : qAsConst(tracksAnalyzedSpy)) {
+            for (const auto &oneTrack : oneSignal.at(0).value<DataTypes::ListTrackDataType>()) {
+                analyzedIds.push_back(oneTrack.databaseId());
+            }
+        }
+
+        std::sort(analyzedIds.begin(), analyzedIds.end());
+
+        // results of the jobs of the stopped session are dropped
+        QCOMPARE(analyzedIds, QList<qulonglong>({100, 101}));
+    }
+
+    void libraryChangedAfterRestart()
+    {
+        if (!LoudnessAnalyzer::isAvailable()) {
+            QSKIP("no audio decoder available");
+        }
+
+        LoudnessAnalyzer analyzer;
+
+        QSignalSpy askTracksSpy(&analyzer, &LoudnessAnalyzer::askTracksPendingAnalysis);
+
+        analyzer.start();
+        analyzer.analyzeTracks(remoteTracks(1, 4));
+        analyzer.stop();
+
+        analyzer.start();
+        analyzer.analyzeTracks({});
+
+        QCOMPARE(askTracksSpy.count(), 2);
+
+        // no job of the stopped session is still counted as running
+        analyzer.libraryChanged();
+
+        QCOMPARE(askTracksSpy.count(), 3);
+    }
+};
+
+QTEST_GUILESS_MAIN(LoudnessAnalyzerTest)
+
+
+#include "loudnessanalyzertest.moc"
@@ -0,0 +1,152 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "loudnessmeter.h"
+
+#include <QObject>
+
+#include <QtMath>
+#include <QtTest>
+
+#include <cmath>
+#include <vector>
+
+class LoudnessMeterTest: public QObject
+{
+    Q_OBJECT
+
+public:
+
+    explicit LoudnessMeterTest(QObject *aParent = nullptr) : QObject(aParent)
+    {
+    }
+
+private:
+
+    static std::vector<float> stereoSine(double frequency, double amplitudeDb, int sampleRate, double duration)
+    {
+        const auto framesCount = static_cast<qsizetype>(sampleRate * duration);
+        const auto amplitude = std::pow(10., amplitudeDb / 20.);
+
+        auto result = std::vector<float>(framesCount * 2);
+        for (qsizetype frame = 0; frame < framesCount; ++frame) {
+            const auto sample = static_cast<float>(amplitude * std::sin(2. * M_PI * frequency * frame / sampleRate));
+            result[2 * frame] = sample;
+            result[2 * frame + 1] = sample;
+        }
+
+        return result;
+    }
+
+private Q_SLOTS:
+
+    void sineAtReferenceLevel_data()
+    {
+        QTest::addColumn<int>("sampleRate");
+
+        QTest::newRow("44100") << 44100;
+        QTest::newRow("48000") << 48000;
+        QTest::newRow("96000") << 96000;
+    }
+
+    void sineAtReferenceLevel()
+    {
+        QFETCH(int, sampleRate);
+
+        const auto samples = stereoSine(1000., -23., sampleRate, 20.);
+
+        LoudnessMeter meter(2, sampleRate);
+        meter.addFrames(samples.data(), static_cast<qsizetype>(samples.size() / 2));
+
+        QVERIFY(std::abs(meter.integratedLoudness() - (-23.)) < 0.1);
+        QVERIFY(std::abs(LoudnessMeter::replayGain(meter.integratedLoudness()) - 5.) < 0.1);
+        QVERIFY(std::abs(meter.samplePeak() - std::pow(10., -23. / 20.)) < 0.001);
+    }
+
+    void integerSamples()
+    {
+        const auto samples = stereoSine(1000., -23., 48000, 10.);
+
+        auto integerSamples = std::vector<qint16>(samples.size());
+        for (std::size_t index = 0; index < samples.size(); ++index) {
+            integerSamples[index] = static_cast<qint16>(qRound(samples[index] * 32767.f));
+        }
+
+        LoudnessMeter floatMeter(2, 48000);
+        floatMeter.addFrames(samples.data(), static_cast<qsizetype>(samples.size() / 2));
+
+        LoudnessMeter integerMeter(2, 48000);
+        integerMeter.addFrames(integerSamples.data(), static_cast<qsizetype>(integerSamples.size() / 2));
+
+        QVERIFY(std::abs(floatMeter.integratedLoudness() - integerMeter.integratedLoudness()) < 0.01);
+    }
+
+    void silence()
+    {
+        const auto samples = std::vector<float>(48000 * 2 * 5, 0.f);
+
+        LoudnessMeter meter(2, 48000);
+        meter.addFrames(samples.data(), static_cast<qsizetype>(samples.size() / 2));
+
+        QVERIFY(std::isinf(meter.integratedLoudness()));
+        QCOMPARE(LoudnessMeter::replayGain(meter.integratedLoudness()), 0.);
+        QCOMPARE(meter.samplePeak(), 0.);
+    }
+
+    void shortStream()
+    {
+        const auto samples = stereoSine(1000., -23., 48000, 0.2);
+
+        LoudnessMeter meter(2, 48000);
+        meter.addFrames(samples.data(), static_cast<qsizetype>(samples.size() / 2));
+
+        QVERIFY(std::isinf(meter.integratedLoudness()));
+    }
+
+    void albumLoudness()
+    {
+        const auto loudSamples = stereoSine(1000., -23., 48000, 20.);
+        const auto quietSamples = stereoSine(1000., -33., 48000, 20.);
+
+        LoudnessMeter loudMeter(2, 48000);
+        loudMeter.addFrames(loudSamples.data(), static_cast<qsizetype>(loudSamples.size() / 2));
+
+        LoudnessMeter quietMeter(2, 48000);
+        quietMeter.addFrames(quietSamples.data(), static_cast<qsizetype>(quietSamples.size() / 2));
+
+        QVERIFY(std::abs(quietMeter.integratedLoudness() - (-33.)) < 0.1);
+
+        const auto albumLoudness = LoudnessMeter::integratedLoudness({&loudMeter, &quietMeter});
+        QVERIFY(std::abs(albumLoudness - (-23. + 10. * std::log10(0.55))) < 0.1);
+
+        QCOMPARE(LoudnessMeter::samplePeak({&loudMeter, &quietMeter}), loudMeter.samplePeak());
+    }
+
+    void clippingSafeGain()
+    {
+        QVERIFY(std::abs(LoudnessMeter::clippingSafeGain(10., 0.5) - 6.0206) < 0.001);
+        QCOMPARE(LoudnessMeter::clippingSafeGain(3., 0.5), 3.);
+        QCOMPARE(LoudnessMeter::clippingSafeGain(-4., 1.), -4.);
+        QCOMPARE(LoudnessMeter::clippingSafeGain(5., 0.), 5.);
+    }
+
+    void benchmarkLoudnessMeter()
+    {
+        const auto samples = stereoSine(997., -18., 44100, 60.);
+
+        QBENCHMARK {
+            LoudnessMeter meter(2, 44100);
+            meter.addFrames(samples.data(), static_cast<qsizetype>(samples.size() / 2));
+            meter.integratedLoudness();
+        }
+    }
+
+};
+
+QTEST_GUILESS_MAIN(LoudnessMeterTest)
+
+
+#include "loudnessmetertest.moc"
@@ -8947,6 +8947,110 @@ void ManageAudioPlayerTest::testRestorePlayListAndSettingsAutomaticPlay()
     QCOMPARE(skipNextTrackSpy.wait(300), true);
 }
 
+void ManageAudioPlayerTest::playTrackAndSwitchToPreloadedNextTrack()
+{
+    ManageAudioPlayer myPlayer;
+    QStandardItemModel myPlayList;
+
+    QSignalSpy playerSourceChangedSpy(&myPlayer, &ManageAudioPlayer::playerSourceChanged);
+    QSignalSpy playerNextSourceChangedSpy(&myPlayer, &ManageAudioPlayer::playerNextSourceChanged);
+    QSignalSpy playerStopSpy(&myPlayer, &ManageAudioPlayer::playerStop);
+    QSignalSpy skipNextTrackSpy(&myPlayer, &ManageAudioPlayer::skipNextTrack);
+    QSignalSpy startedPlayingTrackSpy(&myPlayer, &ManageAudioPlayer::startedPlayingTrack);
+
+    myPlayList.appendRow(new QStandardItem);
+    myPlayList.appendRow(new QStandardItem);
+    myPlayList.appendRow(new QStandardItem);
+
+    myPlayList.item(0, 0)->setData(QUrl::fromUserInput(QStringLiteral("file:///1.mp3")), ManageAudioPlayerTest::ResourceRole);
+    myPlayList.item(1, 0)->setData(QUrl::fromUserInput(QStringLiteral("file:///2.mp3")), ManageAudioPlayerTest::ResourceRole);
+    myPlayList.item(2, 0)->setData(QUrl::fromUserInput(QStringLiteral("file:///3.mp3")), ManageAudioPlayerTest::ResourceRole);
+
+    myPlayer.setPlayListModel(&myPlayList);
+    myPlayer.setUrlRole(ManageAudioPlayerTest::ResourceRole);
+    myPlayer.setIsPlayingRole(ManageAudioPlayerTest::IsPlayingRole);
+    myPlayer.setCurrentTrack(myPlayList.index(0, 0));
+
+    QCOMPARE(playerSourceChangedSpy.count(), 1);
+
+    myPlayer.setPlayerStatus(QMediaPlayer::LoadedMedia);
+    myPlayer.setPlayerStatus(QMediaPlayer::BufferedMedia);
+    myPlayer.setPlayerPlaybackState(QMediaPlayer::PlayingState);
+
+    QCOMPARE(startedPlayingTrackSpy.count(), 1);
+    QCOMPARE(myPlayList.data(myPlayList.index(0, 0), ManageAudioPlayerTest::IsPlayingRole).toBool(), true);
+
+    myPlayer.setNextTrack(myPlayList.index(1, 0));
+
+    QCOMPARE(playerNextSourceChangedSpy.count(), 1);
+    QCOMPARE(playerNextSourceChangedSpy.at(0).at(0).toUrl(), QUrl::fromUserInput(QStringLiteral("file:///2.mp3")));
+
+    myPlayer.setNextTrack(myPlayList.index(1, 0));
+
+    QCOMPARE(playerNextSourceChangedSpy.count(), 1);
+
+    myPlayer.playerSwitchedToNextSource(QUrl::fromUserInput(QStringLiteral("file:///2.mp3")));
+
+    QCOMPARE(skipNextTrackSpy.count(), 1);
+
+    myPlayer.setCurrentTrack(myPlayList.index(1, 0));
+
+    QCOMPARE(playerSourceChangedSpy.count(), 1);
+    QCOMPARE(playerStopSpy.count(), 0);
+    QCOMPARE(startedPlayingTrackSpy.count(), 2);
+    QCOMPARE(startedPlayingTrackSpy.at(1).at(0).toUrl(), QUrl::fromUserInput(QStringLiteral("file:///2.mp3")));
+    QCOMPARE(myPlayer.playerPlaybackState(), QMediaPlayer::PlayingState);
+    QCOMPARE(myPlayList.data(myPlayList.index(0, 0), ManageAudioPlayerTest::IsPlayingRole).toBool(), false);
+    QCOMPARE(myPlayList.data(myPlayList.index(1, 0), ManageAudioPlayerTest::IsPlayingRole).toBool(), true);
+
+    myPlayer.setNextTrack(myPlayList.index(2, 0));
+
+    QCOMPARE(playerNextSourceChangedSpy.count(), 2);
+    QCOMPARE(playerNextSourceChangedSpy.at(1).at(0).toUrl(), QUrl::fromUserInput(QStringLiteral("file:///3.mp3")));
+}
+
+void ManageAudioPlayerTest::saveEstimatedPosition()
+{
+    Elisa::ElisaConfiguration::self()->setDefaults();
+    ManageAudioPlayer myPlayer;
+    QStandardItemModel myPlayList;
+
+    QSignalSpy saveUndoPositionInAudioWrapperSpy(&myPlayer, &ManageAudioPlayer::saveUndoPositionInAudioWrapper);
+
+    myPlayList.appendRow(new QStandardItem);
+
+    myPlayList.item(0, 0)->setData(QUrl::fromUserInput(QStringLiteral("file:///1.mp3")), ManageAudioPlayerTest::ResourceRole);
+
+    myPlayer.setPlayListModel(&myPlayList);
+    myPlayer.setUrlRole(ManageAudioPlayerTest::ResourceRole);
+    myPlayer.setIsPlayingRole(ManageAudioPlayerTest::IsPlayingRole);
+    myPlayer.setCurrentTrack(myPlayList.index(0, 0));
+
+    myPlayer.setPlayerStatus(QMediaPlayer::LoadedMedia);
+    myPlayer.setPlayerStatus(QMediaPlayer::BufferedMedia);
+    myPlayer.setPlayerPlaybackState(QMediaPlayer::PlayingState);
+    myPlayer.setAudioDuration(300000);
+
+    // last position published before the position updates were disabled
+    myPlayer.setPlayerPosition(1000);
+
+    QCOMPARE(myPlayer.persistentState()[QStringLiteral("playerPosition")].toLongLong(), 1000);
+
+    // estimated position pushed by the application right before saving
+    myPlayer.setProperty("playerPosition", qint64{95000});
+
+    const auto persistentState = myPlayer.persistentState();
+
+    QCOMPARE(persistentState[QStringLiteral("playerPosition")].toLongLong(), 95000);
+    QCOMPARE(persistentState[QStringLiteral("playerDuration")].toLongLong(), 300000);
+
+    myPlayer.setPlayerPosition(96000);
+    myPlayer.saveForUndoClearPlaylist();
+
+    QCOMPARE(saveUndoPositionInAudioWrapperSpy.count(), 1);
+    QCOMPARE(saveUndoPositionInAudioWrapperSpy.at(0).at(0).toLongLong(), 96000);
+}
+
 QTEST_GUILESS_MAIN(ManageAudioPlayerTest)
 
 
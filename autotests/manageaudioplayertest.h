@@ -79,6 +79,10 @@ private Q_SLOTS:
 
     void playSingleAndClearPlayListTrack();
 
+    void playTrackAndSwitchToPreloadedNextTrack();
+
+    void saveEstimatedPosition();
+
 };
 
 #endif // MANAGEAUDIOPLAYERTEST_H
@@ -5073,6 +5073,70 @@ void MediaPlayListProxyModelTest::testSetData()
     QCOMPARE(newEntryInListSpy.count(), 3);
 }
 
+void MediaPlayListProxyModelTest::testSetItemData()
+{
+    MediaPlayList myPlayList;
+    QAbstractItemModelTester testModel(&myPlayList);
+    MediaPlayListProxyModel myPlayListProxyModel;
+    myPlayListProxyModel.setPlayListModel(&myPlayList);
+    QAbstractItemModelTester testProxyModel(&myPlayListProxyModel);
+    DatabaseInterface myDatabaseContent;
+    TracksListener myListener(&myDatabaseContent);
+
+    QSignalSpy dataChangedSpy(&myPlayListProxyModel, &MediaPlayListProxyModel::dataChanged);
+
+    myDatabaseContent.init(QStringLiteral("testDbDirectContent"));
+
+    connect(&myListener, &TracksListener::trackHasChanged,
+            &myPlayList, &MediaPlayList::trackChanged,
+            Qt::QueuedConnection);
+    connect(&myPlayList, &MediaPlayList::newEntryInList,
+            &myListener, &TracksListener::newEntryInList,
+            Qt::QueuedConnection);
+    connect(&myDatabaseContent, &DatabaseInterface::tracksAdded,
+            &myListener, &TracksListener::tracksAdded);
+
+    myDatabaseContent.insertTracksList(mNewTracks, mNewCovers);
+
+    auto firstTrackId = myDatabaseContent.trackIdFromTitleAlbumTrackDiscNumber(QStringLiteral("track1"), QStringLiteral("artist2"),
+                                                                               QStringLiteral("album3"), 1, 1);
+    auto secondTrackId = myDatabaseContent.trackIdFromTitleAlbumTrackDiscNumber(QStringLiteral("track2"), QStringLiteral("artist2"),
+                                                                                QStringLiteral("album3"), 2, 1);
+    myPlayListProxyModel.enqueue({{{{DataTypes::DatabaseIdRole, firstTrackId}, {DataTypes::ElementTypeRole, ElisaUtils::Track}}, {}, {}},
+                                  {{{DataTypes::DatabaseIdRole, secondTrackId}, {DataTypes::ElementTypeRole, ElisaUtils::Track}}, {}, {}}},
+                                 ElisaUtils::AppendPlayList, ElisaUtils::DoNotTriggerPlay);
+
+    QCOMPARE(dataChangedSpy.wait(), true);
+    while (dataChangedSpy.count() < 2) {
+        QCOMPARE(dataChangedSpy.wait(), true);
+    }
+
+    myPlayListProxyModel.setShufflePlayList(true);
+
+    dataChangedSpy.clear();
+
+    auto secondProxyIndex = myPlayListProxyModel.index(1, 0);
+
+    QCOMPARE(myPlayListProxyModel.setItemData(secondProxyIndex, {{MediaPlayList::TitleRole, QStringLiteral("new title")},
+                                                                 {MediaPlayList::ArtistRole, QStringLiteral("new artist")}}), true);
+
+    QCOMPARE(dataChangedSpy.count(), 1);
+    QCOMPARE(dataChangedSpy.at(0).at(0).toModelIndex(), secondProxyIndex);
+    QCOMPARE(dataChangedSpy.at(0).at(2).value<QVector<int>>(), (QVector<int>{MediaPlayList::TitleRole, MediaPlayList::ArtistRole}));
+    QCOMPARE(myPlayListProxyModel.data(secondProxyIndex, MediaPlayList::TitleRole).toString(), QStringLiteral("new title"));
+    QCOMPARE(myPlayListProxyModel.data(secondProxyIndex, MediaPlayList::ArtistRole).toString(), QStringLiteral("new artist"));
+    QCOMPARE(myPlayList.data(myPlayListProxyModel.mapToSource(secondProxyIndex), MediaPlayList::TitleRole).toString(), QStringLiteral("new title"));
+
+    QCOMPARE(myPlayListProxyModel.setItemData(secondProxyIndex, {{MediaPlayList::TitleRole, QStringLiteral("new title")},
+                                                                 {MediaPlayList::ArtistRole, QStringLiteral("new artist")}}), false);
+
+    QCOMPARE(dataChangedSpy.count(), 1);
+
+    QCOMPARE(myPlayListProxyModel.setItemData({}, {{MediaPlayList::TitleRole, QStringLiteral("new title")}}), false);
+
+    QCOMPARE(dataChangedSpy.count(), 1);
+}
+
 void MediaPlayListProxyModelTest::testHasHeader()
 {
     MediaPlayList myPlayList;
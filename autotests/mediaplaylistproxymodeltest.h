@@ -84,6 +84,8 @@ private Q_SLOTS:
 
     void testSetData();
 
+    void testSetItemData();
+
     void testRemoveSelection();
 
     void testReplaceAndPlayArtist();
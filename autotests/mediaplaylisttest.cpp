@@ -1386,6 +1386,55 @@ void MediaPlayListTest::testSetData()
     QCOMPARE(newEntryInListSpy.count(), 3);
 }
 
+void MediaPlayListTest::testSetItemData()
+{
+    MediaPlayList myPlayList;
+    QAbstractItemModelTester testModel(&myPlayList);
+    DatabaseInterface myDatabaseContent;
+    TracksListener myListener(&myDatabaseContent);
+
+    QSignalSpy dataChangedSpy(&myPlayList, &MediaPlayList::dataChanged);
+
+    myDatabaseContent.init(QStringLiteral("testDbDirectContent"));
+
+    connect(&myListener, &TracksListener::trackHasChanged,
+            &myPlayList, &MediaPlayList::trackChanged,
+            Qt::QueuedConnection);
+    connect(&myPlayList, &MediaPlayList::newEntryInList,
+            &myListener, &TracksListener::newEntryInList,
+            Qt::QueuedConnection);
+    connect(&myDatabaseContent, &DatabaseInterface::tracksAdded,
+            &myListener, &TracksListener::tracksAdded);
+
+    myDatabaseContent.insertTracksList(mNewTracks, mNewCovers);
+
+    auto firstTrackId = myDatabaseContent.trackIdFromTitleAlbumTrackDiscNumber(QStringLiteral("track1"), QStringLiteral("artist2"),
+                                                                               QStringLiteral("album3"), 1, 1);
+    myPlayList.enqueueOneEntry(DataTypes::EntryData{{{DataTypes::DatabaseIdRole, firstTrackId}, {DataTypes::ElementTypeRole, ElisaUtils::Track}}, {}, {}});
+
+    QCOMPARE(dataChangedSpy.wait(), true);
+    QCOMPARE(dataChangedSpy.count(), 1);
+
+    QCOMPARE(myPlayList.setItemData(myPlayList.index(0, 0), {{MediaPlayList::TitleRole, QStringLiteral("new title")},
+                                                             {MediaPlayList::ArtistRole, QStringLiteral("new artist")}}), true);
+
+    QCOMPARE(dataChangedSpy.count(), 2);
+    QCOMPARE(dataChangedSpy.at(1).at(2).value<QVector<int>>(), (QVector<int>{MediaPlayList::TitleRole, MediaPlayList::ArtistRole}));
+    QCOMPARE(myPlayList.data(myPlayList.index(0, 0), MediaPlayList::TitleRole).toString(), QStringLiteral("new title"));
+    QCOMPARE(myPlayList.data(myPlayList.index(0, 0), MediaPlayList::ArtistRole).toString(), QStringLiteral("new artist"));
+
+    QCOMPARE(myPlayList.setItemData(myPlayList.index(0, 0), {{MediaPlayList::TitleRole, QStringLiteral("new title")},
+                                                             {MediaPlayList::ArtistRole, QStringLiteral("new artist")}}), false);
+
+    QCOMPARE(dataChangedSpy.count(), 2);
+
+    QCOMPARE(myPlayList.setItemData(myPlayList.index(0, 0), {{MediaPlayList::TitleRole, QStringLiteral("new title")},
+                                                             {MediaPlayList::ArtistRole, QStringLiteral("other artist")}}), true);
+
+    QCOMPARE(dataChangedSpy.count(), 3);
+    QCOMPARE(dataChangedSpy.at(2).at(2).value<QVector<int>>(), QVector<int>{MediaPlayList::ArtistRole});
+}
+
 void MediaPlayListTest::testHasHeader()
 {
     MediaPlayList myPlayList;
@@ -49,6 +49,8 @@ private Q_SLOTS:
 
     void testSetData();
 
+    void testSetItemData();
+
     void testHasHeader();
 
     void testHasHeaderWithRemove();
@@ -0,0 +1,204 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "android/mediastoresynchronizer.h"
+
+#include <QObject>
+#include <QHash>
+#include <QList>
+#include <QUrl>
+
+#include <QtTest>
+
+class MockMediaStoreSource : public MediaStoreCursorSource
+{
+
+public:
+
+    bool queryAudioFiles(MediaStoreSynchronizer &synchronizer, qint64 modifiedSince) override
+    {
+        mModifiedSince = modifiedSince;
+
+        synchronizer.addFilePaths(mFilePaths);
+
+        auto modifiedTracks = QStringList{};
+        for (auto rowStart = 0; rowStart < mTracksValues.size(); rowStart += MediaStoreSynchronizer::TrackColumnsCount) {
+            if (mTracksValues[rowStart + MediaStoreSynchronizer::TrackDateModifiedColumn].toLongLong() >= modifiedSince) {
+                modifiedTracks.append(mTracksValues.mid(rowStart, MediaStoreSynchronizer::TrackColumnsCount));
+            }
+        }
+        synchronizer.addTracks(modifiedTracks);
+
+        synchronizer.addAlbums(mAlbumsValues);
+
+        return mIsComplete;
+    }
+
+    bool queryTracks(MediaStoreSynchronizer &synchronizer, const QStringList &filePaths) override
+    {
+        mQueriedFilePaths.append(filePaths);
+
+        auto tracks = QStringList{};
+        for (auto rowStart = 0; rowStart < mTracksValues.size(); rowStart += MediaStoreSynchronizer::TrackColumnsCount) {
+            if (filePaths.contains(mTracksValues[rowStart + MediaStoreSynchronizer::TrackDataColumn])) {
+                tracks.append(mTracksValues.mid(rowStart, MediaStoreSynchronizer::TrackColumnsCount));
+            }
+        }
+        synchronizer.addTracks(tracks);
+
+        synchronizer.addAlbums(mAlbumsValues);
+
+        return true;
+    }
+
+    void addTrack(const QString &filePath, const QString &title, const QString &trackNumber, qint64 modificationTime, const QString &albumId)
+    {
+        mFilePaths.push_back(filePath);
+        mTracksValues.append({QString::number(mFilePaths.size()), title, trackNumber, QStringLiteral("2026"),
+                              QStringLiteral("180000"), filePath, QStringLiteral("artist"), QStringLiteral("album"),
+                              albumId, QString(), QString::number(modificationTime)});
+    }
+
+    QStringList mFilePaths;
+
+    QStringList mTracksValues;
+
+    QStringList mAlbumsValues;
+
+    QStringList mQueriedFilePaths;
+
+    qint64 mModifiedSince = -1;
+
+    bool mIsComplete = true;
+
+};
+
+class MediaStoreSynchronizerTest: public QObject
+{
+    Q_OBJECT
+
+public:
+
+    explicit MediaStoreSynchronizerTest(QObject *aParent = nullptr) : QObject(aParent)
+    {
+    }
+
+private Q_SLOTS:
+
+    void testFirstSynchronization()
+    {
+        MockMediaStoreSource source;
+        source.addTrack(QStringLiteral("/music/track1.ogg"), QStringLiteral("track1"), QStringLiteral("1"), 1000, QStringLiteral("10"));
+        source.addTrack(QStringLiteral("/music/track2.ogg"), QStringLiteral("track2"), QStringLiteral("2003"), 2000, QStringLiteral("11"));
+        source.mAlbumsValues = {QStringLiteral("10"), QStringLiteral("/covers/album10.jpg"), QStringLiteral("11"), QString()};
+
+        MediaStoreSynchronizer synchronizer;
+
+        const auto changes = synchronizer.synchronize(source, {});
+
+        QCOMPARE(source.mModifiedSince, qint64{0});
+        QCOMPARE(changes.mModifiedTracks.size(), 2);
+        QCOMPARE(changes.mRemovedFiles.size(), 0);
+
+        const auto &firstTrack = changes.mModifiedTracks.at(0);
+        QCOMPARE(firstTrack.title(), QStringLiteral("track1"));
+        QCOMPARE(firstTrack.resourceURI(), QUrl::fromLocalFile(QStringLiteral("/music/track1.ogg")));
+        QCOMPARE(firstTrack.fileModificationTime(), QDateTime::fromSecsSinceEpoch(1000));
+        QCOMPARE(firstTrack.trackNumber(), 1);
+        QCOMPARE(firstTrack.hasDiscNumber(), false);
+        QCOMPARE(firstTrack.duration(), QTime::fromMSecsSinceStartOfDay(180000));
+        QCOMPARE(firstTrack.contains(DataTypes::ComposerRole), false);
+
+        const auto &secondTrack = changes.mModifiedTracks.at(1);
+        QCOMPARE(secondTrack.trackNumber(), 3);
+        QCOMPARE(secondTrack.discNumber(), 2);
+
+        QCOMPARE(changes.mCovers.size(), 1);
+        QCOMPARE(changes.mCovers.value(firstTrack.resourceURI().toString()), QUrl::fromLocalFile(QStringLiteral("/covers/album10.jpg")));
+    }
+
+    void testIncrementalSynchronization()
+    {
+        MockMediaStoreSource source;
+        source.addTrack(QStringLiteral("/music/track1.ogg"), QStringLiteral("track1"), QStringLiteral("1"), 1000, {});
+        source.addTrack(QStringLiteral("/music/track2.ogg"), QStringLiteral("track2"), QStringLiteral("2"), 2000, {});
+        source.addTrack(QStringLiteral("/music/track4.ogg"), QStringLiteral("track4"), QStringLiteral("4"), 2000, {});
+        source.addTrack(QStringLiteral("/music/track5.ogg"), QStringLiteral("track5"), QStringLiteral("5"), 3000, {});
+
+        const auto knownFiles = QHash<QUrl, QDateTime>{
+            {QUrl::fromLocalFile(QStringLiteral("/music/track1.ogg")), QDateTime::fromSecsSinceEpoch(1000)},
+            {QUrl::fromLocalFile(QStringLiteral("/music/track2.ogg")), QDateTime::fromSecsSinceEpoch(2000)},
+            {QUrl::fromLocalFile(QStringLiteral("/music/track3.ogg")), QDateTime::fromSecsSinceEpoch(1500)},
+        };
+
+        MediaStoreSynchronizer synchronizer;
+
+        const auto changes = synchronizer.synchronize(source, knownFiles);
+
+        QCOMPARE(source.mModifiedSince, qint64{2000});
+
+        // track2 is read again because of the cursor granularity but is not modified
+        QCOMPARE(changes.mModifiedTracks.size(), 2);
+        QCOMPARE(changes.mModifiedTracks.at(0).title(), QStringLiteral("track4"));
+        QCOMPARE(changes.mModifiedTracks.at(1).title(), QStringLiteral("track5"));
+
+        QCOMPARE(changes.mRemovedFiles, QList<QUrl>{QUrl::fromLocalFile(QStringLiteral("/music/track3.ogg"))});
+        QCOMPARE(changes.mCovers.size(), 0);
+        QCOMPARE(source.mQueriedFilePaths.size(), 0);
+    }
+
+    void testNewFileOlderThanCursor()
+    {
+        MockMediaStoreSource source;
+        source.addTrack(QStringLiteral("/music/track1.ogg"), QStringLiteral("track1"), QStringLiteral("1"), 1000, {});
+        source.addTrack(QStringLiteral("/music/track2.ogg"), QStringLiteral("track2"), QStringLiteral("2"), 2000, {});
+        source.addTrack(QStringLiteral("/music/copied.ogg"), QStringLiteral("copied"), QStringLiteral("3"), 500, QStringLiteral("10"));
+        source.mAlbumsValues = {QStringLiteral("10"), QStringLiteral("/covers/album10.jpg")};
+
+        const auto knownFiles = QHash<QUrl, QDateTime>{
+            {QUrl::fromLocalFile(QStringLiteral("/music/track1.ogg")), QDateTime::fromSecsSinceEpoch(1000)},
+            {QUrl::fromLocalFile(QStringLiteral("/music/track2.ogg")), QDateTime::fromSecsSinceEpoch(2000)},
+        };
+
+        MediaStoreSynchronizer synchronizer;
+
+        const auto changes = synchronizer.synchronize(source, knownFiles);
+
+        QCOMPARE(source.mModifiedSince, qint64{2000});
+        QCOMPARE(source.mQueriedFilePaths, QStringList{QStringLiteral("/music/copied.ogg")});
+
+        QCOMPARE(changes.mModifiedTracks.size(), 1);
+        QCOMPARE(changes.mModifiedTracks.at(0).title(), QStringLiteral("copied"));
+        QCOMPARE(changes.mModifiedTracks.at(0).fileModificationTime(), QDateTime::fromSecsSinceEpoch(500));
+        QCOMPARE(changes.mRemovedFiles.size(), 0);
+
+        QCOMPARE(changes.mCovers.size(), 1);
+        QCOMPARE(changes.mCovers.value(QUrl::fromLocalFile(QStringLiteral("/music/copied.ogg")).toString()),
+                 QUrl::fromLocalFile(QStringLiteral("/covers/album10.jpg")));
+    }
+
+    void testIncompleteSynchronization()
+    {
+        MockMediaStoreSource source;
+        source.mIsComplete = false;
+
+        const auto knownFiles = QHash<QUrl, QDateTime>{
+            {QUrl::fromLocalFile(QStringLiteral("/music/track1.ogg")), QDateTime::fromSecsSinceEpoch(1000)},
+        };
+
+        MediaStoreSynchronizer synchronizer;
+
+        const auto changes = synchronizer.synchronize(source, knownFiles);
+
+        QCOMPARE(changes.mModifiedTracks.size(), 0);
+        QCOMPARE(changes.mRemovedFiles.size(), 0);
+    }
+};
+
+QTEST_GUILESS_MAIN(MediaStoreSynchronizerTest)
+
+
+#include "mediastoresynchronizertest.moc"
@@ -0,0 +1,292 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "playereventqueue.h"
+
+#include <QObject>
+#include <QElapsedTimer>
+
+#include <QtTest>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::atomic<quint64> allocationsCount{0};
+
+}
+
+void *operator new(std::size_t size)
+{
+    allocationsCount.fetch_add(1, std::memory_order_relaxed);
+
+    if (auto memory = std::malloc(size == 0 ? 1 : size)) {
+        return memory;
+    }
+
+    throw std::bad_alloc{};
+}
+
+void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+class PlayerEventQueueTest: public QObject
+{
+    Q_OBJECT
+
+public:
+
+    explicit PlayerEventQueueTest(QObject *aParent = nullptr) : QObject(aParent)
+    {
+    }
+
+private:
+
+    static qint64 encodeEvent(int producer, qint64 sequence)
+    {
+        return (static_cast<qint64>(producer) << 32) | sequence;
+    }
+
+private Q_SLOTS:
+
+    void coalescePositionAndVolume()
+    {
+        PlayerEventQueue queue;
+
+        QVERIFY(queue.push(PlayerEventQueue::EventType::Duration, 1000));
+        for (int position = 0; position <= 100; ++position) {
+            QVERIFY(queue.push(PlayerEventQueue::EventType::Position, position));
+            QVERIFY(queue.push(PlayerEventQueue::EventType::Volume, 100 - position));
+        }
+        QVERIFY(queue.push(PlayerEventQueue::EventType::Muted, 1));
+
+        auto events = std::vector<PlayerEventQueue::Event>{};
+        QCOMPARE(queue.drain([&events](const PlayerEventQueue::Event &event) {events.push_back(event);}), 4);
+
+        QCOMPARE(events.size(), std::size_t{4});
+        QCOMPARE(events[0].mType, PlayerEventQueue::EventType::Duration);
+        QCOMPARE(events[0].mValue, qint64{1000});
+        QCOMPARE(events[1].mType, PlayerEventQueue::EventType::Position);
+        QCOMPARE(events[1].mValue, qint64{100});
+        QCOMPARE(events[2].mType, PlayerEventQueue::EventType::Volume);
+        QCOMPARE(events[2].mValue, qint64{0});
+        QCOMPARE(events[3].mType, PlayerEventQueue::EventType::Muted);
+
+        QCOMPARE(queue.drain([](const PlayerEventQueue::Event &) {}), 0);
+    }
+
+    void positionBeforeLaterEvents()
+    {
+        PlayerEventQueue queue;
+
+        QVERIFY(queue.push(PlayerEventQueue::EventType::MediaStatus, 1));
+        QVERIFY(queue.push(PlayerEventQueue::EventType::Position, 500));
+        QVERIFY(queue.push(PlayerEventQueue::EventType::PlaybackState, 0));
+        QVERIFY(queue.push(PlayerEventQueue::EventType::MediaStatus, 2));
+
+        auto events = std::vector<PlayerEventQueue::Event>{};
+        QCOMPARE(queue.drain([&events](const PlayerEventQueue::Event &event) {events.push_back(event);}), 4);
+
+        QCOMPARE(events.size(), std::size_t{4});
+        QCOMPARE(events[0].mType, PlayerEventQueue::EventType::MediaStatus);
+        QCOMPARE(events[1].mType, PlayerEventQueue::EventType::Position);
+        QCOMPARE(events[1].mValue, qint64{500});
+        QCOMPARE(events[2].mType, PlayerEventQueue::EventType::PlaybackState);
+        QCOMPARE(events[3].mType, PlayerEventQueue::EventType::MediaStatus);
+
+        // a position pushed after the last event is delivered after it
+        QVERIFY(queue.push(PlayerEventQueue::EventType::PlaybackState, 1));
+        QVERIFY(queue.push(PlayerEventQueue::EventType::Position, 0));
+
+        events.clear();
+        QCOMPARE(queue.drain([&events](const PlayerEventQueue::Event &event) {events.push_back(event);}), 2);
+
+        QCOMPARE(events[0].mType, PlayerEventQueue::EventType::PlaybackState);
+        QCOMPARE(events[1].mType, PlayerEventQueue::EventType::Position);
+        QCOMPARE(events[1].mValue, qint64{0});
+    }
+
+    void dropWhenFull()
+    {
+        PlayerEventQueue queue;
+
+        for (std::size_t index = 0; index < PlayerEventQueue::Capacity; ++index) {
+            QVERIFY(queue.push(PlayerEventQueue::EventType::MediaStatus, static_cast<qint64>(index)));
+        }
+
+        QVERIFY(!queue.push(PlayerEventQueue::EventType::MediaStatus, 0));
+        QCOMPARE(queue.droppedEventsCount(), quint64{1});
+
+        // coalesced events never fill the queue
+        QVERIFY(queue.push(PlayerEventQueue::EventType::Position, 10));
+
+        auto expectedValue = qint64{0};
+        queue.drain([&expectedValue](const PlayerEventQueue::Event &event) {
+            if (event.mType == PlayerEventQueue::EventType::MediaStatus) {
+                QCOMPARE(event.mValue, expectedValue);
+                ++expectedValue;
+            }
+        });
+        QCOMPARE(expectedValue, static_cast<qint64>(PlayerEventQueue::Capacity));
+
+        QVERIFY(queue.push(PlayerEventQueue::EventType::MediaStatus, 0));
+    }
+
+    void singleWakeupPerDrain()
+    {
+        PlayerEventQueue queue;
+
+        QVERIFY(queue.push(PlayerEventQueue::EventType::Seekable, 1));
+        QVERIFY(queue.requestWakeup());
+        QVERIFY(queue.push(PlayerEventQueue::EventType::Seekable, 0));
+        QVERIFY(!queue.requestWakeup());
+
+        queue.drain([](const PlayerEventQueue::Event &) {});
+
+        QVERIFY(queue.requestWakeup());
+    }
+
+    void noAllocationPerEvent()
+    {
+        PlayerEventQueue queue;
+
+        const auto allocationsBefore = allocationsCount.load();
+
+        for (int index = 0; index < 100000; ++index) {
+            queue.push(PlayerEventQueue::EventType::Position, index);
+            queue.push(PlayerEventQueue::EventType::PlaybackState, index % 3);
+            queue.requestWakeup();
+
+            if (index % 64 == 0) {
+                queue.drain([](const PlayerEventQueue::Event &) {});
+            }
+        }
+
+        QCOMPARE(allocationsCount.load(), allocationsBefore);
+    }
+
+    void stressSeveralProducers()
+    {
+        constexpr int ProducersCount = 2;
+        constexpr qint64 EventsCount = 100000;
+
+        PlayerEventQueue queue;
+
+        std::mutex wakeupMutex;
+        std::condition_variable wakeupCondition;
+        auto wakeupPending = false;
+        std::atomic<int> finishedProducers{0};
+
+        QElapsedTimer clock;
+        clock.start();
+
+        auto pushTimes = std::vector<qint64>(ProducersCount * EventsCount);
+        auto lastSequence = std::vector<qint64>(ProducersCount, -1);
+        auto receivedEvents = qint64{0};
+        auto maximumLatency = qint64{0};
+
+        auto consumer = std::thread([&]() {
+            while (true) {
+                {
+                    std::unique_lock<std::mutex> lock(wakeupMutex);
+                    wakeupCondition.wait_for(lock, std::chrono::milliseconds(10), [&wakeupPending]() {return wakeupPending;});
+                    wakeupPending = false;
+                }
+
+                const auto allProducersFinished = finishedProducers.load() == ProducersCount;
+
+                queue.drain([&](const PlayerEventQueue::Event &event) {
+                    if (event.mType != PlayerEventQueue::EventType::MediaStatus) {
+                        return;
+                    }
+
+                    const auto producer = static_cast<int>(event.mValue >> 32);
+                    const auto sequence = event.mValue & 0xffffffff;
+
+                    if (sequence > lastSequence[producer]) {
+                        lastSequence[producer] = sequence;
+                        ++receivedEvents;
+                    }
+
+                    maximumLatency = std::max(maximumLatency, clock.nsecsElapsed() - pushTimes[producer * EventsCount + sequence]);
+                });
+
+                if (allProducersFinished) {
+                    break;
+                }
+            }
+        });
+
+        auto producers = std::vector<std::thread>{};
+        for (int producer = 0; producer < ProducersCount; ++producer) {
+            producers.emplace_back([&, producer]() {
+                for (qint64 sequence = 0; sequence < EventsCount; ++sequence) {
+                    pushTimes[producer * EventsCount + sequence] = clock.nsecsElapsed();
+
+                    while (!queue.push(PlayerEventQueue::EventType::MediaStatus, encodeEvent(producer, sequence))) {
+                        std::this_thread::yield();
+                    }
+                    queue.push(PlayerEventQueue::EventType::Position, sequence);
+
+                    if (queue.requestWakeup()) {
+                        std::lock_guard<std::mutex> lock(wakeupMutex);
+                        wakeupPending = true;
+                        wakeupCondition.notify_one();
+                    }
+                }
+
+                ++finishedProducers;
+            });
+        }
+
+        for (auto &oneProducer : producers) {
+            oneProducer.join();
+        }
+        consumer.join();
+
+        // every event is delivered once and in the order of its producer
+        QCOMPARE(receivedEvents, ProducersCount * EventsCount);
+        for (int producer = 0; producer < ProducersCount; ++producer) {
+            QCOMPARE(lastSequence[producer], EventsCount - 1);
+        }
+
+        qDebug() << "maximum latency" << maximumLatency / 1000 << "µs" << "dropped and retried" << queue.droppedEventsCount();
+
+        QVERIFY(maximumLatency < 1000000000);
+    }
+
+    void benchmarkPushAndDrain()
+    {
+        PlayerEventQueue queue;
+
+        QBENCHMARK {
+            for (int index = 0; index < 128; ++index) {
+                queue.push(PlayerEventQueue::EventType::Position, index);
+                queue.push(PlayerEventQueue::EventType::MediaStatus, index);
+            }
+            queue.drain([](const PlayerEventQueue::Event &) {});
+        }
+    }
+
+};
+
+QTEST_GUILESS_MAIN(PlayerEventQueueTest)
+
+
+#include "playereventqueuetest.moc"
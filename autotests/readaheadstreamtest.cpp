@@ -0,0 +1,148 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "readaheadstream.h"
+
+#include <QObject>
+#include <QRandomGenerator>
+#include <QTemporaryFile>
+
+#include <QtTest>
+
+#include <algorithm>
+
+class ReadAheadStreamTest: public QObject
+{
+    Q_OBJECT
+
+public:
+
+    explicit ReadAheadStreamTest(QObject *aParent = nullptr) : QObject(aParent)
+    {
+    }
+
+private:
+
+    QTemporaryFile mTestFile;
+
+    QByteArray mTestContent;
+
+    static QByteArray readAll(ReadAheadStream &stream, qint64 length)
+    {
+        auto result = QByteArray(static_cast<int>(length), '\0');
+        auto readLength = qint64{0};
+
+        while (readLength < length) {
+            const auto chunkLength = stream.read(result.data() + readLength, length - readLength);
+            if (chunkLength <= 0) {
+                break;
+            }
+            readLength += chunkLength;
+        }
+
+        result.resize(static_cast<int>(readLength));
+        return result;
+    }
+
+private Q_SLOTS:
+
+    void initTestCase()
+    {
+        // an odd size ensures the end of the file never falls on a chunk boundary
+        mTestContent.resize(3 * 1024 * 1024 + 17);
+        auto generator = QRandomGenerator(42);
+        std::generate(mTestContent.begin(), mTestContent.end(), [&generator]() {return static_cast<char>(generator.generate());});
+
+        QVERIFY(mTestFile.open());
+        QCOMPARE(mTestFile.write(mTestContent), static_cast<qint64>(mTestContent.size()));
+        mTestFile.close();
+    }
+
+    void sequentialRead_data()
+    {
+        QTest::addColumn<qint64>("bufferSize");
+
+        QTest::newRow("small buffer") << qint64{64 * 1024};
+        QTest::newRow("large buffer") << ReadAheadStream::DefaultBufferSize;
+    }
+
+    void sequentialRead()
+    {
+        QFETCH(qint64, bufferSize);
+
+        ReadAheadStream stream(mTestFile.fileName(), bufferSize);
+
+        QVERIFY(stream.open());
+        QCOMPARE(stream.size(), static_cast<qint64>(mTestContent.size()));
+
+        QCOMPARE(readAll(stream, mTestContent.size() + 1000), mTestContent);
+
+        char endOfFile = 0;
+        QCOMPARE(stream.read(&endOfFile, 1), qint64{0});
+    }
+
+    void randomSeeks()
+    {
+        ReadAheadStream stream(mTestFile.fileName(), 256 * 1024);
+
+        QVERIFY(stream.open());
+
+        auto generator = QRandomGenerator(7);
+        for (int seekIndex = 0; seekIndex < 200; ++seekIndex) {
+            const auto offset = static_cast<qint64>(generator.bounded(mTestContent.size()));
+            const auto length = static_cast<qint64>(generator.bounded(1, 50000));
+
+            QVERIFY(stream.seek(offset));
+            QCOMPARE(readAll(stream, length), mTestContent.mid(static_cast<int>(offset), static_cast<int>(length)));
+        }
+
+        QVERIFY(!stream.seek(mTestContent.size() + 1));
+        QVERIFY(!stream.seek(-1));
+    }
+
+    void shortBackwardSeekIsBuffered()
+    {
+        ReadAheadStream stream(mTestFile.fileName());
+
+        QVERIFY(stream.open());
+        QCOMPARE(readAll(stream, 100000), mTestContent.left(100000));
+
+        QVERIFY(stream.seek(10));
+        QCOMPARE(readAll(stream, 1000), mTestContent.mid(10, 1000));
+
+        // reopening the file keeps the prefetched data
+        stream.close();
+        QVERIFY(stream.open());
+        QCOMPARE(readAll(stream, 1000), mTestContent.left(1000));
+
+        QCOMPARE(stream.statistics().mRefills, 0);
+        QCOMPARE(stream.statistics().mBytesRead, qint64{102000});
+    }
+
+    void missingFile()
+    {
+        ReadAheadStream stream(mTestFile.fileName() + QStringLiteral(".missing"));
+
+        QVERIFY(!stream.open());
+        QCOMPARE(stream.size(), qint64{0});
+    }
+
+    void benchmarkSequentialRead()
+    {
+        QBENCHMARK {
+            ReadAheadStream stream(mTestFile.fileName());
+
+            stream.open();
+            readAll(stream, mTestContent.size());
+        }
+    }
+
+};
+
+QTEST_GUILESS_MAIN(ReadAheadStreamTest)
+
+
+#include "readaheadstreamtest.moc"
@@ -0,0 +1,107 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "rootpathsfilter.h"
+
+#include <QObject>
+
+#include <QtTest>
+
+class RootPathsFilterTest: public QObject
+{
+    Q_OBJECT
+
+public:
+
+    explicit RootPathsFilterTest(QObject *aParent = nullptr) : QObject(aParent)
+    {
+    }
+
+private Q_SLOTS:
+
+    void emptyFilter()
+    {
+        RootPathsFilter filter;
+
+        QVERIFY(filter.isEmpty());
+        QVERIFY(!filter.contains(QStringLiteral("/home/user/Music/track.ogg")));
+
+        RootPathsFilter filterWithEmptyPath({QString{}});
+
+        QVERIFY(filterWithEmptyPath.isEmpty());
+    }
+
+    void filesInRootPaths_data()
+    {
+        QTest::addColumn<QString>("filePath");
+        QTest::addColumn<bool>("isContained");
+
+        QTest::newRow("direct child") << QStringLiteral("/home/user/Music/track.ogg") << true;
+        QTest::newRow("nested child") << QStringLiteral("/home/user/Music/artist/album/track.ogg") << true;
+        QTest::newRow("root path itself") << QStringLiteral("/home/user/Music") << true;
+        QTest::newRow("second root path") << QStringLiteral("/mnt/nas/library/track.flac") << true;
+        QTest::newRow("doubled separator") << QStringLiteral("/home//user/Music/track.ogg") << true;
+        QTest::newRow("parent folder") << QStringLiteral("/home/user/track.ogg") << false;
+        QTest::newRow("same prefix") << QStringLiteral("/home/user/Music Videos/clip.ogg") << false;
+        QTest::newRow("other root") << QStringLiteral("/mnt/usb/track.ogg") << false;
+        QTest::newRow("empty path") << QString{} << false;
+    }
+
+    void filesInRootPaths()
+    {
+        QFETCH(QString, filePath);
+        QFETCH(bool, isContained);
+
+        RootPathsFilter filter({QStringLiteral("/home/user/Music/"), QStringLiteral("/mnt/nas/library"),
+                                QStringLiteral("/home/user/Music/artist")});
+
+        QVERIFY(!filter.isEmpty());
+        QCOMPARE(filter.contains(filePath), isContained);
+    }
+
+    void wholeFileSystem()
+    {
+        RootPathsFilter filter({QStringLiteral("/")});
+
+        QVERIFY(!filter.isEmpty());
+        QVERIFY(filter.contains(QStringLiteral("/any/track.ogg")));
+    }
+
+    void benchmarkManyFiles()
+    {
+        auto rootPaths = QStringList{};
+        for (int rootIndex = 0; rootIndex < 20; ++rootIndex) {
+            rootPaths.push_back(QStringLiteral("/srv/music/collection%1").arg(rootIndex));
+        }
+
+        auto filePaths = QStringList{};
+        for (int fileIndex = 0; fileIndex < 300000; ++fileIndex) {
+            filePaths.push_back(QStringLiteral("/srv/music/collection%1/artist%2/album%3/track%4.flac")
+                                .arg(fileIndex % 40).arg(fileIndex % 997).arg(fileIndex % 13).arg(fileIndex));
+        }
+
+        RootPathsFilter filter(rootPaths);
+
+        auto containedFilesCount = 0;
+
+        QBENCHMARK {
+            containedFilesCount = 0;
+            for (const auto &oneFilePath : qAsConst(filePaths)) {
+                if (filter.contains(oneFilePath)) {
+                    ++containedFilesCount;
+                }
+            }
+        }
+
+        QCOMPARE(containedFilesCount, 150000);
+    }
+
+};
+
+QTEST_GUILESS_MAIN(RootPathsFilterTest)
+
+
+#include "rootpathsfiltertest.moc"
@@ -0,0 +1,128 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "tagwriter.h"
+#include "filescanner.h"
+#include "config-upnp-qt.h"
+
+#include <QObject>
+#include <QList>
+#include <QUrl>
+#include <QFile>
+#include <QFileInfo>
+
+#include <QtTest>
+
+class TagWriterTest: public QObject
+{
+    Q_OBJECT
+
+public:
+
+    explicit TagWriterTest(QObject *aParent = nullptr) : QObject(aParent)
+    {
+    }
+
+private:
+
+    QUrl copyTestFile(const QString &testFileName)
+    {
+        QFile::remove(testFileName);
+        QFile::copy(QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music/test.ogg"), testFileName);
+        QFile::setPermissions(testFileName, QFile::ReadOwner | QFile::WriteOwner);
+
+        return QUrl::fromLocalFile(QFileInfo(testFileName).absoluteFilePath());
+    }
+
+private Q_SLOTS:
+
+    void initTestCase()
+    {
+        qRegisterMetaType<DataTypes::ListTrackDataType>("DataTypes::ListTrackDataType");
+        qRegisterMetaType<QHash<QString,QUrl>>("QHash<QString,QUrl>");
+        qRegisterMetaType<QList<QUrl>>("QList<QUrl>");
+    }
+
+    void testBatchWrite()
+    {
+        auto testFiles = QList<QUrl>{};
+        for (int fileIndex = 0; fileIndex < 5; ++fileIndex) {
+            testFiles.push_back(copyTestFile(QStringLiteral("tagWriterBatchTest%1.ogg").arg(fileIndex)));
+        }
+
+        TagWriter tagWriter;
+
+        QSignalSpy tracksWrittenSpy(&tagWriter, &TagWriter::tracksMetaDataWritten);
+        QSignalSpy filesNotWrittenSpy(&tagWriter, &TagWriter::filesNotWritten);
+
+        tagWriter.writeMetaDataToFiles(testFiles, DataTypes::GenreRole, QStringLiteral("batchGenre"));
+
+        QVERIFY(tracksWrittenSpy.wait());
+        QCOMPARE(tracksWrittenSpy.count(), 1);
+        QCOMPARE(filesNotWrittenSpy.count(), 0);
+        QCOMPARE(tagWriter.pendingFilesCount(), 0);
+
+        const auto writtenTracks = tracksWrittenSpy.at(0).at(0).value<DataTypes::ListTrackDataType>();
+        QCOMPARE(writtenTracks.size(), testFiles.size());
+
+        FileScanner fileScanner;
+        for (const auto &oneFile : testFiles) {
+            const auto scannedTrack = fileScanner.scanOneFile(oneFile);
+            QCOMPARE(scannedTrack.genre(), QStringLiteral("batchGenre"));
+            QCOMPARE(scannedTrack.title(), QStringLiteral("Title"));
+
+            QFile::remove(oneFile.toLocalFile());
+        }
+    }
+
+    void testMergedEdits()
+    {
+        const auto testFile = copyTestFile(QStringLiteral("tagWriterMergeTest.ogg"));
+
+        TagWriter tagWriter;
+
+        QSignalSpy tracksWrittenSpy(&tagWriter, &TagWriter::tracksMetaDataWritten);
+
+        tagWriter.writeSingleMetaData(testFile, DataTypes::AlbumRole, QStringLiteral("mergedAlbum"));
+        tagWriter.writeSingleMetaData(testFile, DataTypes::GenreRole, QStringLiteral("mergedGenre"));
+        tagWriter.writeTrackMetaData(testFile, {{DataTypes::TitleRole, QStringLiteral("mergedTitle")},
+                                                {DataTypes::GenreRole, QStringLiteral("lastGenre")}});
+
+        // edits arriving while the file is written lead to a second write
+        QTRY_COMPARE(tagWriter.pendingFilesCount(), 0);
+        QTRY_VERIFY(!tracksWrittenSpy.isEmpty());
+
+        FileScanner fileScanner;
+        const auto scannedTrack = fileScanner.scanOneFile(testFile);
+        QCOMPARE(scannedTrack.album(), QStringLiteral("mergedAlbum"));
+        QCOMPARE(scannedTrack.genre(), QStringLiteral("lastGenre"));
+        QCOMPARE(scannedTrack.title(), QStringLiteral("mergedTitle"));
+        QCOMPARE(scannedTrack.artist(), QStringLiteral("Artist"));
+
+        QFile::remove(testFile.toLocalFile());
+    }
+
+    void testInvalidFile()
+    {
+        TagWriter tagWriter;
+
+        QSignalSpy tracksWrittenSpy(&tagWriter, &TagWriter::tracksMetaDataWritten);
+        QSignalSpy filesNotWrittenSpy(&tagWriter, &TagWriter::filesNotWritten);
+
+        const auto missingFile = QUrl::fromLocalFile(QStringLiteral("/nonExistingFolder/missing.ogg"));
+
+        tagWriter.writeSingleMetaData(missingFile, DataTypes::GenreRole, QStringLiteral("genre"));
+
+        QVERIFY(filesNotWrittenSpy.wait());
+        QCOMPARE(tracksWrittenSpy.count(), 0);
+        QCOMPARE(filesNotWrittenSpy.at(0).at(0).value<QList<QUrl>>(), QList<QUrl>{missingFile});
+    }
+};
+
+QTEST_GUILESS_MAIN(TagWriterTest)
+
+
+#include "tagwritertest.moc"
@@ -0,0 +1,132 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "tracklongtextprovider.h"
+#include "databaseinterface.h"
+#include "filewriter.h"
+#include "config-upnp-qt.h"
+
+#include <QObject>
+#include <QUrl>
+#include <QFile>
+#include <QFileInfo>
+#include <QThread>
+#include <QTime>
+#include <QDateTime>
+
+#include <QtTest>
+
+class TrackLongTextProviderTest: public QObject
+{
+    Q_OBJECT
+
+public:
+
+    explicit TrackLongTextProviderTest(QObject *aParent = nullptr) : QObject(aParent)
+    {
+    }
+
+private:
+
+    QUrl copyTestFile(const QString &testFileName)
+    {
+        QFile::remove(testFileName);
+        QFile::copy(QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music/test.ogg"), testFileName);
+        QFile::setPermissions(testFileName, QFile::ReadOwner | QFile::WriteOwner);
+
+        return QUrl::fromLocalFile(QFileInfo(testFileName).absoluteFilePath());
+    }
+
+private Q_SLOTS:
+
+    void initTestCase()
+    {
+        qRegisterMetaType<DataTypes::ListTrackDataType>("ListTrackDataType");
+    }
+
+    void testRequestLongText()
+    {
+        const auto testFile = copyTestFile(QStringLiteral("trackLongTextTest.ogg"));
+
+        TrackLongTextProvider longTextProvider;
+
+        QSignalSpy longTextSpy(&longTextProvider, &TrackLongTextProvider::longTextReady);
+
+        longTextProvider.requestLongText(testFile);
+
+        QVERIFY(longTextSpy.wait());
+        QCOMPARE(longTextSpy.count(), 1);
+        QCOMPARE(longTextSpy.at(0).at(0).toUrl(), testFile);
+        QCOMPARE(longTextSpy.at(0).at(1).toString(), QString());
+        QCOMPARE(longTextSpy.at(0).at(2).toString(), QStringLiteral("Comment"));
+
+        // the file modification time is more recent than the cached text
+        QThread::msleep(10);
+
+        FileWriter fileWriter;
+        QVERIFY(fileWriter.writeSingleMetaDataToFile(testFile, DataTypes::CommentRole, QStringLiteral("modifiedComment")));
+
+        longTextProvider.requestLongText(testFile);
+
+        QVERIFY(longTextSpy.wait());
+        QCOMPARE(longTextSpy.count(), 2);
+        QCOMPARE(longTextSpy.at(1).at(2).toString(), QStringLiteral("modifiedComment"));
+
+        QFile::remove(testFile.toLocalFile());
+    }
+
+    void testRemoteFile()
+    {
+        TrackLongTextProvider longTextProvider;
+
+        QSignalSpy longTextSpy(&longTextProvider, &TrackLongTextProvider::longTextReady);
+
+        longTextProvider.requestLongText(QUrl(QStringLiteral("http://127.0.0.1/radio.ogg")));
+
+        QVERIFY(!longTextSpy.wait(100));
+    }
+
+    void testRemoteFileFromDatabase()
+    {
+        DatabaseInterface musicDb;
+
+        musicDb.init(QStringLiteral("testDb"));
+
+        const auto remoteUrl = QUrl(QStringLiteral("content://media/external/audio/media/23"));
+
+        auto newTrack = DataTypes::TrackDataType{true, QStringLiteral("$23"), QStringLiteral("0"), QStringLiteral("track6"),
+                QStringLiteral("artist2"), QStringLiteral("album3"), {},
+                6, 1, QTime::fromMSecsSinceStartOfDay(23), remoteUrl,
+                QDateTime::fromMSecsSinceEpoch(23),
+                {}, 5, true,
+                QStringLiteral("genre1"), QStringLiteral("composer1"), QStringLiteral("lyricist1"), false};
+        newTrack[DataTypes::CommentRole] = QStringLiteral("remote comment");
+
+        QSignalSpy tracksAddedSpy(&musicDb, &DatabaseInterface::tracksAdded);
+
+        musicDb.insertTracksList({newTrack}, {});
+
+        QCOMPARE(tracksAddedSpy.count(), 1);
+
+        TrackLongTextProvider longTextProvider;
+        longTextProvider.setDatabase(&musicDb);
+
+        QSignalSpy longTextSpy(&longTextProvider, &TrackLongTextProvider::longTextReady);
+
+        longTextProvider.requestLongText(remoteUrl);
+
+        QVERIFY(longTextSpy.wait());
+        QCOMPARE(longTextSpy.count(), 1);
+        QCOMPARE(longTextSpy.at(0).at(0).toUrl(), remoteUrl);
+        QCOMPARE(longTextSpy.at(0).at(1).toString(), QString());
+        QCOMPARE(longTextSpy.at(0).at(2).toString(), QStringLiteral("remote comment"));
+    }
+};
+
+QTEST_GUILESS_MAIN(TrackLongTextProviderTest)
+
+
+#include "tracklongtextprovidertest.moc"
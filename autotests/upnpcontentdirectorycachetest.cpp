@@ -0,0 +1,77 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "upnpcontentdirectorycache.h"
+
+#include <QObject>
+#include <QTemporaryDir>
+
+#include <QtTest>
+
+class UpnpContentDirectoryCacheTest: public QObject
+{
+    Q_OBJECT
+
+public:
+
+    explicit UpnpContentDirectoryCacheTest(QObject *aParent = nullptr) : QObject(aParent)
+    {
+    }
+
+private Q_SLOTS:
+
+    void storeAndReadEntry()
+    {
+        QTemporaryDir cacheDirectory;
+        QVERIFY(cacheDirectory.isValid());
+
+        const auto pages = QStringList{QStringLiteral("<DIDL-Lite><item id=\"1\"/></DIDL-Lite>"),
+                                       QStringLiteral("<DIDL-Lite><item id=\"2\"/></DIDL-Lite>")};
+
+        UpnpContentDirectoryCache cache(QStringLiteral("server-uuid"), cacheDirectory.path());
+
+        QVERIFY(!cache.entry(QStringLiteral("0")));
+        QVERIFY(cache.storeEntry(QStringLiteral("0"), {pages, 42}));
+
+        UpnpContentDirectoryCache reopenedCache(QStringLiteral("server-uuid"), cacheDirectory.path());
+
+        const auto storedEntry = reopenedCache.entry(QStringLiteral("0"));
+
+        QVERIFY(storedEntry);
+        QCOMPARE(storedEntry->mResults, pages);
+        QCOMPARE(storedEntry->mSystemUpdateId, 42);
+
+        QVERIFY(!reopenedCache.entry(QStringLiteral("1")));
+
+        UpnpContentDirectoryCache otherServerCache(QStringLiteral("other-uuid"), cacheDirectory.path());
+
+        QVERIFY(!otherServerCache.entry(QStringLiteral("0")));
+    }
+
+    void invalidateContainers()
+    {
+        QTemporaryDir cacheDirectory;
+        QVERIFY(cacheDirectory.isValid());
+
+        UpnpContentDirectoryCache cache(QStringLiteral("server-uuid"), cacheDirectory.path());
+
+        QVERIFY(cache.storeEntry(QStringLiteral("0"), {{QStringLiteral("<DIDL-Lite/>")}, 1}));
+        QVERIFY(cache.storeEntry(QStringLiteral("album1"), {{QStringLiteral("<DIDL-Lite/>")}, 1}));
+        QVERIFY(cache.storeEntry(QStringLiteral("album2"), {{QStringLiteral("<DIDL-Lite/>")}, 1}));
+
+        const auto changedContainers = cache.invalidateContainers(QStringLiteral("album1,7,album2,3"));
+
+        QCOMPARE(changedContainers, QStringList({QStringLiteral("album1"), QStringLiteral("album2")}));
+        QVERIFY(cache.entry(QStringLiteral("0")));
+        QVERIFY(!cache.entry(QStringLiteral("album1")));
+        QVERIFY(!cache.entry(QStringLiteral("album2")));
+    }
+};
+
+QTEST_GUILESS_MAIN(UpnpContentDirectoryCacheTest)
+
+
+#include "upnpcontentdirectorycachetest.moc"
@@ -0,0 +1,152 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "waveformpeaks.h"
+#include "waveformcache.h"
+
+#include <QObject>
+#include <QTemporaryDir>
+
+#include <QtMath>
+#include <QtTest>
+
+#include <cmath>
+#include <vector>
+
+class WaveformPeaksTest: public QObject
+{
+    Q_OBJECT
+
+public:
+
+    explicit WaveformPeaksTest(QObject *aParent = nullptr) : QObject(aParent)
+    {
+    }
+
+private:
+
+    static std::vector<float> stereoSine(double amplitude, int sampleRate, double duration)
+    {
+        const auto framesCount = static_cast<qsizetype>(sampleRate * duration);
+
+        auto result = std::vector<float>(framesCount * 2);
+        for (qsizetype frame = 0; frame < framesCount; ++frame) {
+            const auto sample = static_cast<float>(amplitude * std::sin(2. * M_PI * 440. * frame / sampleRate));
+            result[2 * frame] = sample;
+            result[2 * frame + 1] = sample;
+        }
+
+        return result;
+    }
+
+private Q_SLOTS:
+
+    void sampleRange()
+    {
+        const auto samples = std::vector<float>{0.1f, -0.4f, 0.3f, 0.2f, -0.1f, 0.f, 0.25f, -0.3f, 0.7f, -0.2f, 0.1f};
+
+        auto minimum = 0.f;
+        auto maximum = 0.f;
+        WaveformPeaks::sampleRange(samples.data(), static_cast<qsizetype>(samples.size()), minimum, maximum);
+
+        QCOMPARE(minimum, -0.4f);
+        QCOMPARE(maximum, 0.7f);
+    }
+
+    void sinePeaks()
+    {
+        const auto samples = stereoSine(0.5, 44100, 10.);
+
+        WaveformPeaks waveform(2, 44100);
+        waveform.addFrames(samples.data(), static_cast<qsizetype>(samples.size() / 2));
+
+        const auto peaks = waveform.peaks();
+
+        QCOMPARE(peaks.size(), 2 * 10 * WaveformPeaks::PeaksPerSecond);
+
+        for (int peak = 0; peak < peaks.size() / 2; ++peak) {
+            QVERIFY(std::abs(static_cast<qint8>(peaks[2 * peak]) + 63) <= 1);
+            QVERIFY(std::abs(static_cast<qint8>(peaks[2 * peak + 1]) - 63) <= 1);
+        }
+    }
+
+    void integerSamples()
+    {
+        const auto samples = stereoSine(0.5, 48000, 2.);
+
+        auto integerSamples = std::vector<qint16>(samples.size());
+        for (std::size_t index = 0; index < samples.size(); ++index) {
+            integerSamples[index] = static_cast<qint16>(qRound(samples[index] * 32767.f));
+        }
+
+        WaveformPeaks floatWaveform(2, 48000);
+        floatWaveform.addFrames(samples.data(), static_cast<qsizetype>(samples.size() / 2));
+
+        WaveformPeaks integerWaveform(2, 48000);
+        integerWaveform.addFrames(integerSamples.data(), static_cast<qsizetype>(integerSamples.size() / 2));
+
+        const auto floatPeaks = floatWaveform.peaks();
+        const auto integerPeaks = integerWaveform.peaks();
+
+        QCOMPARE(integerPeaks.size(), floatPeaks.size());
+        for (int index = 0; index < floatPeaks.size(); ++index) {
+            QVERIFY(std::abs(static_cast<qint8>(integerPeaks[index]) - static_cast<qint8>(floatPeaks[index])) <= 1);
+        }
+    }
+
+    void longStreamIsMerged()
+    {
+        const auto samples = stereoSine(0.25, 8000, 600.);
+
+        WaveformPeaks waveform(2, 8000);
+        waveform.addFrames(samples.data(), static_cast<qsizetype>(samples.size() / 2));
+
+        const auto peaks = waveform.peaks();
+
+        QVERIFY(peaks.size() <= 2 * WaveformPeaks::MaximumPeaksCount);
+        QVERIFY(peaks.size() >= WaveformPeaks::MaximumPeaksCount);
+    }
+
+    void cacheEntries()
+    {
+        QTemporaryDir cacheDirectory;
+        QVERIFY(cacheDirectory.isValid());
+
+        WaveformCache cache(cacheDirectory.path());
+
+        const auto filePath = QStringLiteral("/music/artist/album/track.ogg");
+        const auto modifiedTime = QDateTime::fromMSecsSinceEpoch(1700000000000);
+        const auto peaks = QByteArray("\x81\x7f\xc0\x40", 4);
+
+        QVERIFY(!cache.peaks(filePath, modifiedTime));
+
+        QVERIFY(cache.storePeaks(filePath, modifiedTime, peaks));
+
+        const auto cachedPeaks = cache.peaks(filePath, modifiedTime);
+        QVERIFY(cachedPeaks);
+        QCOMPARE(*cachedPeaks, peaks);
+
+        QVERIFY(!cache.peaks(filePath, modifiedTime.addSecs(1)));
+        QVERIFY(!cache.peaks(QStringLiteral("/music/artist/album/other.ogg"), modifiedTime));
+    }
+
+    void benchmarkWaveformPeaks()
+    {
+        const auto samples = stereoSine(0.5, 44100, 60.);
+
+        QBENCHMARK {
+            WaveformPeaks waveform(2, 44100);
+            waveform.addFrames(samples.data(), static_cast<qsizetype>(samples.size() / 2));
+            waveform.peaks();
+        }
+    }
+
+};
+
+QTEST_GUILESS_MAIN(WaveformPeaksTest)
+
+
+#include "waveformpeakstest.moc"
@@ -24,6 +24,8 @@
 
 #cmakedefine01 KF5FileMetaData_FOUND
 
+#cmakedefine01 ELISA_ENABLE_TRACING
+
 #define LOCAL_FILE_TESTS_SAMPLE_FILES_PATH "@CMAKE_CURRENT_SOURCE_DIR@/autotests/data"
 
 #define LOCAL_FILE_TESTS_WORKING_PATH "@CMAKE_CURRENT_BINARY_DIR@/autotests/data"
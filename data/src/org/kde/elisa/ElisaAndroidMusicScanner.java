@@ -9,11 +9,20 @@ import android.database.Cursor;
 import android.content.Intent;
 import android.provider.MediaStore;
 
+import java.util.Arrays;
+
 /**
  * Created by mgallien on 02/05/17.
  */
 
 public class ElisaAndroidMusicScanner {
+    // number of rows sent at once to the native code
+    private static final int BATCH_SIZE = 500;
+
+    // number of paths bound in one query, below the SQLite limit of host parameters
+    private static final int PATHS_QUERY_SIZE = 500;
+
+    // must match MediaStoreSynchronizer::TrackColumns
     private static String[] tracksRequestedColumns = {
         MediaStore.Audio.Media._ID,
         MediaStore.Audio.Media.TITLE,
@@ -22,70 +31,174 @@ public class ElisaAndroidMusicScanner {
         MediaStore.Audio.Media.DURATION,
         MediaStore.Audio.Media.DATA,
         MediaStore.Audio.Media.ARTIST,
-        MediaStore.Audio.Media.ARTIST_ID,
         MediaStore.Audio.Media.ALBUM,
         MediaStore.Audio.Media.ALBUM_ID,
         MediaStore.Audio.Media.COMPOSER,
+        MediaStore.Audio.Media.DATE_MODIFIED,
     };
 
+    private static String[] filesRequestedColumns = {
+        MediaStore.Audio.Media.DATA,
+    };
+
+    // must match MediaStoreSynchronizer::AlbumColumns
     private static String[] albumsRequestedColumns = {
         MediaStore.Audio.Albums._ID,
-        MediaStore.Audio.Albums.ALBUM,
         MediaStore.Audio.Albums.ALBUM_ART,
-        MediaStore.Audio.Albums.ARTIST,
-        MediaStore.Audio.Albums.NUMBER_OF_SONGS,
     };
 
-    public static void listAudioFiles(Context ctx)
+    public static void listAudioFiles(Context ctx, long modifiedSince)
     {
         androidMusicScanTracksStarting();
 
         //Some audio may be explicitly marked as not being music
-        String tracksSelection = MediaStore.Audio.Media.IS_MUSIC + " != 0";
-        String tracksSortOrder = MediaStore.Audio.Media.DEFAULT_SORT_ORDER + " ASC";
-
-        Cursor tracksCursor = ctx.getContentResolver().query(MediaStore.Audio.Media.EXTERNAL_CONTENT_URI, tracksRequestedColumns, tracksSelection, null, tracksSortOrder);
-
-        tracksCursor.moveToFirst();
-        
-        while(tracksCursor.moveToNext()) {
-            sendMusicFile(tracksCursor.getString(0) + "||" + tracksCursor.getString(1) + "||" +
-                tracksCursor.getString(2) + "||" + tracksCursor.getString(3) + "||" + 
-                tracksCursor.getString(4) + "||" + tracksCursor.getString(5) + "||" + 
-                tracksCursor.getString(6) + "||" + tracksCursor.getString(7) + "||" + 
-                tracksCursor.getString(8) + "||" + tracksCursor.getString(9) + "||" + 
-                tracksCursor.getString(10));
+        String musicSelection = MediaStore.Audio.Media.IS_MUSIC + " != 0";
+
+        //Only the paths of all files are read to find the removed ones
+        Cursor filesCursor = ctx.getContentResolver().query(MediaStore.Audio.Media.EXTERNAL_CONTENT_URI, filesRequestedColumns, musicSelection, null, null);
+
+        if (filesCursor == null) {
+            androidMusicScanFailed();
+            return;
+        }
+
+        for (String[] batch = nextBatch(filesCursor); batch != null; batch = nextBatch(filesCursor)) {
+            sendMusicFilePaths(batch);
+        }
+
+        filesCursor.close();
+
+        //Tracks modified during the second of the cursor are read again, the native code ignores the known ones
+        String tracksSelection = musicSelection + " AND " + MediaStore.Audio.Media.DATE_MODIFIED + " >= ?";
+        String[] tracksSelectionArguments = { Long.toString(modifiedSince) };
+        String tracksSortOrder = MediaStore.Audio.Media.DATE_MODIFIED + " ASC";
+
+        Cursor tracksCursor = ctx.getContentResolver().query(MediaStore.Audio.Media.EXTERNAL_CONTENT_URI, tracksRequestedColumns, tracksSelection, tracksSelectionArguments, tracksSortOrder);
+
+        int modifiedTracksCount = 0;
+
+        if (tracksCursor != null) {
+            modifiedTracksCount = tracksCursor.getCount();
+
+            for (String[] batch = nextBatch(tracksCursor); batch != null; batch = nextBatch(tracksCursor)) {
+                sendMusicFiles(batch);
+            }
+
+            tracksCursor.close();
         }
 
         androidMusicScanTracksFinishing();
 
         androidMusicScanAlbumsStarting();
 
-        //Some audio may be explicitly marked as not being music
-        String albumsSortOrder = MediaStore.Audio.Albums.DEFAULT_SORT_ORDER + " ASC";
+        //Album covers are only needed for modified tracks
+        if (modifiedTracksCount > 0) {
+            Cursor albumsCursor = ctx.getContentResolver().query(MediaStore.Audio.Albums.EXTERNAL_CONTENT_URI, albumsRequestedColumns, null, null, null);
 
-        Cursor albumsCursor = ctx.getContentResolver().query(MediaStore.Audio.Albums.EXTERNAL_CONTENT_URI, albumsRequestedColumns, null, null, albumsSortOrder);
+            if (albumsCursor != null) {
+                for (String[] batch = nextBatch(albumsCursor); batch != null; batch = nextBatch(albumsCursor)) {
+                    sendMusicAlbums(batch);
+                }
 
-        albumsCursor.moveToFirst();
-        
-        while(albumsCursor.moveToNext()) {
-            sendMusicAlbum(albumsCursor.getString(0) + "||" + albumsCursor.getString(1) + "||" + 
-            albumsCursor.getString(2) + "||" + albumsCursor.getString(3) + "||" + albumsCursor.getString(4));
+                albumsCursor.close();
+            }
         }
-        
+
         androidMusicScanAlbumsFinishing();
     }
 
+    /**
+     * Read the tracks of new files whose modification time is older than the cursor
+     */
+    public static void listTracks(Context ctx, String[] filePaths)
+    {
+        androidMusicScanTracksStarting();
+
+        String musicSelection = MediaStore.Audio.Media.IS_MUSIC + " != 0";
+
+        int readTracksCount = 0;
+
+        for (int pathsStart = 0; pathsStart < filePaths.length; pathsStart += PATHS_QUERY_SIZE) {
+            String[] tracksSelectionArguments = Arrays.copyOfRange(filePaths, pathsStart, Math.min(pathsStart + PATHS_QUERY_SIZE, filePaths.length));
+
+            StringBuilder tracksSelection = new StringBuilder(musicSelection + " AND " + MediaStore.Audio.Media.DATA + " IN (?");
+            for (int argument = 1; argument < tracksSelectionArguments.length; ++argument) {
+                tracksSelection.append(",?");
+            }
+            tracksSelection.append(")");
+
+            Cursor tracksCursor = ctx.getContentResolver().query(MediaStore.Audio.Media.EXTERNAL_CONTENT_URI, tracksRequestedColumns, tracksSelection.toString(), tracksSelectionArguments, null);
+
+            if (tracksCursor == null) {
+                androidMusicScanFailed();
+                continue;
+            }
+
+            readTracksCount += tracksCursor.getCount();
+
+            for (String[] batch = nextBatch(tracksCursor); batch != null; batch = nextBatch(tracksCursor)) {
+                sendMusicFiles(batch);
+            }
+
+            tracksCursor.close();
+        }
+
+        androidMusicScanTracksFinishing();
+
+        androidMusicScanAlbumsStarting();
+
+        if (readTracksCount > 0) {
+            Cursor albumsCursor = ctx.getContentResolver().query(MediaStore.Audio.Albums.EXTERNAL_CONTENT_URI, albumsRequestedColumns, null, null, null);
+
+            if (albumsCursor != null) {
+                for (String[] batch = nextBatch(albumsCursor); batch != null; batch = nextBatch(albumsCursor)) {
+                    sendMusicAlbums(batch);
+                }
+
+                albumsCursor.close();
+            }
+        }
+
+        androidMusicScanAlbumsFinishing();
+    }
+
+    /**
+     * Read up to BATCH_SIZE rows, the values of all columns of a row are stored one after the other
+     */
+    private static String[] nextBatch(Cursor cursor)
+    {
+        int rowsCount = Math.min(BATCH_SIZE, cursor.getCount() - cursor.getPosition() - 1);
+
+        if (rowsCount <= 0) {
+            return null;
+        }
+
+        int columnsCount = cursor.getColumnCount();
+        String[] batch = new String[rowsCount * columnsCount];
+
+        for (int row = 0; row < rowsCount && cursor.moveToNext(); ++row) {
+            for (int column = 0; column < columnsCount; ++column) {
+                batch[row * columnsCount + column] = cursor.getString(column);
+            }
+        }
+
+        return batch;
+    }
+
     private static native void androidMusicScanTracksStarting();
 
-    private static native void sendMusicFile(String musicFile);
+    private static native void sendMusicFilePaths(String[] filePaths);
+
+    private static native void sendMusicFiles(String[] tracksValues);
 
     private static native void androidMusicScanTracksFinishing();
 
     private static native void androidMusicScanAlbumsStarting();
 
-    private static native void sendMusicAlbum(String musicFile);
+    private static native void sendMusicAlbums(String[] albumsValues);
 
     private static native void androidMusicScanAlbumsFinishing();
 
+    private static native void androidMusicScanFailed();
+
 }
@@ -119,5 +119,7 @@ Kirigami.ApplicationWindow {
         pageStack.push(artistsView)
         pageStack.push(tracksView)
         pageStack.push(genresView)
+
+        elisa.startBackgroundTasksAfterFirstFrame(mainWindow)
     }
 }
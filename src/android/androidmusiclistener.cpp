@@ -7,6 +7,7 @@
 #include "androidmusiclistener.h"
 
 #include "databaseinterface.h"
+#include "mediastoresynchronizer.h"
 
 #include <QDateTime>
 #include <QMetaObject>
@@ -18,28 +19,137 @@
 #include <QtAndroid>
 #include <QDebug>
 
+class AndroidMediaStoreSource : public MediaStoreCursorSource
+{
+
+public:
+
+    bool queryAudioFiles(MediaStoreSynchronizer &synchronizer, qint64 modifiedSince) override;
+
+    bool queryTracks(MediaStoreSynchronizer &synchronizer, const QStringList &filePaths) override;
+
+    MediaStoreSynchronizer *mSynchronizer = nullptr;
+
+    bool mScanFailed = false;
+
+};
+
 class AndroidMusicListenerPrivate
 {
 public:
 
+    /**
+     * number of tracks sent in one batch to the database, each batch is inserted in its own transaction
+     */
+    static constexpr int TracksBatchSize = 1000;
+
     QString mSourceName;
 
-    QHash<QUrl, QDateTime> mAllFiles;
+    MediaStoreSynchronizer mSynchronizer;
 
-    DataTypes::ListTrackDataType mNewTracks;
-    QHash<QString, QUrl> mCovers;
+    AndroidMediaStoreSource mMediaStoreSource;
 
 };
 
+bool AndroidMediaStoreSource::queryAudioFiles(MediaStoreSynchronizer &synchronizer, qint64 modifiedSince)
+{
+    mSynchronizer = &synchronizer;
+    mScanFailed = false;
+
+    // the scanner calls back the native methods from this thread before returning
+    QAndroidJniObject::callStaticMethod<void>("org/kde/elisa/ElisaAndroidMusicScanner",
+                                              "listAudioFiles",
+                                              "(Landroid/content/Context;J)V",
+                                              QtAndroid::androidContext().object(),
+                                              static_cast<jlong>(modifiedSince));
+
+    QAndroidJniEnvironment env;
+    if (env->ExceptionCheck()) {
+        env->ExceptionClear();
+        mScanFailed = true;
+    }
+
+    mSynchronizer = nullptr;
+
+    return !mScanFailed;
+}
+
+bool AndroidMediaStoreSource::queryTracks(MediaStoreSynchronizer &synchronizer, const QStringList &filePaths)
+{
+    mSynchronizer = &synchronizer;
+    mScanFailed = false;
+
+    QAndroidJniEnvironment env;
+
+    auto stringClass = env->FindClass("java/lang/String");
+    auto javaFilePaths = env->NewObjectArray(filePaths.size(), stringClass, nullptr);
+    env->DeleteLocalRef(stringClass);
+    for (int pathIndex = 0; pathIndex < filePaths.size(); ++pathIndex) {
+        const auto &oneFilePath = filePaths[pathIndex];
+        auto javaFilePath = env->NewString(reinterpret_cast<const jchar*>(oneFilePath.constData()), oneFilePath.size());
+        env->SetObjectArrayElement(javaFilePaths, pathIndex, javaFilePath);
+        env->DeleteLocalRef(javaFilePath);
+    }
+
+    // the scanner calls back the native methods from this thread before returning
+    QAndroidJniObject::callStaticMethod<void>("org/kde/elisa/ElisaAndroidMusicScanner",
+                                              "listTracks",
+                                              "(Landroid/content/Context;[Ljava/lang/String;)V",
+                                              QtAndroid::androidContext().object(),
+                                              javaFilePaths);
+
+    if (env->ExceptionCheck()) {
+        env->ExceptionClear();
+        mScanFailed = true;
+    }
+
+    env->DeleteLocalRef(javaFilePaths);
+
+    mSynchronizer = nullptr;
+
+    return !mScanFailed;
+}
+
+static QStringList stringListFromJavaArray(JNIEnv *env, jobjectArray values)
+{
+    const auto valuesCount = env->GetArrayLength(values);
+
+    auto result = QStringList{};
+    result.reserve(valuesCount);
+
+    for (jsize valueIndex = 0; valueIndex < valuesCount; ++valueIndex) {
+        auto oneValue = static_cast<jstring>(env->GetObjectArrayElement(values, valueIndex));
+
+        if (!oneValue) {
+            result.push_back({});
+            continue;
+        }
+
+        // java strings are UTF-16 like QString, their characters are copied without any conversion
+        const auto length = env->GetStringLength(oneValue);
+        const auto characters = env->GetStringChars(oneValue, nullptr);
+        result.push_back(QString(reinterpret_cast<const QChar*>(characters), length));
+        env->ReleaseStringChars(oneValue, characters);
+
+        env->DeleteLocalRef(oneValue);
+    }
+
+    return result;
+}
+
 static void tracksAndroidScanStarted(JNIEnv */*env*/, jobject /*obj*/)
 {
     AndroidMusicListener::currentInstance()->androidMusicTracksScanStarted();
 }
 
-static void sentMusicFile(JNIEnv */*env*/, jobject /*obj*/, jstring musicFile)
+static void sentMusicFilePaths(JNIEnv *env, jobject /*obj*/, jobjectArray filePaths)
 {
-    QAndroidJniObject musicFileJavaString(musicFile);
-    AndroidMusicListener::currentInstance()->newMusicTrack(musicFileJavaString.toString());
+    AndroidMusicListener::currentInstance()->newMusicFilePaths(stringListFromJavaArray(env, filePaths));
+}
+
+static void sentMusicFiles(JNIEnv *env, jobject /*obj*/, jobjectArray tracksValues)
+{
+    AndroidMusicListener::currentInstance()->newMusicTracks(stringListFromJavaArray(env, tracksValues));
 }
 
 static void tracksAndroidScanFinished(JNIEnv */*env*/, jobject /*obj*/)
@@ -52,10 +162,9 @@ static void albumsAndroidScanStarted(JNIEnv */*env*/, jobject /*obj*/)
     AndroidMusicListener::currentInstance()->androidMusicAlbumsScanStarted();
 }
 
-static void sentMusicAlbum(JNIEnv */*env*/, jobject /*obj*/, jstring musicAlbum)
+static void sentMusicAlbums(JNIEnv *env, jobject /*obj*/, jobjectArray albumsValues)
 {
-    QAndroidJniObject musicAlbumJavaString(musicAlbum);
-    AndroidMusicListener::currentInstance()->newMusicAlbum(musicAlbumJavaString.toString());
+    AndroidMusicListener::currentInstance()->newMusicAlbums(stringListFromJavaArray(env, albumsValues));
 }
 
 static void albumsAndroidScanFinished(JNIEnv */*env*/, jobject /*obj*/)
@@ -63,6 +172,11 @@ static void albumsAndroidScanFinished(JNIEnv */*env*/, jobject /*obj*/)
     AndroidMusicListener::currentInstance()->androidMusicAlbumsScanFinished();
 }
 
+static void androidScanFailed(JNIEnv */*env*/, jobject /*obj*/)
+{
+    AndroidMusicListener::currentInstance()->androidMusicScanFailed();
+}
+
 AndroidMusicListener::AndroidMusicListener(QObject *parent) : QObject(parent), d(std::make_unique<AndroidMusicListenerPrivate>())
 {
     AndroidMusicListener::mCurrentInstance = this;
@@ -80,11 +194,13 @@ DatabaseInterface *AndroidMusicListener::databaseInterface() const
 void AndroidMusicListener::registerNativeMethods()
 {
     JNINativeMethod methods[] {{"androidMusicScanTracksStarting", "()V", reinterpret_cast<void *>(tracksAndroidScanStarted)},
-        {"sendMusicFile", "(Ljava/lang/String;)V", reinterpret_cast<void *>(sentMusicFile)},
+        {"sendMusicFilePaths", "([Ljava/lang/String;)V", reinterpret_cast<void *>(sentMusicFilePaths)},
+        {"sendMusicFiles", "([Ljava/lang/String;)V", reinterpret_cast<void *>(sentMusicFiles)},
         {"androidMusicScanTracksFinishing", "()V", reinterpret_cast<void *>(tracksAndroidScanFinished)},
         {"androidMusicScanAlbumsStarting", "()V", reinterpret_cast<void *>(albumsAndroidScanStarted)},
-        {"sendMusicAlbum", "(Ljava/lang/String;)V", reinterpret_cast<void *>(sentMusicAlbum)},
+        {"sendMusicAlbums", "([Ljava/lang/String;)V", reinterpret_cast<void *>(sentMusicAlbums)},
         {"androidMusicScanAlbumsFinishing", "()V", reinterpret_cast<void *>(albumsAndroidScanFinished)},
+        {"androidMusicScanFailed", "()V", reinterpret_cast<void *>(androidScanFailed)},
     };
 
     QAndroidJniObject javaClass("org/kde/elisa/ElisaAndroidMusicScanner");
@@ -107,33 +223,18 @@ void AndroidMusicListener::androidMusicTracksScanStarted()
 {
 }
 
-void AndroidMusicListener::newMusicTrack(const QString &trackDescription)
+void AndroidMusicListener::newMusicFilePaths(const QStringList &filePaths)
 {
-    auto trackData = trackDescription.split(QStringLiteral("||"));
-    auto newTrack = DataTypes::TrackDataType{};
-    newTrack[DataTypes::TitleRole] = trackData[1];
-    bool conversionOK = false;
-    if (trackData[2] != QLatin1String("null")) {
-        newTrack[DataTypes::TrackNumberRole] = trackData[2].toInt(&conversionOK);
-        if (!conversionOK) {
-            qInfo() << "newMusicTrack" << trackData[1] << trackData[2];
-        }
+    if (d->mMediaStoreSource.mSynchronizer) {
+        d->mMediaStoreSource.mSynchronizer->addFilePaths(filePaths);
     }
-    if (trackData[3] != QLatin1String("null")) {
-        newTrack[DataTypes::YearRole] = trackData[3].toInt(&conversionOK);
-        if (!conversionOK) {
-            qInfo() << "newMusicTrack" << trackData[1] << trackData[3];
-        }
-    }
-    if (trackData[4] != QLatin1String("null")) {
-        newTrack[DataTypes::DurationRole] = QTime::fromMSecsSinceStartOfDay(trackData[4].toInt());
-    }
-    newTrack[DataTypes::ResourceRole] = QUrl::fromLocalFile(trackData[5]);
-    newTrack[DataTypes::ArtistRole] = trackData[6];
-    newTrack[DataTypes::AlbumRole] = trackData[8];
-    newTrack[DataTypes::ComposerRole] = trackData[10];
+}
 
-    d->mNewTracks.push_back(newTrack);
+void AndroidMusicListener::newMusicTracks(const QStringList &tracksValues)
+{
+    if (d->mMediaStoreSource.mSynchronizer) {
+        d->mMediaStoreSource.mSynchronizer->addTracks(tracksValues);
+    }
 }
 
 void AndroidMusicListener::androidMusicTracksScanFinished()
@@ -144,18 +245,20 @@ void AndroidMusicListener::androidMusicAlbumsScanStarted()
 {
 }
 
-void AndroidMusicListener::newMusicAlbum(const QString &albumDescription)
+void AndroidMusicListener::newMusicAlbums(const QStringList &albumsValues)
 {
-    auto albumData = albumDescription.split(QStringLiteral("||"));
-
-    if (albumData[2] != QLatin1String("null)")) {
-        d->mCovers[albumData[1]] = QUrl::fromLocalFile(albumData[2]);
+    if (d->mMediaStoreSource.mSynchronizer) {
+        d->mMediaStoreSource.mSynchronizer->addAlbums(albumsValues);
     }
 }
 
 void AndroidMusicListener::androidMusicAlbumsScanFinished()
 {
-    Q_EMIT tracksList(d->mNewTracks, d->mCovers);
+}
+
+void AndroidMusicListener::androidMusicScanFailed()
+{
+    d->mMediaStoreSource.mScanFailed = true;
 }
 
 void AndroidMusicListener::setDatabaseInterface(DatabaseInterface *model)
@@ -187,12 +290,22 @@ void AndroidMusicListener::quitListener()
 
 void AndroidMusicListener::restoredTracks(QHash<QUrl, QDateTime> allFiles)
 {
-    d->mAllFiles = allFiles;
+    Q_EMIT indexingStarted();
 
-    QAndroidJniObject::callStaticMethod<void>("org/kde/elisa/ElisaAndroidMusicScanner",
-                                              "listAudioFiles",
-                                              "(Landroid/content/Context;)V",
-                                              QtAndroid::androidContext().object());
+    const auto changes = d->mSynchronizer.synchronize(d->mMediaStoreSource, allFiles);
+
+    qInfo() << "AndroidMusicListener::restoredTracks" << changes.mModifiedTracks.size() << "modified tracks"
+            << changes.mRemovedFiles.size() << "removed tracks";
+
+    if (!changes.mRemovedFiles.isEmpty()) {
+        Q_EMIT removedTracksList(changes.mRemovedFiles);
+    }
+
+    for (auto batchStart = 0; batchStart < changes.mModifiedTracks.size(); batchStart += AndroidMusicListenerPrivate::TracksBatchSize) {
+        Q_EMIT tracksList(changes.mModifiedTracks.mid(batchStart, AndroidMusicListenerPrivate::TracksBatchSize), changes.mCovers);
+    }
+
+    Q_EMIT indexingFinished();
 }
 
 void AndroidMusicListener::init()
@@ -14,6 +14,7 @@
 #include <QHash>
 #include <QUrl>
 #include <QString>
+#include <QStringList>
 
 #include <memory>
 
@@ -44,16 +45,20 @@ public:
 
     void androidMusicTracksScanStarted();
 
-    void newMusicTrack(const QString &trackDescription);
+    void newMusicFilePaths(const QStringList &filePaths);
+
+    void newMusicTracks(const QStringList &tracksValues);
 
     void androidMusicTracksScanFinished();
 
     void androidMusicAlbumsScanStarted();
 
-    void newMusicAlbum(const QString &albumDescription);
+    void newMusicAlbums(const QStringList &albumsValues);
 
     void androidMusicAlbumsScanFinished();
 
+    void androidMusicScanFailed();
+
 Q_SIGNALS:
 
     void databaseInterfaceChanged();
@@ -0,0 +1,201 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "mediastoresynchronizer.h"
+
+#include <QSet>
+#include <QTime>
+
+#include <algorithm>
+#include <utility>
+
+class MediaStoreSynchronizerPrivate
+{
+
+public:
+
+    QHash<QUrl, QDateTime> mKnownFiles;
+
+    /**
+     * known files not yet seen in the MediaStore
+     */
+    QSet<QUrl> mRemainingFiles;
+
+    /**
+     * unknown files seen in the MediaStore
+     */
+    QStringList mNewFilePaths;
+
+    /**
+     * files whose track was read
+     */
+    QSet<QString> mReadFilePaths;
+
+    QHash<QUrl, QString> mTrackAlbumIds;
+
+    QHash<QString, QString> mAlbumArts;
+
+    MediaStoreSynchronizer::Changes mChanges;
+
+};
+
+MediaStoreSynchronizer::MediaStoreSynchronizer() : d(std::make_unique<MediaStoreSynchronizerPrivate>())
+{
+}
+
+MediaStoreSynchronizer::~MediaStoreSynchronizer() = default;
+
+qint64 MediaStoreSynchronizer::modificationCursor(const QHash<QUrl, QDateTime> &knownFiles)
+{
+    auto cursor = qint64{0};
+
+    for (const auto &oneModificationTime : knownFiles) {
+        if (oneModificationTime.isValid()) {
+            cursor = std::max(cursor, oneModificationTime.toSecsSinceEpoch());
+        }
+    }
+
+    return cursor;
+}
+
+MediaStoreSynchronizer::Changes MediaStoreSynchronizer::synchronize(MediaStoreCursorSource &source, const QHash<QUrl, QDateTime> &knownFiles)
+{
+    d->mKnownFiles = knownFiles;
+    d->mRemainingFiles.clear();
+    d->mRemainingFiles.reserve(knownFiles.size());
+    for (auto itFile = knownFiles.constBegin(); itFile != knownFiles.constEnd(); ++itFile) {
+        d->mRemainingFiles.insert(itFile.key());
+    }
+
+    const auto isComplete = source.queryAudioFiles(*this, modificationCursor(knownFiles));
+
+    // new files can have a modification time older than the cursor, their tracks are read by path
+    auto missingFilePaths = QStringList{};
+    for (const auto &oneFilePath : qAsConst(d->mNewFilePaths)) {
+        if (!d->mReadFilePaths.contains(oneFilePath)) {
+            missingFilePaths.push_back(oneFilePath);
+        }
+    }
+
+    if (!missingFilePaths.isEmpty()) {
+        source.queryTracks(*this, missingFilePaths);
+    }
+
+    for (auto itTrack = d->mTrackAlbumIds.constBegin(); itTrack != d->mTrackAlbumIds.constEnd(); ++itTrack) {
+        const auto &albumArt = d->mAlbumArts.value(itTrack.value());
+        if (!albumArt.isEmpty()) {
+            d->mChanges.mCovers[itTrack.key().toString()] = QUrl::fromLocalFile(albumArt);
+        }
+    }
+
+    // files can only be considered removed if all paths were read
+    if (isComplete) {
+        d->mChanges.mRemovedFiles = d->mRemainingFiles.values();
+    }
+
+    auto changes = std::exchange(d->mChanges, {});
+
+    d->mKnownFiles.clear();
+    d->mRemainingFiles.clear();
+    d->mNewFilePaths.clear();
+    d->mReadFilePaths.clear();
+    d->mTrackAlbumIds.clear();
+    d->mAlbumArts.clear();
+
+    return changes;
+}
+
+void MediaStoreSynchronizer::addFilePaths(const QStringList &filePaths)
+{
+    for (const auto &oneFilePath : filePaths) {
+        if (oneFilePath.isEmpty()) {
+            continue;
+        }
+
+        const auto fileUrl = QUrl::fromLocalFile(oneFilePath);
+
+        d->mRemainingFiles.remove(fileUrl);
+
+        if (!d->mKnownFiles.contains(fileUrl)) {
+            d->mNewFilePaths.push_back(oneFilePath);
+        }
+    }
+}
+
+void MediaStoreSynchronizer::addTracks(const QStringList &values)
+{
+    d->mChanges.mModifiedTracks.reserve(d->mChanges.mModifiedTracks.size() + values.size() / TrackColumnsCount);
+
+    for (auto rowStart = 0; rowStart + TrackColumnsCount <= values.size(); rowStart += TrackColumnsCount) {
+        const auto &filePath = values[rowStart + TrackDataColumn];
+        if (filePath.isEmpty()) {
+            continue;
+        }
+
+        d->mReadFilePaths.insert(filePath);
+
+        const auto fileUrl = QUrl::fromLocalFile(filePath);
+        const auto modificationTime = QDateTime::fromSecsSinceEpoch(values[rowStart + TrackDateModifiedColumn].toLongLong());
+
+        // tracks modified during the second of the cursor are read again but only the new ones are kept
+        const auto itKnownFile = d->mKnownFiles.constFind(fileUrl);
+        if (itKnownFile != d->mKnownFiles.constEnd() && *itKnownFile == modificationTime) {
+            continue;
+        }
+
+        auto newTrack = DataTypes::TrackDataType{};
+
+        newTrack[DataTypes::ResourceRole] = fileUrl;
+        newTrack[DataTypes::FileModificationTime] = modificationTime;
+        newTrack[DataTypes::TitleRole] = values[rowStart + TrackTitleColumn];
+
+        bool conversionOK = false;
+
+        // the MediaStore stores the disc number in the thousands of the track number
+        const auto trackNumber = values[rowStart + TrackNumberColumn].toInt(&conversionOK);
+        if (conversionOK) {
+            newTrack[DataTypes::TrackNumberRole] = trackNumber % 1000;
+            if (trackNumber >= 1000) {
+                newTrack[DataTypes::DiscNumberRole] = trackNumber / 1000;
+            }
+        }
+
+        const auto year = values[rowStart + TrackYearColumn].toInt(&conversionOK);
+        if (conversionOK) {
+            newTrack[DataTypes::YearRole] = year;
+        }
+
+        const auto duration = values[rowStart + TrackDurationColumn].toInt(&conversionOK);
+        if (conversionOK) {
+            newTrack[DataTypes::DurationRole] = QTime::fromMSecsSinceStartOfDay(duration);
+        }
+
+        if (!values[rowStart + TrackArtistColumn].isNull()) {
+            newTrack[DataTypes::ArtistRole] = values[rowStart + TrackArtistColumn];
+        }
+        if (!values[rowStart + TrackAlbumColumn].isNull()) {
+            newTrack[DataTypes::AlbumRole] = values[rowStart + TrackAlbumColumn];
+        }
+        if (!values[rowStart + TrackComposerColumn].isNull()) {
+            newTrack[DataTypes::ComposerRole] = values[rowStart + TrackComposerColumn];
+        }
+
+        if (!values[rowStart + TrackAlbumIdColumn].isEmpty()) {
+            d->mTrackAlbumIds[fileUrl] = values[rowStart + TrackAlbumIdColumn];
+        }
+
+        d->mChanges.mModifiedTracks.push_back(std::move(newTrack));
+    }
+}
+
+void MediaStoreSynchronizer::addAlbums(const QStringList &values)
+{
+    for (auto rowStart = 0; rowStart + AlbumColumnsCount <= values.size(); rowStart += AlbumColumnsCount) {
+        if (!values[rowStart + AlbumArtColumn].isEmpty()) {
+            d->mAlbumArts[values[rowStart + AlbumIdColumn]] = values[rowStart + AlbumArtColumn];
+        }
+    }
+}
@@ -0,0 +1,125 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef MEDIASTORESYNCHRONIZER_H
+#define MEDIASTORESYNCHRONIZER_H
+
+#include "datatypes.h"
+
+#include <QDateTime>
+#include <QHash>
+#include <QList>
+#include <QStringList>
+#include <QUrl>
+
+#include <memory>
+
+class MediaStoreSynchronizer;
+class MediaStoreSynchronizerPrivate;
+
+/**
+ * Source of the rows of the Android MediaStore.
+ *
+ * On Android, the rows are read from MediaStore cursors through JNI.
+ */
+class MediaStoreCursorSource
+{
+
+public:
+
+    virtual ~MediaStoreCursorSource() = default;
+
+    /**
+     * send to the synchronizer the paths of all audio files, the tracks
+     * modified since modifiedSince and their albums
+     *
+     * @param modifiedSince oldest modification time of the tracks to read, in seconds since epoch
+     *
+     * @return false if the list of audio files could not be read completely
+     */
+    virtual bool queryAudioFiles(MediaStoreSynchronizer &synchronizer, qint64 modifiedSince) = 0;
+
+    /**
+     * send to the synchronizer the tracks stored at filePaths and their albums
+     *
+     * @return false if the tracks could not be read completely
+     */
+    virtual bool queryTracks(MediaStoreSynchronizer &synchronizer, const QStringList &filePaths) = 0;
+
+};
+
+/**
+ * Incremental synchronization of the database with the Android MediaStore.
+ *
+ * The modification time stored in the database for each track is used as a
+ * cursor. Only the tracks modified since the most recent known one are read
+ * and converted. The paths of all audio files are read to find the removed
+ * ones, which is a lot cheaper than reading all columns. They also give the
+ * new files older than the cursor, copied with their modification time, whose
+ * tracks are then read by path.
+ *
+ * Rows are received in batches of string values, TrackColumnsCount or
+ * AlbumColumnsCount values for each row.
+ */
+class MediaStoreSynchronizer
+{
+
+public:
+
+    enum TrackColumns {
+        TrackIdColumn,
+        TrackTitleColumn,
+        TrackNumberColumn,
+        TrackYearColumn,
+        TrackDurationColumn,
+        TrackDataColumn,
+        TrackArtistColumn,
+        TrackAlbumColumn,
+        TrackAlbumIdColumn,
+        TrackComposerColumn,
+        TrackDateModifiedColumn,
+        TrackColumnsCount,
+    };
+
+    enum AlbumColumns {
+        AlbumIdColumn,
+        AlbumArtColumn,
+        AlbumColumnsCount,
+    };
+
+    struct Changes
+    {
+        DataTypes::ListTrackDataType mModifiedTracks;
+
+        QHash<QString, QUrl> mCovers;
+
+        QList<QUrl> mRemovedFiles;
+    };
+
+    MediaStoreSynchronizer();
+
+    ~MediaStoreSynchronizer();
+
+    /**
+     * most recent modification time of the known files, in seconds since epoch
+     */
+    static qint64 modificationCursor(const QHash<QUrl, QDateTime> &knownFiles);
+
+    Changes synchronize(MediaStoreCursorSource &source, const QHash<QUrl, QDateTime> &knownFiles);
+
+    void addFilePaths(const QStringList &filePaths);
+
+    void addTracks(const QStringList &values);
+
+    void addAlbums(const QStringList &values);
+
+private:
+
+    std::unique_ptr<MediaStoreSynchronizerPrivate> d;
+
+};
+
+#endif // MEDIASTORESYNCHRONIZER_H
@@ -0,0 +1,55 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "audiofiledecoder.h"
+
+#include "loudnessLogging.h"
+
+#include <QAudioDecoder>
+#include <QEventLoop>
+
+bool AudioFileDecoder::decode(const QUrl &fileUrl, const BufferHandler &bufferHandler,
+                              const std::atomic<bool> *stopRequested)
+{
+    QAudioDecoder decoder;
+    QEventLoop decodingLoop;
+    auto isValid = true;
+
+    QObject::connect(&decoder, &QAudioDecoder::bufferReady, &decodingLoop, [&]() {
+        if (stopRequested && *stopRequested) {
+            isValid = false;
+            decoder.stop();
+            decodingLoop.quit();
+            return;
+        }
+
+        const auto buffer = decoder.read();
+        if (!buffer.isValid()) {
+            return;
+        }
+
+        if (!bufferHandler(buffer)) {
+            qCDebug(orgKdeElisaLoudness()) << "AudioFileDecoder::decode" << fileUrl << "aborted with buffer format" << buffer.format();
+
+            isValid = false;
+            decoder.stop();
+            decodingLoop.quit();
+        }
+    });
+    QObject::connect(&decoder, &QAudioDecoder::finished, &decodingLoop, &QEventLoop::quit);
+    QObject::connect(&decoder, QOverload<QAudioDecoder::Error>::of(&QAudioDecoder::error), &decodingLoop, [&]() {
+        qCDebug(orgKdeElisaLoudness()) << "AudioFileDecoder::decode" << fileUrl << decoder.errorString();
+
+        isValid = false;
+        decodingLoop.quit();
+    });
+
+    decoder.setSourceFilename(fileUrl.toLocalFile());
+    decoder.start();
+    decodingLoop.exec();
+
+    return isValid;
+}
@@ -0,0 +1,62 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef AUDIOFILEDECODER_H
+#define AUDIOFILEDECODER_H
+
+#include "elisaLib_export.h"
+
+#include <QAudioBuffer>
+#include <QUrl>
+
+#include <atomic>
+#include <functional>
+
+/**
+ * Synchronous decoding of a whole audio file, meant to be used from a worker thread.
+ */
+class ELISALIB_EXPORT AudioFileDecoder
+{
+
+public:
+
+    /**
+     * called for each decoded buffer, returning false aborts the decoding
+     */
+    using BufferHandler = std::function<bool(const QAudioBuffer &buffer)>;
+
+    /**
+     * decode fileUrl until its end, an error, an aborting handler or stopRequested becoming true
+     *
+     * @return true if the file has been decoded completely
+     */
+    static bool decode(const QUrl &fileUrl, const BufferHandler &bufferHandler,
+                       const std::atomic<bool> *stopRequested = nullptr);
+
+    /**
+     * give the samples of buffer to consumer->addFrames, false if the sample format is not supported
+     */
+    template <typename Consumer>
+    static bool forwardSamples(const QAudioBuffer &buffer, Consumer &consumer)
+    {
+        const auto format = buffer.format();
+
+        if (format.sampleType() == QAudioFormat::Float && format.sampleSize() == 32) {
+            consumer.addFrames(buffer.constData<float>(), buffer.frameCount());
+        } else if (format.sampleType() == QAudioFormat::SignedInt && format.sampleSize() == 16) {
+            consumer.addFrames(buffer.constData<qint16>(), buffer.frameCount());
+        } else if (format.sampleType() == QAudioFormat::SignedInt && format.sampleSize() == 32) {
+            consumer.addFrames(buffer.constData<qint32>(), buffer.frameCount());
+        } else {
+            return false;
+        }
+
+        return true;
+    }
+
+};
+
+#endif // AUDIOFILEDECODER_H
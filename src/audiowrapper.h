@@ -37,6 +37,11 @@ class ELISALIB_EXPORT AudioWrapper : public QObject
                WRITE setSource
                NOTIFY sourceChanged)
 
+    Q_PROPERTY(QUrl nextSource
+               READ nextSource
+               WRITE setNextSource
+               NOTIFY nextSourceChanged)
+
     Q_PROPERTY(QMediaPlayer::MediaStatus status
                READ status
                NOTIFY statusChanged)
@@ -62,6 +67,11 @@ class ELISALIB_EXPORT AudioWrapper : public QObject
                READ seekable
                NOTIFY seekableChanged)
 
+    Q_PROPERTY(int positionUpdateRate
+               READ positionUpdateRate
+               WRITE setPositionUpdateRate
+               NOTIFY positionUpdateRateChanged)
+
 public:
 
     explicit AudioWrapper(QObject *parent = nullptr);
@@ -74,6 +84,8 @@ public:
 
     QUrl source() const;
 
+    QUrl nextSource() const;
+
     QMediaPlayer::MediaStatus status() const;
 
     QMediaPlayer::State playbackState() const;
@@ -86,6 +98,14 @@ public:
 
     bool seekable() const;
 
+    int positionUpdateRate() const;
+
+    /**
+     * position extrapolated from the last published one with a monotonic clock,
+     * for consumers that need a precise value between two positionChanged signals
+     */
+    Q_INVOKABLE qint64 estimatedPosition() const;
+
 Q_SIGNALS:
 
     void mutedChanged(bool muted);
@@ -94,6 +114,13 @@ Q_SIGNALS:
 
     void sourceChanged();
 
+    void nextSourceChanged();
+
+    /**
+     * emitted when playback continued on the preloaded next source at the end of the current one
+     */
+    void nextSourceStarted(const QUrl &source);
+
     void statusChanged(QMediaPlayer::MediaStatus status);
 
     void playbackStateChanged(QMediaPlayer::State state);
@@ -108,6 +135,8 @@ Q_SIGNALS:
 
     void seekableChanged(bool seekable);
 
+    void positionUpdateRateChanged();
+
     void playing();
 
     void paused();
@@ -122,6 +151,11 @@ public Q_SLOTS:
 
     void setSource(const QUrl &source);
 
+    /**
+     * open and pre-buffer the source that is expected to be played after the current one
+     */
+    void setNextSource(const QUrl &source);
+
     void setPosition(qint64 position);
 
     void saveUndoPosition(qint64 position);
@@ -136,6 +170,21 @@ public Q_SLOTS:
 
     void seek(qint64 position);
 
+    /**
+     * number of positionChanged signals per second while playing, 0 disables the periodic updates
+     */
+    void setPositionUpdateRate(int rate);
+
+    /**
+     * read local files through a large buffer filled by a dedicated I/O thread, useful for network mounts
+     */
+    void setReadAheadBuffering(bool enabled);
+
+    /**
+     * gain in dB applied to source, either the current or the next one, on top of the volume
+     */
+    void setReplayGain(const QUrl &source, qreal gain);
+
 private Q_SLOTS:
 
     void mediaStatusChanged();
@@ -149,6 +198,8 @@ private Q_SLOTS:
 private:
     void savePosition(qint64 position);
 
+    void switchToNextSource();
+
     void playerStateSignalChanges(QMediaPlayer::State newState);
 
     void mediaStatusSignalChanges(QMediaPlayer::MediaStatus newStatus);
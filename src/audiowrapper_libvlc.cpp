@@ -10,9 +10,20 @@
 
 #include "vlcLogging.h"
 #include "powermanagementinterface.h"
+#include "playereventqueue.h"
+#include "readaheadstream.h"
 
 #include <QAudio>
 #include <QDir>
+#include <QTimer>
+#include <QElapsedTimer>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <vector>
 
 #if defined Q_OS_WIN
 
@@ -36,12 +47,28 @@ public:
 
     libvlc_instance_t *mInstance = nullptr;
 
-    libvlc_media_player_t *mPlayer = nullptr;
+    std::atomic<libvlc_media_player_t*> mPlayer = nullptr;
 
     libvlc_event_manager_t *mPlayerEventManager = nullptr;
 
     libvlc_media_t *mMedia = nullptr;
 
+    std::atomic<libvlc_media_player_t*> mNextPlayer = nullptr;
+
+    libvlc_media_t *mNextMedia = nullptr;
+
+    QUrl mNextSource;
+
+    bool mReadAheadBuffering = false;
+
+    std::unique_ptr<ReadAheadStream> mReadAhead;
+
+    std::unique_ptr<ReadAheadStream> mNextReadAhead;
+
+    std::atomic<bool> mNextIsReady = false;
+
+    bool mMediaStartsPaused = false;
+
     qint64 mMediaDuration = 0;
 
     QMediaPlayer::State mPreviousPlayerState = QMediaPlayer::StoppedState;
@@ -56,6 +83,33 @@ public:
 
     qint64 mPreviousPosition = 0;
 
+    std::atomic<qint64> mLatestPosition = 0;
+
+    std::atomic<bool> mPositionDiscontinuity = false;
+
+    /**
+     * last stream meta data sent, only used from the libvlc event thread
+     */
+    libvlc_media_t *mStreamMetaDataMedia = nullptr;
+
+    QString mStreamTitle;
+
+    QString mStreamNowPlaying;
+
+    QTimer mPositionClock;
+
+    QElapsedTimer mPositionReference;
+
+    int mPositionUpdateRate = 4;
+
+    bool mIsPlaying = false;
+
+    QUrl mSource;
+
+    qreal mReplayGain = 0.;
+
+    qreal mNextReplayGain = 0.;
+
     QMediaPlayer::Error mError = QMediaPlayer::NoError;
 
     bool mIsMuted = false;
@@ -64,8 +118,49 @@ public:
 
     bool mHasSavedPosition = false;
 
+    /**
+     * events from the libvlc threads waiting to be handled in the GUI thread
+     */
+    PlayerEventQueue mEvents;
+
+    struct RetiredPlayer
+    {
+        libvlc_media_player_t *mPlayer = nullptr;
+
+        libvlc_media_t *mMedia = nullptr;
+
+        std::unique_ptr<ReadAheadStream> mReadAhead;
+    };
+
+    /**
+     * players replaced by the preloaded one, stopped and released from the event loop
+     */
+    std::vector<RetiredPlayer> mRetiredPlayers;
+
+    void postEvent(PlayerEventQueue::EventType type, qint64 value);
+
+    void drainEvents();
+
     void vlcEventCallback(const struct libvlc_event_t *p_event);
 
+    void nextPlayerEventCallback(libvlc_event_e eventType);
+
+    libvlc_media_player_t* createPlayer();
+
+    void detachPlayer(libvlc_media_player_t *player);
+
+    void releaseRetiredPlayers();
+
+    libvlc_media_t* createMedia(const QUrl &source, std::unique_ptr<ReadAheadStream> &readAhead);
+
+    void releaseReadAhead(std::unique_ptr<ReadAheadStream> &readAhead);
+
+    void releaseNextSource();
+
+    void applyReplayGain(libvlc_media_player_t *player, qreal gain);
+
+    void adoptNextPlayer();
+
     void mediaIsEnded();
 
     bool signalPlaybackChange(QMediaPlayer::State newPlayerState);
@@ -80,6 +175,14 @@ public:
 
     void signalPositionChange(float newPosition);
 
+    void signalStreamMetaData(libvlc_media_t *media);
+
+    static QString mediaMetaData(libvlc_media_t *media, libvlc_meta_t metaType);
+
+    void publishPosition(qint64 newPosition);
+
+    void updatePositionClock();
+
     void signalSeekableChange(bool isSeekable);
 
     void signalErrorChange(QMediaPlayer::Error errorCode);
@@ -91,6 +194,54 @@ static void vlc_callback(const struct libvlc_event_t *p_event, void *p_data)
     reinterpret_cast<AudioWrapperPrivate*>(p_data)->vlcEventCallback(p_event);
 }
 
+static constexpr std::array<libvlc_event_e, 14> playerEvents = {
+    libvlc_MediaPlayerOpening,
+    libvlc_MediaPlayerBuffering,
+    libvlc_MediaPlayerPlaying,
+    libvlc_MediaPlayerPaused,
+    libvlc_MediaPlayerStopped,
+    libvlc_MediaPlayerEndReached,
+    libvlc_MediaPlayerEncounteredError,
+    libvlc_MediaPlayerPositionChanged,
+    libvlc_MediaPlayerSeekableChanged,
+    libvlc_MediaPlayerLengthChanged,
+    libvlc_MediaPlayerMuted,
+    libvlc_MediaPlayerUnmuted,
+    libvlc_MediaPlayerAudioVolume,
+    libvlc_MediaPlayerAudioDevice,
+};
+
+static int readAheadOpen(void *opaque, void **datap, uint64_t *sizep)
+{
+    auto readAhead = static_cast<ReadAheadStream*>(opaque);
+
+    *datap = opaque;
+
+    if (!readAhead->open()) {
+        *sizep = 0;
+        return -1;
+    }
+
+    *sizep = static_cast<uint64_t>(readAhead->size());
+
+    return 0;
+}
+
+static ssize_t readAheadRead(void *opaque, unsigned char *buf, size_t len)
+{
+    return static_cast<ssize_t>(static_cast<ReadAheadStream*>(opaque)->read(reinterpret_cast<char*>(buf), static_cast<qint64>(len)));
+}
+
+static int readAheadSeek(void *opaque, uint64_t offset)
+{
+    return static_cast<ReadAheadStream*>(opaque)->seek(static_cast<qint64>(offset)) ? 0 : -1;
+}
+
+static void readAheadClose(void *opaque)
+{
+    static_cast<ReadAheadStream*>(opaque)->close();
+}
+
 AudioWrapper::AudioWrapper(QObject *parent) : QObject(parent), d(std::make_unique<AudioWrapperPrivate>())
 {
     d->mParent = this;
@@ -98,7 +249,10 @@ AudioWrapper::AudioWrapper(QObject *parent) : QObject(parent), d(std::make_uniqu
     libvlc_set_user_agent(d->mInstance, "elisa", "Elisa Music Player");
     libvlc_set_app_id(d->mInstance, "org.kde.elisa", ELISA_VERSION_STRING, "elisa");
 
-    d->mPlayer = libvlc_media_player_new(d->mInstance);
+    d->mPositionClock.setTimerType(Qt::CoarseTimer);
+    connect(&d->mPositionClock, &QTimer::timeout, this, [this]() {d->publishPosition(d->mLatestPosition);});
+
+    d->mPlayer = d->createPlayer();
 
     if (!d->mPlayer) {
         qCDebug(orgKdeElisaPlayerVlc) << "AudioWrapper::AudioWrapper" << "failed creating player" << libvlc_errmsg();
@@ -107,24 +261,30 @@ AudioWrapper::AudioWrapper(QObject *parent) : QObject(parent), d(std::make_uniqu
 
     d->mPlayerEventManager = libvlc_media_player_event_manager(d->mPlayer);
 
-    libvlc_event_attach(d->mPlayerEventManager, libvlc_MediaPlayerOpening, &vlc_callback, d.get());
-    libvlc_event_attach(d->mPlayerEventManager, libvlc_MediaPlayerBuffering, &vlc_callback, d.get());
-    libvlc_event_attach(d->mPlayerEventManager, libvlc_MediaPlayerPlaying, &vlc_callback, d.get());
-    libvlc_event_attach(d->mPlayerEventManager, libvlc_MediaPlayerPaused, &vlc_callback, d.get());
-    libvlc_event_attach(d->mPlayerEventManager, libvlc_MediaPlayerStopped, &vlc_callback, d.get());
-    libvlc_event_attach(d->mPlayerEventManager, libvlc_MediaPlayerEndReached, &vlc_callback, d.get());
-    libvlc_event_attach(d->mPlayerEventManager, libvlc_MediaPlayerEncounteredError, &vlc_callback, d.get());
-    libvlc_event_attach(d->mPlayerEventManager, libvlc_MediaPlayerPositionChanged, &vlc_callback, d.get());
-    libvlc_event_attach(d->mPlayerEventManager, libvlc_MediaPlayerSeekableChanged, &vlc_callback, d.get());
-    libvlc_event_attach(d->mPlayerEventManager, libvlc_MediaPlayerLengthChanged, &vlc_callback, d.get());
-    libvlc_event_attach(d->mPlayerEventManager, libvlc_MediaPlayerMuted, &vlc_callback, d.get());
-    libvlc_event_attach(d->mPlayerEventManager, libvlc_MediaPlayerUnmuted, &vlc_callback, d.get());
-    libvlc_event_attach(d->mPlayerEventManager, libvlc_MediaPlayerAudioVolume, &vlc_callback, d.get());
-    libvlc_event_attach(d->mPlayerEventManager, libvlc_MediaPlayerAudioDevice, &vlc_callback, d.get());
+    d->mNextPlayer = d->createPlayer();
+
+    if (!d->mNextPlayer) {
+        qCDebug(orgKdeElisaPlayerVlc) << "AudioWrapper::AudioWrapper" << "failed creating player for preloading" << libvlc_errmsg();
+    }
 }
 
 AudioWrapper::~AudioWrapper()
 {
+    d->releaseRetiredPlayers();
+
+    // the input thread of libvlc may still be reading from the read-ahead buffer
+    if (d->mPlayer) {
+        libvlc_media_player_stop(d->mPlayer);
+        libvlc_media_player_release(d->mPlayer);
+    }
+    d->releaseReadAhead(d->mReadAhead);
+
+    d->releaseNextSource();
+
+    if (d->mNextPlayer) {
+        libvlc_media_player_release(d->mNextPlayer);
+    }
+
     if (d->mInstance) {
         libvlc_release(d->mInstance);
     }
@@ -150,12 +310,16 @@ QUrl AudioWrapper::source() const
         return {};
     }
     if (d->mMedia) {
-        auto filePath = QString::fromUtf8(libvlc_media_get_mrl(d->mMedia));
-        return QUrl::fromUserInput(filePath);
+        return d->mSource;
     }
     return {};
 }
 
+QUrl AudioWrapper::nextSource() const
+{
+    return d->mNextSource;
+}
+
 QMediaPlayer::Error AudioWrapper::error() const
 {
     return d->mError;
@@ -179,6 +343,25 @@ qint64 AudioWrapper::position() const
     return qRound64(libvlc_media_player_get_position(d->mPlayer) * d->mMediaDuration);
 }
 
+qint64 AudioWrapper::estimatedPosition() const
+{
+    if (!d->mIsPlaying || !d->mPositionReference.isValid()) {
+        return d->mPreviousPosition;
+    }
+
+    auto estimatedValue = d->mPreviousPosition + d->mPositionReference.elapsed();
+    if (d->mMediaDuration > 0) {
+        estimatedValue = std::min(estimatedValue, d->mMediaDuration);
+    }
+
+    return estimatedValue;
+}
+
+int AudioWrapper::positionUpdateRate() const
+{
+    return d->mPositionUpdateRate;
+}
+
 bool AudioWrapper::seekable() const
 {
     return d->mIsSeekable;
@@ -215,31 +398,40 @@ void AudioWrapper::setVolume(qreal volume)
 
 void AudioWrapper::setSource(const QUrl &source)
 {
-    if (source.isLocalFile()) {
-        qCDebug(orgKdeElisaPlayerVlc) << "AudioWrapper::setSource reading local resource";
-        d->mMedia = libvlc_media_new_path(d->mInstance, QDir::toNativeSeparators(source.toLocalFile()).toUtf8().constData());
-    } else {
-        qCDebug(orgKdeElisaPlayerVlc) << "AudioWrapper::setSource reading remote resource";
-        d->mMedia = libvlc_media_new_location(d->mInstance, source.url().toUtf8().constData());
-    }
+    if (d->mNextIsReady && source == d->mNextSource) {
+        qCDebug(orgKdeElisaPlayerVlc) << "AudioWrapper::setSource using preloaded resource";
 
-    if (!d->mMedia) {
-        qCDebug(orgKdeElisaPlayerVlc) << "AudioWrapper::setSource"
-                 << "failed creating media"
-                 << libvlc_errmsg()
-                 << QDir::toNativeSeparators(source.toLocalFile()).toUtf8().constData();
+        d->adoptNextPlayer();
+        Q_EMIT nextSourceChanged();
+    } else {
+        auto newReadAhead = std::unique_ptr<ReadAheadStream>{};
+        auto newMedia = d->createMedia(source, newReadAhead);
 
-        d->mMedia = libvlc_media_new_path(d->mInstance, QDir::toNativeSeparators(source.toLocalFile()).toLatin1().constData());
-        if (!d->mMedia) {
-            qCDebug(orgKdeElisaPlayerVlc) << "AudioWrapper::setSource"
-                     << "failed creating media"
-                     << libvlc_errmsg()
-                     << QDir::toNativeSeparators(source.toLocalFile()).toLatin1().constData();
+        if (!newMedia) {
             return;
         }
-    }
 
-    libvlc_media_player_set_media(d->mPlayer, d->mMedia);
+        if (d->mMedia) {
+            libvlc_media_release(d->mMedia);
+        }
+        d->mMedia = newMedia;
+        d->mMediaStartsPaused = false;
+        d->mSource = source;
+
+        if (!qFuzzyIsNull(d->mReplayGain)) {
+            d->mReplayGain = 0.;
+            d->applyReplayGain(d->mPlayer, d->mReplayGain);
+        }
+
+        libvlc_media_player_set_media(d->mPlayer, d->mMedia);
+
+        // the previous input has been closed by libvlc_media_player_set_media
+        d->releaseReadAhead(d->mReadAhead);
+        d->mReadAhead = std::move(newReadAhead);
+
+        d->mLatestPosition = 0;
+        d->mPositionDiscontinuity = true;
+    }
 
     if (d->signalPlaybackChange(QMediaPlayer::StoppedState)) {
         Q_EMIT stopped();
@@ -250,6 +442,62 @@ void AudioWrapper::setSource(const QUrl &source)
     d->signalMediaStatusChange(QMediaPlayer::BufferedMedia);
 }
 
+void AudioWrapper::setNextSource(const QUrl &source)
+{
+    if (!d->mNextPlayer || source == d->mNextSource) {
+        return;
+    }
+
+    d->releaseNextSource();
+
+    d->mNextSource = source;
+    Q_EMIT nextSourceChanged();
+
+    if (!qFuzzyIsNull(d->mNextReplayGain)) {
+        d->mNextReplayGain = 0.;
+        d->applyReplayGain(d->mNextPlayer, d->mNextReplayGain);
+    }
+
+    if (source.isEmpty()) {
+        return;
+    }
+
+    // with read-ahead buffering, this also starts prefetching the beginning of the next track
+    d->mNextMedia = d->createMedia(source, d->mNextReadAhead);
+
+    if (!d->mNextMedia) {
+        return;
+    }
+
+    qCDebug(orgKdeElisaPlayerVlc) << "AudioWrapper::setNextSource preloading" << source;
+
+    // open, probe and pre-buffer the media but stay paused on its first sample
+    libvlc_media_add_option(d->mNextMedia, ":start-paused");
+    libvlc_media_player_set_media(d->mNextPlayer, d->mNextMedia);
+    libvlc_media_player_play(d->mNextPlayer);
+}
+
+void AudioWrapper::switchToNextSource()
+{
+    if (!d->mNextIsReady) {
+        d->signalMediaStatusChange(QMediaPlayer::BufferedMedia);
+        d->signalMediaStatusChange(QMediaPlayer::NoMedia);
+        d->signalMediaStatusChange(QMediaPlayer::EndOfMedia);
+        d->mediaIsEnded();
+
+        return;
+    }
+
+    qCDebug(orgKdeElisaPlayerVlc) << "AudioWrapper::switchToNextSource" << d->mNextSource;
+
+    d->adoptNextPlayer();
+
+    libvlc_media_player_set_pause(d->mPlayer, 0);
+
+    Q_EMIT nextSourceChanged();
+    Q_EMIT nextSourceStarted(source());
+}
+
 void AudioWrapper::setPosition(qint64 position)
 {
     if (!d->mPlayer) {
@@ -261,6 +509,7 @@ void AudioWrapper::setPosition(qint64 position)
         return;
     }
 
+    d->mPositionDiscontinuity = true;
     libvlc_media_player_set_position(d->mPlayer, static_cast<float>(position) / d->mMediaDuration);
 }
 
@@ -290,6 +539,23 @@ void AudioWrapper::play()
         return;
     }
 
+    const auto playerState = libvlc_media_player_get_state(d->mPlayer);
+    if (d->mMediaStartsPaused && d->mMedia && playerState != libvlc_Paused && playerState != libvlc_Playing) {
+        auto freshReadAhead = std::unique_ptr<ReadAheadStream>{};
+        auto freshMedia = d->createMedia(d->mSource, freshReadAhead);
+
+        if (freshMedia) {
+            libvlc_media_release(d->mMedia);
+            d->mMedia = freshMedia;
+            libvlc_media_player_set_media(d->mPlayer, d->mMedia);
+
+            d->releaseReadAhead(d->mReadAhead);
+            d->mReadAhead = std::move(freshReadAhead);
+        }
+
+        d->mMediaStartsPaused = false;
+    }
+
     libvlc_media_player_play(d->mPlayer);
 }
 
@@ -316,6 +582,49 @@ void AudioWrapper::seek(qint64 position)
     setPosition(position);
 }
 
+void AudioWrapper::setPositionUpdateRate(int rate)
+{
+    rate = qBound(0, rate, 100);
+
+    if (d->mPositionUpdateRate == rate) {
+        return;
+    }
+
+    qCDebug(orgKdeElisaPlayerVlc) << "AudioWrapper::setPositionUpdateRate" << rate;
+
+    d->mPositionUpdateRate = rate;
+    d->updatePositionClock();
+
+    Q_EMIT positionUpdateRateChanged();
+}
+
+void AudioWrapper::setReadAheadBuffering(bool enabled)
+{
+    qCDebug(orgKdeElisaPlayerVlc) << "AudioWrapper::setReadAheadBuffering" << enabled;
+
+    // only applies to the tracks opened from now on
+    d->mReadAheadBuffering = enabled;
+}
+
+void AudioWrapper::setReplayGain(const QUrl &source, qreal gain)
+{
+    if (source.isEmpty()) {
+        return;
+    }
+
+    if (source == d->mSource) {
+        qCDebug(orgKdeElisaPlayerVlc) << "AudioWrapper::setReplayGain" << source << gain;
+
+        d->mReplayGain = gain;
+        d->applyReplayGain(d->mPlayer, d->mReplayGain);
+    } else if (source == d->mNextSource) {
+        qCDebug(orgKdeElisaPlayerVlc) << "AudioWrapper::setReplayGain" << "next source" << source << gain;
+
+        d->mNextReplayGain = gain;
+        d->applyReplayGain(d->mNextPlayer, d->mNextReplayGain);
+    }
+}
+
 void AudioWrapper::mediaStatusChanged()
 {
 }
@@ -334,65 +643,125 @@ void AudioWrapper::playerVolumeChanged()
 
 void AudioWrapper::playerStateSignalChanges(QMediaPlayer::State newState)
 {
-    QMetaObject::invokeMethod(this, [this, newState]() {
-        Q_EMIT playbackStateChanged(newState);
-        switch (newState)
-        {
-        case QMediaPlayer::StoppedState:
-            Q_EMIT stopped();
-            d->mPowerInterface.setPreventSleep(false);
-            break;
-        case QMediaPlayer::PlayingState:
-            Q_EMIT playing();
-            d->mPowerInterface.setPreventSleep(true);
-            break;
-        case QMediaPlayer::PausedState:
-            Q_EMIT paused();
-            d->mPowerInterface.setPreventSleep(false);
-            break;
-        }
-    }, Qt::QueuedConnection);
+    d->postEvent(PlayerEventQueue::EventType::PlaybackState, newState);
 }
 
 void AudioWrapper::mediaStatusSignalChanges(QMediaPlayer::MediaStatus newStatus)
 {
-    QMetaObject::invokeMethod(this, [this, newStatus]() {Q_EMIT statusChanged(newStatus);}, Qt::QueuedConnection);
+    d->postEvent(PlayerEventQueue::EventType::MediaStatus, newStatus);
 }
 
 void AudioWrapper::playerErrorSignalChanges(QMediaPlayer::Error error)
 {
-    QMetaObject::invokeMethod(this, [this, error]() {Q_EMIT errorChanged(error);}, Qt::QueuedConnection);
+    d->postEvent(PlayerEventQueue::EventType::Error, error);
 }
 
 void AudioWrapper::playerDurationSignalChanges(qint64 newDuration)
 {
-    QMetaObject::invokeMethod(this, [this, newDuration]() {Q_EMIT durationChanged(newDuration);}, Qt::QueuedConnection);
+    d->postEvent(PlayerEventQueue::EventType::Duration, newDuration);
 }
 
 void AudioWrapper::playerPositionSignalChanges(qint64 newPosition)
 {
-    QMetaObject::invokeMethod(this, [this, newPosition]() {Q_EMIT positionChanged(newPosition);}, Qt::QueuedConnection);
+    d->postEvent(PlayerEventQueue::EventType::Position, newPosition);
 }
 
 void AudioWrapper::playerVolumeSignalChanges()
 {
-    QMetaObject::invokeMethod(this, [this]() {Q_EMIT volumeChanged();}, Qt::QueuedConnection);
+    d->postEvent(PlayerEventQueue::EventType::Volume, 0);
 }
 
 void AudioWrapper::playerMutedSignalChanges(bool isMuted)
 {
-    QMetaObject::invokeMethod(this, [this, isMuted]() {Q_EMIT mutedChanged(isMuted);}, Qt::QueuedConnection);
+    d->postEvent(PlayerEventQueue::EventType::Muted, isMuted);
 }
 
 void AudioWrapper::playerSeekableSignalChanges(bool isSeekable)
 {
-    QMetaObject::invokeMethod(this, [this, isSeekable]() {Q_EMIT seekableChanged(isSeekable);}, Qt::QueuedConnection);
+    d->postEvent(PlayerEventQueue::EventType::Seekable, isSeekable);
+}
+
+void AudioWrapperPrivate::postEvent(PlayerEventQueue::EventType type, qint64 value)
+{
+    if (!mEvents.push(type, value)) {
+        qCInfo(orgKdeElisaPlayerVlc) << "AudioWrapperPrivate::postEvent" << "dropped player event" << static_cast<int>(type)
+                                    << "total dropped" << mEvents.droppedEventsCount();
+    }
+
+    // a single queued call is pending at any time whatever the number of events
+    if (mEvents.requestWakeup()) {
+        QMetaObject::invokeMethod(mParent, [this]() {drainEvents();}, Qt::QueuedConnection);
+    }
+}
+
+void AudioWrapperPrivate::drainEvents()
+{
+    mEvents.drain([this](const PlayerEventQueue::Event &event) {
+        switch (event.mType)
+        {
+        case PlayerEventQueue::EventType::PlaybackState:
+        {
+            const auto newState = static_cast<QMediaPlayer::State>(event.mValue);
+
+            Q_EMIT mParent->playbackStateChanged(newState);
+            switch (newState)
+            {
+            case QMediaPlayer::StoppedState:
+                Q_EMIT mParent->stopped();
+                mPowerInterface.setPreventSleep(false);
+                break;
+            case QMediaPlayer::PlayingState:
+                Q_EMIT mParent->playing();
+                mPowerInterface.setPreventSleep(true);
+                break;
+            case QMediaPlayer::PausedState:
+                Q_EMIT mParent->paused();
+                mPowerInterface.setPreventSleep(false);
+                break;
+            }
+
+            mIsPlaying = (newState == QMediaPlayer::PlayingState);
+            publishPosition(mLatestPosition);
+            updatePositionClock();
+            break;
+        }
+        case PlayerEventQueue::EventType::MediaStatus:
+            Q_EMIT mParent->statusChanged(static_cast<QMediaPlayer::MediaStatus>(event.mValue));
+            break;
+        case PlayerEventQueue::EventType::Error:
+            Q_EMIT mParent->errorChanged(static_cast<QMediaPlayer::Error>(event.mValue));
+            break;
+        case PlayerEventQueue::EventType::Duration:
+            Q_EMIT mParent->durationChanged(event.mValue);
+            break;
+        case PlayerEventQueue::EventType::Seekable:
+            Q_EMIT mParent->seekableChanged(event.mValue != 0);
+            break;
+        case PlayerEventQueue::EventType::Muted:
+            Q_EMIT mParent->mutedChanged(event.mValue != 0);
+            break;
+        case PlayerEventQueue::EventType::Position:
+            publishPosition(event.mValue);
+            break;
+        case PlayerEventQueue::EventType::Volume:
+            Q_EMIT mParent->volumeChanged();
+            break;
+        }
+    });
 }
 
 void AudioWrapperPrivate::vlcEventCallback(const struct libvlc_event_t *p_event)
 {
     const auto eventType = static_cast<libvlc_event_e>(p_event->type);
 
+    if (p_event->p_obj != mPlayer) {
+        if (p_event->p_obj == mNextPlayer) {
+            nextPlayerEventCallback(eventType);
+        }
+
+        return;
+    }
+
     switch(eventType)
     {
     case libvlc_MediaPlayerOpening:
@@ -417,6 +786,11 @@ void AudioWrapperPrivate::vlcEventCallback(const struct libvlc_event_t *p_event)
         break;
     case libvlc_MediaPlayerEndReached:
         qCDebug(orgKdeElisaPlayerVlc) << "AudioWrapperPrivate::vlcEventCallback" << "libvlc_MediaPlayerEndReached";
+        if (mNextIsReady) {
+            // libvlc functions cannot be called from its own event callbacks
+            QMetaObject::invokeMethod(mParent, [this]() {mParent->switchToNextSource();}, Qt::QueuedConnection);
+            break;
+        }
         signalMediaStatusChange(QMediaPlayer::BufferedMedia);
         signalMediaStatusChange(QMediaPlayer::NoMedia);
         signalMediaStatusChange(QMediaPlayer::EndOfMedia);
@@ -465,6 +839,208 @@ void AudioWrapperPrivate::vlcEventCallback(const struct libvlc_event_t *p_event)
     }
 }
 
+void AudioWrapperPrivate::nextPlayerEventCallback(libvlc_event_e eventType)
+{
+    switch(eventType)
+    {
+    case libvlc_MediaPlayerPaused:
+        qCDebug(orgKdeElisaPlayerVlc) << "AudioWrapperPrivate::nextPlayerEventCallback" << "next media is ready";
+        mNextIsReady = true;
+        break;
+    case libvlc_MediaPlayerEncounteredError:
+        qCDebug(orgKdeElisaPlayerVlc) << "AudioWrapperPrivate::nextPlayerEventCallback" << "libvlc_MediaPlayerEncounteredError";
+        mNextIsReady = false;
+        break;
+    default:
+        break;
+    }
+}
+
+libvlc_media_player_t* AudioWrapperPrivate::createPlayer()
+{
+    auto newPlayer = libvlc_media_player_new(mInstance);
+
+    if (!newPlayer) {
+        return newPlayer;
+    }
+
+    auto eventManager = libvlc_media_player_event_manager(newPlayer);
+
+    for (const auto oneEvent : playerEvents) {
+        libvlc_event_attach(eventManager, oneEvent, &vlc_callback, this);
+    }
+
+    return newPlayer;
+}
+
+void AudioWrapperPrivate::detachPlayer(libvlc_media_player_t *player)
+{
+    auto eventManager = libvlc_media_player_event_manager(player);
+
+    // once detached, no callback of this player is running nor will run
+    for (const auto oneEvent : playerEvents) {
+        libvlc_event_detach(eventManager, oneEvent, &vlc_callback, this);
+    }
+}
+
+void AudioWrapperPrivate::releaseRetiredPlayers()
+{
+    for (auto &oneRetiredPlayer : mRetiredPlayers) {
+        libvlc_media_player_stop(oneRetiredPlayer.mPlayer);
+        libvlc_media_player_release(oneRetiredPlayer.mPlayer);
+
+        if (oneRetiredPlayer.mMedia) {
+            libvlc_media_release(oneRetiredPlayer.mMedia);
+        }
+
+        // the input thread of the player is stopped, nothing reads the buffer anymore
+        releaseReadAhead(oneRetiredPlayer.mReadAhead);
+    }
+
+    mRetiredPlayers.clear();
+}
+
+libvlc_media_t* AudioWrapperPrivate::createMedia(const QUrl &source, std::unique_ptr<ReadAheadStream> &readAhead)
+{
+    libvlc_media_t *newMedia = nullptr;
+
+    if (source.isLocalFile() && mReadAheadBuffering) {
+        qCDebug(orgKdeElisaPlayerVlc) << "AudioWrapperPrivate::createMedia reading local resource through read-ahead buffer";
+
+        auto newReadAhead = std::make_unique<ReadAheadStream>(source.toLocalFile());
+        newMedia = libvlc_media_new_callbacks(mInstance, &readAheadOpen, &readAheadRead, &readAheadSeek, &readAheadClose, newReadAhead.get());
+
+        if (newMedia) {
+            readAhead = std::move(newReadAhead);
+            return newMedia;
+        }
+    }
+
+    if (source.isLocalFile()) {
+        qCDebug(orgKdeElisaPlayerVlc) << "AudioWrapperPrivate::createMedia reading local resource";
+        newMedia = libvlc_media_new_path(mInstance, QDir::toNativeSeparators(source.toLocalFile()).toUtf8().constData());
+    } else {
+        qCDebug(orgKdeElisaPlayerVlc) << "AudioWrapperPrivate::createMedia reading remote resource";
+        newMedia = libvlc_media_new_location(mInstance, source.url().toUtf8().constData());
+    }
+
+    if (!newMedia) {
+        qCDebug(orgKdeElisaPlayerVlc) << "AudioWrapperPrivate::createMedia"
+                 << "failed creating media"
+                 << libvlc_errmsg()
+                 << QDir::toNativeSeparators(source.toLocalFile()).toUtf8().constData();
+
+        newMedia = libvlc_media_new_path(mInstance, QDir::toNativeSeparators(source.toLocalFile()).toLatin1().constData());
+        if (!newMedia) {
+            qCDebug(orgKdeElisaPlayerVlc) << "AudioWrapperPrivate::createMedia"
+                     << "failed creating media"
+                     << libvlc_errmsg()
+                     << QDir::toNativeSeparators(source.toLocalFile()).toLatin1().constData();
+        }
+    }
+
+    return newMedia;
+}
+
+void AudioWrapperPrivate::releaseReadAhead(std::unique_ptr<ReadAheadStream> &readAhead)
+{
+    if (!readAhead) {
+        return;
+    }
+
+    const auto statistics = readAhead->statistics();
+
+    if (statistics.mUnderruns > 0) {
+        qCInfo(orgKdeElisaPlayerVlc) << "AudioWrapperPrivate::releaseReadAhead" << readAhead->fileName()
+                                     << statistics.mUnderruns << "underruns" << statistics.mUnderrunsDuration << "ms"
+                                     << statistics.mRefills << "refills" << statistics.mBytesRead << "bytes read";
+    } else {
+        qCDebug(orgKdeElisaPlayerVlc) << "AudioWrapperPrivate::releaseReadAhead" << readAhead->fileName()
+                                      << statistics.mRefills << "refills" << statistics.mBytesRead << "bytes read";
+    }
+
+    readAhead.reset();
+}
+
+void AudioWrapperPrivate::releaseNextSource()
+{
+    mNextIsReady = false;
+    mNextSource.clear();
+
+    if (mNextPlayer) {
+        libvlc_media_player_stop(mNextPlayer);
+    }
+    releaseReadAhead(mNextReadAhead);
+
+    if (mNextMedia) {
+        libvlc_media_release(mNextMedia);
+        mNextMedia = nullptr;
+    }
+}
+
+void AudioWrapperPrivate::applyReplayGain(libvlc_media_player_t *player, qreal gain)
+{
+    if (!player) {
+        return;
+    }
+
+    // the equalizer pre-amplification is the only gain libvlc applies to the decoded signal
+    if (qFuzzyIsNull(gain)) {
+        libvlc_media_player_set_equalizer(player, nullptr);
+        return;
+    }
+
+    auto equalizer = libvlc_audio_equalizer_new();
+    if (!equalizer) {
+        return;
+    }
+
+    libvlc_audio_equalizer_set_preamp(equalizer, static_cast<float>(qBound(-20., gain, 20.)));
+    libvlc_media_player_set_equalizer(player, equalizer);
+    libvlc_audio_equalizer_release(equalizer);
+}
+
+void AudioWrapperPrivate::adoptNextPlayer()
+{
+    libvlc_media_player_t *previousPlayer = mPlayer;
+
+    // the callbacks of the previous player may be running in a libvlc thread until it is detached
+    detachPlayer(previousPlayer);
+
+    mRetiredPlayers.push_back({previousPlayer, mMedia, std::move(mReadAhead)});
+
+    libvlc_audio_set_volume(mNextPlayer, qRound(mPreviousVolume));
+    libvlc_audio_set_mute(mNextPlayer, mIsMuted);
+
+    mPlayer = mNextPlayer.load();
+    mMedia = mNextMedia;
+    mMediaStartsPaused = true;
+
+    mReadAhead = std::move(mNextReadAhead);
+
+    mNextPlayer = createPlayer();
+    mNextMedia = nullptr;
+    mNextIsReady = false;
+    mSource = mNextSource;
+    mNextSource.clear();
+    mReplayGain = std::exchange(mNextReplayGain, 0.);
+
+    if (!mNextPlayer) {
+        qCDebug(orgKdeElisaPlayerVlc) << "AudioWrapperPrivate::adoptNextPlayer" << "failed creating player for preloading" << libvlc_errmsg();
+    }
+
+    mPlayerEventManager = libvlc_media_player_event_manager(mPlayer);
+    mPositionDiscontinuity = true;
+
+    // stopping a player waits for its threads, never do it from a call that may come from one of them
+    QMetaObject::invokeMethod(mParent, [this]() {releaseRetiredPlayers();}, Qt::QueuedConnection);
+
+    signalDurationChange(libvlc_media_player_get_length(mPlayer));
+    signalSeekableChange(libvlc_media_player_is_seekable(mPlayer));
+
+    Q_EMIT mParent->sourceChanged();
+}
+
 void AudioWrapperPrivate::mediaIsEnded()
 {
     libvlc_media_release(mMedia);
@@ -536,17 +1112,67 @@ void AudioWrapperPrivate::signalPositionChange(float newPosition)
 
     auto computedPosition = qRound64(newPosition * mMediaDuration);
 
-    if (mPreviousPosition != computedPosition) {
-        mPreviousPosition = computedPosition;
+    mLatestPosition = computedPosition;
 
-        mParent->playerPositionSignalChanges(mPreviousPosition);
+    // regular progress is published by the position clock, only jumps are forwarded right away
+    if (mPositionDiscontinuity.exchange(false)) {
+        mParent->playerPositionSignalChanges(computedPosition);
     }
 
     if (this->mMedia) {
-        QString title = QLatin1String(libvlc_media_get_meta(this->mMedia, libvlc_meta_Title));
-        QString nowPlaying = QLatin1String(libvlc_media_get_meta(this->mMedia, libvlc_meta_NowPlaying));
+        signalStreamMetaData(this->mMedia);
+    }
+}
+
+void AudioWrapperPrivate::signalStreamMetaData(libvlc_media_t *media)
+{
+    auto title = mediaMetaData(media, libvlc_meta_Title);
+    auto nowPlaying = mediaMetaData(media, libvlc_meta_NowPlaying);
+
+    // position events are frequent, stream meta data only changes when the station sends new ones
+    if (media == mStreamMetaDataMedia && title == mStreamTitle && nowPlaying == mStreamNowPlaying) {
+        return;
+    }
+
+    mStreamMetaDataMedia = media;
+    mStreamTitle = title;
+    mStreamNowPlaying = nowPlaying;
 
-        Q_EMIT mParent->currentPlayingForRadiosChanged(title, nowPlaying);
+    Q_EMIT mParent->currentPlayingForRadiosChanged(title, nowPlaying);
+}
+
+QString AudioWrapperPrivate::mediaMetaData(libvlc_media_t *media, libvlc_meta_t metaType)
+{
+    auto *rawValue = libvlc_media_get_meta(media, metaType);
+
+    if (!rawValue) {
+        return {};
+    }
+
+    auto result = QString::fromUtf8(rawValue);
+
+    libvlc_free(rawValue);
+
+    return result;
+}
+
+void AudioWrapperPrivate::publishPosition(qint64 newPosition)
+{
+    mPositionReference.start();
+
+    if (mPreviousPosition != newPosition) {
+        mPreviousPosition = newPosition;
+
+        Q_EMIT mParent->positionChanged(mPreviousPosition);
+    }
+}
+
+void AudioWrapperPrivate::updatePositionClock()
+{
+    if (mIsPlaying && mPositionUpdateRate > 0) {
+        mPositionClock.start(1000 / mPositionUpdateRate);
+    } else {
+        mPositionClock.stop();
     }
 }
 
@@ -12,6 +12,11 @@
 #include <QTimer>
 #include <QAudio>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
 #include "config-upnp-qt.h"
 
 class AudioWrapperPrivate
@@ -21,7 +26,15 @@ public:
 
     PowerManagementInterface mPowerInterface;
 
-    QMediaPlayer mPlayer;
+    QMediaPlayer mFirstPlayer;
+
+    QMediaPlayer mSecondPlayer;
+
+    QMediaPlayer *mPlayer = &mFirstPlayer;
+
+    QMediaPlayer *mNextPlayer = &mSecondPlayer;
+
+    QUrl mNextSource;
 
     qint64 mSavedPosition = 0.0;
 
@@ -29,21 +42,105 @@ public:
 
     bool mHasSavedPosition = false;
 
+    int mPositionUpdateRate = 4;
+
+    int mUserVolume = 100;
+
+    qreal mGainFactor = 1.;
+
+    qreal mNextGainFactor = 1.;
+
+    // QMediaPlayer cannot amplify, a positive gain is only applied up to full volume
+    void applyVolume(QMediaPlayer *player, qreal gainFactor) const
+    {
+        player->setVolume(std::min(100, qRound(mUserVolume * gainFactor)));
+    }
+
+    void applyPositionUpdateRate()
+    {
+        const auto interval = (mPositionUpdateRate > 0 ? 1000 / mPositionUpdateRate : std::numeric_limits<int>::max());
+
+        mFirstPlayer.setNotifyInterval(interval);
+        mSecondPlayer.setNotifyInterval(interval);
+    }
+
+    bool canSwitchToNextSource() const
+    {
+        if (mNextSource.isEmpty() || mPlayer->state() != QMediaPlayer::StoppedState ||
+                mPlayer->mediaStatus() != QMediaPlayer::EndOfMedia) {
+            return false;
+        }
+
+        const auto nextStatus = mNextPlayer->mediaStatus();
+        return nextStatus == QMediaPlayer::LoadedMedia || nextStatus == QMediaPlayer::BufferedMedia;
+    }
+
 };
 
 AudioWrapper::AudioWrapper(QObject *parent) : QObject(parent), d(std::make_unique<AudioWrapperPrivate>())
 {
-    connect(&d->mPlayer, &QMediaPlayer::mutedChanged, this, &AudioWrapper::playerMutedChanged);
-    connect(&d->mPlayer, &QMediaPlayer::volumeChanged, this, &AudioWrapper::playerVolumeChanged);
-    connect(&d->mPlayer, &QMediaPlayer::mediaChanged, this, &AudioWrapper::sourceChanged);
-    connect(&d->mPlayer, &QMediaPlayer::mediaStatusChanged, this, &AudioWrapper::statusChanged);
-    connect(&d->mPlayer, &QMediaPlayer::mediaStatusChanged, this, &AudioWrapper::mediaStatusChanged);
-    connect(&d->mPlayer, &QMediaPlayer::stateChanged, this, &AudioWrapper::playbackStateChanged);
-    connect(&d->mPlayer, &QMediaPlayer::stateChanged, this, &AudioWrapper::playerStateChanged);
-    connect(&d->mPlayer, QOverload<QMediaPlayer::Error>::of(&QMediaPlayer::error), this, &AudioWrapper::errorChanged);
-    connect(&d->mPlayer, &QMediaPlayer::durationChanged, this, &AudioWrapper::durationChanged);
-    connect(&d->mPlayer, &QMediaPlayer::positionChanged, this, &AudioWrapper::positionChanged);
-    connect(&d->mPlayer, &QMediaPlayer::seekableChanged, this, &AudioWrapper::seekableChanged);
+    d->applyPositionUpdateRate();
+
+    // both players stay connected, only the one currently playing is forwarded
+    for (auto player : {&d->mFirstPlayer, &d->mSecondPlayer}) {
+        connect(player, &QMediaPlayer::mutedChanged, this, [this, player]() {
+            if (player == d->mPlayer) {
+                playerMutedChanged();
+            }
+        });
+        connect(player, &QMediaPlayer::volumeChanged, this, [this, player]() {
+            if (player == d->mPlayer) {
+                playerVolumeChanged();
+            }
+        });
+        connect(player, &QMediaPlayer::mediaChanged, this, [this, player]() {
+            if (player == d->mPlayer) {
+                Q_EMIT sourceChanged();
+            }
+        });
+        connect(player, &QMediaPlayer::mediaStatusChanged, this, [this, player](QMediaPlayer::MediaStatus status) {
+            if (player != d->mPlayer) {
+                return;
+            }
+            if (d->canSwitchToNextSource()) {
+                switchToNextSource();
+                return;
+            }
+            Q_EMIT statusChanged(status);
+            mediaStatusChanged();
+        });
+        connect(player, &QMediaPlayer::stateChanged, this, [this, player](QMediaPlayer::State state) {
+            if (player != d->mPlayer) {
+                return;
+            }
+            if (d->canSwitchToNextSource()) {
+                switchToNextSource();
+                return;
+            }
+            Q_EMIT playbackStateChanged(state);
+            playerStateChanged();
+        });
+        connect(player, QOverload<QMediaPlayer::Error>::of(&QMediaPlayer::error), this, [this, player](QMediaPlayer::Error errorCode) {
+            if (player == d->mPlayer) {
+                Q_EMIT errorChanged(errorCode);
+            }
+        });
+        connect(player, &QMediaPlayer::durationChanged, this, [this, player](qint64 duration) {
+            if (player == d->mPlayer) {
+                Q_EMIT durationChanged(duration);
+            }
+        });
+        connect(player, &QMediaPlayer::positionChanged, this, [this, player](qint64 position) {
+            if (player == d->mPlayer) {
+                Q_EMIT positionChanged(position);
+            }
+        });
+        connect(player, &QMediaPlayer::seekableChanged, this, [this, player](bool seekable) {
+            if (player == d->mPlayer) {
+                Q_EMIT seekableChanged(seekable);
+            }
+        });
+    }
 }
 
 AudioWrapper::~AudioWrapper()
@@ -51,12 +148,12 @@ AudioWrapper::~AudioWrapper()
 
 bool AudioWrapper::muted() const
 {
-    return d->mPlayer.isMuted();
+    return d->mPlayer->isMuted();
 }
 
 qreal AudioWrapper::volume() const
 {
-    auto realVolume = static_cast<qreal>(d->mPlayer.volume() / 100.0);
+    auto realVolume = static_cast<qreal>(d->mUserVolume / 100.0);
     auto userVolume = static_cast<qreal>(QAudio::convertVolume(realVolume, QAudio::LinearVolumeScale, QAudio::LogarithmicVolumeScale));
 
     return userVolume * 100.0;
@@ -65,49 +162,64 @@ qreal AudioWrapper::volume() const
 QUrl AudioWrapper::source() const
 {
 #if (QT_VERSION >= QT_VERSION_CHECK(5, 14, 0))
-    return d->mPlayer.media().request().url();
+    return d->mPlayer->media().request().url();
 #else
-    return d->mPlayer.media().canonicalUrl();
+    return d->mPlayer->media().canonicalUrl();
 #endif
 }
 
+QUrl AudioWrapper::nextSource() const
+{
+    return d->mNextSource;
+}
+
 QMediaPlayer::Error AudioWrapper::error() const
 {
-    if (d->mPlayer.error() != QMediaPlayer::NoError) {
-        qDebug() << "AudioWrapper::error" << d->mPlayer.errorString();
+    if (d->mPlayer->error() != QMediaPlayer::NoError) {
+        qDebug() << "AudioWrapper::error" << d->mPlayer->errorString();
     }
 
-    return d->mPlayer.error();
+    return d->mPlayer->error();
 }
 
 qint64 AudioWrapper::duration() const
 {
-    return d->mPlayer.duration();
+    return d->mPlayer->duration();
 }
 
 qint64 AudioWrapper::position() const
 {
-    return d->mPlayer.position();
+    return d->mPlayer->position();
+}
+
+qint64 AudioWrapper::estimatedPosition() const
+{
+    return d->mPlayer->position();
+}
+
+int AudioWrapper::positionUpdateRate() const
+{
+    return d->mPositionUpdateRate;
 }
 
 bool AudioWrapper::seekable() const
 {
-    return d->mPlayer.isSeekable();
+    return d->mPlayer->isSeekable();
 }
 
 QMediaPlayer::State AudioWrapper::playbackState() const
 {
-    return d->mPlayer.state();
+    return d->mPlayer->state();
 }
 
 QMediaPlayer::MediaStatus AudioWrapper::status() const
 {
-    return d->mPlayer.mediaStatus();
+    return d->mPlayer->mediaStatus();
 }
 
 void AudioWrapper::setMuted(bool muted)
 {
-    d->mPlayer.setMuted(muted);
+    d->mPlayer->setMuted(muted);
 }
 
 void AudioWrapper::setVolume(qreal volume)
@@ -115,33 +227,92 @@ void AudioWrapper::setVolume(qreal volume)
     qCDebug(orgKdeElisaPlayerQtMultimedia) << "AudioWrapper::setVolume" << volume;
 
     auto realVolume = static_cast<qreal>(QAudio::convertVolume(volume / 100.0, QAudio::LogarithmicVolumeScale, QAudio::LinearVolumeScale));
-    d->mPlayer.setVolume(qRound(realVolume * 100));
+    d->mUserVolume = qRound(realVolume * 100);
+    d->applyVolume(d->mPlayer, d->mGainFactor);
 }
 
 void AudioWrapper::setSource(const QUrl &source)
 {
     qCDebug(orgKdeElisaPlayerQtMultimedia) << "AudioWrapper::setSource" << source;
 
-    d->mPlayer.setMedia({source});
+    if (!d->mNextSource.isEmpty() && source == d->mNextSource) {
+        d->applyVolume(d->mNextPlayer, d->mNextGainFactor);
+        d->mNextPlayer->setMuted(d->mPlayer->isMuted());
+
+        std::swap(d->mPlayer, d->mNextPlayer);
+        d->mNextPlayer->setMedia({});
+        d->mNextSource.clear();
+        d->mGainFactor = std::exchange(d->mNextGainFactor, 1.);
+
+        Q_EMIT sourceChanged();
+        Q_EMIT statusChanged(d->mPlayer->mediaStatus());
+        Q_EMIT durationChanged(d->mPlayer->duration());
+        Q_EMIT seekableChanged(d->mPlayer->isSeekable());
+        Q_EMIT nextSourceChanged();
+
+        return;
+    }
+
+    d->mGainFactor = 1.;
+    d->applyVolume(d->mPlayer, d->mGainFactor);
+    d->mPlayer->setMedia({source});
+}
+
+void AudioWrapper::setNextSource(const QUrl &source)
+{
+    if (source == d->mNextSource) {
+        return;
+    }
+
+    qCDebug(orgKdeElisaPlayerQtMultimedia) << "AudioWrapper::setNextSource" << source;
+
+    d->mNextSource = source;
+    d->mNextGainFactor = 1.;
+
+    // setting the media lets the backend open and preroll it while the current one is playing
+    d->mNextPlayer->setMedia(source.isEmpty() ? QMediaContent{} : QMediaContent{source});
+
+    Q_EMIT nextSourceChanged();
+}
+
+void AudioWrapper::switchToNextSource()
+{
+    qCDebug(orgKdeElisaPlayerQtMultimedia) << "AudioWrapper::switchToNextSource" << d->mNextSource;
+
+    d->applyVolume(d->mNextPlayer, d->mNextGainFactor);
+    d->mNextPlayer->setMuted(d->mPlayer->isMuted());
+
+    std::swap(d->mPlayer, d->mNextPlayer);
+    d->mPlayer->play();
+    d->mNextPlayer->setMedia({});
+    d->mNextSource.clear();
+    d->mGainFactor = std::exchange(d->mNextGainFactor, 1.);
+
+    Q_EMIT sourceChanged();
+    Q_EMIT statusChanged(d->mPlayer->mediaStatus());
+    Q_EMIT durationChanged(d->mPlayer->duration());
+    Q_EMIT seekableChanged(d->mPlayer->isSeekable());
+    Q_EMIT nextSourceChanged();
+    Q_EMIT nextSourceStarted(source());
 }
 
 void AudioWrapper::setPosition(qint64 position)
 {
     qCDebug(orgKdeElisaPlayerQtMultimedia) << "AudioWrapper::setPosition" << position;
 
-    if (d->mPlayer.duration() <= 0) {
+    if (d->mPlayer->duration() <= 0) {
         savePosition(position);
         return;
     }
 
-    d->mPlayer.setPosition(position);
+    d->mPlayer->setPosition(position);
 }
 
 void AudioWrapper::play()
 {
     qCDebug(orgKdeElisaPlayerQtMultimedia) << "AudioWrapper::play";
 
-    d->mPlayer.play();
+    d->mPlayer->play();
 
     if (d->mHasSavedPosition) {
         qCDebug(orgKdeElisaPlayerQtMultimedia) << "AudioWrapper::playerDurationSignalChanges" << "restore old position" << d->mSavedPosition;
@@ -155,21 +326,59 @@ void AudioWrapper::pause()
 {
     qCDebug(orgKdeElisaPlayerQtMultimedia) << "AudioWrapper::pause";
 
-    d->mPlayer.pause();
+    d->mPlayer->pause();
 }
 
 void AudioWrapper::stop()
 {
     qCDebug(orgKdeElisaPlayerQtMultimedia) << "AudioWrapper::stop";
 
-    d->mPlayer.stop();
+    d->mPlayer->stop();
 }
 
 void AudioWrapper::seek(qint64 position)
 {
     qCDebug(orgKdeElisaPlayerQtMultimedia) << "AudioWrapper::seek" << position;
 
-    d->mPlayer.setPosition(position);
+    d->mPlayer->setPosition(position);
+}
+
+void AudioWrapper::setPositionUpdateRate(int rate)
+{
+    rate = qBound(0, rate, 100);
+
+    if (d->mPositionUpdateRate == rate) {
+        return;
+    }
+
+    qCDebug(orgKdeElisaPlayerQtMultimedia) << "AudioWrapper::setPositionUpdateRate" << rate;
+
+    d->mPositionUpdateRate = rate;
+    d->applyPositionUpdateRate();
+
+    Q_EMIT positionUpdateRateChanged();
+}
+
+void AudioWrapper::setReadAheadBuffering(bool enabled)
+{
+    // QMediaPlayer does its own buffering
+    Q_UNUSED(enabled);
+}
+
+void AudioWrapper::setReplayGain(const QUrl &source, qreal gain)
+{
+    const auto gainFactor = std::pow(10., qBound(-20., gain, 20.) / 20.);
+
+    if (source == this->source()) {
+        qCDebug(orgKdeElisaPlayerQtMultimedia) << "AudioWrapper::setReplayGain" << source << gain;
+
+        d->mGainFactor = gainFactor;
+        d->applyVolume(d->mPlayer, d->mGainFactor);
+    } else if (!d->mNextSource.isEmpty() && source == d->mNextSource) {
+        qCDebug(orgKdeElisaPlayerQtMultimedia) << "AudioWrapper::setReplayGain" << "next source" << source << gain;
+
+        d->mNextGainFactor = gainFactor;
+    }
 }
 
 void AudioWrapper::mediaStatusChanged()
@@ -181,7 +390,7 @@ void AudioWrapper::playerStateChanged()
 {
     qCDebug(orgKdeElisaPlayerQtMultimedia) << "AudioWrapper::playerStateChanged";
 
-    switch(d->mPlayer.state())
+    switch(d->mPlayer->state())
     {
     case QMediaPlayer::State::StoppedState:
         Q_EMIT stopped();
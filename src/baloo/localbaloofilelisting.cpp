@@ -18,6 +18,7 @@
 #include "baloowatcherapplicationadaptor.h"
 
 #include "filescanner.h"
+#include "rootpathsfilter.h"
 
 #include <Baloo/Query>
 #include <Baloo/File>
@@ -32,18 +33,37 @@
 #include <QDBusServiceWatcher>
 
 #include <QThread>
+#include <QThreadPool>
+#include <QTimer>
 #include <QHash>
+#include <QSet>
 #include <QFileInfo>
 #include <QAtomicInt>
 #include <QScopedPointer>
 
+#include <QtConcurrent>
+
 #include <algorithm>
 #include <memory>
+#include <utility>
+#include <vector>
 
 class LocalBalooFileListingPrivate
 {
 public:
 
+    /**
+     * Baloo notifies each indexed file separately, they are collected during this delay and added to the database at once
+     */
+    static constexpr int NewFilesBatchDelay = 1000;
+
+    static constexpr int NewFilesMaximumBatchSize = 500;
+
+    /**
+     * number of Baloo results converted to tracks in parallel before being sent to the database
+     */
+    static constexpr int RefreshBatchSize = 500;
+
     Baloo::Query mQuery;
 
     QDBusServiceWatcher mServiceWatcher;
@@ -56,6 +76,19 @@ public:
 
     BalooWatcherApplicationAdaptor *mDbusAdaptor = nullptr;
 
+    QTimer *mNewFilesTimer = nullptr;
+
+    QStringList mNewFiles;
+
+    QSet<QString> mNewFilesSet;
+
+    /**
+     * one scanner per conversion thread, a scanner is not thread safe
+     */
+    std::vector<std::unique_ptr<FileScanner>> mScanners;
+
+    QThreadPool mScannersPool;
+
     QAtomicInt mStopRequest = 0;
 
     bool mIsRegisteredToBaloo = false;
@@ -78,6 +111,13 @@ LocalBalooFileListing::LocalBalooFileListing(QObject *parent)
 
     d->mDbusAdaptor = new BalooWatcherApplicationAdaptor(this);
 
+    // a child object follows this object when it is moved to the indexer thread
+    d->mNewFilesTimer = new QTimer(this);
+    d->mNewFilesTimer->setSingleShot(true);
+    d->mNewFilesTimer->setInterval(LocalBalooFileListingPrivate::NewFilesBatchDelay);
+    connect(d->mNewFilesTimer, &QTimer::timeout,
+            this, &LocalBalooFileListing::scanNewBalooFiles);
+
     sessionBus.registerObject(QStringLiteral("/org/kde/BalooWatcherApplication"), d->mDbusAdaptor, QDBusConnection::ExportAllContents);
 
     connect(&d->mServiceWatcher, &QDBusServiceWatcher::serviceRegistered,
@@ -156,31 +196,70 @@ void LocalBalooFileListing::newBalooFile(const QString &fileName)
         return;
     }
 
-    auto scanFileInfo = QFileInfo(fileName);
-
-    if (!scanFileInfo.exists()) {
+    if (d->mNewFilesSet.contains(fileName)) {
         return;
     }
 
-    if (!fileScanner().shouldScanFile(fileName)) {
+    d->mNewFilesSet.insert(fileName);
+    d->mNewFiles.push_back(fileName);
+
+    if (d->mNewFiles.size() >= LocalBalooFileListingPrivate::NewFilesMaximumBatchSize) {
+        scanNewBalooFiles();
+    } else if (!d->mNewFilesTimer->isActive()) {
+        d->mNewFilesTimer->start();
+    }
+}
+
+void LocalBalooFileListing::scanNewBalooFiles()
+{
+    d->mNewFilesTimer->stop();
+
+    const auto newFiles = std::exchange(d->mNewFiles, {});
+    d->mNewFilesSet.clear();
+
+    qCDebug(orgKdeElisaBaloo()) << "LocalBalooFileListing::scanNewBalooFiles" << newFiles.size();
+
+    if (!isActive() || d->mStopRequest == 1) {
         return;
     }
 
-    Q_EMIT indexingStarted();
+    auto newTracks = DataTypes::ListTrackDataType{};
+    auto hasStartedIndexing = false;
+
+    for (const auto &fileName : newFiles) {
+        auto scanFileInfo = QFileInfo(fileName);
+
+        if (!scanFileInfo.exists()) {
+            continue;
+        }
+
+        if (!fileScanner().shouldScanFile(fileName)) {
+            continue;
+        }
 
-    auto newFile = QUrl::fromLocalFile(fileName);
+        if (!hasStartedIndexing) {
+            hasStartedIndexing = true;
+            Q_EMIT indexingStarted();
+        }
 
-    auto newTrack = scanOneFile(newFile, scanFileInfo);
+        auto newFile = QUrl::fromLocalFile(fileName);
 
-    if (newTrack.isValid()) {
-        QFileInfo newFileInfo(fileName);
+        auto newTrack = scanOneFile(newFile, scanFileInfo);
 
-        addFileInDirectory(newFile, QUrl::fromLocalFile(newFileInfo.absoluteDir().absolutePath()));
+        if (newTrack.isValid()) {
+            addFileInDirectory(newFile, QUrl::fromLocalFile(scanFileInfo.absoluteDir().absolutePath()));
 
-        emitNewFiles({newTrack});
+            newTracks.push_back(newTrack);
+        }
     }
 
-    Q_EMIT indexingFinished();
+    if (!newTracks.isEmpty()) {
+        emitNewFiles(newTracks);
+    }
+
+    if (hasStartedIndexing) {
+        Q_EMIT indexingFinished();
+    }
 }
 
 void LocalBalooFileListing::registeredToBaloo(QDBusPendingCallWatcher *watcher)
@@ -352,36 +431,32 @@ void LocalBalooFileListing::triggerRefreshOfContent()
 
     AbstractFileListing::triggerRefreshOfContent();
 
-    const auto &rootPaths = allRootPaths();
-    bool hasSingleRootPath = (rootPaths.size() == 1);
-    auto singleRootPath = rootPaths.at(0);
+    const auto rootPathsFilter = RootPathsFilter(allRootPaths());
 
     auto resultIterator = d->mQuery.exec();
-    auto newFiles = DataTypes::ListTrackDataType();
+    auto balooFiles = QList<QPair<QUrl, QFileInfo>>();
+
+    balooFiles.reserve(LocalBalooFileListingPrivate::RefreshBatchSize);
+
+    auto sendBalooFiles = [this, &balooFiles]() {
+        const auto newFiles = scanBalooFiles(balooFiles);
+        balooFiles.clear();
+
+        if (!newFiles.isEmpty() && d->mStopRequest == 0) {
+            qCDebug(orgKdeElisaBaloo()) << "LocalBalooFileListing::triggerRefreshOfContent" << "insert new tracks in database" << newFiles.count();
+            emitNewFiles(newFiles);
+        }
+    };
 
     while(resultIterator.next() && d->mStopRequest == 0) {
         const auto &fileName = resultIterator.filePath();
 
-        if (hasSingleRootPath) {
-            if (!fileName.startsWith(singleRootPath)) {
-                qCDebug(orgKdeElisaBaloo()) << "LocalBalooFileListing::triggerRefreshOfContent" << fileName << "does not match root paths";
-                continue;
-            }
-        } else {
-            bool isIncluded = false;
-            for (const auto &oneRootPath : rootPaths) {
-                if (fileName.startsWith(oneRootPath)) {
-                    isIncluded = true;
-                    break;
-                }
-            }
-            if (!isIncluded) {
-                qCDebug(orgKdeElisaBaloo()) << "LocalBalooFileListing::triggerRefreshOfContent" << fileName << "does not match root paths";
-                continue;
-            }
+        if (!rootPathsFilter.contains(fileName)) {
+            qCDebug(orgKdeElisaBaloo()) << "LocalBalooFileListing::triggerRefreshOfContent" << fileName << "does not match root paths";
+            continue;
         }
 
-        const auto &newFileUrl = QUrl::fromLocalFile(resultIterator.filePath());
+        const auto &newFileUrl = QUrl::fromLocalFile(fileName);
 
         auto scanFileInfo = QFileInfo(fileName);
 
@@ -403,23 +478,15 @@ void LocalBalooFileListing::triggerRefreshOfContent()
 
         addFileInDirectory(newFileUrl, currentDirectory);
 
-        const auto &newTrack = scanOneFile(newFileUrl, scanFileInfo);
+        balooFiles.push_back({newFileUrl, scanFileInfo});
 
-        if (newTrack.isValid()) {
-            newFiles.push_back(newTrack);
-            if (newFiles.size() > 500 && d->mStopRequest == 0) {
-                qCDebug(orgKdeElisaBaloo()) << "LocalBalooFileListing::triggerRefreshOfContent" << "insert new tracks in database" << newFiles.count();
-                emitNewFiles(newFiles);
-                newFiles.clear();
-            }
-        } else {
-            qCDebug(orgKdeElisaBaloo()) << "LocalBalooFileListing::triggerRefreshOfContent" << fileName << "invalid track" << newTrack;
+        if (balooFiles.size() >= LocalBalooFileListingPrivate::RefreshBatchSize) {
+            sendBalooFiles();
         }
     }
 
-    if (!newFiles.isEmpty() && d->mStopRequest == 0) {
-        qCDebug(orgKdeElisaBaloo()) << "LocalBalooFileListing::triggerRefreshOfContent" << "insert new tracks in database" << newFiles.count();
-        emitNewFiles(newFiles);
+    if (!balooFiles.isEmpty() && d->mStopRequest == 0) {
+        sendBalooFiles();
     }
 
     setWaitEndTrackRemoval(false);
@@ -437,6 +504,60 @@ void LocalBalooFileListing::triggerStop()
     AbstractFileListing::triggerStop();
 }
 
+DataTypes::ListTrackDataType LocalBalooFileListing::scanBalooFiles(const QList<QPair<QUrl, QFileInfo>> &balooFiles)
+{
+    if (d->mScanners.empty()) {
+        const auto scannersCount = std::max(QThread::idealThreadCount(), 1);
+
+        for (int scannerIndex = 0; scannerIndex < scannersCount; ++scannerIndex) {
+            d->mScanners.push_back(std::make_unique<FileScanner>());
+        }
+
+        d->mScannersPool.setMaxThreadCount(scannersCount);
+    }
+
+    // reading the properties stored by Baloo and checking for embedded covers is done in parallel,
+    // everything touching the state of this object stays in this thread
+    auto balooTracks = QVector<DataTypes::TrackDataType>(balooFiles.size());
+    const auto scannersCount = static_cast<int>(d->mScanners.size());
+
+    auto pendingScans = QVector<QFuture<void>>{};
+    for (int scannerIndex = 0; scannerIndex < scannersCount && scannerIndex < balooFiles.size(); ++scannerIndex) {
+        pendingScans.push_back(QtConcurrent::run(&d->mScannersPool, [this, scannerIndex, scannersCount, &balooFiles, &balooTracks]() {
+            auto &scanner = *d->mScanners[scannerIndex];
+
+            for (auto fileIndex = scannerIndex; fileIndex < balooFiles.size() && d->mStopRequest == 0; fileIndex += scannersCount) {
+                balooTracks[fileIndex] = scanner.scanOneBalooFile(balooFiles[fileIndex].first, balooFiles[fileIndex].second);
+            }
+        }));
+    }
+
+    for (auto &oneScan : pendingScans) {
+        oneScan.waitForFinished();
+    }
+
+    auto newTracks = DataTypes::ListTrackDataType{};
+    newTracks.reserve(balooFiles.size());
+
+    for (int fileIndex = 0; fileIndex < balooFiles.size() && d->mStopRequest == 0; ++fileIndex) {
+        auto &trackData = balooTracks[fileIndex];
+
+        if (!trackData.isValid()) {
+            qCDebug(orgKdeElisaBaloo) << "LocalBalooFileListing::scanBalooFiles" << balooFiles[fileIndex].first << "falling back to plain file metadata analysis";
+            trackData = AbstractFileListing::scanOneFile(balooFiles[fileIndex].first, balooFiles[fileIndex].second);
+        }
+
+        if (trackData.isValid()) {
+            addCover(trackData);
+            newTracks.push_back(trackData);
+        } else {
+            qCDebug(orgKdeElisaBaloo()) << "LocalBalooFileListing::scanBalooFiles" << balooFiles[fileIndex].first << "invalid track" << trackData;
+        }
+    }
+
+    return newTracks;
+}
+
 DataTypes::TrackDataType LocalBalooFileListing::scanOneFile(const QUrl &scanFile, const QFileInfo &scanFileInfo)
 {
 
@@ -13,6 +13,9 @@
 #include <QString>
 #include <QUrl>
 #include <QHash>
+#include <QFileInfo>
+#include <QList>
+#include <QPair>
 
 #include <memory>
 
@@ -50,6 +53,8 @@ private Q_SLOTS:
 
     void newBalooFile(const QString &fileName);
 
+    void scanNewBalooFiles();
+
     void registeredToBaloo(QDBusPendingCallWatcher *watcher);
 
     void registeredToBalooWatcher(QDBusPendingCallWatcher *watcher);
@@ -62,6 +67,8 @@ private:
 
     void triggerRefreshOfContent() override;
 
+    DataTypes::ListTrackDataType scanBalooFiles(const QList<QPair<QUrl, QFileInfo>> &balooFiles);
+
     void triggerStop() override;
 
     DataTypes::TrackDataType scanOneFile(const QUrl &scanFile, const QFileInfo &scanFileInfo) override;
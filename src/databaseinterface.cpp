@@ -7,6 +7,8 @@
 #include "databaseinterface.h"
 
 #include "databaseLogging.h"
+#include "databasestatement.h"
+#include "elisatrace.h"
 
 #include <KI18n/KLocalizedString>
 
@@ -23,9 +25,66 @@
 #include <QVariant>
 #include <QAtomicInt>
 #include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QDebug>
 
 #include <algorithm>
+#include <cmath>
+
+namespace {
+
+/**
+ * a play loses half of its weight in the play score after this many seconds
+ */
+constexpr double PlayScoreHalfLife = 30. * 24. * 3600.;
+
+/**
+ * number of file names bound to one execution of the query of tracks by file names,
+ * longer lists are split and shorter ones padded with null values
+ */
+constexpr int FileNamesQueryBatchSize = 64;
+
+/**
+ * number of now playing entries kept for each radio
+ */
+constexpr int RadioHistoryMaximumEntries = 100;
+
+/**
+ * The play score is the logarithm of the sum of exp(lambda * playDate) over all plays.
+ * Decaying every play with the same factor exp(-lambda * now) does not change the
+ * order of the scores, so the stored value never needs to be updated when time passes
+ * and an index on it gives the frequently played order directly.
+ */
+double addPlayToScore(std::optional<double> score, qint64 playDate)
+{
+    const auto newPlay = std::log(2.) / PlayScoreHalfLife * (static_cast<double>(playDate) / 1000.);
+
+    if (!score) {
+        return newPlay;
+    }
+
+    const auto highestValue = std::max(*score, newPlay);
+    const auto lowestValue = std::min(*score, newPlay);
+
+    return highestValue + std::log1p(std::exp(lowestValue - highestValue));
+}
+
+/**
+ * Copy of a name used to sort and filter views: SQLite only folds the case of ASCII letters.
+ */
+QVariant foldedName(const QVariant &name)
+{
+    if (name.isNull()) {
+        return {};
+    }
+
+    return name.toString().toCaseFolded();
+}
+
+}
 
 class DatabaseInterfacePrivate
 {
@@ -36,7 +95,7 @@ public:
           mSelectTrackQuery(mTracksDatabase), mSelectAlbumIdFromTitleQuery(mTracksDatabase),
           mInsertAlbumQuery(mTracksDatabase), mSelectTrackIdFromTitleAlbumIdArtistQuery(mTracksDatabase),
           mInsertTrackQuery(mTracksDatabase), mSelectTracksFromArtist(mTracksDatabase),
-          mSelectTracksFromGenre(mTracksDatabase),
+          mSelectTracksFromGenre(mTracksDatabase), mSelectTracksFromFileNames(mTracksDatabase),
           mSelectTrackFromIdQuery(mTracksDatabase), mSelectRadioFromIdQuery(mTracksDatabase),
           mSelectCountAlbumsForArtistQuery(mTracksDatabase),
           mSelectTrackIdFromTitleArtistAlbumTrackDiscNumberQuery(mTracksDatabase),
@@ -80,191 +139,258 @@ public:
           mArtistMatchGenreQuery(mTracksDatabase), mSelectTrackIdQuery(mTracksDatabase),
           mInsertRadioQuery(mTracksDatabase), mDeleteRadioQuery(mTracksDatabase),
           mSelectTrackFromIdAndUrlQuery(mTracksDatabase),
-          mUpdateDatabaseVersionQuery(mTracksDatabase), mSelectDatabaseVersionQuery(mTracksDatabase)
+          mUpdateDatabaseVersionQuery(mTracksDatabase), mSelectDatabaseVersionQuery(mTracksDatabase),
+          mInsertChangeJournalEntryQuery(mTracksDatabase), mSelectChangesSinceQuery(mTracksDatabase),
+          mSelectCurrentGenerationQuery(mTracksDatabase), mClearChangeJournalTable(mTracksDatabase),
+          mSelectChangeJournalEntryQuery(mTracksDatabase),
+          mUpdateChangeJournalConsumerQuery(mTracksDatabase), mCompactChangeJournalQuery(mTracksDatabase),
+          mSelectPlayScoreQuery(mTracksDatabase), mUpdatePlayScoreQuery(mTracksDatabase),
+          mSortFilterTracksQuery(mTracksDatabase), mSortFilterAlbumsQuery(mTracksDatabase),
+          mSortFilterArtistsQuery(mTracksDatabase), mSortFilterGenresQuery(mTracksDatabase),
+          mSelectTracksPendingLoudnessQuery(mTracksDatabase), mSelectAlbumTracksForLoudnessQuery(mTracksDatabase),
+          mUpdateTrackLoudnessQuery(mTracksDatabase), mSelectTrackReplayGainQuery(mTracksDatabase),
+          mInsertRadioHistoryQuery(mTracksDatabase), mTrimRadioHistoryQuery(mTracksDatabase),
+          mSelectRadioHistoryQuery(mTracksDatabase)
     {
     }
 
     QSqlDatabase mTracksDatabase;
 
-    QSqlQuery mSelectAlbumQuery;
+    DatabaseStatement mSelectAlbumQuery;
+
+    DatabaseStatement mSelectTrackQuery;
+
+    DatabaseStatement mSelectAlbumIdFromTitleQuery;
+
+    DatabaseStatement mInsertAlbumQuery;
+
+    DatabaseStatement mSelectTrackIdFromTitleAlbumIdArtistQuery;
+
+    DatabaseStatement mInsertTrackQuery;
+
+    DatabaseStatement mSelectTracksFromArtist;
+
+    DatabaseStatement mSelectTracksFromGenre;
+
+    DatabaseStatement mSelectTracksFromFileNames;
+
+    DatabaseStatement mSelectTrackFromIdQuery;
+
+    DatabaseStatement mSelectRadioFromIdQuery;
+
+    DatabaseStatement mSelectCountAlbumsForArtistQuery;
+
+    DatabaseStatement mSelectTrackIdFromTitleArtistAlbumTrackDiscNumberQuery;
+
+    DatabaseStatement mSelectAllAlbumsFromArtistQuery;
+
+    DatabaseStatement mSelectAllArtistsQuery;
+
+    DatabaseStatement mInsertArtistsQuery;
+
+    DatabaseStatement mSelectArtistByNameQuery;
+
+    DatabaseStatement mSelectArtistQuery;
+
+    DatabaseStatement mUpdateTrackStatistics;
+
+    DatabaseStatement mRemoveTrackQuery;
 
-    QSqlQuery mSelectTrackQuery;
+    DatabaseStatement mRemoveAlbumQuery;
 
-    QSqlQuery mSelectAlbumIdFromTitleQuery;
+    DatabaseStatement mRemoveArtistQuery;
 
-    QSqlQuery mInsertAlbumQuery;
+    DatabaseStatement mSelectAllTracksQuery;
 
-    QSqlQuery mSelectTrackIdFromTitleAlbumIdArtistQuery;
+    DatabaseStatement mSelectAllRadiosQuery;
 
-    QSqlQuery mInsertTrackQuery;
+    DatabaseStatement mInsertTrackMapping;
 
-    QSqlQuery mSelectTracksFromArtist;
+    DatabaseStatement mUpdateTrackFirstPlayStatistics;
 
-    QSqlQuery mSelectTracksFromGenre;
+    DatabaseStatement mInsertMusicSource;
 
-    QSqlQuery mSelectTrackFromIdQuery;
+    DatabaseStatement mSelectMusicSource;
 
-    QSqlQuery mSelectRadioFromIdQuery;
+    DatabaseStatement mUpdateTrackPriority;
 
-    QSqlQuery mSelectCountAlbumsForArtistQuery;
+    DatabaseStatement mUpdateTrackFileModifiedTime;
 
-    QSqlQuery mSelectTrackIdFromTitleArtistAlbumTrackDiscNumberQuery;
+    DatabaseStatement mSelectTracksMapping;
 
-    QSqlQuery mSelectAllAlbumsFromArtistQuery;
+    DatabaseStatement mSelectTracksMappingPriority;
 
-    QSqlQuery mSelectAllArtistsQuery;
+    DatabaseStatement mSelectRadioIdFromHttpAddress;
 
-    QSqlQuery mInsertArtistsQuery;
+    DatabaseStatement mUpdateAlbumArtUriFromAlbumIdQuery;
 
-    QSqlQuery mSelectArtistByNameQuery;
+    DatabaseStatement mSelectTracksMappingPriorityByTrackId;
 
-    QSqlQuery mSelectArtistQuery;
+    DatabaseStatement mSelectAlbumIdsFromArtist;
 
-    QSqlQuery mUpdateTrackStatistics;
+    DatabaseStatement mSelectAllTrackFilesQuery;
 
-    QSqlQuery mRemoveTrackQuery;
+    DatabaseStatement mRemoveTracksMappingFromSource;
 
-    QSqlQuery mRemoveAlbumQuery;
+    DatabaseStatement mRemoveTracksMapping;
 
-    QSqlQuery mRemoveArtistQuery;
+    DatabaseStatement mSelectTracksWithoutMappingQuery;
 
-    QSqlQuery mSelectAllTracksQuery;
+    DatabaseStatement mSelectAlbumIdFromTitleAndArtistQuery;
 
-    QSqlQuery mSelectAllRadiosQuery;
+    DatabaseStatement mSelectAlbumIdFromTitleWithoutArtistQuery;
 
-    QSqlQuery mInsertTrackMapping;
+    DatabaseStatement mSelectTrackIdFromTitleAlbumTrackDiscNumberQuery;
 
-    QSqlQuery mUpdateTrackFirstPlayStatistics;
+    DatabaseStatement mSelectAlbumArtUriFromAlbumIdQuery;
 
-    QSqlQuery mInsertMusicSource;
+    DatabaseStatement mInsertComposerQuery;
 
-    QSqlQuery mSelectMusicSource;
+    DatabaseStatement mSelectComposerByNameQuery;
 
-    QSqlQuery mUpdateTrackPriority;
+    DatabaseStatement mSelectComposerQuery;
 
-    QSqlQuery mUpdateTrackFileModifiedTime;
+    DatabaseStatement mInsertLyricistQuery;
 
-    QSqlQuery mSelectTracksMapping;
+    DatabaseStatement mSelectLyricistByNameQuery;
 
-    QSqlQuery mSelectTracksMappingPriority;
+    DatabaseStatement mSelectLyricistQuery;
 
-    QSqlQuery mSelectRadioIdFromHttpAddress;
+    DatabaseStatement mInsertGenreQuery;
 
-    QSqlQuery mUpdateAlbumArtUriFromAlbumIdQuery;
+    DatabaseStatement mSelectGenreByNameQuery;
 
-    QSqlQuery mSelectTracksMappingPriorityByTrackId;
+    DatabaseStatement mSelectGenreQuery;
 
-    QSqlQuery mSelectAlbumIdsFromArtist;
+    DatabaseStatement mSelectAllTracksShortQuery;
 
-    QSqlQuery mSelectAllTrackFilesQuery;
+    DatabaseStatement mSelectAllAlbumsShortQuery;
 
-    QSqlQuery mRemoveTracksMappingFromSource;
+    DatabaseStatement mSelectAllComposersQuery;
 
-    QSqlQuery mRemoveTracksMapping;
+    DatabaseStatement mSelectAllLyricistsQuery;
 
-    QSqlQuery mSelectTracksWithoutMappingQuery;
+    DatabaseStatement mSelectCountAlbumsForComposerQuery;
 
-    QSqlQuery mSelectAlbumIdFromTitleAndArtistQuery;
+    DatabaseStatement mSelectCountAlbumsForLyricistQuery;
 
-    QSqlQuery mSelectAlbumIdFromTitleWithoutArtistQuery;
+    DatabaseStatement mSelectAllGenresQuery;
 
-    QSqlQuery mSelectTrackIdFromTitleAlbumTrackDiscNumberQuery;
+    DatabaseStatement mSelectGenreForArtistQuery;
 
-    QSqlQuery mSelectAlbumArtUriFromAlbumIdQuery;
+    DatabaseStatement mSelectGenreForAlbumQuery;
 
-    QSqlQuery mInsertComposerQuery;
+    DatabaseStatement mUpdateTrackQuery;
 
-    QSqlQuery mSelectComposerByNameQuery;
+    DatabaseStatement mUpdateAlbumArtistQuery;
 
-    QSqlQuery mSelectComposerQuery;
+    DatabaseStatement mUpdateRadioQuery;
 
-    QSqlQuery mInsertLyricistQuery;
+    DatabaseStatement mUpdateAlbumArtistInTracksQuery;
 
-    QSqlQuery mSelectLyricistByNameQuery;
+    DatabaseStatement mQueryMaximumTrackIdQuery;
 
-    QSqlQuery mSelectLyricistQuery;
+    DatabaseStatement mQueryMaximumAlbumIdQuery;
 
-    QSqlQuery mInsertGenreQuery;
+    DatabaseStatement mQueryMaximumArtistIdQuery;
 
-    QSqlQuery mSelectGenreByNameQuery;
+    DatabaseStatement mQueryMaximumLyricistIdQuery;
 
-    QSqlQuery mSelectGenreQuery;
+    DatabaseStatement mQueryMaximumComposerIdQuery;
 
-    QSqlQuery mSelectAllTracksShortQuery;
+    DatabaseStatement mQueryMaximumGenreIdQuery;
 
-    QSqlQuery mSelectAllAlbumsShortQuery;
+    DatabaseStatement mSelectAllArtistsWithGenreFilterQuery;
 
-    QSqlQuery mSelectAllComposersQuery;
+    DatabaseStatement mSelectAllAlbumsShortWithGenreArtistFilterQuery;
 
-    QSqlQuery mSelectAllLyricistsQuery;
+    DatabaseStatement mSelectAllAlbumsShortWithArtistFilterQuery;
 
-    QSqlQuery mSelectCountAlbumsForComposerQuery;
+    DatabaseStatement mSelectAllRecentlyPlayedTracksQuery;
 
-    QSqlQuery mSelectCountAlbumsForLyricistQuery;
+    DatabaseStatement mSelectAllFrequentlyPlayedTracksQuery;
 
-    QSqlQuery mSelectAllGenresQuery;
+    DatabaseStatement mClearTracksDataTable;
 
-    QSqlQuery mSelectGenreForArtistQuery;
+    DatabaseStatement mClearTracksTable;
 
-    QSqlQuery mSelectGenreForAlbumQuery;
+    DatabaseStatement mClearAlbumsTable;
 
-    QSqlQuery mUpdateTrackQuery;
+    DatabaseStatement mClearArtistsTable;
 
-    QSqlQuery mUpdateAlbumArtistQuery;
+    DatabaseStatement mClearComposerTable;
 
-    QSqlQuery mUpdateRadioQuery;
+    DatabaseStatement mClearGenreTable;
 
-    QSqlQuery mUpdateAlbumArtistInTracksQuery;
+    DatabaseStatement mClearLyricistTable;
 
-    QSqlQuery mQueryMaximumTrackIdQuery;
+    DatabaseStatement mArtistMatchGenreQuery;
 
-    QSqlQuery mQueryMaximumAlbumIdQuery;
+    DatabaseStatement mSelectTrackIdQuery;
 
-    QSqlQuery mQueryMaximumArtistIdQuery;
+    DatabaseStatement mInsertRadioQuery;
 
-    QSqlQuery mQueryMaximumLyricistIdQuery;
+    DatabaseStatement mDeleteRadioQuery;
 
-    QSqlQuery mQueryMaximumComposerIdQuery;
+    DatabaseStatement mSelectTrackFromIdAndUrlQuery;
 
-    QSqlQuery mQueryMaximumGenreIdQuery;
+    DatabaseStatement mUpdateDatabaseVersionQuery;
 
-    QSqlQuery mSelectAllArtistsWithGenreFilterQuery;
+    DatabaseStatement mSelectDatabaseVersionQuery;
 
-    QSqlQuery mSelectAllAlbumsShortWithGenreArtistFilterQuery;
+    DatabaseStatement mInsertChangeJournalEntryQuery;
 
-    QSqlQuery mSelectAllAlbumsShortWithArtistFilterQuery;
+    DatabaseStatement mSelectChangesSinceQuery;
 
-    QSqlQuery mSelectAllRecentlyPlayedTracksQuery;
+    DatabaseStatement mSelectCurrentGenerationQuery;
 
-    QSqlQuery mSelectAllFrequentlyPlayedTracksQuery;
+    DatabaseStatement mClearChangeJournalTable;
 
-    QSqlQuery mClearTracksDataTable;
+    DatabaseStatement mSelectChangeJournalEntryQuery;
 
-    QSqlQuery mClearTracksTable;
+    DatabaseStatement mUpdateChangeJournalConsumerQuery;
 
-    QSqlQuery mClearAlbumsTable;
+    DatabaseStatement mCompactChangeJournalQuery;
 
-    QSqlQuery mClearArtistsTable;
+    DatabaseStatement mSelectPlayScoreQuery;
 
-    QSqlQuery mClearComposerTable;
+    DatabaseStatement mUpdatePlayScoreQuery;
 
-    QSqlQuery mClearGenreTable;
+    DatabaseStatement mSortFilterTracksQuery;
 
-    QSqlQuery mClearLyricistTable;
+    DatabaseStatement mSortFilterAlbumsQuery;
 
-    QSqlQuery mArtistMatchGenreQuery;
+    DatabaseStatement mSortFilterArtistsQuery;
 
-    QSqlQuery mSelectTrackIdQuery;
+    DatabaseStatement mSortFilterGenresQuery;
 
-    QSqlQuery mInsertRadioQuery;
+    DatabaseStatement mSelectTracksPendingLoudnessQuery;
 
-    QSqlQuery mDeleteRadioQuery;
+    DatabaseStatement mSelectAlbumTracksForLoudnessQuery;
 
-    QSqlQuery mSelectTrackFromIdAndUrlQuery;
+    DatabaseStatement mUpdateTrackLoudnessQuery;
 
-    QSqlQuery mUpdateDatabaseVersionQuery;
+    DatabaseStatement mSelectTrackReplayGainQuery;
 
-    QSqlQuery mSelectDatabaseVersionQuery;
+    DatabaseStatement mInsertRadioHistoryQuery;
+
+    DatabaseStatement mTrimRadioHistoryQuery;
+
+    DatabaseStatement mSelectRadioHistoryQuery;
+
+    QSet<DatabaseStatement*> mStatements;
+
+    DatabaseHistogram mLockWaitHistogram{10000};
+
+    qint64 mSlowQueryThreshold = 0;
+
+    QString mSelectAllTracksText;
+
+    QString mSelectAllAlbumsText;
+
+    QString mSelectAllArtistsText;
+
+    QString mSelectAllGenresText;
 
     QSet<qulonglong> mModifiedTrackIds;
 
@@ -372,7 +498,34 @@ DataTypes::ListTrackDataType DatabaseInterface::allTracksData()
         return result;
     }
 
-    result = internalAllTracksPartialData();
+    result = internalAllTracksPartialData(d->mSelectAllTracksQuery);
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    return result;
+}
+
+DataTypes::ListTrackDataType DatabaseInterface::allTracksData(const DataTypes::SortFilterParameters &parameters)
+{
+    auto result = DataTypes::ListTrackDataType{};
+
+    if (!d) {
+        return result;
+    }
+
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    auto &sortFilterQuery = d->mSortFilterTracksQuery;
+
+    if (prepareSortFilterQuery(sortFilterQuery, ElisaUtils::Track, parameters)) {
+        result = internalAllTracksPartialData(sortFilterQuery);
+    }
 
     transactionResult = finishTransaction();
     if (!transactionResult) {
@@ -428,6 +581,54 @@ DataTypes::ListTrackDataType DatabaseInterface::recentlyPlayedTracksData(int cou
     return result;
 }
 
+DataTypes::ListTrackDataType DatabaseInterface::radioHistory(qulonglong radioId, int count)
+{
+    auto result = DataTypes::ListTrackDataType{};
+
+    if (!d) {
+        return result;
+    }
+
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    d->mSelectRadioHistoryQuery.bindValue(QStringLiteral(":radioId"), radioId);
+    d->mSelectRadioHistoryQuery.bindValue(QStringLiteral(":maximumResults"), count);
+
+    auto queryResult = execQuery(d->mSelectRadioHistoryQuery);
+
+    if (!queryResult || !d->mSelectRadioHistoryQuery.isSelect() || !d->mSelectRadioHistoryQuery.isActive()) {
+        Q_EMIT databaseError();
+
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::radioHistory" << d->mSelectRadioHistoryQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::radioHistory" << d->mSelectRadioHistoryQuery.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::radioHistory" << d->mSelectRadioHistoryQuery.lastError();
+    }
+
+    while (d->mSelectRadioHistoryQuery.next()) {
+        const auto &currentRecord = d->mSelectRadioHistoryQuery.record();
+
+        auto oneEntry = DataTypes::TrackDataType{};
+        oneEntry[DataTypes::DatabaseIdRole] = radioId;
+        oneEntry[DataTypes::ElementTypeRole] = ElisaUtils::Radio;
+        oneEntry[DataTypes::TitleRole] = currentRecord.value(0);
+        oneEntry[DataTypes::ArtistRole] = currentRecord.value(1);
+        oneEntry[DataTypes::LastPlayDate] = QDateTime::fromMSecsSinceEpoch(currentRecord.value(2).toLongLong());
+        result.push_back(oneEntry);
+    }
+
+    d->mSelectRadioHistoryQuery.finish();
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    return result;
+}
+
 DataTypes::ListTrackDataType DatabaseInterface::frequentlyPlayedTracksData(int count)
 {
     auto result = DataTypes::ListTrackDataType{};
@@ -474,6 +675,33 @@ DataTypes::ListAlbumDataType DatabaseInterface::allAlbumsData()
     return result;
 }
 
+DataTypes::ListAlbumDataType DatabaseInterface::allAlbumsData(const DataTypes::SortFilterParameters &parameters)
+{
+    auto result = DataTypes::ListAlbumDataType{};
+
+    if (!d) {
+        return result;
+    }
+
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    auto &sortFilterQuery = d->mSortFilterAlbumsQuery;
+
+    if (prepareSortFilterQuery(sortFilterQuery, ElisaUtils::Album, parameters)) {
+        result = internalAllAlbumsPartialData(sortFilterQuery);
+    }
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    return result;
+}
+
 DataTypes::ListAlbumDataType DatabaseInterface::allAlbumsDataByGenreAndArtist(const QString &genre, const QString &artist)
 {
     auto result = DataTypes::ListAlbumDataType{};
@@ -612,6 +840,33 @@ DataTypes::ListArtistDataType DatabaseInterface::allArtistsData()
     return result;
 }
 
+DataTypes::ListArtistDataType DatabaseInterface::allArtistsData(const DataTypes::SortFilterParameters &parameters)
+{
+    auto result = DataTypes::ListArtistDataType{};
+
+    if (!d) {
+        return result;
+    }
+
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    auto &sortFilterQuery = d->mSortFilterArtistsQuery;
+
+    if (prepareSortFilterQuery(sortFilterQuery, ElisaUtils::Artist, parameters)) {
+        result = internalAllArtistsPartialData(sortFilterQuery);
+    }
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    return result;
+}
+
 DataTypes::ListArtistDataType DatabaseInterface::allArtistsDataByGenre(const QString &genre)
 {
     qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::allArtistsDataByGenre" << genre;
@@ -694,7 +949,34 @@ DataTypes::ListGenreDataType DatabaseInterface::allGenresData()
         return result;
     }
 
-    result = internalAllGenresPartialData();
+    result = internalAllGenresPartialData(d->mSelectAllGenresQuery);
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    return result;
+}
+
+DataTypes::ListGenreDataType DatabaseInterface::allGenresData(const DataTypes::SortFilterParameters &parameters)
+{
+    auto result = DataTypes::ListGenreDataType{};
+
+    if (!d) {
+        return result;
+    }
+
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    auto &sortFilterQuery = d->mSortFilterGenresQuery;
+
+    if (prepareSortFilterQuery(sortFilterQuery, ElisaUtils::Genre, parameters)) {
+        result = internalAllGenresPartialData(sortFilterQuery);
+    }
 
     transactionResult = finishTransaction();
     if (!transactionResult) {
@@ -780,6 +1062,30 @@ DataTypes::ListTrackDataType DatabaseInterface::tracksDataFromGenre(const QStrin
 
     return allTracks;
 }
+
+DataTypes::ListTrackDataType DatabaseInterface::tracksDataFromFileNames(const QList<QUrl> &fileNames)
+{
+    auto allTracks = DataTypes::ListTrackDataType{};
+
+    if (!d || fileNames.isEmpty()) {
+        return allTracks;
+    }
+
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return allTracks;
+    }
+
+    allTracks = internalTracksFromFileNames(fileNames);
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return allTracks;
+    }
+
+    return allTracks;
+}
+
 DataTypes::TrackDataType DatabaseInterface::trackDataFromDatabaseId(qulonglong id)
 {
     auto result = DataTypes::TrackDataType();
@@ -896,6 +1202,29 @@ qulonglong DatabaseInterface::trackIdFromFileName(const QUrl &fileName)
     return result;
 }
 
+QString DatabaseInterface::trackCommentFromFileName(const QUrl &fileName)
+{
+    auto result = QString{};
+
+    if (!d) {
+        return result;
+    }
+
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    internalTrackIdFromFileName(fileName, &result);
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    return result;
+}
+
 qulonglong DatabaseInterface::radioIdFromFileName(const QUrl &fileName)
 {
     auto result = qulonglong(0);
@@ -924,52 +1253,396 @@ void DatabaseInterface::applicationAboutToQuit()
     d->mStopRequest = 1;
 }
 
-void DatabaseInterface::askRestoredTracks()
+qulonglong DatabaseInterface::currentGeneration()
 {
+    auto result = qulonglong{0};
+
+    if (!d) {
+        return result;
+    }
+
     auto transactionResult = startTransaction();
     if (!transactionResult) {
-        return;
+        return result;
     }
 
-    auto result = internalAllFileName();
-
-    Q_EMIT restoredTracks(result);
+    result = internalCurrentGeneration();
 
     transactionResult = finishTransaction();
     if (!transactionResult) {
-        return;
+        return result;
     }
+
+    return result;
 }
 
-void DatabaseInterface::trackHasStartedPlaying(const QUrl &fileName, const QDateTime &time)
+DataTypes::LibraryChanges DatabaseInterface::changesSince(qulonglong generation)
 {
+    auto result = DataTypes::LibraryChanges{};
+    result.mGeneration = generation;
+
+    if (!d) {
+        return result;
+    }
+
     auto transactionResult = startTransaction();
     if (!transactionResult) {
-        return;
+        return result;
     }
 
-    updateTrackStatistics(fileName, time);
-    auto trackId = internalTrackIdFromFileName(fileName);
-    if (trackId != 0) {
-        Q_EMIT trackModified(internalOneTrackPartialData(trackId));
+    d->mSelectChangesSinceQuery.bindValue(QStringLiteral(":generation"), generation);
+
+    if (!internalGenericPartialData(d->mSelectChangesSinceQuery)) {
+        return result;
+    }
+
+    while(d->mSelectChangesSinceQuery.next()) {
+        const auto &currentRecord = d->mSelectChangesSinceQuery.record();
+
+        const auto entryGeneration = currentRecord.value(0).toULongLong();
+        const auto entityType = static_cast<ElisaUtils::PlayListEntryType>(currentRecord.value(1).toInt());
+        const auto entityId = currentRecord.value(2).toULongLong();
+        const auto changeType = static_cast<DataTypes::LibraryChanges::ChangeType>(currentRecord.value(3).toInt());
+
+        result.mGeneration = std::max(result.mGeneration, entryGeneration);
+
+        switch (changeType)
+        {
+        case DataTypes::LibraryChanges::Inserted:
+            result.mInsertedIds[entityType].push_back(entityId);
+            break;
+        case DataTypes::LibraryChanges::Modified:
+            result.mModifiedIds[entityType].push_back(entityId);
+            break;
+        case DataTypes::LibraryChanges::Removed:
+            result.mRemovedIds[entityType].push_back(entityId);
+            break;
+        case DataTypes::LibraryChanges::Reset:
+            result.mNeedFullReload = true;
+            break;
+        }
     }
 
+    d->mSelectChangesSinceQuery.finish();
+
     transactionResult = finishTransaction();
     if (!transactionResult) {
-        return;
+        return result;
     }
+
+    return result;
 }
 
-void DatabaseInterface::clearData()
+void DatabaseInterface::acknowledgeChanges(const QString &consumerName, qulonglong generation)
 {
+    if (!d) {
+        return;
+    }
+
     auto transactionResult = startTransaction();
     if (!transactionResult) {
         return;
     }
 
-    auto queryResult = execQuery(d->mClearTracksTable);
+    d->mUpdateChangeJournalConsumerQuery.bindValue(QStringLiteral(":name"), consumerName);
+    d->mUpdateChangeJournalConsumerQuery.bindValue(QStringLiteral(":generation"), generation);
 
-    if (!queryResult || !d->mClearTracksTable.isActive()) {
+    auto queryResult = execQuery(d->mUpdateChangeJournalConsumerQuery);
+
+    if (!queryResult || !d->mUpdateChangeJournalConsumerQuery.isActive()) {
+        Q_EMIT databaseError();
+
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::acknowledgeChanges" << d->mUpdateChangeJournalConsumerQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::acknowledgeChanges" << d->mUpdateChangeJournalConsumerQuery.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::acknowledgeChanges" << d->mUpdateChangeJournalConsumerQuery.lastError();
+    }
+
+    d->mUpdateChangeJournalConsumerQuery.finish();
+
+    // removals read by the oldest consumer are no longer needed by anyone
+    d->mCompactChangeJournalQuery.bindValue(QStringLiteral(":removedType"), static_cast<int>(DataTypes::LibraryChanges::Removed));
+
+    queryResult = execQuery(d->mCompactChangeJournalQuery);
+
+    if (!queryResult || !d->mCompactChangeJournalQuery.isActive()) {
+        Q_EMIT databaseError();
+
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::acknowledgeChanges" << d->mCompactChangeJournalQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::acknowledgeChanges" << d->mCompactChangeJournalQuery.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::acknowledgeChanges" << d->mCompactChangeJournalQuery.lastError();
+    }
+
+    d->mCompactChangeJournalQuery.finish();
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return;
+    }
+}
+
+void DatabaseInterface::askRestoredTracks()
+{
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return;
+    }
+
+    auto result = internalAllFileName();
+
+    Q_EMIT restoredTracks(result);
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return;
+    }
+}
+
+void DatabaseInterface::askTracksPendingLoudnessAnalysis(int maximumCount)
+{
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return;
+    }
+
+    auto result = DataTypes::ListTrackDataType{};
+    auto pendingAlbumIds = QList<qulonglong>{};
+
+    d->mSelectTracksPendingLoudnessQuery.bindValue(QStringLiteral(":maximumCount"), maximumCount);
+
+    auto queryResult = execQuery(d->mSelectTracksPendingLoudnessQuery);
+
+    if (!queryResult || !d->mSelectTracksPendingLoudnessQuery.isSelect() || !d->mSelectTracksPendingLoudnessQuery.isActive()) {
+        Q_EMIT databaseError();
+
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::askTracksPendingLoudnessAnalysis" << d->mSelectTracksPendingLoudnessQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::askTracksPendingLoudnessAnalysis" << d->mSelectTracksPendingLoudnessQuery.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::askTracksPendingLoudnessAnalysis" << d->mSelectTracksPendingLoudnessQuery.lastError();
+    }
+
+    while (d->mSelectTracksPendingLoudnessQuery.next()) {
+        const auto &currentRecord = d->mSelectTracksPendingLoudnessQuery.record();
+
+        if (currentRecord.isNull(2)) {
+            auto oneTrack = DataTypes::TrackDataType{};
+            oneTrack[DataTypes::DatabaseIdRole] = currentRecord.value(0);
+            oneTrack[DataTypes::ResourceRole] = currentRecord.value(1).toUrl();
+            result.push_back(oneTrack);
+        } else if (!pendingAlbumIds.contains(currentRecord.value(2).toULongLong())) {
+            pendingAlbumIds.push_back(currentRecord.value(2).toULongLong());
+        }
+    }
+
+    d->mSelectTracksPendingLoudnessQuery.finish();
+
+    // album gain needs all tracks of an album, including the ones already analyzed
+    for (auto oneAlbumId : pendingAlbumIds) {
+        d->mSelectAlbumTracksForLoudnessQuery.bindValue(QStringLiteral(":albumId"), oneAlbumId);
+
+        queryResult = execQuery(d->mSelectAlbumTracksForLoudnessQuery);
+
+        if (!queryResult || !d->mSelectAlbumTracksForLoudnessQuery.isSelect() || !d->mSelectAlbumTracksForLoudnessQuery.isActive()) {
+            Q_EMIT databaseError();
+
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::askTracksPendingLoudnessAnalysis" << d->mSelectAlbumTracksForLoudnessQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::askTracksPendingLoudnessAnalysis" << d->mSelectAlbumTracksForLoudnessQuery.boundValues();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::askTracksPendingLoudnessAnalysis" << d->mSelectAlbumTracksForLoudnessQuery.lastError();
+        }
+
+        while (d->mSelectAlbumTracksForLoudnessQuery.next()) {
+            const auto &currentRecord = d->mSelectAlbumTracksForLoudnessQuery.record();
+
+            auto oneTrack = DataTypes::TrackDataType{};
+            oneTrack[DataTypes::DatabaseIdRole] = currentRecord.value(0);
+            oneTrack[DataTypes::ResourceRole] = currentRecord.value(1).toUrl();
+            oneTrack[DataTypes::AlbumIdRole] = oneAlbumId;
+            result.push_back(oneTrack);
+        }
+
+        d->mSelectAlbumTracksForLoudnessQuery.finish();
+    }
+
+    Q_EMIT tracksPendingLoudnessAnalysis(result);
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return;
+    }
+}
+
+void DatabaseInterface::updateLoudnessAnalysis(const DataTypes::ListTrackDataType &tracks)
+{
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return;
+    }
+
+    for (const auto &oneTrack : tracks) {
+        d->mUpdateTrackLoudnessQuery.bindValue(QStringLiteral(":trackId"), oneTrack.databaseId());
+        d->mUpdateTrackLoudnessQuery.bindValue(QStringLiteral(":trackGain"), oneTrack[DataTypes::ReplayGainTrackGainRole]);
+        d->mUpdateTrackLoudnessQuery.bindValue(QStringLiteral(":trackPeak"), oneTrack[DataTypes::ReplayGainTrackPeakRole]);
+        d->mUpdateTrackLoudnessQuery.bindValue(QStringLiteral(":albumGain"), oneTrack[DataTypes::ReplayGainAlbumGainRole]);
+        d->mUpdateTrackLoudnessQuery.bindValue(QStringLiteral(":albumPeak"), oneTrack[DataTypes::ReplayGainAlbumPeakRole]);
+
+        auto queryResult = execQuery(d->mUpdateTrackLoudnessQuery);
+
+        if (!queryResult || !d->mUpdateTrackLoudnessQuery.isActive()) {
+            Q_EMIT databaseError();
+
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::updateLoudnessAnalysis" << d->mUpdateTrackLoudnessQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::updateLoudnessAnalysis" << d->mUpdateTrackLoudnessQuery.boundValues();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::updateLoudnessAnalysis" << d->mUpdateTrackLoudnessQuery.lastError();
+        }
+
+        d->mUpdateTrackLoudnessQuery.finish();
+    }
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return;
+    }
+}
+
+void DatabaseInterface::askReplayGain(const QUrl &fileName)
+{
+    if (fileName.isEmpty()) {
+        return;
+    }
+
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return;
+    }
+
+    auto result = DataTypes::TrackDataType{};
+    result[DataTypes::ResourceRole] = fileName;
+
+    d->mSelectTrackReplayGainQuery.bindValue(QStringLiteral(":fileName"), fileName);
+
+    auto queryResult = execQuery(d->mSelectTrackReplayGainQuery);
+
+    if (!queryResult || !d->mSelectTrackReplayGainQuery.isSelect() || !d->mSelectTrackReplayGainQuery.isActive()) {
+        Q_EMIT databaseError();
+
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::askReplayGain" << d->mSelectTrackReplayGainQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::askReplayGain" << d->mSelectTrackReplayGainQuery.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::askReplayGain" << d->mSelectTrackReplayGainQuery.lastError();
+    }
+
+    if (d->mSelectTrackReplayGainQuery.next()) {
+        const auto &currentRecord = d->mSelectTrackReplayGainQuery.record();
+
+        if (!currentRecord.isNull(0)) {
+            result[DataTypes::ReplayGainTrackGainRole] = currentRecord.value(0);
+            result[DataTypes::ReplayGainTrackPeakRole] = currentRecord.value(1);
+            result[DataTypes::ReplayGainAlbumGainRole] = currentRecord.value(2);
+            result[DataTypes::ReplayGainAlbumPeakRole] = currentRecord.value(3);
+        }
+    }
+
+    d->mSelectTrackReplayGainQuery.finish();
+
+    Q_EMIT replayGainAvailable(result);
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return;
+    }
+}
+
+void DatabaseInterface::trackHasStartedPlaying(const QUrl &fileName, const QDateTime &time)
+{
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return;
+    }
+
+    updateTrackStatistics(fileName, time);
+    auto trackId = internalTrackIdFromFileName(fileName);
+    if (trackId != 0) {
+        recordChange(ElisaUtils::Track, trackId, DataTypes::LibraryChanges::Modified);
+        Q_EMIT trackModified(internalOneTrackPartialData(trackId));
+    }
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return;
+    }
+}
+
+void DatabaseInterface::insertRadiosHistory(const DataTypes::ListTrackDataType &entries)
+{
+    if (entries.isEmpty()) {
+        return;
+    }
+
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return;
+    }
+
+    auto modifiedRadios = QSet<qulonglong>{};
+
+    for (const auto &oneEntry : entries) {
+        const auto radioId = internalRadioIdFromHttpAddress(oneEntry.resourceURI().toString());
+        if (radioId == 0) {
+            continue;
+        }
+
+        d->mInsertRadioHistoryQuery.bindValue(QStringLiteral(":radioId"), radioId);
+        d->mInsertRadioHistoryQuery.bindValue(QStringLiteral(":title"), oneEntry.title());
+        d->mInsertRadioHistoryQuery.bindValue(QStringLiteral(":nowPlaying"), oneEntry.artist());
+        d->mInsertRadioHistoryQuery.bindValue(QStringLiteral(":playDate"), oneEntry[DataTypes::LastPlayDate].toDateTime().toMSecsSinceEpoch());
+
+        auto queryResult = execQuery(d->mInsertRadioHistoryQuery);
+
+        if (!queryResult || !d->mInsertRadioHistoryQuery.isActive()) {
+            Q_EMIT databaseError();
+
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::insertRadiosHistory" << d->mInsertRadioHistoryQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::insertRadiosHistory" << d->mInsertRadioHistoryQuery.boundValues();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::insertRadiosHistory" << d->mInsertRadioHistoryQuery.lastError();
+        }
+
+        d->mInsertRadioHistoryQuery.finish();
+
+        modifiedRadios.insert(radioId);
+    }
+
+    // the history is only trimmed once for each radio of the batch
+    for (const auto oneRadioId : qAsConst(modifiedRadios)) {
+        d->mTrimRadioHistoryQuery.bindValue(QStringLiteral(":radioId"), oneRadioId);
+        d->mTrimRadioHistoryQuery.bindValue(QStringLiteral(":keptRadioId"), oneRadioId);
+        d->mTrimRadioHistoryQuery.bindValue(QStringLiteral(":maximumEntries"), RadioHistoryMaximumEntries);
+
+        auto queryResult = execQuery(d->mTrimRadioHistoryQuery);
+
+        if (!queryResult || !d->mTrimRadioHistoryQuery.isActive()) {
+            Q_EMIT databaseError();
+
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::insertRadiosHistory" << d->mTrimRadioHistoryQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::insertRadiosHistory" << d->mTrimRadioHistoryQuery.boundValues();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::insertRadiosHistory" << d->mTrimRadioHistoryQuery.lastError();
+        }
+
+        d->mTrimRadioHistoryQuery.finish();
+    }
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return;
+    }
+}
+
+void DatabaseInterface::clearData()
+{
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return;
+    }
+
+    auto queryResult = execQuery(d->mClearTracksTable);
+
+    if (!queryResult || !d->mClearTracksTable.isActive()) {
         Q_EMIT databaseError();
 
         qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearTracksTable.lastQuery();
@@ -1051,6 +1724,20 @@ void DatabaseInterface::clearData()
 
     d->mClearArtistsTable.finish();
 
+    queryResult = execQuery(d->mClearChangeJournalTable);
+
+    if (!queryResult || !d->mClearChangeJournalTable.isActive()) {
+        Q_EMIT databaseError();
+
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearChangeJournalTable.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearChangeJournalTable.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearChangeJournalTable.lastError();
+    }
+
+    d->mClearChangeJournalTable.finish();
+
+    recordChange(ElisaUtils::Unknown, 0, DataTypes::LibraryChanges::Reset);
+
     transactionResult = finishTransaction();
     if (!transactionResult) {
         return;
@@ -1079,6 +1766,91 @@ void DatabaseInterface::recordModifiedAlbum(qulonglong albumId)
     d->mModifiedAlbumIds.insert(albumId);
 }
 
+void DatabaseInterface::recordChange(ElisaUtils::PlayListEntryType entityType, qulonglong entityId,
+                                     DataTypes::LibraryChanges::ChangeType changeType)
+{
+    auto recordedChangeType = changeType;
+
+    d->mSelectChangeJournalEntryQuery.bindValue(QStringLiteral(":entityType"), static_cast<int>(entityType));
+    d->mSelectChangeJournalEntryQuery.bindValue(QStringLiteral(":entityId"), entityId);
+
+    auto queryResult = execQuery(d->mSelectChangeJournalEntryQuery);
+
+    if (!queryResult || !d->mSelectChangeJournalEntryQuery.isSelect() || !d->mSelectChangeJournalEntryQuery.isActive()) {
+        Q_EMIT databaseError();
+
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::recordChange" << d->mSelectChangeJournalEntryQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::recordChange" << d->mSelectChangeJournalEntryQuery.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::recordChange" << d->mSelectChangeJournalEntryQuery.lastError();
+
+        d->mSelectChangeJournalEntryQuery.finish();
+
+        return;
+    }
+
+    auto isInsertionUnknownToConsumers = false;
+
+    if (d->mSelectChangeJournalEntryQuery.next()) {
+        const auto &currentRecord = d->mSelectChangeJournalEntryQuery.record();
+
+        const auto entryGeneration = currentRecord.value(0).toULongLong();
+        const auto entryChangeType = static_cast<DataTypes::LibraryChanges::ChangeType>(currentRecord.value(1).toInt());
+        const auto lastReadGeneration = currentRecord.value(2).toULongLong();
+
+        isInsertionUnknownToConsumers = (entryChangeType == DataTypes::LibraryChanges::Inserted && entryGeneration > lastReadGeneration);
+    }
+
+    d->mSelectChangeJournalEntryQuery.finish();
+
+    // a modification of an entity no consumer has acknowledged yet is still reported as its insertion
+    // a removal is always recorded: a reader may have seen the insertion without acknowledging it
+    if (isInsertionUnknownToConsumers && changeType == DataTypes::LibraryChanges::Modified) {
+        recordedChangeType = DataTypes::LibraryChanges::Inserted;
+    }
+
+    d->mInsertChangeJournalEntryQuery.bindValue(QStringLiteral(":entityType"), static_cast<int>(entityType));
+    d->mInsertChangeJournalEntryQuery.bindValue(QStringLiteral(":entityId"), entityId);
+    d->mInsertChangeJournalEntryQuery.bindValue(QStringLiteral(":changeType"), static_cast<int>(recordedChangeType));
+
+    queryResult = execQuery(d->mInsertChangeJournalEntryQuery);
+
+    if (!queryResult || !d->mInsertChangeJournalEntryQuery.isActive()) {
+        Q_EMIT databaseError();
+
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::recordChange" << d->mInsertChangeJournalEntryQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::recordChange" << d->mInsertChangeJournalEntryQuery.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::recordChange" << d->mInsertChangeJournalEntryQuery.lastError();
+    }
+
+    d->mInsertChangeJournalEntryQuery.finish();
+}
+
+qulonglong DatabaseInterface::internalCurrentGeneration()
+{
+    auto result = qulonglong{0};
+
+    auto queryResult = execQuery(d->mSelectCurrentGenerationQuery);
+
+    if (!queryResult || !d->mSelectCurrentGenerationQuery.isSelect() || !d->mSelectCurrentGenerationQuery.isActive()) {
+        Q_EMIT databaseError();
+
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalCurrentGeneration" << d->mSelectCurrentGenerationQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalCurrentGeneration" << d->mSelectCurrentGenerationQuery.lastError();
+
+        d->mSelectCurrentGenerationQuery.finish();
+
+        return result;
+    }
+
+    if (d->mSelectCurrentGenerationQuery.next()) {
+        result = d->mSelectCurrentGenerationQuery.record().value(0).toULongLong();
+    }
+
+    d->mSelectCurrentGenerationQuery.finish();
+
+    return result;
+}
+
 void DatabaseInterface::insertTracksList(const DataTypes::ListTrackDataType &tracks, const QHash<QString, QUrl> &covers)
 {
     qCDebug(orgKdeElisaDatabase()) << "DatabaseInterface::insertTracksList" << tracks.count();
@@ -1148,6 +1920,7 @@ void DatabaseInterface::insertTracksList(const DataTypes::ListTrackDataType &tra
         DataTypes::ListArtistDataType newArtists;
 
         for (auto newArtistData : qAsConst(d->mInsertedArtists)) {
+            recordChange(ElisaUtils::Artist, newArtistData.first, DataTypes::LibraryChanges::Inserted);
             newArtists.push_back({{DataTypes::DatabaseIdRole, newArtistData.first},
                                   {DataTypes::TitleRole, newArtistData.second},
                                   {DataTypes::ElementTypeRole, ElisaUtils::Artist}});
@@ -1161,6 +1934,7 @@ void DatabaseInterface::insertTracksList(const DataTypes::ListTrackDataType &tra
 
         for (auto albumId : qAsConst(d->mInsertedAlbums)) {
             d->mModifiedAlbumIds.remove(albumId);
+            recordChange(ElisaUtils::Album, albumId, DataTypes::LibraryChanges::Inserted);
             newAlbums.push_back(internalOneAlbumPartialData(albumId));
         }
 
@@ -1169,6 +1943,7 @@ void DatabaseInterface::insertTracksList(const DataTypes::ListTrackDataType &tra
     }
 
     for (auto albumId : qAsConst(d->mModifiedAlbumIds)) {
+        recordChange(ElisaUtils::Album, albumId, DataTypes::LibraryChanges::Modified);
         Q_EMIT albumModified({{DataTypes::DatabaseIdRole, albumId}}, albumId);
     }
 
@@ -1176,6 +1951,7 @@ void DatabaseInterface::insertTracksList(const DataTypes::ListTrackDataType &tra
         DataTypes::ListTrackDataType newTracks;
 
         for (auto trackId : qAsConst(d->mInsertedTracks)) {
+            recordChange(ElisaUtils::Track, trackId, DataTypes::LibraryChanges::Inserted);
             newTracks.push_back(internalOneTrackPartialData(trackId));
             d->mModifiedTrackIds.remove(trackId);
         }
@@ -1185,6 +1961,7 @@ void DatabaseInterface::insertTracksList(const DataTypes::ListTrackDataType &tra
     }
 
     for (auto trackId : qAsConst(d->mModifiedTrackIds)) {
+        recordChange(ElisaUtils::Track, trackId, DataTypes::LibraryChanges::Modified);
         Q_EMIT trackModified(internalOneTrackPartialData(trackId));
     }
 
@@ -1211,6 +1988,7 @@ void DatabaseInterface::removeTracksList(const QList<QUrl> &removedTracks)
     if (!d->mInsertedArtists.isEmpty()) {
         DataTypes::ListArtistDataType newArtists;
         for (auto newArtistData : qAsConst(d->mInsertedArtists)) {
+            recordChange(ElisaUtils::Artist, newArtistData.first, DataTypes::LibraryChanges::Inserted);
             newArtists.push_back({{DataTypes::DatabaseIdRole, newArtistData.first},
                                   {DataTypes::TitleRole, newArtistData.second},
                                   {DataTypes::ElementTypeRole, ElisaUtils::Artist}});
@@ -1231,7 +2009,13 @@ bool DatabaseInterface::startTransaction() const
 {
     auto result = false;
 
+    auto timer = QElapsedTimer{};
+    timer.start();
+
     auto transactionResult = d->mTracksDatabase.transaction();
+
+    d->mLockWaitHistogram.addSample(timer.nsecsElapsed());
+
     if (!transactionResult) {
         qCDebug(orgKdeElisaDatabase) << "transaction failed" << d->mTracksDatabase.lastError() << d->mTracksDatabase.lastError().driverText();
 
@@ -1247,8 +2031,13 @@ bool DatabaseInterface::finishTransaction() const
 {
     auto result = false;
 
+    auto timer = QElapsedTimer{};
+    timer.start();
+
     auto transactionResult = d->mTracksDatabase.commit();
 
+    d->mLockWaitHistogram.addSample(timer.nsecsElapsed());
+
     if (!transactionResult) {
         qCDebug(orgKdeElisaDatabase) << "commit failed" << d->mTracksDatabase.lastError() << d->mTracksDatabase.lastError().nativeErrorCode();
 
@@ -3128,17 +3917,348 @@ void DatabaseInterface::upgradeDatabaseV16()
 
 }
 
-void DatabaseInterface::checkDatabaseSchema()
+void DatabaseInterface::upgradeDatabaseV17()
 {
-    checkAlbumsTableSchema();
-    if (d->mIsInBadState)
-    {
-        resetDatabase();
-        return;
-    }
+    qCInfo(orgKdeElisaDatabase) << "begin update to v17 of database schema";
+
+    // copies of the names folded by Qt, the views are sorted and filtered on them
+    const auto foldedColumns = QList<QPair<QString, QStringList>>{
+        {QStringLiteral("Tracks"), {QStringLiteral("Title"), QStringLiteral("ArtistName"), QStringLiteral("AlbumTitle")}},
+        {QStringLiteral("Albums"), {QStringLiteral("Title"), QStringLiteral("ArtistName")}},
+        {QStringLiteral("Artists"), {QStringLiteral("Name")}},
+        {QStringLiteral("Genre"), {QStringLiteral("Name")}},
+    };
+
+    for (const auto &oneTable : foldedColumns) {
+        auto foldedAssignments = QStringList{};
+
+        for (const auto &oneColumn : oneTable.second) {
+            QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+            const auto &result = createSchemaQuery.exec(QStringLiteral("ALTER TABLE `%1` ADD COLUMN `Folded%2` VARCHAR(85) DEFAULT NULL")
+                                                        .arg(oneTable.first, oneColumn));
+
+            if (!result) {
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV17" << createSchemaQuery.lastQuery();
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV17" << createSchemaQuery.lastError();
+
+                Q_EMIT databaseError();
+            }
+
+            foldedAssignments.push_back(QStringLiteral("`Folded%1` = :folded%1").arg(oneColumn));
+        }
+
+        QSqlQuery selectNamesQuery(d->mTracksDatabase);
+
+        auto result = selectNamesQuery.exec(QStringLiteral("SELECT `ID`, `%1` FROM `%2`")
+                                            .arg(oneTable.second.join(QStringLiteral("`, `")), oneTable.first));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV17" << selectNamesQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV17" << selectNamesQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+
+        QSqlQuery updateFoldedNamesQuery(d->mTracksDatabase);
+
+        if (result) {
+            result = updateFoldedNamesQuery.prepare(QStringLiteral("UPDATE `%1` SET %2 WHERE `ID` = :id")
+                                                    .arg(oneTable.first, foldedAssignments.join(QStringLiteral(", "))));
+
+            if (!result) {
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV17" << updateFoldedNamesQuery.lastQuery();
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV17" << updateFoldedNamesQuery.lastError();
+
+                Q_EMIT databaseError();
+            }
+        }
+
+        while (result && selectNamesQuery.next()) {
+            const auto &currentRecord = selectNamesQuery.record();
+
+            updateFoldedNamesQuery.bindValue(QStringLiteral(":id"), currentRecord.value(0));
+            for (int columnIndex = 0; columnIndex < oneTable.second.size(); ++columnIndex) {
+                updateFoldedNamesQuery.bindValue(QStringLiteral(":folded") + oneTable.second[columnIndex],
+                                                 foldedName(currentRecord.value(columnIndex + 1)));
+            }
+
+            if (!updateFoldedNamesQuery.exec()) {
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV17" << updateFoldedNamesQuery.lastQuery();
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV17" << updateFoldedNamesQuery.boundValues();
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV17" << updateFoldedNamesQuery.lastError();
+
+                Q_EMIT databaseError();
+            }
+        }
+
+        selectNamesQuery.finish();
+        updateFoldedNamesQuery.finish();
+    }
+
+    const auto foldedIndexes = {
+        QStringLiteral("`TracksFoldedTitleIndex` ON `Tracks` (`FoldedTitle`)"),
+        QStringLiteral("`TracksFoldedArtistNameIndex` ON `Tracks` (`FoldedArtistName`)"),
+        QStringLiteral("`AlbumsFoldedTitleIndex` ON `Albums` (`FoldedTitle`)"),
+        QStringLiteral("`AlbumsFoldedArtistNameIndex` ON `Albums` (`FoldedArtistName`)"),
+        QStringLiteral("`ArtistsFoldedNameIndex` ON `Artists` (`FoldedName`)"),
+    };
+
+    for (const auto &oneIndex : foldedIndexes) {
+        QSqlQuery createTrackIndex(d->mTracksDatabase);
+
+        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
+                                                                  "IF NOT EXISTS ") + oneIndex);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV17" << createTrackIndex.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV17" << createTrackIndex.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    qCInfo(orgKdeElisaDatabase) << "finished update to v17 of database schema";
+}
+
+void DatabaseInterface::upgradeDatabaseV18()
+{
+    qCInfo(orgKdeElisaDatabase) << "begin update to v18 of database schema";
 
-    checkArtistsTableSchema();
-    if (d->mIsInBadState)
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE IF NOT EXISTS `ChangeJournal` ("
+                                                                   "`Generation` INTEGER PRIMARY KEY AUTOINCREMENT, "
+                                                                   "`EntityType` INTEGER NOT NULL, "
+                                                                   "`EntityId` INTEGER NOT NULL, "
+                                                                   "`ChangeType` INTEGER NOT NULL, "
+                                                                   "UNIQUE (`EntityType`, `EntityId`))"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV18" << createSchemaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV18" << createSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE IF NOT EXISTS `ChangeJournalConsumers` ("
+                                                                   "`Name` VARCHAR(255) PRIMARY KEY NOT NULL, "
+                                                                   "`Generation` INTEGER NOT NULL)"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV18" << createSchemaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV18" << createSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    qCInfo(orgKdeElisaDatabase) << "finished update to v18 of database schema";
+}
+
+void DatabaseInterface::upgradeDatabaseV19()
+{
+    qCInfo(orgKdeElisaDatabase) << "begin update to v19 of database schema";
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE IF NOT EXISTS `PlayStats` ("
+                                                                   "`FileName` VARCHAR(255) NOT NULL, "
+                                                                   "`Score` REAL NOT NULL, "
+                                                                   "PRIMARY KEY (`FileName`), "
+                                                                   "CONSTRAINT fk_playstats_filename FOREIGN KEY (`FileName`) "
+                                                                   "REFERENCES `TracksData`(`FileName`) ON DELETE CASCADE)"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV19" << createSchemaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV19" << createSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createTrackIndex(d->mTracksDatabase);
+
+        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
+                                                                  "IF NOT EXISTS "
+                                                                  "`PlayStatsScoreIndex` ON `PlayStats` "
+                                                                  "(`Score`)"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV19" << createTrackIndex.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV19" << createTrackIndex.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery selectPlayedTracksQuery(d->mTracksDatabase);
+        QSqlQuery insertPlayScoreQuery(d->mTracksDatabase);
+
+        auto result = selectPlayedTracksQuery.exec(QStringLiteral("SELECT "
+                                                                  "td.`FileName`, "
+                                                                  "td.`PlayCounter`, "
+                                                                  "td.`FirstPlayDate`, "
+                                                                  "td.`LastPlayDate` "
+                                                                  "FROM "
+                                                                  "`TracksData` td "
+                                                                  "WHERE "
+                                                                  "td.`PlayCounter` > 0 AND "
+                                                                  "td.`LastPlayDate` IS NOT NULL"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV19" << selectPlayedTracksQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV19" << selectPlayedTracksQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+
+        result = insertPlayScoreQuery.prepare(QStringLiteral("INSERT OR REPLACE INTO `PlayStats` (`FileName`, `Score`) "
+                                                             "VALUES (:fileName, :score)"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV19" << insertPlayScoreQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV19" << insertPlayScoreQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+
+        while (result && selectPlayedTracksQuery.next()) {
+            const auto &currentRecord = selectPlayedTracksQuery.record();
+
+            const auto playCounter = currentRecord.value(1).toLongLong();
+            const auto lastPlayDate = currentRecord.value(3).toLongLong();
+            const auto firstPlayDate = currentRecord.value(2).isNull() ? lastPlayDate : currentRecord.value(2).toLongLong();
+
+            // only the first and last play dates are known: spread the plays evenly between them
+            auto score = std::optional<double>{};
+            for (auto playIndex = qint64{0}; playIndex < playCounter; ++playIndex) {
+                const auto playDate = (playCounter > 1 ?
+                                           firstPlayDate + (lastPlayDate - firstPlayDate) * playIndex / (playCounter - 1) :
+                                           lastPlayDate);
+                score = addPlayToScore(score, playDate);
+            }
+
+            insertPlayScoreQuery.bindValue(QStringLiteral(":fileName"), currentRecord.value(0));
+            insertPlayScoreQuery.bindValue(QStringLiteral(":score"), *score);
+
+            if (!insertPlayScoreQuery.exec()) {
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV19" << insertPlayScoreQuery.lastQuery();
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV19" << insertPlayScoreQuery.boundValues();
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV19" << insertPlayScoreQuery.lastError();
+
+                Q_EMIT databaseError();
+            }
+        }
+
+        selectPlayedTracksQuery.finish();
+        insertPlayScoreQuery.finish();
+    }
+
+    qCInfo(orgKdeElisaDatabase) << "finished update to v19 of database schema";
+}
+
+void DatabaseInterface::upgradeDatabaseV20()
+{
+    qCInfo(orgKdeElisaDatabase) << "begin update to v20 of database schema";
+
+    const auto newColumns = {QStringLiteral("ReplayGainTrackGain"), QStringLiteral("ReplayGainTrackPeak"),
+                             QStringLiteral("ReplayGainAlbumGain"), QStringLiteral("ReplayGainAlbumPeak")};
+
+    for (const auto &oneColumn : newColumns) {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        const auto &result = createSchemaQuery.exec(QStringLiteral("ALTER TABLE `Tracks` ADD COLUMN `%1` REAL DEFAULT NULL").arg(oneColumn));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV20" << createSchemaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV20" << createSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createTrackIndex(d->mTracksDatabase);
+
+        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
+                                                                  "IF NOT EXISTS "
+                                                                  "`TracksReplayGainIndex` ON `Tracks` "
+                                                                  "(`ReplayGainTrackGain`)"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV20" << createTrackIndex.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV20" << createTrackIndex.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    qCInfo(orgKdeElisaDatabase) << "finished update to v20 of database schema";
+}
+
+void DatabaseInterface::upgradeDatabaseV21()
+{
+    qCInfo(orgKdeElisaDatabase) << "begin update to v21 of database schema";
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE IF NOT EXISTS `RadiosHistory` ("
+                                                                   "`ID` INTEGER PRIMARY KEY AUTOINCREMENT, "
+                                                                   "`RadioID` INTEGER NOT NULL, "
+                                                                   "`Title` VARCHAR(255), "
+                                                                   "`NowPlaying` VARCHAR(255), "
+                                                                   "`PlayDate` INTEGER NOT NULL, "
+                                                                   "CONSTRAINT fk_radioshistory_radio FOREIGN KEY (`RadioID`) "
+                                                                   "REFERENCES `Radios`(`ID`) ON DELETE CASCADE)"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV21" << createSchemaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV21" << createSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createTrackIndex(d->mTracksDatabase);
+
+        const auto &result = createTrackIndex.exec(QStringLiteral("CREATE INDEX "
+                                                                  "IF NOT EXISTS "
+                                                                  "`RadiosHistoryPlayDateIndex` ON `RadiosHistory` "
+                                                                  "(`RadioID`, `PlayDate`)"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV21" << createTrackIndex.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV21" << createTrackIndex.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    qCInfo(orgKdeElisaDatabase) << "finished update to v21 of database schema";
+}
+
+void DatabaseInterface::checkDatabaseSchema()
+{
+    checkAlbumsTableSchema();
+    if (d->mIsInBadState)
+    {
+        resetDatabase();
+        return;
+    }
+
+    checkArtistsTableSchema();
+    if (d->mIsInBadState)
     {
         resetDatabase();
         return;
@@ -3178,20 +4298,49 @@ void DatabaseInterface::checkDatabaseSchema()
         resetDatabase();
         return;
     }
+
+    checkChangeJournalTableSchema();
+    if (d->mIsInBadState)
+    {
+        resetDatabase();
+        return;
+    }
+
+    checkChangeJournalConsumersTableSchema();
+    if (d->mIsInBadState)
+    {
+        resetDatabase();
+        return;
+    }
+
+    checkPlayStatsTableSchema();
+    if (d->mIsInBadState)
+    {
+        resetDatabase();
+        return;
+    }
+
+    checkRadiosHistoryTableSchema();
+    if (d->mIsInBadState)
+    {
+        resetDatabase();
+        return;
+    }
 }
 
 void DatabaseInterface::checkAlbumsTableSchema()
 {
     auto fieldsList = QStringList{QStringLiteral("ID"), QStringLiteral("Title"),
                                   QStringLiteral("ArtistName"), QStringLiteral("AlbumPath"),
-                                  QStringLiteral("CoverFileName")};
+                                  QStringLiteral("CoverFileName"), QStringLiteral("FoldedTitle"),
+                                  QStringLiteral("FoldedArtistName")};
 
     genericCheckTable(QStringLiteral("Albums"), fieldsList);
 }
 
 void DatabaseInterface::checkArtistsTableSchema()
 {
-    auto fieldsList = QStringList{QStringLiteral("ID"), QStringLiteral("Name")};
+    auto fieldsList = QStringList{QStringLiteral("ID"), QStringLiteral("Name"), QStringLiteral("FoldedName")};
 
     genericCheckTable(QStringLiteral("Artists"), fieldsList);
 }
@@ -3205,7 +4354,7 @@ void DatabaseInterface::checkComposerTableSchema()
 
 void DatabaseInterface::checkGenreTableSchema()
 {
-    auto fieldsList = QStringList{QStringLiteral("ID"), QStringLiteral("Name")};
+    auto fieldsList = QStringList{QStringLiteral("ID"), QStringLiteral("Name"), QStringLiteral("FoldedName")};
 
     genericCheckTable(QStringLiteral("Genre"), fieldsList);
 }
@@ -3229,7 +4378,10 @@ void DatabaseInterface::checkTracksTableSchema()
                                   QStringLiteral("Lyricist"), QStringLiteral("Comment"),
                                   QStringLiteral("Year"), QStringLiteral("Channels"),
                                   QStringLiteral("BitRate"), QStringLiteral("SampleRate"),
-                                  QStringLiteral("HasEmbeddedCover")};
+                                  QStringLiteral("HasEmbeddedCover"), QStringLiteral("ReplayGainTrackGain"),
+                                  QStringLiteral("ReplayGainTrackPeak"), QStringLiteral("ReplayGainAlbumGain"),
+                                  QStringLiteral("ReplayGainAlbumPeak"), QStringLiteral("FoldedTitle"),
+                                  QStringLiteral("FoldedArtistName"), QStringLiteral("FoldedAlbumTitle")};
 
     genericCheckTable(QStringLiteral("Tracks"), fieldsList);
 }
@@ -3243,6 +4395,37 @@ void DatabaseInterface::checkTracksDataTableSchema()
     genericCheckTable(QStringLiteral("TracksData"), fieldsList);
 }
 
+void DatabaseInterface::checkChangeJournalTableSchema()
+{
+    auto fieldsList = QStringList{QStringLiteral("Generation"), QStringLiteral("EntityType"),
+                                  QStringLiteral("EntityId"), QStringLiteral("ChangeType")};
+
+    genericCheckTable(QStringLiteral("ChangeJournal"), fieldsList);
+}
+
+void DatabaseInterface::checkChangeJournalConsumersTableSchema()
+{
+    auto fieldsList = QStringList{QStringLiteral("Name"), QStringLiteral("Generation")};
+
+    genericCheckTable(QStringLiteral("ChangeJournalConsumers"), fieldsList);
+}
+
+void DatabaseInterface::checkPlayStatsTableSchema()
+{
+    auto fieldsList = QStringList{QStringLiteral("FileName"), QStringLiteral("Score")};
+
+    genericCheckTable(QStringLiteral("PlayStats"), fieldsList);
+}
+
+void DatabaseInterface::checkRadiosHistoryTableSchema()
+{
+    auto fieldsList = QStringList{QStringLiteral("ID"), QStringLiteral("RadioID"),
+                                  QStringLiteral("Title"), QStringLiteral("NowPlaying"),
+                                  QStringLiteral("PlayDate")};
+
+    genericCheckTable(QStringLiteral("RadiosHistory"), fieldsList);
+}
+
 void DatabaseInterface::genericCheckTable(const QString &tableName, const QStringList &expectedColumns)
 {
     auto columnsList = d->mTracksDatabase.record(tableName);
@@ -3306,7 +4489,7 @@ void DatabaseInterface::manageNewDatabaseVersion()
         if(d->mSelectDatabaseVersionQuery.next()) {
             const auto &currentRecord = d->mSelectDatabaseVersionQuery.record();
 
-            versionBegin = currentRecord.value(0).toInt();
+            versionBegin = currentRecord.value(0).toInt() + 1;
         }
     } else if (listTables.contains(QLatin1String("DatabaseVersionV5")) &&
                !listTables.contains(QLatin1String("DatabaseVersionV9"))) {
@@ -3334,19 +4517,21 @@ void DatabaseInterface::manageNewDatabaseVersion()
     }
 
     int version = versionBegin;
-    for (; version-1 != DatabaseInterface::V16; version++) {
+    for (; version <= DatabaseInterface::V21; version++) {
         callUpgradeFunctionForVersion(static_cast<DatabaseVersion>(version));
     }
 
-    if (version-1 != versionBegin) {
-        dropTable(QStringLiteral("DROP TABLE DatabaseVersionV9"));
-        dropTable(QStringLiteral("DROP TABLE DatabaseVersionV11"));
-        dropTable(QStringLiteral("DROP TABLE DatabaseVersionV12"));
-        dropTable(QStringLiteral("DROP TABLE DatabaseVersionV13"));
-        dropTable(QStringLiteral("DROP TABLE DatabaseVersionV14"));
-    }
+    // a database written by a newer version keeps its version
+    if (version != versionBegin) {
+        // only a database upgraded from the legacy version tables still has them
+        dropTable(QStringLiteral("DROP TABLE IF EXISTS DatabaseVersionV9"));
+        dropTable(QStringLiteral("DROP TABLE IF EXISTS DatabaseVersionV11"));
+        dropTable(QStringLiteral("DROP TABLE IF EXISTS DatabaseVersionV12"));
+        dropTable(QStringLiteral("DROP TABLE IF EXISTS DatabaseVersionV13"));
+        dropTable(QStringLiteral("DROP TABLE IF EXISTS DatabaseVersionV14"));
 
-    setDatabaseVersionInTable(DatabaseInterface::V16);
+        setDatabaseVersionInTable(DatabaseInterface::V21);
+    }
 
     checkDatabaseSchema();
 }
@@ -3456,6 +4641,21 @@ void DatabaseInterface::callUpgradeFunctionForVersion(DatabaseVersion databaseVe
     case DatabaseInterface::V16:
         upgradeDatabaseV16();
         break;
+    case DatabaseInterface::V17:
+        upgradeDatabaseV17();
+        break;
+    case DatabaseInterface::V18:
+        upgradeDatabaseV18();
+        break;
+    case DatabaseInterface::V19:
+        upgradeDatabaseV19();
+        break;
+    case DatabaseInterface::V20:
+        upgradeDatabaseV20();
+        break;
+    case DatabaseInterface::V21:
+        upgradeDatabaseV21();
+        break;
     }
 }
 
@@ -3548,11 +4748,12 @@ void DatabaseInterface::initRequest()
     }
 
     {
-        auto selectAllGenresText = QStringLiteral("SELECT "
-                                                  "genre.`ID`, "
-                                                  "genre.`Name` "
-                                                  "FROM `Genre` genre "
-                                                  "ORDER BY genre.`Name` COLLATE NOCASE");
+        d->mSelectAllGenresText = QStringLiteral("SELECT "
+                                                 "genre.`ID`, "
+                                                 "genre.`Name` "
+                                                 "FROM `Genre` genre ");
+
+        auto selectAllGenresText = d->mSelectAllGenresText + QStringLiteral("ORDER BY genre.`Name` COLLATE NOCASE");
 
         auto result = prepareQuery(d->mSelectAllGenresQuery, selectAllGenresText);
 
@@ -3565,58 +4766,59 @@ void DatabaseInterface::initRequest()
     }
 
     {
-        auto selectAllAlbumsText = QStringLiteral("SELECT "
-                                                  "album.`ID`, "
-                                                  "album.`Title`, "
-                                                  "album.`ArtistName` as SecondaryText, "
-                                                  "album.`CoverFileName`, "
-                                                  "album.`ArtistName`, "
-                                                  "COUNT(DISTINCT tracks.`ArtistName`) as ArtistsCount, "
-                                                  "GROUP_CONCAT(tracks.`ArtistName`, ', ') as AllArtists, "
-                                                  "MAX(tracks.`Rating`) as HighestRating, "
-                                                  "GROUP_CONCAT(genres.`Name`, ', ') as AllGenres, "
-                                                  "("
-                                                  "SELECT "
-                                                  "COUNT(DISTINCT tracks2.DiscNumber) <= 1 "
-                                                  "FROM "
-                                                  "`Tracks` tracks2 "
-                                                  "WHERE "
-                                                  "tracks2.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracks2.`AlbumArtistName` = album.`ArtistName` OR "
-                                                  "(tracks2.`AlbumArtistName` IS NULL AND "
-                                                  "album.`ArtistName` IS NULL"
-                                                  ")"
-                                                  ") AND "
-                                                  "tracks2.`AlbumPath` = album.`AlbumPath` "
-                                                  ") as `IsSingleDiscAlbum`, "
-                                                  "( "
-                                                  "SELECT tracksCover.`FileName` "
-                                                  "FROM "
-                                                  "`Tracks` tracksCover "
-                                                  "WHERE "
-                                                  "tracksCover.`HasEmbeddedCover` = 1 AND "
-                                                  "tracksCover.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracksCover.`AlbumArtistName` = album.`ArtistName` OR "
-                                                  "(tracksCover.`AlbumArtistName` IS NULL AND "
-                                                  "album.`ArtistName` IS NULL "
-                                                  ") "
-                                                  ") AND "
-                                                  "tracksCover.`AlbumPath` = album.`AlbumPath` "
-                                                  ") as EmbeddedCover "
-                                                  "FROM "
-                                                  "`Albums` album, "
-                                                  "`Tracks` tracks LEFT JOIN "
-                                                  "`Genre` genres ON tracks.`Genre` = genres.`Name` "
-                                                  "WHERE "
-                                                  "tracks.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracks.`AlbumArtistName` = album.`ArtistName` OR "
-                                                  "(tracks.`AlbumArtistName` IS NULL AND "
-                                                  "album.`ArtistName` IS NULL"
-                                                  ") "
-                                                  ") AND "
-                                                  "tracks.`AlbumPath` = album.`AlbumPath` "
-                                                  "GROUP BY album.`ID`, album.`Title`, album.`AlbumPath` "
-                                                  "ORDER BY album.`Title` COLLATE NOCASE");
+        d->mSelectAllAlbumsText = QStringLiteral("SELECT "
+                                                 "album.`ID`, "
+                                                 "album.`Title`, "
+                                                 "album.`ArtistName` as SecondaryText, "
+                                                 "album.`CoverFileName`, "
+                                                 "album.`ArtistName`, "
+                                                 "COUNT(DISTINCT tracks.`ArtistName`) as ArtistsCount, "
+                                                 "GROUP_CONCAT(tracks.`ArtistName`, ', ') as AllArtists, "
+                                                 "MAX(tracks.`Rating`) as HighestRating, "
+                                                 "GROUP_CONCAT(genres.`Name`, ', ') as AllGenres, "
+                                                 "("
+                                                 "SELECT "
+                                                 "COUNT(DISTINCT tracks2.DiscNumber) <= 1 "
+                                                 "FROM "
+                                                 "`Tracks` tracks2 "
+                                                 "WHERE "
+                                                 "tracks2.`AlbumTitle` = album.`Title` AND "
+                                                 "(tracks2.`AlbumArtistName` = album.`ArtistName` OR "
+                                                 "(tracks2.`AlbumArtistName` IS NULL AND "
+                                                 "album.`ArtistName` IS NULL"
+                                                 ")"
+                                                 ") AND "
+                                                 "tracks2.`AlbumPath` = album.`AlbumPath` "
+                                                 ") as `IsSingleDiscAlbum`, "
+                                                 "( "
+                                                 "SELECT tracksCover.`FileName` "
+                                                 "FROM "
+                                                 "`Tracks` tracksCover "
+                                                 "WHERE "
+                                                 "tracksCover.`HasEmbeddedCover` = 1 AND "
+                                                 "tracksCover.`AlbumTitle` = album.`Title` AND "
+                                                 "(tracksCover.`AlbumArtistName` = album.`ArtistName` OR "
+                                                 "(tracksCover.`AlbumArtistName` IS NULL AND "
+                                                 "album.`ArtistName` IS NULL "
+                                                 ") "
+                                                 ") AND "
+                                                 "tracksCover.`AlbumPath` = album.`AlbumPath` "
+                                                 ") as EmbeddedCover "
+                                                 "FROM "
+                                                 "`Albums` album, "
+                                                 "`Tracks` tracks LEFT JOIN "
+                                                 "`Genre` genres ON tracks.`Genre` = genres.`Name` "
+                                                 "WHERE "
+                                                 "tracks.`AlbumTitle` = album.`Title` AND "
+                                                 "(tracks.`AlbumArtistName` = album.`ArtistName` OR "
+                                                 "(tracks.`AlbumArtistName` IS NULL AND "
+                                                 "album.`ArtistName` IS NULL"
+                                                 ") "
+                                                 ") AND "
+                                                 "tracks.`AlbumPath` = album.`AlbumPath` "
+                                                 "GROUP BY album.`ID`, album.`Title`, album.`AlbumPath` ");
+
+        auto selectAllAlbumsText = d->mSelectAllAlbumsText + QStringLiteral("ORDER BY album.`Title` COLLATE NOCASE");
 
         auto result = prepareQuery(d->mSelectAllAlbumsShortQuery, selectAllAlbumsText);
 
@@ -3788,14 +4990,15 @@ void DatabaseInterface::initRequest()
     }
 
     {
-        auto selectAllArtistsWithFilterText = QStringLiteral("SELECT artists.`ID`, "
-                                                             "artists.`Name`, "
-                                                             "GROUP_CONCAT(genres.`Name`, ', ') as AllGenres "
-                                                             "FROM `Artists` artists  LEFT JOIN "
-                                                             "`Tracks` tracks ON artists.`Name` = tracks.`ArtistName` LEFT JOIN "
-                                                             "`Genre` genres ON tracks.`Genre` = genres.`Name` "
-                                                             "GROUP BY artists.`ID` "
-                                                             "ORDER BY artists.`Name` COLLATE NOCASE");
+        d->mSelectAllArtistsText = QStringLiteral("SELECT artists.`ID`, "
+                                                  "artists.`Name`, "
+                                                  "GROUP_CONCAT(genres.`Name`, ', ') as AllGenres "
+                                                  "FROM `Artists` artists  LEFT JOIN "
+                                                  "`Tracks` tracks ON artists.`Name` = tracks.`ArtistName` LEFT JOIN "
+                                                  "`Genre` genres ON tracks.`Genre` = genres.`Name` "
+                                                  "GROUP BY artists.`ID` ");
+
+        auto selectAllArtistsWithFilterText = d->mSelectAllArtistsText + QStringLiteral("ORDER BY artists.`Name` COLLATE NOCASE");
 
         auto result = prepareQuery(d->mSelectAllArtistsQuery, selectAllArtistsWithFilterText);
 
@@ -3858,163 +5061,163 @@ void DatabaseInterface::initRequest()
 
         auto result = prepareQuery(d->mArtistMatchGenreQuery, artistMatchGenreText);
 
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mArtistMatchGenreQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mArtistMatchGenreQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
-    }
-
-    {
-        auto selectAllComposersWithFilterText = QStringLiteral("SELECT `ID`, "
-                                                               "`Name` "
-                                                               "FROM `Artists` "
-                                                               "ORDER BY `Name` COLLATE NOCASE");
-
-        auto result = prepareQuery(d->mSelectAllComposersQuery, selectAllComposersWithFilterText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllComposersQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllComposersQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
-    }
-
-    {
-        auto selectAllLyricistsWithFilterText = QStringLiteral("SELECT `ID`, "
-                                                               "`Name` "
-                                                               "FROM `Lyricist` "
-                                                               "ORDER BY `Name` COLLATE NOCASE");
-
-        auto result = prepareQuery(d->mSelectAllLyricistsQuery, selectAllLyricistsWithFilterText);
-
-        if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllLyricistsQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllLyricistsQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
-    }
-
-    {
-        auto selectAllTracksText = QStringLiteral("SELECT "
-                                                  "tracks.`ID`, "
-                                                  "tracks.`Title`, "
-                                                  "album.`ID`, "
-                                                  "tracks.`ArtistName`, "
-                                                  "( "
-                                                  "SELECT "
-                                                  "COUNT(DISTINCT tracksFromAlbum1.`ArtistName`) "
-                                                  "FROM "
-                                                  "`Tracks` tracksFromAlbum1 "
-                                                  "WHERE "
-                                                  "tracksFromAlbum1.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracksFromAlbum1.`AlbumArtistName` = album.`ArtistName` OR "
-                                                  "(tracksFromAlbum1.`AlbumArtistName` IS NULL AND "
-                                                  "album.`ArtistName` IS NULL "
-                                                  ") "
-                                                  ") AND "
-                                                  "tracksFromAlbum1.`AlbumPath` = album.`AlbumPath` "
-                                                  ") AS ArtistsCount, "
-                                                  "( "
-                                                  "SELECT "
-                                                  "GROUP_CONCAT(tracksFromAlbum2.`ArtistName`) "
-                                                  "FROM "
-                                                  "`Tracks` tracksFromAlbum2 "
-                                                  "WHERE "
-                                                  "tracksFromAlbum2.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracksFromAlbum2.`AlbumArtistName` = album.`ArtistName` OR "
-                                                  "(tracksFromAlbum2.`AlbumArtistName` IS NULL AND "
-                                                  "album.`ArtistName` IS NULL "
-                                                  ") "
-                                                  ") AND "
-                                                  "tracksFromAlbum2.`AlbumPath` = album.`AlbumPath` "
-                                                  ") AS AllArtists, "
-                                                  "tracks.`AlbumArtistName`, "
-                                                  "tracksMapping.`FileName`, "
-                                                  "tracksMapping.`FileModifiedTime`, "
-                                                  "tracks.`TrackNumber`, "
-                                                  "tracks.`DiscNumber`, "
-                                                  "tracks.`Duration`, "
-                                                  "tracks.`AlbumTitle`, "
-                                                  "tracks.`Rating`, "
-                                                  "album.`CoverFileName`, "
-                                                  "("
-                                                  "SELECT "
-                                                  "COUNT(DISTINCT tracks2.DiscNumber) <= 1 "
-                                                  "FROM "
-                                                  "`Tracks` tracks2 "
-                                                  "WHERE "
-                                                  "tracks2.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracks2.`AlbumArtistName` = album.`ArtistName` OR "
-                                                  "(tracks2.`AlbumArtistName` IS NULL AND "
-                                                  "album.`ArtistName` IS NULL"
-                                                  ")"
-                                                  ") AND "
-                                                  "tracks2.`AlbumPath` = album.`AlbumPath` "
-                                                  ") as `IsSingleDiscAlbum`, "
-                                                  "trackGenre.`Name`, "
-                                                  "trackComposer.`Name`, "
-                                                  "trackLyricist.`Name`, "
-                                                  "tracks.`Comment`, "
-                                                  "tracks.`Year`, "
-                                                  "tracks.`Channels`, "
-                                                  "tracks.`BitRate`, "
-                                                  "tracks.`SampleRate`, "
-                                                  "tracks.`HasEmbeddedCover`, "
-                                                  "tracksMapping.`ImportDate`, "
-                                                  "tracksMapping.`FirstPlayDate`, "
-                                                  "tracksMapping.`LastPlayDate`, "
-                                                  "tracksMapping.`PlayCounter`, "
-                                                  "tracksMapping.`PlayCounter` / (strftime('%s', 'now') - tracksMapping.`FirstPlayDate`) as PlayFrequency, "
-                                                  "( "
-                                                  "SELECT tracksCover.`FileName` "
-                                                  "FROM "
-                                                  "`Tracks` tracksCover "
-                                                  "WHERE "
-                                                  "tracksCover.`HasEmbeddedCover` = 1 AND "
-                                                  "tracksCover.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracksCover.`AlbumArtistName` = album.`ArtistName` OR "
-                                                  "(tracksCover.`AlbumArtistName` IS NULL AND "
-                                                  "album.`ArtistName` IS NULL "
-                                                  ") "
-                                                  ") AND "
-                                                  "tracksCover.`AlbumPath` = album.`AlbumPath` "
-                                                  ") as EmbeddedCover "
-                                                  "FROM "
-                                                  "`TracksData` tracksMapping "
-                                                  "LEFT JOIN "
-                                                  "`Tracks` tracks "
-                                                  "ON "
-                                                  "tracksMapping.`FileName` = tracks.`FileName` "
-                                                  "LEFT JOIN "
-                                                  "`Albums` album "
-                                                  "ON "
-                                                  "tracks.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL ) AND "
-                                                  "tracks.`AlbumPath` = album.`AlbumPath` "
-                                                  "LEFT JOIN `Genre` trackGenre ON trackGenre.`Name` = tracks.`Genre` "
-                                                  "LEFT JOIN `Composer` trackComposer ON trackComposer.`Name` = tracks.`Composer` "
-                                                  "LEFT JOIN `Lyricist` trackLyricist ON trackLyricist.`Name` = tracks.`Lyricist` "
-                                                  "WHERE "
-                                                  "tracks.`Title` IS NULL OR "
-                                                  "tracks.`Priority` = ("
-                                                  "     SELECT "
-                                                  "     MIN(`Priority`) "
-                                                  "     FROM "
-                                                  "     `Tracks` tracks2 "
-                                                  "     WHERE "
-                                                  "     tracks.`Title` = tracks2.`Title` AND "
-                                                  "     (tracks.`ArtistName` IS NULL OR tracks.`ArtistName` = tracks2.`ArtistName`) AND "
-                                                  "     (tracks.`AlbumTitle` IS NULL OR tracks.`AlbumTitle` = tracks2.`AlbumTitle`) AND "
-                                                  "     (tracks.`AlbumArtistName` IS NULL OR tracks.`AlbumArtistName` = tracks2.`AlbumArtistName`) AND "
-                                                  "     (tracks.`AlbumPath` IS NULL OR tracks.`AlbumPath` = tracks2.`AlbumPath`)"
-                                                  ")"
-                                                  "");
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mArtistMatchGenreQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mArtistMatchGenreQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto selectAllComposersWithFilterText = QStringLiteral("SELECT `ID`, "
+                                                               "`Name` "
+                                                               "FROM `Artists` "
+                                                               "ORDER BY `Name` COLLATE NOCASE");
+
+        auto result = prepareQuery(d->mSelectAllComposersQuery, selectAllComposersWithFilterText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllComposersQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllComposersQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto selectAllLyricistsWithFilterText = QStringLiteral("SELECT `ID`, "
+                                                               "`Name` "
+                                                               "FROM `Lyricist` "
+                                                               "ORDER BY `Name` COLLATE NOCASE");
+
+        auto result = prepareQuery(d->mSelectAllLyricistsQuery, selectAllLyricistsWithFilterText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllLyricistsQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllLyricistsQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
 
-        auto result = prepareQuery(d->mSelectAllTracksQuery, selectAllTracksText);
+    {
+        d->mSelectAllTracksText = QStringLiteral("SELECT "
+                                                 "tracks.`ID`, "
+                                                 "tracks.`Title`, "
+                                                 "album.`ID`, "
+                                                 "tracks.`ArtistName`, "
+                                                 "( "
+                                                 "SELECT "
+                                                 "COUNT(DISTINCT tracksFromAlbum1.`ArtistName`) "
+                                                 "FROM "
+                                                 "`Tracks` tracksFromAlbum1 "
+                                                 "WHERE "
+                                                 "tracksFromAlbum1.`AlbumTitle` = album.`Title` AND "
+                                                 "(tracksFromAlbum1.`AlbumArtistName` = album.`ArtistName` OR "
+                                                 "(tracksFromAlbum1.`AlbumArtistName` IS NULL AND "
+                                                 "album.`ArtistName` IS NULL "
+                                                 ") "
+                                                 ") AND "
+                                                 "tracksFromAlbum1.`AlbumPath` = album.`AlbumPath` "
+                                                 ") AS ArtistsCount, "
+                                                 "( "
+                                                 "SELECT "
+                                                 "GROUP_CONCAT(tracksFromAlbum2.`ArtistName`) "
+                                                 "FROM "
+                                                 "`Tracks` tracksFromAlbum2 "
+                                                 "WHERE "
+                                                 "tracksFromAlbum2.`AlbumTitle` = album.`Title` AND "
+                                                 "(tracksFromAlbum2.`AlbumArtistName` = album.`ArtistName` OR "
+                                                 "(tracksFromAlbum2.`AlbumArtistName` IS NULL AND "
+                                                 "album.`ArtistName` IS NULL "
+                                                 ") "
+                                                 ") AND "
+                                                 "tracksFromAlbum2.`AlbumPath` = album.`AlbumPath` "
+                                                 ") AS AllArtists, "
+                                                 "tracks.`AlbumArtistName`, "
+                                                 "tracksMapping.`FileName`, "
+                                                 "tracksMapping.`FileModifiedTime`, "
+                                                 "tracks.`TrackNumber`, "
+                                                 "tracks.`DiscNumber`, "
+                                                 "tracks.`Duration`, "
+                                                 "tracks.`AlbumTitle`, "
+                                                 "tracks.`Rating`, "
+                                                 "album.`CoverFileName`, "
+                                                 "("
+                                                 "SELECT "
+                                                 "COUNT(DISTINCT tracks2.DiscNumber) <= 1 "
+                                                 "FROM "
+                                                 "`Tracks` tracks2 "
+                                                 "WHERE "
+                                                 "tracks2.`AlbumTitle` = album.`Title` AND "
+                                                 "(tracks2.`AlbumArtistName` = album.`ArtistName` OR "
+                                                 "(tracks2.`AlbumArtistName` IS NULL AND "
+                                                 "album.`ArtistName` IS NULL"
+                                                 ")"
+                                                 ") AND "
+                                                 "tracks2.`AlbumPath` = album.`AlbumPath` "
+                                                 ") as `IsSingleDiscAlbum`, "
+                                                 "trackGenre.`Name`, "
+                                                 "trackComposer.`Name`, "
+                                                 "trackLyricist.`Name`, "
+                                                 "tracks.`Comment`, "
+                                                 "tracks.`Year`, "
+                                                 "tracks.`Channels`, "
+                                                 "tracks.`BitRate`, "
+                                                 "tracks.`SampleRate`, "
+                                                 "tracks.`HasEmbeddedCover`, "
+                                                 "tracksMapping.`ImportDate`, "
+                                                 "tracksMapping.`FirstPlayDate`, "
+                                                 "tracksMapping.`LastPlayDate`, "
+                                                 "tracksMapping.`PlayCounter`, "
+                                                 "(SELECT playStats.`Score` FROM `PlayStats` playStats WHERE playStats.`FileName` = tracksMapping.`FileName`) as PlayFrequency, "
+                                                 "( "
+                                                 "SELECT tracksCover.`FileName` "
+                                                 "FROM "
+                                                 "`Tracks` tracksCover "
+                                                 "WHERE "
+                                                 "tracksCover.`HasEmbeddedCover` = 1 AND "
+                                                 "tracksCover.`AlbumTitle` = album.`Title` AND "
+                                                 "(tracksCover.`AlbumArtistName` = album.`ArtistName` OR "
+                                                 "(tracksCover.`AlbumArtistName` IS NULL AND "
+                                                 "album.`ArtistName` IS NULL "
+                                                 ") "
+                                                 ") AND "
+                                                 "tracksCover.`AlbumPath` = album.`AlbumPath` "
+                                                 ") as EmbeddedCover "
+                                                 "FROM "
+                                                 "`TracksData` tracksMapping "
+                                                 "LEFT JOIN "
+                                                 "`Tracks` tracks "
+                                                 "ON "
+                                                 "tracksMapping.`FileName` = tracks.`FileName` "
+                                                 "LEFT JOIN "
+                                                 "`Albums` album "
+                                                 "ON "
+                                                 "tracks.`AlbumTitle` = album.`Title` AND "
+                                                 "(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL ) AND "
+                                                 "tracks.`AlbumPath` = album.`AlbumPath` "
+                                                 "LEFT JOIN `Genre` trackGenre ON trackGenre.`Name` = tracks.`Genre` "
+                                                 "LEFT JOIN `Composer` trackComposer ON trackComposer.`Name` = tracks.`Composer` "
+                                                 "LEFT JOIN `Lyricist` trackLyricist ON trackLyricist.`Name` = tracks.`Lyricist` "
+                                                 "WHERE ("
+                                                 "tracks.`Title` IS NULL OR "
+                                                 "tracks.`Priority` = ("
+                                                 "     SELECT "
+                                                 "     MIN(`Priority`) "
+                                                 "     FROM "
+                                                 "     `Tracks` tracks2 "
+                                                 "     WHERE "
+                                                 "     tracks.`Title` = tracks2.`Title` AND "
+                                                 "     (tracks.`ArtistName` IS NULL OR tracks.`ArtistName` = tracks2.`ArtistName`) AND "
+                                                 "     (tracks.`AlbumTitle` IS NULL OR tracks.`AlbumTitle` = tracks2.`AlbumTitle`) AND "
+                                                 "     (tracks.`AlbumArtistName` IS NULL OR tracks.`AlbumArtistName` = tracks2.`AlbumArtistName`) AND "
+                                                 "     (tracks.`AlbumPath` IS NULL OR tracks.`AlbumPath` = tracks2.`AlbumPath`)"
+                                                 ")"
+                                                 ") ");
+
+        auto result = prepareQuery(d->mSelectAllTracksQuery, d->mSelectAllTracksText);
 
         if (!result) {
             qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllTracksQuery.lastQuery();
@@ -4118,7 +5321,7 @@ void DatabaseInterface::initRequest()
                                                   "tracksMapping.`FirstPlayDate`, "
                                                   "tracksMapping.`LastPlayDate`, "
                                                   "tracksMapping.`PlayCounter`, "
-                                                  "tracksMapping.`PlayCounter` / (strftime('%s', 'now') - tracksMapping.`FirstPlayDate`) as PlayFrequency, "
+                                                  "(SELECT playStats.`Score` FROM `PlayStats` playStats WHERE playStats.`FileName` = tracksMapping.`FileName`) as PlayFrequency, "
                                                   "( "
                                                   "SELECT tracksCover.`FileName` "
                                                   "FROM "
@@ -4243,7 +5446,7 @@ void DatabaseInterface::initRequest()
                                                   "tracksMapping.`FirstPlayDate`, "
                                                   "tracksMapping.`LastPlayDate`, "
                                                   "tracksMapping.`PlayCounter`, "
-                                                  "CAST(tracksMapping.`PlayCounter` AS REAL) / ((CAST(strftime('%s','now') as INTEGER) - CAST(tracksMapping.`FirstPlayDate` / 1000 as INTEGER)) / CAST(1000 AS REAL)) as PlayFrequency, "
+                                                  "playStats.`Score` as PlayFrequency, "
                                                   "( "
                                                   "SELECT tracksCover.`FileName` "
                                                   "FROM "
@@ -4259,8 +5462,9 @@ void DatabaseInterface::initRequest()
                                                   "tracksCover.`AlbumPath` = album.`AlbumPath` "
                                                   ") as EmbeddedCover "
                                                   "FROM "
-                                                  "`Tracks` tracks, "
-                                                  "`TracksData` tracksMapping "
+                                                  "`PlayStats` playStats "
+                                                  "CROSS JOIN `TracksData` tracksMapping "
+                                                  "CROSS JOIN `Tracks` tracks "
                                                   "LEFT JOIN "
                                                   "`Albums` album "
                                                   "ON "
@@ -4271,8 +5475,8 @@ void DatabaseInterface::initRequest()
                                                   "LEFT JOIN `Composer` trackComposer ON trackComposer.`Name` = tracks.`Composer` "
                                                   "LEFT JOIN `Lyricist` trackLyricist ON trackLyricist.`Name` = tracks.`Lyricist` "
                                                   "WHERE "
+                                                  "playStats.`FileName` = tracksMapping.`FileName` AND "
                                                   "tracksMapping.`FileName` = tracks.`FileName` AND "
-                                                  "tracksMapping.`PlayCounter` > 0 AND "
                                                   "tracks.`Priority` = ("
                                                   "     SELECT "
                                                   "     MIN(`Priority`) "
@@ -4285,7 +5489,7 @@ void DatabaseInterface::initRequest()
                                                   "     (tracks.`AlbumArtistName` IS NULL OR tracks.`AlbumArtistName` = tracks2.`AlbumArtistName`) AND "
                                                   "     (tracks.`AlbumPath` IS NULL OR tracks.`AlbumPath` = tracks2.`AlbumPath`)"
                                                   ")"
-                                                  "ORDER BY CAST(tracksMapping.`PlayCounter` AS REAL) / ((CAST(strftime('%s','now') as INTEGER) - CAST(tracksMapping.`FirstPlayDate` / 1000 as INTEGER)) / CAST(1000 AS REAL)) DESC "
+                                                  "ORDER BY playStats.`Score` DESC "
                                                   "LIMIT :maximumResults");
 
         auto result = prepareQuery(d->mSelectAllFrequentlyPlayedTracksQuery, selectAllTracksText);
@@ -4514,8 +5718,8 @@ void DatabaseInterface::initRequest()
     }
 
     {
-        auto insertArtistsText = QStringLiteral("INSERT INTO `Artists` (`ID`, `Name`) "
-                                                "VALUES (:artistId, :name)");
+        auto insertArtistsText = QStringLiteral("INSERT INTO `Artists` (`ID`, `Name`, `FoldedName`) "
+                                                "VALUES (:artistId, :name, :foldedName)");
 
         auto result = prepareQuery(d->mInsertArtistsQuery, insertArtistsText);
 
@@ -4528,8 +5732,8 @@ void DatabaseInterface::initRequest()
     }
 
     {
-        auto insertGenreText = QStringLiteral("INSERT INTO `Genre` (`ID`, `Name`) "
-                                              "VALUES (:genreId, :name)");
+        auto insertGenreText = QStringLiteral("INSERT INTO `Genre` (`ID`, `Name`, `FoldedName`) "
+                                              "VALUES (:genreId, :name, :foldedName)");
 
         auto result = prepareQuery(d->mInsertGenreQuery, insertGenreText);
 
@@ -4635,7 +5839,7 @@ void DatabaseInterface::initRequest()
                                                    "tracksMapping.`FirstPlayDate`, "
                                                    "tracksMapping.`LastPlayDate`, "
                                                    "tracksMapping.`PlayCounter`, "
-                                                   "tracksMapping.`PlayCounter` / (strftime('%s', 'now') - tracksMapping.`FirstPlayDate`) as PlayFrequency, "
+                                                   "(SELECT playStats.`Score` FROM `PlayStats` playStats WHERE playStats.`FileName` = tracksMapping.`FileName`) as PlayFrequency, "
                                                    "( "
                                                    "SELECT tracksCover.`FileName` "
                                                    "FROM "
@@ -4802,7 +6006,7 @@ void DatabaseInterface::initRequest()
                                                          "tracksMapping.`FirstPlayDate`, "
                                                          "tracksMapping.`LastPlayDate`, "
                                                          "tracksMapping.`PlayCounter`, "
-                                                         "tracksMapping.`PlayCounter` / (strftime('%s', 'now') - tracksMapping.`FirstPlayDate`) as PlayFrequency, "
+                                                         "(SELECT playStats.`Score` FROM `PlayStats` playStats WHERE playStats.`FileName` = tracksMapping.`FileName`) as PlayFrequency, "
                                                          "( "
                                                          "SELECT tracksCover.`FileName` "
                                                          "FROM "
@@ -4926,7 +6130,7 @@ void DatabaseInterface::initRequest()
                                                          "tracksMapping.`FirstPlayDate`, "
                                                          "tracksMapping.`LastPlayDate`, "
                                                          "tracksMapping.`PlayCounter`, "
-                                                         "tracksMapping.`PlayCounter` / (strftime('%s', 'now') - tracksMapping.`FirstPlayDate`) as PlayFrequency, "
+                                                         "(SELECT playStats.`Score` FROM `PlayStats` playStats WHERE playStats.`FileName` = tracksMapping.`FileName`) as PlayFrequency, "
                                                          "( "
                                                          "SELECT tracksCover.`FileName` "
                                                          "FROM "
@@ -5166,13 +6370,17 @@ void DatabaseInterface::initRequest()
                                                    "`Title`, "
                                                    "`ArtistName`, "
                                                    "`AlbumPath`, "
-                                                   "`CoverFileName`) "
+                                                   "`CoverFileName`, "
+                                                   "`FoldedTitle`, "
+                                                   "`FoldedArtistName`) "
                                                    "VALUES "
                                                    "(:albumId, "
                                                    ":title, "
                                                    ":albumArtist, "
                                                    ":albumPath, "
-                                                   ":coverFileName)");
+                                                   ":coverFileName, "
+                                                   ":foldedTitle, "
+                                                   ":foldedAlbumArtist)");
 
         auto result = prepareQuery(d->mInsertAlbumQuery, insertAlbumQueryText);
 
@@ -5333,7 +6541,7 @@ void DatabaseInterface::initRequest()
                                                                   "tracksMapping.`FirstPlayDate`, "
                                                                   "tracksMapping.`LastPlayDate`, "
                                                                   "tracksMapping.`PlayCounter`, "
-                                                                  "tracksMapping.`PlayCounter` / (strftime('%s', 'now') - tracksMapping.`FirstPlayDate`) as PlayFrequency, "
+                                                                  "(SELECT playStats.`Score` FROM `PlayStats` playStats WHERE playStats.`FileName` = tracksMapping.`FileName`) as PlayFrequency, "
                                                                   "( "
                                                                   "SELECT tracksCover.`FileName` "
                                                                   "FROM "
@@ -5379,7 +6587,8 @@ void DatabaseInterface::initRequest()
                                                            "track.`ID`, "
                                                            "trackData.`FileName`, "
                                                            "track.`Priority`, "
-                                                           "trackData.`FileModifiedTime` "
+                                                           "trackData.`FileModifiedTime`, "
+                                                           "track.`Comment` "
                                                            "FROM "
                                                            "`TracksData` trackData "
                                                            "LEFT JOIN "
@@ -5566,7 +6775,10 @@ void DatabaseInterface::initRequest()
                                                    "`Year`,  "
                                                    "`Duration`, "
                                                    "`Rating`, "
-                                                   "`HasEmbeddedCover`) "
+                                                   "`HasEmbeddedCover`, "
+                                                   "`FoldedTitle`, "
+                                                   "`FoldedArtistName`, "
+                                                   "`FoldedAlbumTitle`) "
                                                    "VALUES "
                                                    "("
                                                    ":trackId, "
@@ -5589,7 +6801,10 @@ void DatabaseInterface::initRequest()
                                                    ":year, "
                                                    ":trackDuration, "
                                                    ":trackRating, "
-                                                   ":hasEmbeddedCover)");
+                                                   ":hasEmbeddedCover, "
+                                                   ":foldedTitle, "
+                                                   ":foldedArtistName, "
+                                                   ":foldedAlbumTitle)");
 
         auto result = prepareQuery(d->mInsertTrackQuery, insertTrackQueryText);
 
@@ -5621,7 +6836,14 @@ void DatabaseInterface::initRequest()
                                                    "`SampleRate` = :sampleRate, "
                                                    "`Year` = :year, "
                                                    " `Duration` = :trackDuration, "
-                                                   "`Rating` = :trackRating "
+                                                   "`Rating` = :trackRating, "
+                                                   "`ReplayGainTrackGain` = NULL, "
+                                                   "`ReplayGainTrackPeak` = NULL, "
+                                                   "`ReplayGainAlbumGain` = NULL, "
+                                                   "`ReplayGainAlbumPeak` = NULL, "
+                                                   "`FoldedTitle` = :foldedTitle, "
+                                                   "`FoldedArtistName` = :foldedArtistName, "
+                                                   "`FoldedAlbumTitle` = :foldedAlbumTitle "
                                                    "WHERE "
                                                    "`ID` = :trackId");
 
@@ -5699,7 +6921,8 @@ void DatabaseInterface::initRequest()
     {
         auto updateAlbumArtistQueryText = QStringLiteral("UPDATE `Albums` "
                                                          "SET "
-                                                         "`ArtistName` = :artistName "
+                                                         "`ArtistName` = :artistName, "
+                                                         "`FoldedArtistName` = :foldedArtistName "
                                                          "WHERE "
                                                          "`ID` = :albumId");
 
@@ -5974,7 +7197,7 @@ void DatabaseInterface::initRequest()
                                                               "tracksMapping.`FirstPlayDate`, "
                                                               "tracksMapping.`LastPlayDate`, "
                                                               "tracksMapping.`PlayCounter`, "
-                                                              "tracksMapping.`PlayCounter` / (strftime('%s', 'now') - tracksMapping.`FirstPlayDate`) as PlayFrequency, "
+                                                              "(SELECT playStats.`Score` FROM `PlayStats` playStats WHERE playStats.`FileName` = tracksMapping.`FileName`) as PlayFrequency, "
                                                               "( "
                                                               "SELECT tracksCover.`FileName` "
                                                               "FROM "
@@ -6103,7 +7326,7 @@ void DatabaseInterface::initRequest()
                                                              "tracksMapping.`FirstPlayDate`, "
                                                              "tracksMapping.`LastPlayDate`, "
                                                              "tracksMapping.`PlayCounter`, "
-                                                             "tracksMapping.`PlayCounter` / (strftime('%s', 'now') - tracksMapping.`FirstPlayDate`) as PlayFrequency, "
+                                                             "(SELECT playStats.`Score` FROM `PlayStats` playStats WHERE playStats.`FileName` = tracksMapping.`FileName`) as PlayFrequency, "
                                                              "( "
                                                              "SELECT tracksCover.`FileName` "
                                                              "FROM "
@@ -6162,6 +7385,122 @@ void DatabaseInterface::initRequest()
         }
     }
 
+    {
+        auto selectTracksFromFileNamesQueryText = QStringLiteral("SELECT "
+                                                                 "tracks.`ID`, "
+                                                                 "tracks.`Title`, "
+                                                                 "album.`ID`, "
+                                                                 "tracks.`ArtistName`, "
+                                                                 "( "
+                                                                 "SELECT "
+                                                                 "COUNT(DISTINCT tracksFromAlbum1.`ArtistName`) "
+                                                                 "FROM "
+                                                                 "`Tracks` tracksFromAlbum1 "
+                                                                 "WHERE "
+                                                                 "tracksFromAlbum1.`AlbumTitle` = album.`Title` AND "
+                                                                 "(tracksFromAlbum1.`AlbumArtistName` = album.`ArtistName` OR "
+                                                                 "(tracksFromAlbum1.`AlbumArtistName` IS NULL AND "
+                                                                 "album.`ArtistName` IS NULL "
+                                                                 ") "
+                                                                 ") AND "
+                                                                 "tracksFromAlbum1.`AlbumPath` = album.`AlbumPath` "
+                                                                 ") AS ArtistsCount, "
+                                                                 "( "
+                                                                 "SELECT "
+                                                                 "GROUP_CONCAT(tracksFromAlbum2.`ArtistName`) "
+                                                                 "FROM "
+                                                                 "`Tracks` tracksFromAlbum2 "
+                                                                 "WHERE "
+                                                                 "tracksFromAlbum2.`AlbumTitle` = album.`Title` AND "
+                                                                 "(tracksFromAlbum2.`AlbumArtistName` = album.`ArtistName` OR "
+                                                                 "(tracksFromAlbum2.`AlbumArtistName` IS NULL AND "
+                                                                 "album.`ArtistName` IS NULL "
+                                                                 ") "
+                                                                 ") AND "
+                                                                 "tracksFromAlbum2.`AlbumPath` = album.`AlbumPath` "
+                                                                 ") AS AllArtists, "
+                                                                 "tracks.`AlbumArtistName`, "
+                                                                 "tracksMapping.`FileName`, "
+                                                                 "tracksMapping.`FileModifiedTime`, "
+                                                                 "tracks.`TrackNumber`, "
+                                                                 "tracks.`DiscNumber`, "
+                                                                 "tracks.`Duration`, "
+                                                                 "tracks.`AlbumTitle`, "
+                                                                 "tracks.`Rating`, "
+                                                                 "album.`CoverFileName`, "
+                                                                 "("
+                                                                 "SELECT "
+                                                                 "COUNT(DISTINCT tracks2.DiscNumber) <= 1 "
+                                                                 "FROM "
+                                                                 "`Tracks` tracks2 "
+                                                                 "WHERE "
+                                                                 "tracks2.`AlbumTitle` = album.`Title` AND "
+                                                                 "(tracks2.`AlbumArtistName` = album.`ArtistName` OR "
+                                                                 "(tracks2.`AlbumArtistName` IS NULL AND "
+                                                                 "album.`ArtistName` IS NULL"
+                                                                 ")"
+                                                                 ") AND "
+                                                                 "tracks2.`AlbumPath` = album.`AlbumPath` "
+                                                                 ") as `IsSingleDiscAlbum`, "
+                                                                 "trackGenre.`Name`, "
+                                                                 "trackComposer.`Name`, "
+                                                                 "trackLyricist.`Name`, "
+                                                                 "tracks.`Comment`, "
+                                                                 "tracks.`Year`, "
+                                                                 "tracks.`Channels`, "
+                                                                 "tracks.`BitRate`, "
+                                                                 "tracks.`SampleRate`, "
+                                                                 "tracks.`HasEmbeddedCover`, "
+                                                                 "tracksMapping.`ImportDate`, "
+                                                                 "tracksMapping.`FirstPlayDate`, "
+                                                                 "tracksMapping.`LastPlayDate`, "
+                                                                 "tracksMapping.`PlayCounter`, "
+                                                                 "(SELECT playStats.`Score` FROM `PlayStats` playStats WHERE playStats.`FileName` = tracksMapping.`FileName`) as PlayFrequency, "
+                                                                 "( "
+                                                                 "SELECT tracksCover.`FileName` "
+                                                                 "FROM "
+                                                                 "`Tracks` tracksCover "
+                                                                 "WHERE "
+                                                                 "tracksCover.`HasEmbeddedCover` = 1 AND "
+                                                                 "tracksCover.`AlbumTitle` = album.`Title` AND "
+                                                                 "(tracksCover.`AlbumArtistName` = album.`ArtistName` OR "
+                                                                 "(tracksCover.`AlbumArtistName` IS NULL AND "
+                                                                 "album.`ArtistName` IS NULL "
+                                                                 ") "
+                                                                 ") AND "
+                                                                 "tracksCover.`AlbumPath` = album.`AlbumPath` "
+                                                                 ") as EmbeddedCover "
+                                                                 "FROM "
+                                                                 "`Tracks` tracks, "
+                                                                 "`TracksData` tracksMapping "
+                                                                 "LEFT JOIN "
+                                                                 "`Albums` album "
+                                                                 "ON "
+                                                                 "tracks.`AlbumTitle` = album.`Title` AND "
+                                                                 "(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL ) AND "
+                                                                 "tracks.`AlbumPath` = album.`AlbumPath` "
+                                                                 "LEFT JOIN `Composer` trackComposer ON trackComposer.`Name` = tracks.`Composer` "
+                                                                 "LEFT JOIN `Lyricist` trackLyricist ON trackLyricist.`Name` = tracks.`Lyricist` "
+                                                                 "LEFT JOIN `Genre` trackGenre ON trackGenre.`Name` = tracks.`Genre` "
+                                                                 "WHERE "
+                                                                 "tracksMapping.`FileName` = tracks.`FileName` AND "
+                                                                 "tracks.`FileName` IN (");
+
+        for (int fileIndex = 0; fileIndex < FileNamesQueryBatchSize; ++fileIndex) {
+            selectTracksFromFileNamesQueryText += (fileIndex == 0 ? QStringLiteral(":fileName%1") : QStringLiteral(", :fileName%1")).arg(fileIndex);
+        }
+        selectTracksFromFileNamesQueryText += QStringLiteral(")");
+
+        auto result = prepareQuery(d->mSelectTracksFromFileNames, selectTracksFromFileNamesQueryText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTracksFromFileNames.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTracksFromFileNames.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
     {
         auto selectAlbumIdsFromArtistQueryText = QStringLiteral("SELECT "
                                                                 "album.`ID` "
@@ -6205,121 +7544,432 @@ void DatabaseInterface::initRequest()
                                                              "WHERE "
                                                              "`FileName` = :fileName");
 
-        auto result = prepareQuery(d->mUpdateTrackStatistics, updateTrackStatisticsQueryText);
+        auto result = prepareQuery(d->mUpdateTrackStatistics, updateTrackStatisticsQueryText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateTrackStatistics.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateTrackStatistics.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto updateTrackFirstPlayStatisticsQueryText = QStringLiteral("UPDATE `TracksData` "
+                                                                      "SET "
+                                                                      "`FirstPlayDate` = :playDate "
+                                                                      "WHERE "
+                                                                      "`FileName` = :fileName AND "
+                                                                      "`FirstPlayDate` IS NULL");
+
+        auto result = prepareQuery(d->mUpdateTrackFirstPlayStatistics, updateTrackFirstPlayStatisticsQueryText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateTrackFirstPlayStatistics.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateTrackFirstPlayStatistics.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto selectGenreQueryText = QStringLiteral("SELECT `ID`, "
+                                                   "`Name` "
+                                                   "FROM `Genre` "
+                                                   "WHERE "
+                                                   "`ID` = :genreId");
+
+        auto result = prepareQuery(d->mSelectGenreQuery, selectGenreQueryText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectGenreQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectGenreQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto selectComposerQueryText = QStringLiteral("SELECT `ID`, "
+                                                      "`Name` "
+                                                      "FROM `Composer` "
+                                                      "WHERE "
+                                                      "`ID` = :composerId");
+
+        auto result = prepareQuery(d->mSelectComposerQuery, selectComposerQueryText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectComposerQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectComposerQuery.lastError();
+        }
+    }
+
+    {
+        auto selectLyricistQueryText = QStringLiteral("SELECT `ID`, "
+                                                      "`Name` "
+                                                      "FROM `Lyricist` "
+                                                      "WHERE "
+                                                      "`ID` = :lyricistId");
+
+        auto result = prepareQuery(d->mSelectLyricistQuery, selectLyricistQueryText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectLyricistQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectLyricistQuery.lastError();
+        }
+    }
+
+    {
+        auto removeTrackQueryText = QStringLiteral("DELETE FROM `Tracks` "
+                                                   "WHERE "
+                                                   "`ID` = :trackId");
+
+        auto result = prepareQuery(d->mRemoveTrackQuery, removeTrackQueryText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveTrackQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveTrackQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto removeAlbumQueryText = QStringLiteral("DELETE FROM `Albums` "
+                                                   "WHERE "
+                                                   "`ID` = :albumId");
+
+        auto result = prepareQuery(d->mRemoveAlbumQuery, removeAlbumQueryText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveAlbumQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveAlbumQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto removeAlbumQueryText = QStringLiteral("DELETE FROM `Artists` "
+                                                   "WHERE "
+                                                   "`ID` = :artistId");
+
+        auto result = prepareQuery(d->mRemoveArtistQuery, removeAlbumQueryText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveArtistQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveArtistQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto insertChangeJournalEntryQueryText = QStringLiteral("INSERT OR REPLACE INTO `ChangeJournal` "
+                                                                "(`EntityType`, `EntityId`, `ChangeType`) "
+                                                                "VALUES (:entityType, :entityId, :changeType)");
+
+        auto result = prepareQuery(d->mInsertChangeJournalEntryQuery, insertChangeJournalEntryQueryText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertChangeJournalEntryQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertChangeJournalEntryQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto selectChangesSinceQueryText = QStringLiteral("SELECT "
+                                                          "journal.`Generation`, "
+                                                          "journal.`EntityType`, "
+                                                          "journal.`EntityId`, "
+                                                          "journal.`ChangeType` "
+                                                          "FROM `ChangeJournal` journal "
+                                                          "WHERE "
+                                                          "journal.`Generation` > :generation "
+                                                          "ORDER BY journal.`Generation`");
+
+        auto result = prepareQuery(d->mSelectChangesSinceQuery, selectChangesSinceQueryText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectChangesSinceQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectChangesSinceQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto selectCurrentGenerationQueryText = QStringLiteral("SELECT "
+                                                               "COALESCE(MAX(journal.`Generation`), 0) "
+                                                               "FROM `ChangeJournal` journal");
+
+        auto result = prepareQuery(d->mSelectCurrentGenerationQuery, selectCurrentGenerationQueryText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectCurrentGenerationQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectCurrentGenerationQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto clearChangeJournalTableText = QStringLiteral("DELETE FROM `ChangeJournal`");
+
+        auto result = prepareQuery(d->mClearChangeJournalTable, clearChangeJournalTableText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mClearChangeJournalTable.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mClearChangeJournalTable.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto selectChangeJournalEntryQueryText = QStringLiteral("SELECT "
+                                                                "journal.`Generation`, "
+                                                                "journal.`ChangeType`, "
+                                                                "(SELECT COALESCE(MAX(consumers.`Generation`), 0) FROM `ChangeJournalConsumers` consumers) "
+                                                                "FROM `ChangeJournal` journal "
+                                                                "WHERE "
+                                                                "journal.`EntityType` = :entityType AND "
+                                                                "journal.`EntityId` = :entityId");
+
+        auto result = prepareQuery(d->mSelectChangeJournalEntryQuery, selectChangeJournalEntryQueryText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectChangeJournalEntryQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectChangeJournalEntryQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto updateChangeJournalConsumerQueryText = QStringLiteral("INSERT OR REPLACE INTO `ChangeJournalConsumers` "
+                                                                   "(`Name`, `Generation`) "
+                                                                   "VALUES (:name, :generation)");
+
+        auto result = prepareQuery(d->mUpdateChangeJournalConsumerQuery, updateChangeJournalConsumerQueryText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateChangeJournalConsumerQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateChangeJournalConsumerQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto compactChangeJournalQueryText = QStringLiteral("DELETE FROM `ChangeJournal` "
+                                                            "WHERE "
+                                                            "`ChangeType` = :removedType AND "
+                                                            "`Generation` <= (SELECT MIN(consumers.`Generation`) FROM `ChangeJournalConsumers` consumers)");
+
+        auto result = prepareQuery(d->mCompactChangeJournalQuery, compactChangeJournalQueryText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mCompactChangeJournalQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mCompactChangeJournalQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto selectPlayScoreQueryText = QStringLiteral("SELECT "
+                                                       "playStats.`Score` "
+                                                       "FROM `PlayStats` playStats "
+                                                       "WHERE "
+                                                       "playStats.`FileName` = :fileName");
+
+        auto result = prepareQuery(d->mSelectPlayScoreQuery, selectPlayScoreQueryText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectPlayScoreQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectPlayScoreQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto updatePlayScoreQueryText = QStringLiteral("INSERT OR REPLACE INTO `PlayStats` (`FileName`, `Score`) "
+                                                       "SELECT "
+                                                       "tracksMapping.`FileName`, "
+                                                       ":score "
+                                                       "FROM `TracksData` tracksMapping "
+                                                       "WHERE "
+                                                       "tracksMapping.`FileName` = :fileName");
+
+        auto result = prepareQuery(d->mUpdatePlayScoreQuery, updatePlayScoreQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateTrackStatistics.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateTrackStatistics.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdatePlayScoreQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdatePlayScoreQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto updateTrackFirstPlayStatisticsQueryText = QStringLiteral("UPDATE `TracksData` "
-                                                                      "SET "
-                                                                      "`FirstPlayDate` = :playDate "
-                                                                      "WHERE "
-                                                                      "`FileName` = :fileName AND "
-                                                                      "`FirstPlayDate` IS NULL");
+        auto selectTracksPendingLoudnessQueryText = QStringLiteral("SELECT "
+                                                                   "tracks.`ID`, "
+                                                                   "tracks.`FileName`, "
+                                                                   "album.`ID` "
+                                                                   "FROM "
+                                                                   "`Tracks` tracks "
+                                                                   "LEFT JOIN "
+                                                                   "`Albums` album "
+                                                                   "ON "
+                                                                   "tracks.`AlbumTitle` = album.`Title` AND "
+                                                                   "(tracks.`AlbumArtistName` = album.`ArtistName` OR "
+                                                                   "(tracks.`AlbumArtistName` IS NULL AND "
+                                                                   "album.`ArtistName` IS NULL"
+                                                                   ")"
+                                                                   ") AND "
+                                                                   "tracks.`AlbumPath` = album.`AlbumPath` "
+                                                                   "WHERE "
+                                                                   "tracks.`ReplayGainTrackGain` IS NULL "
+                                                                   "ORDER BY album.`ID`, tracks.`ID` "
+                                                                   "LIMIT :maximumCount");
 
-        auto result = prepareQuery(d->mUpdateTrackFirstPlayStatistics, updateTrackFirstPlayStatisticsQueryText);
+        auto result = prepareQuery(d->mSelectTracksPendingLoudnessQuery, selectTracksPendingLoudnessQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateTrackFirstPlayStatistics.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateTrackFirstPlayStatistics.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTracksPendingLoudnessQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTracksPendingLoudnessQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto selectGenreQueryText = QStringLiteral("SELECT `ID`, "
-                                                   "`Name` "
-                                                   "FROM `Genre` "
-                                                   "WHERE "
-                                                   "`ID` = :genreId");
+        auto selectAlbumTracksForLoudnessQueryText = QStringLiteral("SELECT "
+                                                                    "tracks.`ID`, "
+                                                                    "tracks.`FileName` "
+                                                                    "FROM "
+                                                                    "`Tracks` tracks, "
+                                                                    "`Albums` album "
+                                                                    "WHERE "
+                                                                    "album.`ID` = :albumId AND "
+                                                                    "tracks.`AlbumTitle` = album.`Title` AND "
+                                                                    "(tracks.`AlbumArtistName` = album.`ArtistName` OR "
+                                                                    "(tracks.`AlbumArtistName` IS NULL AND "
+                                                                    "album.`ArtistName` IS NULL"
+                                                                    ")"
+                                                                    ") AND "
+                                                                    "tracks.`AlbumPath` = album.`AlbumPath`");
 
-        auto result = prepareQuery(d->mSelectGenreQuery, selectGenreQueryText);
+        auto result = prepareQuery(d->mSelectAlbumTracksForLoudnessQuery, selectAlbumTracksForLoudnessQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectGenreQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectGenreQuery.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAlbumTracksForLoudnessQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAlbumTracksForLoudnessQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto selectComposerQueryText = QStringLiteral("SELECT `ID`, "
-                                                      "`Name` "
-                                                      "FROM `Composer` "
-                                                      "WHERE "
-                                                      "`ID` = :composerId");
+        auto updateTrackLoudnessQueryText = QStringLiteral("UPDATE `Tracks` "
+                                                           "SET "
+                                                           "`ReplayGainTrackGain` = :trackGain, "
+                                                           "`ReplayGainTrackPeak` = :trackPeak, "
+                                                           "`ReplayGainAlbumGain` = :albumGain, "
+                                                           "`ReplayGainAlbumPeak` = :albumPeak "
+                                                           "WHERE "
+                                                           "`ID` = :trackId");
 
-        auto result = prepareQuery(d->mSelectComposerQuery, selectComposerQueryText);
+        auto result = prepareQuery(d->mUpdateTrackLoudnessQuery, updateTrackLoudnessQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectComposerQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectComposerQuery.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateTrackLoudnessQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateTrackLoudnessQuery.lastError();
+
+            Q_EMIT databaseError();
         }
     }
 
     {
-        auto selectLyricistQueryText = QStringLiteral("SELECT `ID`, "
-                                                      "`Name` "
-                                                      "FROM `Lyricist` "
-                                                      "WHERE "
-                                                      "`ID` = :lyricistId");
+        auto selectTrackReplayGainQueryText = QStringLiteral("SELECT "
+                                                             "tracks.`ReplayGainTrackGain`, "
+                                                             "tracks.`ReplayGainTrackPeak`, "
+                                                             "tracks.`ReplayGainAlbumGain`, "
+                                                             "tracks.`ReplayGainAlbumPeak` "
+                                                             "FROM "
+                                                             "`Tracks` tracks "
+                                                             "WHERE "
+                                                             "tracks.`FileName` = :fileName "
+                                                             "ORDER BY tracks.`Priority` ASC "
+                                                             "LIMIT 1");
 
-        auto result = prepareQuery(d->mSelectLyricistQuery, selectLyricistQueryText);
+        auto result = prepareQuery(d->mSelectTrackReplayGainQuery, selectTrackReplayGainQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectLyricistQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectLyricistQuery.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTrackReplayGainQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectTrackReplayGainQuery.lastError();
+
+            Q_EMIT databaseError();
         }
     }
 
     {
-        auto removeTrackQueryText = QStringLiteral("DELETE FROM `Tracks` "
-                                                   "WHERE "
-                                                   "`ID` = :trackId");
+        auto insertRadioHistoryQueryText = QStringLiteral("INSERT INTO `RadiosHistory` "
+                                                          "(`RadioID`, `Title`, `NowPlaying`, `PlayDate`) "
+                                                          "VALUES (:radioId, :title, :nowPlaying, :playDate)");
 
-        auto result = prepareQuery(d->mRemoveTrackQuery, removeTrackQueryText);
+        auto result = prepareQuery(d->mInsertRadioHistoryQuery, insertRadioHistoryQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveTrackQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveTrackQuery.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertRadioHistoryQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertRadioHistoryQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto removeAlbumQueryText = QStringLiteral("DELETE FROM `Albums` "
-                                                   "WHERE "
-                                                   "`ID` = :albumId");
+        auto trimRadioHistoryQueryText = QStringLiteral("DELETE FROM `RadiosHistory` "
+                                                        "WHERE "
+                                                        "`RadioID` = :radioId AND "
+                                                        "`ID` NOT IN ("
+                                                        "SELECT keptHistory.`ID` "
+                                                        "FROM `RadiosHistory` keptHistory "
+                                                        "WHERE keptHistory.`RadioID` = :keptRadioId "
+                                                        "ORDER BY keptHistory.`PlayDate` DESC, keptHistory.`ID` DESC "
+                                                        "LIMIT :maximumEntries)");
 
-        auto result = prepareQuery(d->mRemoveAlbumQuery, removeAlbumQueryText);
+        auto result = prepareQuery(d->mTrimRadioHistoryQuery, trimRadioHistoryQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveAlbumQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveAlbumQuery.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mTrimRadioHistoryQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mTrimRadioHistoryQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto removeAlbumQueryText = QStringLiteral("DELETE FROM `Artists` "
-                                                   "WHERE "
-                                                   "`ID` = :artistId");
+        auto selectRadioHistoryQueryText = QStringLiteral("SELECT "
+                                                          "history.`Title`, "
+                                                          "history.`NowPlaying`, "
+                                                          "history.`PlayDate` "
+                                                          "FROM "
+                                                          "`RadiosHistory` history "
+                                                          "WHERE "
+                                                          "history.`RadioID` = :radioId "
+                                                          "ORDER BY history.`PlayDate` DESC, history.`ID` DESC "
+                                                          "LIMIT :maximumResults");
 
-        auto result = prepareQuery(d->mRemoveArtistQuery, removeAlbumQueryText);
+        auto result = prepareQuery(d->mSelectRadioHistoryQuery, selectRadioHistoryQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveArtistQuery.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveArtistQuery.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectRadioHistoryQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectRadioHistoryQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -6375,11 +8025,14 @@ qulonglong DatabaseInterface::insertAlbum(const QString &title, const QString &a
 
     d->mInsertAlbumQuery.bindValue(QStringLiteral(":albumId"), d->mAlbumId);
     d->mInsertAlbumQuery.bindValue(QStringLiteral(":title"), title);
+    d->mInsertAlbumQuery.bindValue(QStringLiteral(":foldedTitle"), foldedName(title));
     if (!albumArtist.isEmpty()) {
         insertArtist(albumArtist);
         d->mInsertAlbumQuery.bindValue(QStringLiteral(":albumArtist"), albumArtist);
+        d->mInsertAlbumQuery.bindValue(QStringLiteral(":foldedAlbumArtist"), foldedName(albumArtist));
     } else {
         d->mInsertAlbumQuery.bindValue(QStringLiteral(":albumArtist"), {});
+        d->mInsertAlbumQuery.bindValue(QStringLiteral(":foldedAlbumArtist"), {});
     }
     d->mInsertAlbumQuery.bindValue(QStringLiteral(":albumPath"), trackPath);
     d->mInsertAlbumQuery.bindValue(QStringLiteral(":coverFileName"), albumArtURI);
@@ -6489,6 +8142,7 @@ qulonglong DatabaseInterface::insertArtist(const QString &name)
 
     d->mInsertArtistsQuery.bindValue(QStringLiteral(":artistId"), d->mArtistId);
     d->mInsertArtistsQuery.bindValue(QStringLiteral(":name"), name);
+    d->mInsertArtistsQuery.bindValue(QStringLiteral(":foldedName"), foldedName(name));
 
     queryResult = execQuery(d->mInsertArtistsQuery);
 
@@ -6614,6 +8268,7 @@ qulonglong DatabaseInterface::insertGenre(const QString &name)
 
     d->mInsertGenreQuery.bindValue(QStringLiteral(":genreId"), d->mGenreId);
     d->mInsertGenreQuery.bindValue(QStringLiteral(":name"), name);
+    d->mInsertGenreQuery.bindValue(QStringLiteral(":foldedName"), foldedName(name));
 
     queryResult = execQuery(d->mInsertGenreQuery);
 
@@ -6717,7 +8372,8 @@ qulonglong DatabaseInterface::internalInsertTrack(const DataTypes::TrackDataType
 
     auto oldAlbumId = albumId;
 
-    auto existingTrackId = internalTrackIdFromFileName(oneTrack.resourceURI());
+    auto existingComment = QString{};
+    auto existingTrackId = internalTrackIdFromFileName(oneTrack.resourceURI(), &existingComment);
     bool isModifiedTrack = (existingTrackId != 0);
 
     if (isModifiedTrack && !oneTrack.title().isEmpty()) {
@@ -6745,7 +8401,8 @@ qulonglong DatabaseInterface::internalInsertTrack(const DataTypes::TrackDataType
         isSameTrack = isSameTrack && (oldTrack.genre() == oneTrack.genre());
         isSameTrack = isSameTrack && (oldTrack.composer() == oneTrack.composer());
         isSameTrack = isSameTrack && (oldTrack.lyricist() == oneTrack.lyricist());
-        isSameTrack = isSameTrack && (oldTrack.comment() == oneTrack.comment());
+        // the comment is not part of the track data built from the database
+        isSameTrack = isSameTrack && (existingComment == oneTrack.comment());
         isSameTrack = isSameTrack && (oldTrack.year() == oneTrack.year());
         isSameTrack = isSameTrack && (oldTrack.hasChannels() == oneTrack.hasChannels());
         if (isSameTrack && oldTrack.hasChannels()) {
@@ -6781,6 +8438,7 @@ qulonglong DatabaseInterface::internalInsertTrack(const DataTypes::TrackDataType
                 recordModifiedAlbum(oldAlbumId);
             } else {
                 removeAlbumInDatabase(oldAlbumId);
+                recordChange(ElisaUtils::Album, oldAlbumId, DataTypes::LibraryChanges::Removed);
                 Q_EMIT albumRemoved(oldAlbumId);
             }
         }
@@ -6818,6 +8476,9 @@ qulonglong DatabaseInterface::internalInsertTrack(const DataTypes::TrackDataType
         insertArtist(oneTrack.artist());
         d->mInsertTrackQuery.bindValue(QStringLiteral(":artistName"), oneTrack.artist());
         d->mInsertTrackQuery.bindValue(QStringLiteral(":albumTitle"), oneTrack.album());
+        d->mInsertTrackQuery.bindValue(QStringLiteral(":foldedTitle"), foldedName(oneTrack.title()));
+        d->mInsertTrackQuery.bindValue(QStringLiteral(":foldedArtistName"), foldedName(oneTrack.artist()));
+        d->mInsertTrackQuery.bindValue(QStringLiteral(":foldedAlbumTitle"), foldedName(oneTrack.album()));
         if (oneTrack.hasAlbumArtist()) {
             d->mInsertTrackQuery.bindValue(QStringLiteral(":albumArtistName"), oneTrack.albumArtist());
         } else {
@@ -6974,9 +8635,6 @@ DataTypes::TrackDataType DatabaseInterface::buildTrackDataFromDatabaseRecord(con
     if (!trackRecord.value(18).isNull()) {
         result[DataTypes::TrackDataType::key_type::LyricistRole] = trackRecord.value(18);
     }
-    if (!trackRecord.value(19).isNull()) {
-        result[DataTypes::TrackDataType::key_type::CommentRole] = trackRecord.value(19);
-    }
     if (!trackRecord.value(20).isNull()) {
         result[DataTypes::TrackDataType::key_type::YearRole] = trackRecord.value(20);
     }
@@ -7036,6 +8694,7 @@ void DatabaseInterface::internalRemoveTracksList(const QList<QUrl> &removedTrack
     for (const auto &removedTrackFileName : removedTracks) {
         auto removedTrackId = internalTrackIdFromFileName(removedTrackFileName);
 
+        recordChange(ElisaUtils::Track, removedTrackId, DataTypes::LibraryChanges::Removed);
         Q_EMIT trackRemoved(removedTrackId);
 
         auto oneRemovedTrack = internalTrackFromDatabaseId(removedTrackId);
@@ -7056,6 +8715,7 @@ void DatabaseInterface::internalRemoveTracksList(const QList<QUrl> &removedTrack
 
         if (removedArtistId != 0 && allTracksFromArtist.isEmpty() && allAlbumsFromArtist.isEmpty()) {
             removeArtistInDatabase(removedArtistId);
+            recordChange(ElisaUtils::Artist, removedArtistId, DataTypes::LibraryChanges::Removed);
             Q_EMIT artistRemoved(removedArtistId);
         }
 
@@ -7082,9 +8742,11 @@ void DatabaseInterface::internalRemoveTracksList(const QList<QUrl> &removedTrack
         auto tracksCount = fetchTrackIds(modifiedAlbumId).count();
 
         if (!modifiedAlbumData.isEmpty() && tracksCount) {
+            recordChange(ElisaUtils::Album, modifiedAlbumId, DataTypes::LibraryChanges::Modified);
             Q_EMIT albumModified({{DataTypes::DatabaseIdRole, modifiedAlbumId}}, modifiedAlbumId);
         } else {
             removeAlbumInDatabase(modifiedAlbumId);
+            recordChange(ElisaUtils::Album, modifiedAlbumId, DataTypes::LibraryChanges::Removed);
             Q_EMIT albumRemoved(modifiedAlbumId);
 
             const auto &allTracksFromArtist = internalTracksFromAuthor(modifiedAlbumData[DataTypes::AlbumDataType::key_type::ArtistRole].toString());
@@ -7093,6 +8755,7 @@ void DatabaseInterface::internalRemoveTracksList(const QList<QUrl> &removedTrack
 
             if (removedArtistId != 0 && allTracksFromArtist.isEmpty() && allAlbumsFromArtist.isEmpty()) {
                 removeArtistInDatabase(removedArtistId);
+                recordChange(ElisaUtils::Artist, removedArtistId, DataTypes::LibraryChanges::Removed);
                 Q_EMIT artistRemoved(removedArtistId);
             }
         }
@@ -7165,7 +8828,7 @@ bool DatabaseInterface::isValidArtist(qulonglong albumId)
     return result;
 }
 
-bool DatabaseInterface::internalGenericPartialData(QSqlQuery &query)
+bool DatabaseInterface::internalGenericPartialData(DatabaseStatement &query)
 {
     auto result = false;
 
@@ -7347,6 +9010,9 @@ void DatabaseInterface::updateTrackInDatabase(const DataTypes::TrackDataType &on
     insertArtist(oneTrack.artist());
     d->mUpdateTrackQuery.bindValue(QStringLiteral(":artistName"), oneTrack.artist());
     d->mUpdateTrackQuery.bindValue(QStringLiteral(":albumTitle"), oneTrack.album());
+    d->mUpdateTrackQuery.bindValue(QStringLiteral(":foldedTitle"), foldedName(oneTrack.title()));
+    d->mUpdateTrackQuery.bindValue(QStringLiteral(":foldedArtistName"), foldedName(oneTrack.artist()));
+    d->mUpdateTrackQuery.bindValue(QStringLiteral(":foldedAlbumTitle"), foldedName(oneTrack.album()));
     if (oneTrack.hasAlbumArtist()) {
         d->mUpdateTrackQuery.bindValue(QStringLiteral(":albumArtistName"), oneTrack.albumArtist());
     } else {
@@ -7413,11 +9079,7 @@ void DatabaseInterface::updateTrackInDatabase(const DataTypes::TrackDataType &on
 
 void DatabaseInterface::insertRadio(const DataTypes::TrackDataType &oneTrack)
 {
-    QSqlQuery query = d->mUpdateRadioQuery;
-
-    if (oneTrack.databaseId() == -1ull) {
-        query = d->mInsertRadioQuery;
-    }
+    auto &query = (oneTrack.databaseId() == -1ull) ? d->mInsertRadioQuery : d->mUpdateRadioQuery;
 
     query.bindValue(QStringLiteral(":httpAddress"), oneTrack.resourceURI());
     query.bindValue(QStringLiteral(":radioId"), oneTrack.databaseId());
@@ -7438,10 +9100,12 @@ void DatabaseInterface::insertRadio(const DataTypes::TrackDataType &oneTrack)
         if (oneTrack[DataTypes::TrackDataType::key_type::DatabaseIdRole] == -1) {
             auto radio = internalOneRadioPartialData(internalRadioIdFromHttpAddress(oneTrack.resourceURI().toString()));
 
+            recordChange(ElisaUtils::Radio, radio.databaseId(), DataTypes::LibraryChanges::Inserted);
             Q_EMIT radioAdded(radio);
         } else {
             auto radio = internalOneRadioPartialData(oneTrack.databaseId());
 
+            recordChange(ElisaUtils::Radio, radio.databaseId(), DataTypes::LibraryChanges::Modified);
             Q_EMIT radioModified(radio);
         }
     }
@@ -7451,7 +9115,7 @@ void DatabaseInterface::insertRadio(const DataTypes::TrackDataType &oneTrack)
 
 void DatabaseInterface::removeRadio(qulonglong radioId)
 {
-    QSqlQuery query = d->mDeleteRadioQuery;
+    auto &query = d->mDeleteRadioQuery;
 
     query.bindValue(QStringLiteral(":radioId"), radioId);
 
@@ -7464,6 +9128,7 @@ void DatabaseInterface::removeRadio(qulonglong radioId)
         qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::updateTrackInDatabase" << query.boundValues();
         qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::updateTrackInDatabase" << query.lastError();
     }else{
+        recordChange(ElisaUtils::Radio, radioId, DataTypes::LibraryChanges::Removed);
         Q_EMIT radioRemoved(radioId);
     }
 
@@ -7516,7 +9181,7 @@ void DatabaseInterface::reloadExistingDatabase()
     d->mGenreId = genericInitialId(d->mQueryMaximumGenreIdQuery);
 }
 
-qulonglong DatabaseInterface::genericInitialId(QSqlQuery &request)
+qulonglong DatabaseInterface::genericInitialId(DatabaseStatement &request)
 {
     auto result = qulonglong(0);
 
@@ -7776,7 +9441,7 @@ qulonglong DatabaseInterface::getDuplicateTrackIdFromTitleAlbumTrackDiscNumber(c
     return result;
 }
 
-qulonglong DatabaseInterface::internalTrackIdFromFileName(const QUrl &fileName)
+qulonglong DatabaseInterface::internalTrackIdFromFileName(const QUrl &fileName, QString *comment)
 {
     auto result = qulonglong(0);
 
@@ -7801,10 +9466,14 @@ qulonglong DatabaseInterface::internalTrackIdFromFileName(const QUrl &fileName)
     }
 
     if (d->mSelectTracksMapping.next()) {
-        const auto &currentRecordValue = d->mSelectTracksMapping.record().value(0);
+        const auto &currentRecord = d->mSelectTracksMapping.record();
+        const auto &currentRecordValue = currentRecord.value(0);
         if (currentRecordValue.isValid()) {
             result = currentRecordValue.toULongLong();
         }
+        if (comment) {
+            *comment = currentRecord.value(4).toString();
+        }
     }
 
     d->mSelectTracksMapping.finish();
@@ -7906,6 +9575,41 @@ DataTypes::ListTrackDataType DatabaseInterface::internalTracksFromGenre(const QS
     return allTracks;
 }
 
+DataTypes::ListTrackDataType DatabaseInterface::internalTracksFromFileNames(const QList<QUrl> &fileNames)
+{
+    auto allTracks = DataTypes::ListTrackDataType{};
+
+    for (int firstFile = 0; firstFile < fileNames.size(); firstFile += FileNamesQueryBatchSize) {
+        for (int fileIndex = 0; fileIndex < FileNamesQueryBatchSize; ++fileIndex) {
+            const auto oneFileName = (firstFile + fileIndex < fileNames.size() ? QVariant{fileNames[firstFile + fileIndex].toString()} : QVariant{});
+
+            d->mSelectTracksFromFileNames.bindValue(QStringLiteral(":fileName%1").arg(fileIndex), oneFileName);
+        }
+
+        auto result = execQuery(d->mSelectTracksFromFileNames);
+
+        if (!result || !d->mSelectTracksFromFileNames.isSelect() || !d->mSelectTracksFromFileNames.isActive()) {
+            Q_EMIT databaseError();
+
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::tracksFromFileNames" << d->mSelectTracksFromFileNames.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::tracksFromFileNames" << d->mSelectTracksFromFileNames.boundValues();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::tracksFromFileNames" << d->mSelectTracksFromFileNames.lastError();
+
+            return allTracks;
+        }
+
+        while (d->mSelectTracksFromFileNames.next()) {
+            const auto &currentRecord = d->mSelectTracksFromFileNames.record();
+
+            allTracks.push_back(buildTrackDataFromDatabaseRecord(currentRecord));
+        }
+
+        d->mSelectTracksFromFileNames.finish();
+    }
+
+    return allTracks;
+}
+
 
 QList<qulonglong> DatabaseInterface::internalAlbumIdsFromAuthor(const QString &ArtistName)
 {
@@ -7936,7 +9640,7 @@ QList<qulonglong> DatabaseInterface::internalAlbumIdsFromAuthor(const QString &A
     return allAlbumIds;
 }
 
-DataTypes::ListArtistDataType DatabaseInterface::internalAllArtistsPartialData(QSqlQuery &artistsQuery)
+DataTypes::ListArtistDataType DatabaseInterface::internalAllArtistsPartialData(DatabaseStatement &artistsQuery)
 {
     auto result = DataTypes::ListArtistDataType{};
 
@@ -7962,7 +9666,7 @@ DataTypes::ListArtistDataType DatabaseInterface::internalAllArtistsPartialData(Q
     return result;
 }
 
-DataTypes::ListAlbumDataType DatabaseInterface::internalAllAlbumsPartialData(QSqlQuery &query)
+DataTypes::ListAlbumDataType DatabaseInterface::internalAllAlbumsPartialData(DatabaseStatement &query)
 {
     auto result = DataTypes::ListAlbumDataType{};
 
@@ -8083,23 +9787,23 @@ DataTypes::ArtistDataType DatabaseInterface::internalOneArtistPartialData(qulong
     return result;
 }
 
-DataTypes::ListTrackDataType DatabaseInterface::internalAllTracksPartialData()
+DataTypes::ListTrackDataType DatabaseInterface::internalAllTracksPartialData(DatabaseStatement &query)
 {
     auto result = DataTypes::ListTrackDataType{};
 
-    if (!internalGenericPartialData(d->mSelectAllTracksQuery)) {
+    if (!internalGenericPartialData(query)) {
         return result;
     }
 
-    while(d->mSelectAllTracksQuery.next()) {
-        const auto &currentRecord = d->mSelectAllTracksQuery.record();
+    while(query.next()) {
+        const auto &currentRecord = query.record();
 
         auto newData = buildTrackDataFromDatabaseRecord(currentRecord);
 
         result.push_back(newData);
     }
 
-    d->mSelectAllTracksQuery.finish();
+    query.finish();
 
     return result;
 }
@@ -8235,18 +9939,18 @@ DataTypes::TrackDataType DatabaseInterface::internalOneRadioPartialData(qulonglo
     return result;
 }
 
-DataTypes::ListGenreDataType DatabaseInterface::internalAllGenresPartialData()
+DataTypes::ListGenreDataType DatabaseInterface::internalAllGenresPartialData(DatabaseStatement &query)
 {
     DataTypes::ListGenreDataType result;
 
-    if (!internalGenericPartialData(d->mSelectAllGenresQuery)) {
+    if (!internalGenericPartialData(query)) {
         return result;
     }
 
-    while(d->mSelectAllGenresQuery.next()) {
+    while(query.next()) {
         auto newData = DataTypes::GenreDataType{};
 
-        const auto &currentRecord = d->mSelectAllGenresQuery.record();
+        const auto &currentRecord = query.record();
 
         newData[DataTypes::DatabaseIdRole] = currentRecord.value(0);
         newData[DataTypes::TitleRole] = currentRecord.value(1);
@@ -8255,7 +9959,7 @@ DataTypes::ListGenreDataType DatabaseInterface::internalAllGenresPartialData()
         result.push_back(newData);
     }
 
-    d->mSelectAllGenresQuery.finish();
+    query.finish();
 
     return result;
 }
@@ -8310,30 +10014,365 @@ DataTypes::ListArtistDataType DatabaseInterface::internalAllLyricistsPartialData
     return result;
 }
 
-bool DatabaseInterface::prepareQuery(QSqlQuery &query, const QString &queryText) const
+bool DatabaseInterface::prepareQuery(DatabaseStatement &query, const QString &queryText)
 {
-    query.setForwardOnly(true);
-    return query.prepare(queryText);
+    query.setQueryText(queryText);
+    d->mStatements.insert(&query);
+
+    return true;
 }
 
-bool DatabaseInterface::execQuery(QSqlQuery &query)
+bool DatabaseInterface::prepareSortFilterQuery(DatabaseStatement &query, ElisaUtils::PlayListEntryType dataType,
+                                               const DataTypes::SortFilterParameters &parameters)
 {
-#if !defined NDEBUG
+    auto result = false;
+
+    auto queryText = QString{};
+    auto filterConditions = QStringList{};
+    auto filterKeyword = QString{};
+    auto orderByColumn = QString{};
+    auto uniqueIdColumn = QString{};
+    auto hasRatingFilter = false;
+
+    const auto hasTextFilter = !parameters.mFilterText.isEmpty();
+
+    switch (dataType)
+    {
+    case ElisaUtils::Track:
+        queryText = d->mSelectAllTracksText;
+        filterKeyword = QStringLiteral("AND ");
+        uniqueIdColumn = QStringLiteral("tracks.`ID`");
+
+        if (hasTextFilter) {
+            filterConditions.push_back(QStringLiteral("(tracks.`FoldedTitle` LIKE :filterTitle ESCAPE '\\' OR "
+                                                      "tracks.`FoldedArtistName` LIKE :filterArtist ESCAPE '\\' OR "
+                                                      "EXISTS ("
+                                                      "SELECT 1 "
+                                                      "FROM "
+                                                      "`Tracks` tracksFromAlbum3 "
+                                                      "WHERE "
+                                                      "tracksFromAlbum3.`AlbumTitle` = album.`Title` AND "
+                                                      "(tracksFromAlbum3.`AlbumArtistName` = album.`ArtistName` OR "
+                                                      "(tracksFromAlbum3.`AlbumArtistName` IS NULL AND "
+                                                      "album.`ArtistName` IS NULL "
+                                                      ") "
+                                                      ") AND "
+                                                      "tracksFromAlbum3.`AlbumPath` = album.`AlbumPath` AND "
+                                                      "tracksFromAlbum3.`FoldedArtistName` LIKE :filterAllArtists ESCAPE '\\'"
+                                                      "))"));
+        }
+
+        if (parameters.mFilterRating > 0) {
+            filterConditions.push_back(QStringLiteral("tracks.`Rating` >= :filterRating"));
+            hasRatingFilter = true;
+        }
+
+        switch (parameters.mSortRole)
+        {
+        case DataTypes::ArtistRole:
+            orderByColumn = QStringLiteral("tracks.`FoldedArtistName`");
+            break;
+        case DataTypes::AlbumRole:
+            orderByColumn = QStringLiteral("tracks.`FoldedAlbumTitle`");
+            break;
+        case DataTypes::GenreRole:
+            orderByColumn = QStringLiteral("trackGenre.`FoldedName`");
+            break;
+        case DataTypes::DurationRole:
+            orderByColumn = QStringLiteral("tracks.`Duration`");
+            break;
+        case DataTypes::RatingRole:
+            orderByColumn = QStringLiteral("tracks.`Rating`");
+            break;
+        case DataTypes::YearRole:
+            orderByColumn = QStringLiteral("tracks.`Year`");
+            break;
+        case DataTypes::FileModificationTime:
+            orderByColumn = QStringLiteral("tracksMapping.`FileModifiedTime`");
+            break;
+        case DataTypes::FirstPlayDate:
+            orderByColumn = QStringLiteral("tracksMapping.`FirstPlayDate`");
+            break;
+        case DataTypes::LastPlayDate:
+            orderByColumn = QStringLiteral("tracksMapping.`LastPlayDate`");
+            break;
+        case DataTypes::PlayCounter:
+            orderByColumn = QStringLiteral("tracksMapping.`PlayCounter`");
+            break;
+        case DataTypes::PlayFrequency:
+            orderByColumn = QStringLiteral("PlayFrequency");
+            break;
+        default:
+            orderByColumn = QStringLiteral("tracks.`FoldedTitle`");
+            break;
+        }
+        break;
+    case ElisaUtils::Album:
+        queryText = d->mSelectAllAlbumsText;
+        filterKeyword = QStringLiteral("HAVING ");
+        uniqueIdColumn = QStringLiteral("album.`ID`");
+
+        if (hasTextFilter) {
+            filterConditions.push_back(QStringLiteral("(album.`FoldedTitle` LIKE :filterTitle ESCAPE '\\' OR "
+                                                      "album.`FoldedArtistName` LIKE :filterArtist ESCAPE '\\' OR "
+                                                      "MAX(tracks.`FoldedArtistName` LIKE :filterAllArtists ESCAPE '\\'))"));
+        }
+
+        if (parameters.mFilterRating > 0) {
+            filterConditions.push_back(QStringLiteral("HighestRating >= :filterRating"));
+            hasRatingFilter = true;
+        }
+
+        switch (parameters.mSortRole)
+        {
+        case DataTypes::ArtistRole:
+        case DataTypes::SecondaryTextRole:
+            orderByColumn = QStringLiteral("album.`FoldedArtistName`");
+            break;
+        case DataTypes::HighestTrackRating:
+            orderByColumn = QStringLiteral("HighestRating");
+            break;
+        default:
+            orderByColumn = QStringLiteral("album.`FoldedTitle`");
+            break;
+        }
+        break;
+    case ElisaUtils::Artist:
+        queryText = d->mSelectAllArtistsText;
+        filterKeyword = QStringLiteral("HAVING ");
+        uniqueIdColumn = QStringLiteral("artists.`ID`");
+        orderByColumn = QStringLiteral("artists.`FoldedName`");
+
+        if (hasTextFilter) {
+            filterConditions.push_back(QStringLiteral("artists.`FoldedName` LIKE :filterTitle ESCAPE '\\'"));
+        }
+
+        if (parameters.mFilterRating > 0) {
+            // artists have no rating: the view filter rejects all of them
+            filterConditions.push_back(QStringLiteral("0"));
+        }
+        break;
+    case ElisaUtils::Genre:
+        queryText = d->mSelectAllGenresText;
+        filterKeyword = QStringLiteral("WHERE ");
+        uniqueIdColumn = QStringLiteral("genre.`ID`");
+        orderByColumn = QStringLiteral("genre.`FoldedName`");
+
+        if (hasTextFilter) {
+            filterConditions.push_back(QStringLiteral("genre.`FoldedName` LIKE :filterTitle ESCAPE '\\'"));
+        }
+
+        if (parameters.mFilterRating > 0) {
+            filterConditions.push_back(QStringLiteral("0"));
+        }
+        break;
+    case ElisaUtils::Radio:
+    case ElisaUtils::Lyricist:
+    case ElisaUtils::Composer:
+    case ElisaUtils::FileName:
+    case ElisaUtils::Container:
+    case ElisaUtils::Unknown:
+        return result;
+    }
+
+    if (!filterConditions.isEmpty()) {
+        queryText += filterKeyword + filterConditions.join(QStringLiteral(" AND ")) + QStringLiteral(" ");
+    }
+
+    const auto sortDirection = (parameters.mSortOrder == Qt::AscendingOrder ? QStringLiteral(" ASC") : QStringLiteral(" DESC"));
+
+    queryText += QStringLiteral("ORDER BY ") + orderByColumn + sortDirection + QStringLiteral(", ") + uniqueIdColumn + sortDirection;
+
+    prepareQuery(query, queryText);
+    result = query.ensurePrepared();
+
+    if (!result) {
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::prepareSortFilterQuery" << query.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::prepareSortFilterQuery" << query.lastError();
+
+        return result;
+    }
+
+    if (hasTextFilter) {
+        auto filterPattern = parameters.mFilterText.toCaseFolded();
+        filterPattern.replace(QLatin1Char('\\'), QStringLiteral("\\\\"));
+        filterPattern.replace(QLatin1Char('%'), QStringLiteral("\\%"));
+        filterPattern.replace(QLatin1Char('_'), QStringLiteral("\\_"));
+        filterPattern = QLatin1Char('%') + filterPattern + QLatin1Char('%');
+
+        query.bindValue(QStringLiteral(":filterTitle"), filterPattern);
+
+        if (dataType == ElisaUtils::Track || dataType == ElisaUtils::Album) {
+            query.bindValue(QStringLiteral(":filterArtist"), filterPattern);
+            query.bindValue(QStringLiteral(":filterAllArtists"), filterPattern);
+        }
+    }
+
+    if (hasRatingFilter) {
+        query.bindValue(QStringLiteral(":filterRating"), parameters.mFilterRating);
+    }
+
+    return result;
+}
+
+bool DatabaseInterface::execQuery(DatabaseStatement &query)
+{
+    ELISA_TRACE_SCOPE_DETAIL("database", "execQuery", query.lastQuery());
+
+    if (!query.ensurePrepared()) {
+        return false;
+    }
+
     auto timer = QElapsedTimer{};
     timer.start();
-#endif
 
     auto result = query.exec();
 
+    const auto executionTime = timer.nsecsElapsed();
+    const auto isSlow = d->mSlowQueryThreshold > 0 && executionTime >= d->mSlowQueryThreshold;
+
+    query.recordExecution(executionTime, isSlow);
+
+    if (isSlow) {
+        logSlowQuery(query, executionTime);
+    }
+
 #if !defined NDEBUG
-    if (timer.nsecsElapsed() > 10000000) {
-        qCDebug(orgKdeElisaDatabase) << "[[" << timer.nsecsElapsed() << "]]" << query.lastQuery();
+    if (executionTime > 10000000) {
+        qCDebug(orgKdeElisaDatabase) << "[[" << executionTime << "]]" << query.lastQuery();
     }
 #endif
 
     return result;
 }
 
+void DatabaseInterface::logSlowQuery(const DatabaseStatement &query, qint64 executionTime)
+{
+    qCInfo(orgKdeElisaDatabase) << "DatabaseInterface::logSlowQuery" << executionTime / 1000000 << "ms" << query.lastQuery();
+    qCInfo(orgKdeElisaDatabase) << "DatabaseInterface::logSlowQuery" << query.boundValues();
+
+    QSqlQuery explainQuery(d->mTracksDatabase);
+
+    if (!explainQuery.prepare(QStringLiteral("EXPLAIN QUERY PLAN ") + query.lastQuery())) {
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::logSlowQuery" << explainQuery.lastError();
+
+        return;
+    }
+
+    const auto &boundValues = query.boundValues();
+    for (auto itValue = boundValues.cbegin(); itValue != boundValues.cend(); ++itValue) {
+        explainQuery.bindValue(itValue.key(), itValue.value());
+    }
+
+    if (!explainQuery.exec()) {
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::logSlowQuery" << explainQuery.lastError();
+
+        return;
+    }
+
+    while (explainQuery.next()) {
+        const auto &currentRecord = explainQuery.record();
+
+        qCInfo(orgKdeElisaDatabase) << "DatabaseInterface::logSlowQuery" << "query plan:"
+                                    << currentRecord.value(QStringLiteral("detail")).toString();
+    }
+
+    explainQuery.finish();
+}
+
+void DatabaseInterface::setSlowQueryThreshold(int milliseconds)
+{
+    if (!d) {
+        return;
+    }
+
+    d->mSlowQueryThreshold = qint64{milliseconds} * 1000000;
+}
+
+QJsonObject DatabaseInterface::statementsStatisticsToJson() const
+{
+    auto result = QJsonObject{};
+
+    if (!d) {
+        return result;
+    }
+
+    auto allStatements = QJsonArray{};
+    for (const auto &oneStatistics : statementsStatistics()) {
+        if (oneStatistics.mIsPrepared) {
+            allStatements.append(oneStatistics.toJson());
+        }
+    }
+
+    result[QStringLiteral("slowQueryThreshold")] = d->mSlowQueryThreshold;
+    result[QStringLiteral("lockWait")] = d->mLockWaitHistogram.toJson();
+    result[QStringLiteral("statements")] = allStatements;
+
+    return result;
+}
+
+bool DatabaseInterface::exportStatementsStatistics(const QString &fileName) const
+{
+    QFile statisticsFile(fileName);
+
+    if (!statisticsFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::exportStatementsStatistics" << fileName << statisticsFile.errorString();
+
+        return false;
+    }
+
+    statisticsFile.write(QJsonDocument(statementsStatisticsToJson()).toJson());
+
+    return true;
+}
+
+QList<DatabaseStatementStatistics> DatabaseInterface::statementsStatistics() const
+{
+    auto result = QList<DatabaseStatementStatistics>{};
+
+    if (!d) {
+        return result;
+    }
+
+    result.reserve(d->mStatements.size());
+    for (const auto *oneStatement : qAsConst(d->mStatements)) {
+        result.push_back(oneStatement->statistics());
+    }
+
+    std::sort(result.begin(), result.end(), [](const auto &left, const auto &right) {
+        return left.mCumulativeExecutionTime > right.mCumulativeExecutionTime;
+    });
+
+    return result;
+}
+
+void DatabaseInterface::dumpStatementsStatistics() const
+{
+    const auto allStatistics = statementsStatistics();
+
+    auto preparedCount = 0;
+    for (const auto &oneStatistics : allStatistics) {
+        if (!oneStatistics.mIsPrepared) {
+            continue;
+        }
+
+        ++preparedCount;
+
+        qCInfo(orgKdeElisaDatabase) << "DatabaseInterface::dumpStatementsStatistics"
+                                    << oneStatistics.mExecutionCount << "executions"
+                                    << oneStatistics.mCumulativeExecutionTime / 1000 << "us"
+                                    << "prepared in" << oneStatistics.mPrepareTime / 1000 << "us"
+                                    << oneStatistics.mQueryText;
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::dumpStatementsStatistics"
+                                     << QJsonDocument(oneStatistics.toJson()).toJson(QJsonDocument::Compact);
+    }
+
+    qCInfo(orgKdeElisaDatabase) << "DatabaseInterface::dumpStatementsStatistics" << preparedCount
+                                << "statements prepared out of" << allStatistics.size();
+    qCInfo(orgKdeElisaDatabase) << "DatabaseInterface::dumpStatementsStatistics" << "lock wait"
+                                << QJsonDocument(d->mLockWaitHistogram.toJson()).toJson(QJsonDocument::Compact);
+}
+
 void DatabaseInterface::updateAlbumArtist(qulonglong albumId, const QString &title,
                                           const QString &albumPath,
                                           const QString &artistName)
@@ -8341,6 +10380,7 @@ void DatabaseInterface::updateAlbumArtist(qulonglong albumId, const QString &tit
     d->mUpdateAlbumArtistQuery.bindValue(QStringLiteral(":albumId"), albumId);
     insertArtist(artistName);
     d->mUpdateAlbumArtistQuery.bindValue(QStringLiteral(":artistName"), artistName);
+    d->mUpdateAlbumArtistQuery.bindValue(QStringLiteral(":foldedArtistName"), foldedName(artistName));
 
     auto queryResult = execQuery(d->mUpdateAlbumArtistQuery);
 
@@ -8418,6 +10458,34 @@ void DatabaseInterface::updateTrackStatistics(const QUrl &fileName, const QDateT
     }
 
     d->mUpdateTrackFirstPlayStatistics.finish();
+
+    d->mSelectPlayScoreQuery.bindValue(QStringLiteral(":fileName"), fileName);
+
+    if (!internalGenericPartialData(d->mSelectPlayScoreQuery)) {
+        return;
+    }
+
+    auto currentScore = std::optional<double>{};
+    if (d->mSelectPlayScoreQuery.next()) {
+        currentScore = d->mSelectPlayScoreQuery.record().value(0).toDouble();
+    }
+
+    d->mSelectPlayScoreQuery.finish();
+
+    d->mUpdatePlayScoreQuery.bindValue(QStringLiteral(":fileName"), fileName);
+    d->mUpdatePlayScoreQuery.bindValue(QStringLiteral(":score"), addPlayToScore(currentScore, time.toMSecsSinceEpoch()));
+
+    queryResult = execQuery(d->mUpdatePlayScoreQuery);
+
+    if (!queryResult || !d->mUpdatePlayScoreQuery.isActive()) {
+        Q_EMIT databaseError();
+
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::updateTrackStatistics" << d->mUpdatePlayScoreQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::updateTrackStatistics" << d->mUpdatePlayScoreQuery.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::updateTrackStatistics" << d->mUpdatePlayScoreQuery.lastError();
+    }
+
+    d->mUpdatePlayScoreQuery.finish();
 }
 
 
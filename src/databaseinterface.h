@@ -11,6 +11,7 @@
 
 #include "elisautils.h"
 #include "datatypes.h"
+#include "databasestatement.h"
 
 #include <QObject>
 #include <QString>
@@ -18,13 +19,13 @@
 #include <QList>
 #include <QUrl>
 #include <QDateTime>
+#include <QJsonObject>
 
 #include <memory>
 #include <optional>
 
 class DatabaseInterfacePrivate;
 class QSqlRecord;
-class QSqlQuery;
 
 class ELISALIB_EXPORT DatabaseInterface : public QObject
 {
@@ -39,7 +40,12 @@ public:
         V13 = 13,
         V14 = 14,
         V15 = 15,
-        V16 = 16, //Does not exist yet, for testing purpose only.
+        V16 = 16,
+        V17 = 17,
+        V18 = 18,
+        V19 = 19,
+        V20 = 20,
+        V21 = 21,
     };
 
     explicit DatabaseInterface(QObject *parent = nullptr);
@@ -52,14 +58,20 @@ public:
 
     DataTypes::ListTrackDataType allTracksData();
 
+    DataTypes::ListTrackDataType allTracksData(const DataTypes::SortFilterParameters &parameters);
+
     DataTypes::ListRadioDataType allRadiosData();
 
     DataTypes::ListTrackDataType recentlyPlayedTracksData(int count);
 
     DataTypes::ListTrackDataType frequentlyPlayedTracksData(int count);
 
+    DataTypes::ListTrackDataType radioHistory(qulonglong radioId, int count);
+
     DataTypes::ListAlbumDataType allAlbumsData();
 
+    DataTypes::ListAlbumDataType allAlbumsData(const DataTypes::SortFilterParameters &parameters);
+
     DataTypes::ListAlbumDataType allAlbumsDataByGenreAndArtist(const QString &genre, const QString &artist);
 
     DataTypes::ListAlbumDataType allAlbumsDataByArtist(const QString &artist);
@@ -70,6 +82,8 @@ public:
 
     DataTypes::ListArtistDataType allArtistsData();
 
+    DataTypes::ListArtistDataType allArtistsData(const DataTypes::SortFilterParameters &parameters);
+
     DataTypes::ListArtistDataType allArtistsDataByGenre(const QString &genre);
 
     DataTypes::ArtistDataType artistDataFromDatabaseId(qulonglong id);
@@ -78,12 +92,19 @@ public:
 
     DataTypes::ListGenreDataType allGenresData();
 
+    DataTypes::ListGenreDataType allGenresData(const DataTypes::SortFilterParameters &parameters);
+
     bool internalArtistMatchGenre(qulonglong databaseId, const QString &genre);
 
     DataTypes::ListTrackDataType tracksDataFromAuthor(const QString &artistName);
 
     DataTypes::ListTrackDataType tracksDataFromGenre(const QString &genre);
 
+    /**
+     * tracks of the files already in the database, files unknown to it are ignored
+     */
+    DataTypes::ListTrackDataType tracksDataFromFileNames(const QList<QUrl> &fileNames);
+
     DataTypes::TrackDataType trackDataFromDatabaseId(qulonglong id);
 
     DataTypes::TrackDataType trackDataFromDatabaseIdAndUrl(qulonglong id, const QUrl &trackUrl);
@@ -94,8 +115,48 @@ public:
 
     qulonglong trackIdFromFileName(const QUrl &fileName);
 
+    QString trackCommentFromFileName(const QUrl &fileName);
+
     qulonglong radioIdFromFileName(const QUrl &fileName);
 
+    qulonglong currentGeneration();
+
+    /**
+     * Changes recorded after generation, at most one per entity.
+     *
+     * A consumer may receive the insertion of an entity it already knows, it
+     * is then a modification, and the removal of an entity it never knew.
+     * There is no consumer in Elisa itself yet, the models reload from the
+     * database signals.
+     */
+    DataTypes::LibraryChanges changesSince(qulonglong generation);
+
+    /**
+     * Record that a consumer has applied all the changes up to generation.
+     *
+     * Removals acknowledged by all the consumers are then dropped from the
+     * journal: a reader that never acknowledges may miss them. Modifications
+     * of an entity whose insertion no consumer has acknowledged are reported
+     * as that insertion.
+     */
+    void acknowledgeChanges(const QString &consumerName, qulonglong generation);
+
+    /**
+     * Per-statement execution counts and cumulative execution time, hottest first.
+     * Statements that were never used in this session are reported as not prepared.
+     */
+    QList<DatabaseStatementStatistics> statementsStatistics() const;
+
+    void dumpStatementsStatistics() const;
+
+    /**
+     * Execution, fetch and row count histograms of all used statements and the time
+     * spent waiting on the database lock when beginning and committing transactions.
+     */
+    QJsonObject statementsStatisticsToJson() const;
+
+    bool exportStatementsStatistics(const QString &fileName) const;
+
     void applicationAboutToQuit();
 
 Q_SIGNALS:
@@ -140,6 +201,10 @@ Q_SIGNALS:
 
     void radioRemoved(qulonglong radioId);
 
+    void tracksPendingLoudnessAnalysis(const DataTypes::ListTrackDataType &tracks);
+
+    void replayGainAvailable(const DataTypes::TrackDataType &trackGain);
+
 public Q_SLOTS:
 
     void insertTracksList(const DataTypes::ListTrackDataType &tracks, const QHash<QString, QUrl> &covers);
@@ -156,6 +221,16 @@ public Q_SLOTS:
 
     void removeRadio(qulonglong radioId);
 
+    void setSlowQueryThreshold(int milliseconds);
+
+    void askTracksPendingLoudnessAnalysis(int maximumCount);
+
+    void updateLoudnessAnalysis(const DataTypes::ListTrackDataType &tracks);
+
+    void askReplayGain(const QUrl &fileName);
+
+    void insertRadiosHistory(const DataTypes::ListTrackDataType &entries);
+
 private:
 
     enum class TrackFileInsertType {
@@ -169,6 +244,11 @@ private:
 
     void recordModifiedAlbum(qulonglong albumId);
 
+    void recordChange(ElisaUtils::PlayListEntryType entityType, qulonglong entityId,
+                      DataTypes::LibraryChanges::ChangeType changeType);
+
+    qulonglong internalCurrentGeneration();
+
     bool startTransaction() const;
 
     bool finishTransaction() const;
@@ -188,7 +268,10 @@ private:
                                                                 const QString &albumArtist, const QString &trackPath, int trackNumber,
                                                                 int discNumber, int priority);
 
-    qulonglong internalTrackIdFromFileName(const QUrl &fileName);
+    /**
+     * @param comment if not null, receives the comment of the track stored for this file
+     */
+    qulonglong internalTrackIdFromFileName(const QUrl &fileName, QString *comment = nullptr);
 
     qulonglong internalRadioIdFromHttpAddress(const QString &httpAddress);
 
@@ -196,6 +279,8 @@ private:
 
     DataTypes::ListTrackDataType internalTracksFromGenre(const QString &genre);
 
+    DataTypes::ListTrackDataType internalTracksFromFileNames(const QList<QUrl> &fileNames);
+
     QList<qulonglong> internalAlbumIdsFromAuthor(const QString &artistName);
 
     void initDatabase();
@@ -224,7 +309,7 @@ private:
 
     void reloadExistingDatabase();
 
-    qulonglong genericInitialId(QSqlQuery &request);
+    qulonglong genericInitialId(DatabaseStatement &request);
 
     void insertTrackOrigin(const QUrl &fileNameURI, const QDateTime &fileModifiedTime, const QDateTime &importDate);
 
@@ -251,17 +336,17 @@ private:
 
     QHash<QUrl, QDateTime> internalAllFileName();
 
-    bool internalGenericPartialData(QSqlQuery &query);
+    bool internalGenericPartialData(DatabaseStatement &query);
 
-    DataTypes::ListArtistDataType internalAllArtistsPartialData(QSqlQuery &artistsQuery);
+    DataTypes::ListArtistDataType internalAllArtistsPartialData(DatabaseStatement &artistsQuery);
 
-    DataTypes::ListAlbumDataType internalAllAlbumsPartialData(QSqlQuery &query);
+    DataTypes::ListAlbumDataType internalAllAlbumsPartialData(DatabaseStatement &query);
 
     DataTypes::AlbumDataType internalOneAlbumPartialData(qulonglong databaseId);
 
     DataTypes::ArtistDataType internalOneArtistPartialData(qulonglong databaseId);
 
-    DataTypes::ListTrackDataType internalAllTracksPartialData();
+    DataTypes::ListTrackDataType internalAllTracksPartialData(DatabaseStatement &query);
 
     DataTypes::ListRadioDataType internalAllRadiosPartialData();
 
@@ -275,15 +360,20 @@ private:
 
     DataTypes::TrackDataType internalOneRadioPartialData(qulonglong databaseId);
 
-    DataTypes::ListGenreDataType internalAllGenresPartialData();
+    DataTypes::ListGenreDataType internalAllGenresPartialData(DatabaseStatement &query);
 
     DataTypes::ListArtistDataType internalAllComposersPartialData();
 
     DataTypes::ListArtistDataType internalAllLyricistsPartialData();
 
-    bool prepareQuery(QSqlQuery &query, const QString &queryText) const;
+    bool prepareQuery(DatabaseStatement &query, const QString &queryText);
+
+    bool prepareSortFilterQuery(DatabaseStatement &query, ElisaUtils::PlayListEntryType dataType,
+                                const DataTypes::SortFilterParameters &parameters);
 
-    bool execQuery(QSqlQuery &query);
+    bool execQuery(DatabaseStatement &query);
+
+    void logSlowQuery(const DatabaseStatement &query, qint64 executionTime);
 
     void updateAlbumArtist(qulonglong albumId, const QString &title, const QString &albumPath,
                            const QString &artistName);
@@ -306,6 +396,16 @@ private:
 
     void upgradeDatabaseV16();
 
+    void upgradeDatabaseV17();
+
+    void upgradeDatabaseV18();
+
+    void upgradeDatabaseV19();
+
+    void upgradeDatabaseV20();
+
+    void upgradeDatabaseV21();
+
     void checkDatabaseSchema();
 
     void checkAlbumsTableSchema();
@@ -322,6 +422,14 @@ private:
 
     void checkTracksDataTableSchema();
 
+    void checkChangeJournalTableSchema();
+
+    void checkChangeJournalConsumersTableSchema();
+
+    void checkPlayStatsTableSchema();
+
+    void checkRadiosHistoryTableSchema();
+
     void genericCheckTable(const QString &tableName, const QStringList &expectedColumns);
 
     void resetDatabase();
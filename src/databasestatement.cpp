@@ -0,0 +1,189 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "databasestatement.h"
+
+#include "databaseLogging.h"
+
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QJsonArray>
+#include <QElapsedTimer>
+
+#include <algorithm>
+
+DatabaseHistogram::DatabaseHistogram(qint64 firstUpperBound) : mFirstUpperBound(firstUpperBound)
+{
+}
+
+void DatabaseHistogram::addSample(qint64 value)
+{
+    auto bucket = 0;
+    auto upperBound = mFirstUpperBound;
+
+    while (bucket < BucketsCount - 1 && value >= upperBound) {
+        ++bucket;
+        upperBound *= 10;
+    }
+
+    ++mBuckets[bucket];
+    ++mCount;
+    mTotal += value;
+    mMaximum = std::max(mMaximum, value);
+}
+
+QJsonObject DatabaseHistogram::toJson() const
+{
+    auto buckets = QJsonArray{};
+    auto upperBound = mFirstUpperBound;
+
+    for (auto bucket = 0; bucket < BucketsCount; ++bucket) {
+        auto oneBucket = QJsonObject{};
+
+        if (bucket < BucketsCount - 1) {
+            oneBucket[QStringLiteral("lessThan")] = upperBound;
+        }
+        oneBucket[QStringLiteral("count")] = static_cast<qint64>(mBuckets[bucket]);
+
+        buckets.append(oneBucket);
+        upperBound *= 10;
+    }
+
+    return {{QStringLiteral("count"), static_cast<qint64>(mCount)},
+            {QStringLiteral("total"), mTotal},
+            {QStringLiteral("maximum"), mMaximum},
+            {QStringLiteral("buckets"), buckets}};
+}
+
+QJsonObject DatabaseStatementStatistics::toJson() const
+{
+    return {{QStringLiteral("query"), mQueryText},
+            {QStringLiteral("prepared"), mIsPrepared},
+            {QStringLiteral("prepareTime"), mPrepareTime},
+            {QStringLiteral("executions"), static_cast<qint64>(mExecutionCount)},
+            {QStringLiteral("slowExecutions"), static_cast<qint64>(mSlowExecutionCount)},
+            {QStringLiteral("rowsReturned"), static_cast<qint64>(mRowsReturned)},
+            {QStringLiteral("cumulativeExecutionTime"), mCumulativeExecutionTime},
+            {QStringLiteral("executionTime"), mExecutionTimeHistogram.toJson()},
+            {QStringLiteral("stepTime"), mStepTimeHistogram.toJson()},
+            {QStringLiteral("rows"), mRowsHistogram.toJson()}};
+}
+
+DatabaseStatement::DatabaseStatement(const QSqlDatabase &database) : QSqlQuery(database)
+{
+}
+
+void DatabaseStatement::setQueryText(const QString &queryText)
+{
+    if (queryText == mStatistics.mQueryText) {
+        return;
+    }
+
+    flushPendingExecution();
+
+    mStatistics.mQueryText = queryText;
+    mStatistics.mIsPrepared = false;
+    mPrepareFailed = false;
+}
+
+bool DatabaseStatement::ensurePrepared()
+{
+    if (mStatistics.mIsPrepared) {
+        return true;
+    }
+
+    if (mPrepareFailed || mStatistics.mQueryText.isEmpty()) {
+        return false;
+    }
+
+    auto timer = QElapsedTimer{};
+    timer.start();
+
+    setForwardOnly(true);
+    mStatistics.mIsPrepared = QSqlQuery::prepare(mStatistics.mQueryText);
+    mStatistics.mPrepareTime = timer.nsecsElapsed();
+
+    if (!mStatistics.mIsPrepared) {
+        mPrepareFailed = true;
+
+        qCDebug(orgKdeElisaDatabase) << "DatabaseStatement::ensurePrepared" << mStatistics.mQueryText;
+        qCDebug(orgKdeElisaDatabase) << "DatabaseStatement::ensurePrepared" << lastError();
+    }
+
+    return mStatistics.mIsPrepared;
+}
+
+void DatabaseStatement::bindValue(const QString &placeholder, const QVariant &value, QSql::ParamType paramType)
+{
+    if (!ensurePrepared()) {
+        return;
+    }
+
+    QSqlQuery::bindValue(placeholder, value, paramType);
+}
+
+bool DatabaseStatement::exec()
+{
+    if (!ensurePrepared()) {
+        return false;
+    }
+
+    return QSqlQuery::exec();
+}
+
+bool DatabaseStatement::next()
+{
+    auto timer = QElapsedTimer{};
+    timer.start();
+
+    auto result = QSqlQuery::next();
+
+    mPendingStepTime += timer.nsecsElapsed();
+    if (result) {
+        ++mPendingRows;
+    }
+
+    return result;
+}
+
+void DatabaseStatement::finish()
+{
+    flushPendingExecution();
+
+    QSqlQuery::finish();
+}
+
+void DatabaseStatement::recordExecution(qint64 executionTime, bool isSlow)
+{
+    flushPendingExecution();
+
+    ++mStatistics.mExecutionCount;
+    mStatistics.mCumulativeExecutionTime += executionTime;
+    mStatistics.mExecutionTimeHistogram.addSample(executionTime);
+
+    if (isSlow) {
+        ++mStatistics.mSlowExecutionCount;
+    }
+
+    mHasPendingExecution = isSelect();
+    mPendingStepTime = 0;
+    mPendingRows = 0;
+}
+
+void DatabaseStatement::flushPendingExecution()
+{
+    if (!mHasPendingExecution) {
+        return;
+    }
+
+    mStatistics.mStepTimeHistogram.addSample(mPendingStepTime);
+    mStatistics.mRowsHistogram.addSample(static_cast<qint64>(mPendingRows));
+    mStatistics.mRowsReturned += mPendingRows;
+
+    mHasPendingExecution = false;
+    mPendingStepTime = 0;
+    mPendingRows = 0;
+}
@@ -0,0 +1,152 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef DATABASESTATEMENT_H
+#define DATABASESTATEMENT_H
+
+#include "elisaLib_export.h"
+
+#include <QSqlQuery>
+#include <QString>
+#include <QVariant>
+#include <QJsonObject>
+#include <QMetaType>
+
+#include <array>
+
+class QSqlDatabase;
+
+/**
+ * Histogram with decade buckets: the first bucket holds samples below the first
+ * upper bound, each following bucket has a ten times larger upper bound and the
+ * last one is unbounded.
+ */
+class ELISALIB_EXPORT DatabaseHistogram
+{
+public:
+
+    enum {
+        BucketsCount = 8,
+    };
+
+    explicit DatabaseHistogram(qint64 firstUpperBound = 1);
+
+    void addSample(qint64 value);
+
+    QJsonObject toJson() const;
+
+    qint64 mFirstUpperBound = 1;
+
+    std::array<qulonglong, BucketsCount> mBuckets = {};
+
+    qulonglong mCount = 0;
+
+    qint64 mTotal = 0;
+
+    qint64 mMaximum = 0;
+
+};
+
+class ELISALIB_EXPORT DatabaseStatementStatistics
+{
+public:
+
+    QJsonObject toJson() const;
+
+    QString mQueryText;
+
+    bool mIsPrepared = false;
+
+    qulonglong mExecutionCount = 0;
+
+    qulonglong mSlowExecutionCount = 0;
+
+    qulonglong mRowsReturned = 0;
+
+    qint64 mCumulativeExecutionTime = 0;
+
+    qint64 mPrepareTime = 0;
+
+    /**
+     * time spent in QSqlQuery::exec, in nanoseconds
+     */
+    DatabaseHistogram mExecutionTimeHistogram{10000};
+
+    /**
+     * time spent fetching the rows of one execution of a select, in nanoseconds
+     */
+    DatabaseHistogram mStepTimeHistogram{10000};
+
+    /**
+     * number of rows fetched from one execution of a select
+     */
+    DatabaseHistogram mRowsHistogram{1};
+
+};
+
+/**
+ * A prepared statement that is only compiled by the database driver on its first use.
+ *
+ * Binding a value or executing the statement triggers the preparation. Execution counts
+ * and times are recorded by DatabaseInterface; rows and fetch times are recorded here
+ * when the rows are read through next().
+ *
+ * QSqlQuery is inherited privately: its bindValue, exec, next and finish are not virtual
+ * and calling them through a QSqlQuery reference would skip the preparation and the
+ * statistics. Only the read-only accessors are forwarded.
+ */
+class ELISALIB_EXPORT DatabaseStatement : private QSqlQuery
+{
+public:
+
+    explicit DatabaseStatement(const QSqlDatabase &database);
+
+    using QSqlQuery::boundValues;
+    using QSqlQuery::isActive;
+    using QSqlQuery::isSelect;
+    using QSqlQuery::lastError;
+    using QSqlQuery::lastQuery;
+    using QSqlQuery::record;
+    using QSqlQuery::value;
+
+    void setQueryText(const QString &queryText);
+
+    bool ensurePrepared();
+
+    void bindValue(const QString &placeholder, const QVariant &value, QSql::ParamType paramType = QSql::In);
+
+    bool exec();
+
+    bool next();
+
+    void finish();
+
+    void recordExecution(qint64 executionTime, bool isSlow);
+
+    const DatabaseStatementStatistics &statistics() const
+    {
+        return mStatistics;
+    }
+
+private:
+
+    void flushPendingExecution();
+
+    DatabaseStatementStatistics mStatistics;
+
+    qint64 mPendingStepTime = 0;
+
+    qulonglong mPendingRows = 0;
+
+    bool mHasPendingExecution = false;
+
+    bool mPrepareFailed = false;
+
+};
+
+Q_DECLARE_METATYPE(DatabaseStatementStatistics)
+
+#endif // DATABASESTATEMENT_H
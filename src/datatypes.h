@@ -71,6 +71,10 @@ public:
         IsDirectoryRole,
         IsPlayListRole,
         FilePathRole,
+        ReplayGainTrackGainRole,
+        ReplayGainTrackPeakRole,
+        ReplayGainAlbumGainRole,
+        ReplayGainAlbumPeakRole,
     };
 
     Q_ENUM(ColumnsRoles)
@@ -370,6 +374,59 @@ public:
 
     using ListGenreDataType = QList<GenreDataType>;
 
+    class SortFilterParameters
+    {
+    public:
+
+        int mSortRole = Qt::DisplayRole;
+
+        Qt::SortOrder mSortOrder = Qt::AscendingOrder;
+
+        QString mFilterText;
+
+        int mFilterRating = 0;
+
+        bool operator==(const SortFilterParameters &other) const
+        {
+            return mSortRole == other.mSortRole && mSortOrder == other.mSortOrder &&
+                    mFilterText == other.mFilterText && mFilterRating == other.mFilterRating;
+        }
+
+        bool operator!=(const SortFilterParameters &other) const
+        {
+            return !(*this == other);
+        }
+
+    };
+
+    class LibraryChanges
+    {
+    public:
+
+        enum ChangeType {
+            Inserted,
+            Modified,
+            Removed,
+            Reset,
+        };
+
+        qulonglong mGeneration = 0;
+
+        bool mNeedFullReload = false;
+
+        QMap<ElisaUtils::PlayListEntryType, QList<qulonglong>> mInsertedIds;
+
+        QMap<ElisaUtils::PlayListEntryType, QList<qulonglong>> mModifiedIds;
+
+        QMap<ElisaUtils::PlayListEntryType, QList<qulonglong>> mRemovedIds;
+
+        bool isEmpty() const
+        {
+            return !mNeedFullReload && mInsertedIds.isEmpty() && mModifiedIds.isEmpty() && mRemovedIds.isEmpty();
+        }
+
+    };
+
     using EntryData = std::tuple<MusicDataType, QString, QUrl>;
     using EntryDataList = QList<EntryData>;
 
@@ -386,6 +443,10 @@ Q_DECLARE_METATYPE(DataTypes::ListAlbumDataType)
 Q_DECLARE_METATYPE(DataTypes::ListArtistDataType)
 Q_DECLARE_METATYPE(DataTypes::ListGenreDataType)
 
+Q_DECLARE_METATYPE(DataTypes::SortFilterParameters)
+
+Q_DECLARE_METATYPE(DataTypes::LibraryChanges)
+
 Q_DECLARE_METATYPE(DataTypes::EntryData)
 Q_DECLARE_METATYPE(DataTypes::EntryDataList)
 
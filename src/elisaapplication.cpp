@@ -16,6 +16,9 @@
 #include "managemediaplayercontrol.h"
 #include "manageheaderbar.h"
 #include "databaseinterface.h"
+#include "radiohistoryrecorder.h"
+#include "loudnessmeter.h"
+#include "startuptrace.h"
 
 #include "elisa_settings.h"
 #include <KConfigCore/KAuthorized>
@@ -46,6 +49,7 @@
 #include <QFileInfo>
 #include <QDir>
 #include <QFileSystemWatcher>
+#include <QTimer>
 #include <QKeyEvent>
 #include <QDebug>
 #include <QFileSystemWatcher>
@@ -88,6 +92,10 @@ public:
 
     QFileSystemWatcher mConfigFileWatcher;
 
+    QMetaObject::Connection mFirstFrameConnection;
+
+    bool mBackgroundTasksStarted = false;
+
 };
 
 ElisaApplication::ElisaApplication(QObject *parent) : QObject(parent), d(std::make_unique<ElisaApplicationPrivate>(this))
@@ -305,7 +313,29 @@ void ElisaApplication::configChanged()
 
     Q_EMIT showProgressOnTaskBarChanged();
     Q_EMIT showSystemTrayIconChanged();
+    Q_EMIT positionUpdateRateChanged();
     Q_EMIT embeddedViewChanged();
+
+    if (d->mAudioWrapper) {
+        d->mAudioWrapper->setReadAheadBuffering(currentConfiguration->readAheadBuffering());
+    }
+}
+
+void ElisaApplication::startBackgroundTasks()
+{
+    disconnect(d->mFirstFrameConnection);
+
+    if (d->mBackgroundTasksStarted) {
+        return;
+    }
+
+    d->mBackgroundTasksStarted = true;
+
+    StartupTrace::markPhase(QStringLiteral("first frame"));
+
+    if (d->mMusicManager) {
+        d->mMusicManager->startBackgroundTasks();
+    }
 }
 
 DataTypes::EntryDataList ElisaApplication::checkFileListAndMakeAbsolute(const DataTypes::EntryDataList &filesList,
@@ -345,7 +375,10 @@ DataTypes::EntryDataList ElisaApplication::checkFileListAndMakeAbsolute(const Da
 void ElisaApplication::initialize()
 {
     initializeModels();
+    StartupTrace::markPhase(QStringLiteral("models"));
+
     initializePlayer();
+    StartupTrace::markPhase(QStringLiteral("player"));
 
     Q_EMIT initializationDone();
 }
@@ -358,6 +391,10 @@ void ElisaApplication::setQmlEngine(QQmlEngine *engine)
 void ElisaApplication::initializeModels()
 {
     d->mMusicManager = std::make_unique<MusicListenersManager>();
+    // scanning the music collection competes with the display of the main window
+    d->mMusicManager->delayBackgroundTasks();
+    // a window that is never shown, or that never asks for it, must not prevent the indexing of the music collection
+    QTimer::singleShot(3000, this, &ElisaApplication::startBackgroundTasks);
     Q_EMIT musicManagerChanged();
 
     d->mMediaPlayList = std::make_unique<MediaPlayList>();
@@ -379,6 +416,8 @@ void ElisaApplication::initializeModels()
 void ElisaApplication::initializePlayer()
 {
     d->mAudioWrapper = std::make_unique<AudioWrapper>();
+    d->mAudioWrapper->setPositionUpdateRate(positionUpdateRate());
+    d->mAudioWrapper->setReadAheadBuffering(Elisa::ElisaConfiguration::self()->readAheadBuffering());
     Q_EMIT audioPlayerChanged();
     d->mAudioControl = std::make_unique<ManageAudioPlayer>();
     Q_EMIT audioControlChanged();
@@ -406,13 +445,49 @@ void ElisaApplication::initializePlayer()
 
     QObject::connect(d->mAudioControl.get(), &ManageAudioPlayer::sourceInError, d->mMusicManager.get(), &MusicListenersManager::playBackError);
     QObject::connect(d->mAudioControl.get(), &ManageAudioPlayer::playerSourceChanged, d->mAudioWrapper.get(), &AudioWrapper::setSource);
+    QObject::connect(d->mAudioControl.get(), &ManageAudioPlayer::playerNextSourceChanged, d->mAudioWrapper.get(), &AudioWrapper::setNextSource);
     QObject::connect(d->mAudioControl.get(), &ManageAudioPlayer::startedPlayingTrack,
                      d->mMusicManager->viewDatabase(), &DatabaseInterface::trackHasStartedPlaying);
-    QObject::connect(d->mAudioControl.get(), &ManageAudioPlayer::updateData, d->mMediaPlayList.get(), &MediaPlayList::setData);
+    QObject::connect(d->mAudioControl.get(), &ManageAudioPlayer::playerSourceChanged,
+                     d->mMusicManager->viewDatabase(), &DatabaseInterface::askReplayGain);
+    QObject::connect(d->mAudioControl.get(), &ManageAudioPlayer::playerNextSourceChanged,
+                     d->mMusicManager->viewDatabase(), &DatabaseInterface::askReplayGain);
+    QObject::connect(d->mMusicManager->viewDatabase(), &DatabaseInterface::replayGainAvailable,
+                     d->mAudioWrapper.get(), [this](const DataTypes::TrackDataType &trackGain) {
+        auto gain = 0.;
+
+        switch (Elisa::ElisaConfiguration::replayGainMode())
+        {
+        case Elisa::ElisaConfiguration::EnumReplayGainMode::Disabled:
+            break;
+        case Elisa::ElisaConfiguration::EnumReplayGainMode::Track:
+            if (trackGain.contains(DataTypes::ReplayGainTrackGainRole)) {
+                gain = LoudnessMeter::clippingSafeGain(trackGain[DataTypes::ReplayGainTrackGainRole].toDouble(),
+                                                       trackGain[DataTypes::ReplayGainTrackPeakRole].toDouble());
+            }
+            break;
+        case Elisa::ElisaConfiguration::EnumReplayGainMode::Album:
+            if (trackGain.contains(DataTypes::ReplayGainAlbumGainRole)) {
+                gain = LoudnessMeter::clippingSafeGain(trackGain[DataTypes::ReplayGainAlbumGainRole].toDouble(),
+                                                       trackGain[DataTypes::ReplayGainAlbumPeakRole].toDouble());
+            }
+            break;
+        }
+
+        d->mAudioWrapper->setReplayGain(trackGain.resourceURI(), gain);
+    });
+    QObject::connect(d->mAudioControl.get(), &ManageAudioPlayer::updateItemData, d->mMediaPlayListProxyModel.get(), &MediaPlayListProxyModel::setItemData);
+    QObject::connect(d->mAudioControl.get(), &ManageAudioPlayer::radioNowPlayingChanged,
+                     d->mMusicManager->radioHistoryRecorder(), &RadioHistoryRecorder::recordNowPlaying);
 
     QObject::connect(d->mMediaPlayListProxyModel.get(), &MediaPlayListProxyModel::ensurePlay, d->mAudioControl.get(), &ManageAudioPlayer::ensurePlay);
     QObject::connect(d->mMediaPlayListProxyModel.get(), &MediaPlayListProxyModel::playListFinished, d->mAudioControl.get(), &ManageAudioPlayer::playListFinished);
     QObject::connect(d->mMediaPlayListProxyModel.get(), &MediaPlayListProxyModel::currentTrackChanged, d->mAudioControl.get(), &ManageAudioPlayer::setCurrentTrack);
+    QObject::connect(d->mMediaPlayListProxyModel.get(), &MediaPlayListProxyModel::nextTrackChanged, d->mAudioControl.get(), &ManageAudioPlayer::setNextTrack);
+    QObject::connect(d->mMediaPlayListProxyModel.get(), &MediaPlayListProxyModel::clearPlayListPlayer, d->mAudioControl.get(), [this]() {
+        // no position is published while the main window is hidden
+        d->mAudioControl->setPlayerPosition(d->mAudioWrapper->estimatedPosition());
+    });
     QObject::connect(d->mMediaPlayListProxyModel.get(), &MediaPlayListProxyModel::clearPlayListPlayer, d->mAudioControl.get(), &ManageAudioPlayer::saveForUndoClearPlaylist);
     QObject::connect(d->mMediaPlayListProxyModel.get(), &MediaPlayListProxyModel::undoClearPlayListPlayer, d->mAudioControl.get(), &ManageAudioPlayer::restoreForUndoClearPlaylist);
     QObject::connect(d->mMediaPlayListProxyModel.get(), &MediaPlayListProxyModel::seek, d->mAudioWrapper.get(), &AudioWrapper::seek);
@@ -420,6 +495,7 @@ void ElisaApplication::initializePlayer()
     QObject::connect(d->mAudioWrapper.get(), &AudioWrapper::playbackStateChanged,
                      d->mAudioControl.get(), &ManageAudioPlayer::setPlayerPlaybackState);
     QObject::connect(d->mAudioWrapper.get(), &AudioWrapper::statusChanged, d->mAudioControl.get(), &ManageAudioPlayer::setPlayerStatus);
+    QObject::connect(d->mAudioWrapper.get(), &AudioWrapper::nextSourceStarted, d->mAudioControl.get(), &ManageAudioPlayer::playerSwitchedToNextSource);
     QObject::connect(d->mAudioWrapper.get(), &AudioWrapper::errorChanged, d->mAudioControl.get(), &ManageAudioPlayer::setPlayerError);
     QObject::connect(d->mAudioWrapper.get(), &AudioWrapper::durationChanged, d->mAudioControl.get(), &ManageAudioPlayer::setAudioDuration);
     QObject::connect(d->mAudioWrapper.get(), &AudioWrapper::seekableChanged, d->mAudioControl.get(), &ManageAudioPlayer::setPlayerIsSeekable);
@@ -486,6 +562,16 @@ void ElisaApplication::installKeyEventFilter(QObject *object)
     object->installEventFilter(this);
 }
 
+void ElisaApplication::startBackgroundTasksAfterFirstFrame(QObject *window)
+{
+    if (!window) {
+        return;
+    }
+
+    // QQuickWindow::frameSwapped is emitted from the render thread
+    d->mFirstFrameConnection = connect(window, SIGNAL(frameSwapped()), this, SLOT(startBackgroundTasks()), Qt::QueuedConnection);
+}
+
 bool ElisaApplication::eventFilter(QObject *object, QEvent *event)
 {
     Q_UNUSED(object)
@@ -554,6 +640,13 @@ bool ElisaApplication::showSystemTrayIcon() const
     return currentConfiguration->showSystemTrayIcon();
 }
 
+int ElisaApplication::positionUpdateRate() const
+{
+    auto currentConfiguration = Elisa::ElisaConfiguration::self();
+
+    return currentConfiguration->positionUpdateRate();
+}
+
 ElisaUtils::PlayListEntryType ElisaApplication::embeddedView() const
 {
     ElisaUtils::PlayListEntryType result = ElisaUtils::Unknown;
@@ -84,6 +84,10 @@ class ELISALIB_EXPORT ElisaApplication : public QObject
                READ showSystemTrayIcon
                NOTIFY showSystemTrayIconChanged)
 
+    Q_PROPERTY(int positionUpdateRate
+               READ positionUpdateRate
+               NOTIFY positionUpdateRateChanged)
+
 public:
     explicit ElisaApplication(QObject *parent = nullptr);
 
@@ -95,6 +99,11 @@ public:
 
     Q_INVOKABLE void installKeyEventFilter(QObject *object);
 
+    /**
+     * start the indexers and other background tasks once window has displayed its first frame
+     */
+    Q_INVOKABLE void startBackgroundTasksAfterFirstFrame(QObject *window);
+
     bool eventFilter(QObject *object, QEvent *event) override;
 
     const DataTypes::EntryDataList &arguments() const;
@@ -117,6 +126,8 @@ public:
 
     bool showSystemTrayIcon() const;
 
+    int positionUpdateRate() const;
+
     ElisaUtils::PlayListEntryType embeddedView() const;
 
 Q_SIGNALS:
@@ -147,6 +158,8 @@ Q_SIGNALS:
 
     void showSystemTrayIconChanged();
 
+    void positionUpdateRateChanged();
+
     void commitDataRequest(QSessionManager &manager);
 
     void embeddedViewChanged();
@@ -193,6 +206,8 @@ private Q_SLOTS:
 
     void configChanged();
 
+    void startBackgroundTasks();
+
 private:
 
     void initializeModels();
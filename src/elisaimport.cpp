@@ -5,42 +5,116 @@
  */
 
 #include "config-upnp-qt.h"
+#include "elisa-version.h"
 
-#include "musiclistenersmanager.h"
 #include "elisaimportapplication.h"
 #include "elisa_settings.h"
+#include "datatypes.h"
 
 #include <QCoreApplication>
 #include <QCommandLineParser>
+#include <QDir>
 #include <QStandardPaths>
+#include <QThread>
 
 int main(int argc, char *argv[])
 {
     QCoreApplication app(argc, argv);
 
+    // same identity as Elisa, its database is found in the same data location
+    QCoreApplication::setApplicationName(QStringLiteral("elisa"));
+    QCoreApplication::setOrganizationDomain(QStringLiteral("kde.org"));
+    QCoreApplication::setApplicationVersion(QStringLiteral(ELISA_VERSION_STRING));
+
     qRegisterMetaType<QHash<QString,QUrl>>("QHash<QString,QUrl>");
+    qRegisterMetaType<QHash<QUrl,QDateTime>>("QHash<QUrl,QDateTime>");
     qRegisterMetaType<QVector<qulonglong>>("QVector<qulonglong>");
     qRegisterMetaType<QHash<qulonglong,int>>("QHash<qulonglong,int>");
     qRegisterMetaType<QMap<QString, int>>();
     qRegisterMetaType<QMap<QString,int>>("QMap<QString,int>");
+    qRegisterMetaType<DataTypes::ListTrackDataType>("DataTypes::ListTrackDataType");
 
     QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Import music files into an Elisa database. "
+                                                    "An interrupted import resumes when run again with the same database."));
     parser.addHelpOption();
     parser.addVersionOption();
+
+    QCommandLineOption databaseOption(QStringList{QStringLiteral("d"), QStringLiteral("database")},
+                                      QStringLiteral("Database file to create or update, defaults to the database of Elisa."),
+                                      QStringLiteral("file"));
+    parser.addOption(databaseOption);
+
+    QCommandLineOption workersOption(QStringList{QStringLiteral("j"), QStringLiteral("workers")},
+                                     QStringLiteral("Number of files scanned in parallel, defaults to the number of processors."),
+                                     QStringLiteral("count"), QString::number(QThread::idealThreadCount()));
+    parser.addOption(workersOption);
+
+    QCommandLineOption batchSizeOption(QStringLiteral("batch-size"),
+                                       QStringLiteral("Number of files committed to the database at once."),
+                                       QStringLiteral("count"), QStringLiteral("200"));
+    parser.addOption(batchSizeOption);
+
+    QCommandLineOption quietOption(QStringList{QStringLiteral("q"), QStringLiteral("quiet")},
+                                   QStringLiteral("Do not report progress."));
+    parser.addOption(quietOption);
+
+    parser.addPositionalArgument(QStringLiteral("paths"),
+                                 QStringLiteral("Folders to import, defaults to the music folders configured in Elisa."),
+                                 QStringLiteral("[paths...]"));
+
     parser.process(app);
 
-    auto configurationFileName = QStandardPaths::writableLocation(QStandardPaths::ConfigLocation);
-    configurationFileName += QStringLiteral("/elisarc");
-    Elisa::ElisaConfiguration::instance(configurationFileName);
-    Elisa::ElisaConfiguration::self()->load();
-    Elisa::ElisaConfiguration::self()->save();
+    auto options = ElisaImportApplication::Options{};
+
+    options.mRootPaths = parser.positionalArguments();
+    if (options.mRootPaths.isEmpty()) {
+        auto configurationFileName = QStandardPaths::writableLocation(QStandardPaths::ConfigLocation);
+        configurationFileName += QStringLiteral("/elisarc");
+        Elisa::ElisaConfiguration::instance(configurationFileName);
+        Elisa::ElisaConfiguration::self()->load();
+
+        options.mRootPaths = Elisa::ElisaConfiguration::rootPath();
+        if (options.mRootPaths.isEmpty()) {
+            options.mRootPaths = QStandardPaths::standardLocations(QStandardPaths::MusicLocation);
+        }
+    }
 
-    MusicListenersManager myMusicManager;
-    ElisaImportApplication myApplication;
+    options.mDatabaseFileName = parser.value(databaseOption);
+    if (options.mDatabaseFileName.isEmpty()) {
+        const auto &localDataPaths = QStandardPaths::standardLocations(QStandardPaths::AppDataLocation);
+        if (!localDataPaths.isEmpty()) {
+            QDir().mkpath(localDataPaths.first());
+            options.mDatabaseFileName = localDataPaths.first() + QStringLiteral("/elisaDatabase.db");
+        }
+    }
 
-    QObject::connect(&myMusicManager, &MusicListenersManager::indexerBusyChanged,
-            &myApplication, &ElisaImportApplication::indexingChanged);
+    if (options.mDatabaseFileName.isEmpty()) {
+        parser.showHelp(1);
+    }
+
+    auto isValidNumber = false;
+
+    options.mWorkersCount = parser.value(workersOption).toInt(&isValidNumber);
+    if (!isValidNumber || options.mWorkersCount <= 0) {
+        parser.showHelp(1);
+    }
+
+    options.mBatchSize = parser.value(batchSizeOption).toInt(&isValidNumber);
+    if (!isValidNumber || options.mBatchSize <= 0) {
+        parser.showHelp(1);
+    }
+
+    if (parser.isSet(quietOption)) {
+        options.mProgressInterval = 0;
+    }
+
+    ElisaImportApplication myApplication(options);
+
+    QObject::connect(&myApplication, &ElisaImportApplication::importFinished,
+                     &app, &QCoreApplication::exit, Qt::QueuedConnection);
+
+    QMetaObject::invokeMethod(&myApplication, &ElisaImportApplication::start, Qt::QueuedConnection);
 
     return app.exec();
 }
-
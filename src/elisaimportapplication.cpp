@@ -6,22 +6,300 @@
 
 #include "elisaimportapplication.h"
 
+#include "databaseinterface.h"
+#include "filescanner.h"
+
 #include <QCoreApplication>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QTextStream>
+#include <QThread>
+#include <QThreadPool>
+#include <QTimer>
+
+#include <QtConcurrent>
 
-ElisaImportApplication::ElisaImportApplication(QObject *parent) : QObject(parent)
+#include <atomic>
+
+class ElisaImportApplicationPrivate
 {
+public:
+
+    explicit ElisaImportApplicationPrivate(ElisaImportApplication::Options options)
+        : mOptions(std::move(options))
+    {
+    }
+
+    ElisaImportApplication::Options mOptions;
+
+    QThread mDatabaseThread;
+
+    DatabaseInterface mDatabaseInterface;
+
+    QThreadPool mWorkers;
+
+    QTimer mProgressTimer;
+
+    QElapsedTimer mImportTimer;
+
+    QList<QFileInfo> mPendingFiles;
+
+    int mKnownFilesCount = 0;
+
+    std::atomic<int> mNextBatch{0};
+
+    std::atomic<int> mScannedFilesCount{0};
+
+    std::atomic<int> mValidTracksCount{0};
+
+    int mRunningWorkersCount = 0;
+
+    int mPendingBatchesCount = 0;
+
+    int mInsertedTracksCount = 0;
+
+    int mDatabaseErrorsCount = 0;
+
+    bool mIsFinished = false;
+
+};
+
+ElisaImportApplication::ElisaImportApplication(Options options, QObject *parent)
+    : QObject(parent), d(std::make_unique<ElisaImportApplicationPrivate>(std::move(options)))
+{
+    d->mOptions.mWorkersCount = std::max(d->mOptions.mWorkersCount, 1);
+    d->mOptions.mBatchSize = std::max(d->mOptions.mBatchSize, 1);
+
+    d->mWorkers.setMaxThreadCount(d->mOptions.mWorkersCount);
+
+    d->mDatabaseThread.setObjectName(QStringLiteral("database"));
+    d->mDatabaseThread.start();
+    d->mDatabaseInterface.moveToThread(&d->mDatabaseThread);
+
+    connect(&d->mDatabaseInterface, &DatabaseInterface::requestsInitDone,
+            this, &ElisaImportApplication::databaseIsReady);
+    connect(&d->mDatabaseInterface, &DatabaseInterface::restoredTracks,
+            this, &ElisaImportApplication::restoredTracks);
+    connect(&d->mDatabaseInterface, &DatabaseInterface::finishInsertingTracksList,
+            this, &ElisaImportApplication::batchInserted);
+    connect(&d->mDatabaseInterface, &DatabaseInterface::databaseError,
+            this, &ElisaImportApplication::databaseError);
+
+    connect(&d->mProgressTimer, &QTimer::timeout,
+            this, &ElisaImportApplication::reportProgress);
+}
+
+ElisaImportApplication::~ElisaImportApplication()
+{
+    d->mWorkers.waitForDone();
+
+    d->mDatabaseThread.quit();
+    d->mDatabaseThread.wait();
+}
+
+void ElisaImportApplication::start()
+{
+    QTextStream(stderr) << "importing " << d->mOptions.mRootPaths.join(QStringLiteral(", "))
+                        << " into " << d->mOptions.mDatabaseFileName
+                        << " with " << d->mOptions.mWorkersCount << " workers" << Qt::endl;
+
+    QMetaObject::invokeMethod(&d->mDatabaseInterface, "init", Qt::QueuedConnection,
+                              Q_ARG(QString, QStringLiteral("import")), Q_ARG(QString, d->mOptions.mDatabaseFileName));
+}
+
+void ElisaImportApplication::databaseIsReady()
+{
+    QMetaObject::invokeMethod(&d->mDatabaseInterface, "askRestoredTracks", Qt::QueuedConnection);
+}
+
+void ElisaImportApplication::restoredTracks(const QHash<QUrl, QDateTime> &allFiles)
+{
+    listFiles(allFiles);
+
+    QTextStream(stderr) << d->mPendingFiles.size() << " files to scan, "
+                        << d->mKnownFilesCount << " already imported files skipped" << Qt::endl;
+
+    scanFiles();
 }
 
-void ElisaImportApplication::indexingChanged()
+void ElisaImportApplication::listFiles(const QHash<QUrl, QDateTime> &knownFiles)
 {
-    static bool firstCall = true;
+    FileScanner fileScanner;
+
+    for (const auto &oneRootPath : qAsConst(d->mOptions.mRootPaths)) {
+        QDirIterator rootIterator(oneRootPath, QDir::Files | QDir::Readable, QDirIterator::Subdirectories | QDirIterator::FollowSymlinks);
+
+        while (rootIterator.hasNext()) {
+            rootIterator.next();
+
+            auto oneFile = rootIterator.fileInfo();
+            const auto fileUrl = QUrl::fromLocalFile(oneFile.canonicalFilePath());
 
-    if (firstCall) {
-        firstCall = false;
-    } else {
-        QCoreApplication::quit();
+            // a file already committed by a previous run is only scanned again if it was modified since
+            const auto itKnownFile = knownFiles.constFind(fileUrl);
+            if (itKnownFile != knownFiles.constEnd() && *itKnownFile >= oneFile.metadataChangeTime()) {
+                ++d->mKnownFilesCount;
+                continue;
+            }
+
+            if (!fileScanner.shouldScanFile(oneFile.canonicalFilePath())) {
+                continue;
+            }
+
+            d->mPendingFiles.push_back(oneFile);
+        }
     }
 }
 
+void ElisaImportApplication::scanFiles()
+{
+    d->mImportTimer.start();
+
+    if (d->mOptions.mProgressInterval > 0) {
+        d->mProgressTimer.start(d->mOptions.mProgressInterval);
+    }
+
+    const auto batchSize = d->mOptions.mBatchSize;
+    const auto batchesCount = static_cast<int>((d->mPendingFiles.size() + batchSize - 1) / batchSize);
+
+    d->mRunningWorkersCount = std::min(d->mOptions.mWorkersCount, batchesCount);
+
+    for (int worker = 0; worker < d->mRunningWorkersCount; ++worker) {
+        QtConcurrent::run(&d->mWorkers, [this, batchSize, batchesCount]() {
+            // scanning a file loads metadata extractors, each worker keeps its own scanner
+            FileScanner fileScanner;
+
+            for (auto batch = d->mNextBatch++; batch < batchesCount; batch = d->mNextBatch++) {
+                auto newTracks = DataTypes::ListTrackDataType{};
+                auto covers = QHash<QString, QUrl>{};
+                auto coversByDirectory = QHash<QString, QUrl>{};
+
+                const auto lastFile = std::min(static_cast<int>(d->mPendingFiles.size()), (batch + 1) * batchSize);
+                for (auto fileIndex = batch * batchSize; fileIndex < lastFile; ++fileIndex) {
+                    const auto &oneFile = d->mPendingFiles.at(fileIndex);
+                    const auto newTrack = fileScanner.scanOneFile(QUrl::fromLocalFile(oneFile.canonicalFilePath()), oneFile);
+
+                    ++d->mScannedFilesCount;
+
+                    if (!newTrack.isValid()) {
+                        continue;
+                    }
+
+                    const auto directoryPath = oneFile.canonicalPath();
+                    auto itCover = coversByDirectory.find(directoryPath);
+                    if (itCover == coversByDirectory.end()) {
+                        itCover = coversByDirectory.insert(directoryPath, fileScanner.searchForCoverFile(oneFile.canonicalFilePath()));
+                    }
+
+                    if (!itCover->isEmpty()) {
+                        covers[newTrack.resourceURI().toString()] = *itCover;
+                    }
+
+                    newTracks.push_back(newTrack);
+                }
+
+                if (newTracks.isEmpty()) {
+                    continue;
+                }
+
+                d->mValidTracksCount += newTracks.size();
+
+                QMetaObject::invokeMethod(this, [this, newTracks, covers]() {
+                    ++d->mPendingBatchesCount;
+                    d->mInsertedTracksCount += newTracks.size();
+
+                    QMetaObject::invokeMethod(&d->mDatabaseInterface, "insertTracksList", Qt::QueuedConnection,
+                                              Q_ARG(DataTypes::ListTrackDataType, newTracks), Q_ARG(QHash<QString,QUrl>, covers));
+                }, Qt::QueuedConnection);
+            }
+
+            QMetaObject::invokeMethod(this, &ElisaImportApplication::workerFinished, Qt::QueuedConnection);
+        });
+    }
+
+    finishWhenIdle();
+}
+
+void ElisaImportApplication::batchInserted()
+{
+    --d->mPendingBatchesCount;
+
+    finishWhenIdle();
+}
+
+void ElisaImportApplication::workerFinished()
+{
+    --d->mRunningWorkersCount;
+
+    finishWhenIdle();
+}
+
+void ElisaImportApplication::reportProgress()
+{
+    const auto scannedFilesCount = d->mScannedFilesCount.load();
+    const auto elapsedSeconds = d->mImportTimer.elapsed() / 1000.;
+    const auto throughput = elapsedSeconds > 0 ? scannedFilesCount / elapsedSeconds : 0.;
+    const auto remainingFilesCount = d->mPendingFiles.size() - scannedFilesCount;
+
+    QTextStream progress(stderr);
+
+    progress << scannedFilesCount << '/' << d->mPendingFiles.size() << " files scanned, "
+             << d->mValidTracksCount.load() << " tracks, "
+             << QString::number(throughput, 'f', 1) << " files/s";
+
+    if (throughput > 0 && remainingFilesCount > 0) {
+        // a large collection on a slow disk can take more than a day
+        const auto remainingSeconds = static_cast<qint64>(remainingFilesCount / throughput);
+        const auto remainingDays = remainingSeconds / 86400;
+
+        progress << ", ETA ";
+        if (remainingDays > 0) {
+            progress << remainingDays << "d ";
+        }
+        progress << QStringLiteral("%1:%2:%3").arg(remainingSeconds % 86400 / 3600, 2, 10, QLatin1Char('0'))
+                                              .arg(remainingSeconds % 3600 / 60, 2, 10, QLatin1Char('0'))
+                                              .arg(remainingSeconds % 60, 2, 10, QLatin1Char('0'));
+    }
+
+    progress << Qt::endl;
+}
+
+void ElisaImportApplication::databaseError()
+{
+    ++d->mDatabaseErrorsCount;
+
+    if (!d->mImportTimer.isValid() && !d->mIsFinished) {
+        d->mIsFinished = true;
+
+        QTextStream(stderr) << "cannot read " << d->mOptions.mDatabaseFileName << Qt::endl;
+
+        Q_EMIT importFinished(1);
+    }
+}
+
+void ElisaImportApplication::finishWhenIdle()
+{
+    if (d->mIsFinished || d->mRunningWorkersCount > 0 || d->mPendingBatchesCount > 0) {
+        return;
+    }
+
+    d->mIsFinished = true;
+    d->mProgressTimer.stop();
+
+    if (d->mOptions.mProgressInterval > 0) {
+        reportProgress();
+    }
+
+    QTextStream(stderr) << d->mInsertedTracksCount << " tracks imported in "
+                        << QString::number(d->mImportTimer.elapsed() / 1000., 'f', 1) << " s";
+    if (d->mDatabaseErrorsCount > 0) {
+        QTextStream(stderr) << ", " << d->mDatabaseErrorsCount << " database errors";
+    }
+    QTextStream(stderr) << Qt::endl;
+
+    Q_EMIT importFinished(d->mDatabaseErrorsCount > 0 ? 1 : 0);
+}
+
 
 #include "moc_elisaimportapplication.cpp"
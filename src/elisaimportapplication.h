@@ -8,18 +8,79 @@
 #define ELISAIMPORTAPPLICATION_H
 
 #include <QObject>
+#include <QDateTime>
+#include <QHash>
+#include <QStringList>
+#include <QUrl>
 
+#include <memory>
+
+class ElisaImportApplicationPrivate;
+
+/**
+ * Batch import of music files into an Elisa database without any GUI.
+ *
+ * Files are scanned by a pool of workers and inserted in the database by
+ * batches, each batch being committed in its own transaction. Files already
+ * in the database with an unchanged modification time are skipped, so an
+ * interrupted import resumes where the last committed batch stopped.
+ */
 class ElisaImportApplication : public QObject
 {
     Q_OBJECT
 public:
-    explicit ElisaImportApplication(QObject *parent = nullptr);
+
+    struct Options
+    {
+        QStringList mRootPaths;
+
+        QString mDatabaseFileName;
+
+        int mWorkersCount = 1;
+
+        int mBatchSize = 200;
+
+        /**
+         * interval between progress reports in milliseconds, 0 disables them
+         */
+        int mProgressInterval = 1000;
+    };
+
+    explicit ElisaImportApplication(Options options, QObject *parent = nullptr);
+
+    ~ElisaImportApplication() override;
 
 Q_SIGNALS:
 
+    void importFinished(int exitCode);
+
 public Q_SLOTS:
 
-    void indexingChanged();
+    void start();
+
+private Q_SLOTS:
+
+    void databaseIsReady();
+
+    void restoredTracks(const QHash<QUrl, QDateTime> &allFiles);
+
+    void batchInserted();
+
+    void workerFinished();
+
+    void reportProgress();
+
+    void databaseError();
+
+private:
+
+    void listFiles(const QHash<QUrl, QDateTime> &knownFiles);
+
+    void scanFiles();
+
+    void finishWhenIdle();
+
+    std::unique_ptr<ElisaImportApplicationPrivate> d;
 
 };
 
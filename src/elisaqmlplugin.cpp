@@ -56,6 +56,8 @@
 #include "embeddedcoverageimageprovider.h"
 #endif
 
+#include "waveformimageprovider.h"
+
 #if defined KF5KIO_FOUND && KF5KIO_FOUND
 #include "models/filebrowsermodel.h"
 #include "models/filebrowserproxymodel.h"
@@ -88,6 +90,7 @@ void ElisaQmlTestPlugin::initializeEngine(QQmlEngine *engine, const char *uri)
 #if defined KF5FileMetaData_FOUND && KF5FileMetaData_FOUND
     engine->addImageProvider(QStringLiteral("cover"), new EmbeddedCoverageImageProvider);
 #endif
+    engine->addImageProvider(QStringLiteral("waveform"), new WaveformImageProvider);
 }
 
 void ElisaQmlTestPlugin::registerTypes(const char *uri)
@@ -173,6 +176,8 @@ void ElisaQmlTestPlugin::registerTypes(const char *uri)
     qRegisterMetaType<ElisaUtils::PlayListEntryType>("ElisaUtils::PlayListEntryType");
     qRegisterMetaType<DataTypes::EntryData>("DataTypes::EntryData");
     qRegisterMetaType<DataTypes::EntryDataList>("DataTypes::EntryDataList");
+    qRegisterMetaType<DataTypes::SortFilterParameters>("DataTypes::SortFilterParameters");
+    qRegisterMetaType<DataTypes::LibraryChanges>("DataTypes::LibraryChanges");
     qRegisterMetaType<ElisaUtils::FilterType>("ElisaUtils::FilterType");
     qRegisterMetaType<DataTypes::TrackDataType>("DataTypes::TrackDataType");
     qRegisterMetaType<DataTypes::AlbumDataType>("DataTypes::AlbumDataType");
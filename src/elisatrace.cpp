@@ -0,0 +1,200 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "elisatrace.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
+
+#include <memory>
+#include <vector>
+
+namespace {
+
+struct TraceEvent
+{
+    const char *mCategory = nullptr;
+
+    const char *mName = nullptr;
+
+    char mPhase = 'X';
+
+    qint64 mTimestamp = 0;
+
+    qint64 mDuration = 0;
+
+    QString mDetail;
+};
+
+struct ThreadEvents
+{
+    QMutex mMutex;
+
+    int mThreadId = 0;
+
+    QString mThreadName;
+
+    std::vector<TraceEvent> mEvents;
+};
+
+struct TraceData
+{
+    TraceData()
+    {
+        mTimer.start();
+    }
+
+    QMutex mMutex;
+
+    QElapsedTimer mTimer;
+
+    std::vector<std::shared_ptr<ThreadEvents>> mThreads;
+};
+
+TraceData &traceData()
+{
+    static TraceData data;
+
+    return data;
+}
+
+void writeTraceOnExit()
+{
+    ElisaTrace::writeTraceFile(qEnvironmentVariable("ELISA_TRACE_FILE"));
+}
+
+ThreadEvents &currentThreadEvents()
+{
+    // buffers are shared with the trace data so that events outlive the thread that recorded them
+    thread_local std::shared_ptr<ThreadEvents> threadEvents;
+
+    if (!threadEvents) {
+        threadEvents = std::make_shared<ThreadEvents>();
+
+        auto currentThread = QThread::currentThread();
+        threadEvents->mThreadName = currentThread->objectName();
+        if (threadEvents->mThreadName.isEmpty()) {
+            auto isMainThread = QCoreApplication::instance() && QCoreApplication::instance()->thread() == currentThread;
+            threadEvents->mThreadName = isMainThread ? QStringLiteral("main") : QStringLiteral("thread");
+        }
+
+        auto &data = traceData();
+        QMutexLocker locker(&data.mMutex);
+
+        threadEvents->mThreadId = static_cast<int>(data.mThreads.size()) + 1;
+        data.mThreads.push_back(threadEvents);
+    }
+
+    return *threadEvents;
+}
+
+}
+
+bool ElisaTrace::isEnabled()
+{
+    static const bool enabled = [] {
+        auto isEnabled = !qEnvironmentVariableIsEmpty("ELISA_TRACE_FILE");
+
+        if (isEnabled) {
+            traceData();
+            qAddPostRoutine(writeTraceOnExit);
+        }
+
+        return isEnabled;
+    }();
+
+    return enabled;
+}
+
+qint64 ElisaTrace::timestamp()
+{
+    return traceData().mTimer.nsecsElapsed() / 1000;
+}
+
+void ElisaTrace::addCompleteEvent(const char *category, const char *name, qint64 start, qint64 duration, const QString &detail)
+{
+    auto &threadEvents = currentThreadEvents();
+    QMutexLocker locker(&threadEvents.mMutex);
+
+    threadEvents.mEvents.push_back({category, name, 'X', start, duration, detail});
+}
+
+void ElisaTrace::addInstantEvent(const char *category, const char *name, const QString &detail)
+{
+    const auto eventTimestamp = timestamp();
+
+    auto &threadEvents = currentThreadEvents();
+    QMutexLocker locker(&threadEvents.mMutex);
+
+    threadEvents.mEvents.push_back({category, name, 'i', eventTimestamp, 0, detail});
+}
+
+bool ElisaTrace::writeTraceFile(const QString &fileName)
+{
+    if (fileName.isEmpty()) {
+        return false;
+    }
+
+    auto &data = traceData();
+
+    auto allThreads = std::vector<std::shared_ptr<ThreadEvents>>{};
+    {
+        QMutexLocker locker(&data.mMutex);
+        allThreads = data.mThreads;
+    }
+
+    const auto processId = static_cast<qint64>(QCoreApplication::applicationPid());
+
+    QJsonArray traceEvents;
+
+    for (const auto &oneThread : allThreads) {
+        QMutexLocker locker(&oneThread->mMutex);
+
+        traceEvents.append(QJsonObject{{QStringLiteral("name"), QStringLiteral("thread_name")},
+                                       {QStringLiteral("ph"), QStringLiteral("M")},
+                                       {QStringLiteral("pid"), processId},
+                                       {QStringLiteral("tid"), oneThread->mThreadId},
+                                       {QStringLiteral("args"), QJsonObject{{QStringLiteral("name"), oneThread->mThreadName}}}});
+
+        for (const auto &oneEvent : oneThread->mEvents) {
+            auto jsonEvent = QJsonObject{{QStringLiteral("name"), QString::fromLatin1(oneEvent.mName)},
+                                         {QStringLiteral("cat"), QString::fromLatin1(oneEvent.mCategory)},
+                                         {QStringLiteral("ph"), QString(QLatin1Char(oneEvent.mPhase))},
+                                         {QStringLiteral("ts"), oneEvent.mTimestamp},
+                                         {QStringLiteral("pid"), processId},
+                                         {QStringLiteral("tid"), oneThread->mThreadId}};
+
+            if (oneEvent.mPhase == 'X') {
+                jsonEvent[QStringLiteral("dur")] = oneEvent.mDuration;
+            } else {
+                jsonEvent[QStringLiteral("s")] = QStringLiteral("t");
+            }
+
+            if (!oneEvent.mDetail.isEmpty()) {
+                jsonEvent[QStringLiteral("args")] = QJsonObject{{QStringLiteral("detail"), oneEvent.mDetail}};
+            }
+
+            traceEvents.append(jsonEvent);
+        }
+    }
+
+    QFile traceFile(fileName);
+    if (!traceFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+
+    const auto traceDocument = QJsonDocument{QJsonObject{{QStringLiteral("traceEvents"), traceEvents},
+                                                         {QStringLiteral("displayTimeUnit"), QStringLiteral("ms")}}};
+
+    return traceFile.write(traceDocument.toJson(QJsonDocument::Compact)) != -1;
+}
@@ -0,0 +1,110 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef ELISATRACE_H
+#define ELISATRACE_H
+
+#include "elisaLib_export.h"
+
+#include "config-upnp-qt.h"
+
+#include <QString>
+
+#include <utility>
+
+/**
+ * Recorder of timed spans written as a Chrome JSON trace file.
+ *
+ * Tracing is enabled by setting the ELISA_TRACE_FILE environment variable to
+ * the path of the trace file, which is written when the application exits.
+ * The file can be opened in chrome://tracing or https://ui.perfetto.dev.
+ *
+ * Events are buffered per thread and the threads are identified by their
+ * object name. The ELISA_TRACE_* macros only record something when Elisa is
+ * built with the ELISA_ENABLE_TRACING option.
+ */
+class ELISALIB_EXPORT ElisaTrace
+{
+
+public:
+
+    static bool isEnabled();
+
+    /**
+     * time elapsed since the start of the trace in microseconds
+     */
+    static qint64 timestamp();
+
+    /**
+     * @param category and name must be string literals, only pointers are stored
+     */
+    static void addCompleteEvent(const char *category, const char *name, qint64 start, qint64 duration, const QString &detail = {});
+
+    static void addInstantEvent(const char *category, const char *name, const QString &detail = {});
+
+    static bool writeTraceFile(const QString &fileName);
+
+};
+
+class ELISALIB_EXPORT ElisaTraceSpan
+{
+
+public:
+
+    ElisaTraceSpan(const char *category, const char *name, QString detail = {})
+        : mCategory(category), mName(name), mDetail(std::move(detail)),
+          mStart(ElisaTrace::isEnabled() ? ElisaTrace::timestamp() : -1)
+    {
+    }
+
+    ~ElisaTraceSpan()
+    {
+        if (mStart >= 0) {
+            ElisaTrace::addCompleteEvent(mCategory, mName, mStart, ElisaTrace::timestamp() - mStart, mDetail);
+        }
+    }
+
+    ElisaTraceSpan(const ElisaTraceSpan &) = delete;
+
+    ElisaTraceSpan& operator=(const ElisaTraceSpan &) = delete;
+
+private:
+
+    const char *mCategory;
+
+    const char *mName;
+
+    QString mDetail;
+
+    qint64 mStart;
+
+};
+
+#if defined ELISA_ENABLE_TRACING && ELISA_ENABLE_TRACING
+
+#define ELISA_TRACE_CONCAT_INNER(first, second) first##second
+#define ELISA_TRACE_CONCAT(first, second) ELISA_TRACE_CONCAT_INNER(first, second)
+
+#define ELISA_TRACE_SCOPE(category, name) \
+    ElisaTraceSpan ELISA_TRACE_CONCAT(elisaTraceSpan, __LINE__)(category, name)
+
+#define ELISA_TRACE_SCOPE_DETAIL(category, name, detail) \
+    ElisaTraceSpan ELISA_TRACE_CONCAT(elisaTraceSpan, __LINE__)(category, name, ElisaTrace::isEnabled() ? QString(detail) : QString())
+
+#define ELISA_TRACE_INSTANT(category, name, detail) \
+    do { if (ElisaTrace::isEnabled()) { ElisaTrace::addInstantEvent(category, name, detail); } } while (false)
+
+#else
+
+#define ELISA_TRACE_SCOPE(category, name) do {} while (false)
+
+#define ELISA_TRACE_SCOPE_DETAIL(category, name, detail) do {} while (false)
+
+#define ELISA_TRACE_INSTANT(category, name, detail) do {} while (false)
+
+#endif
+
+#endif // ELISATRACE_H
@@ -6,6 +6,8 @@
 
 #include "embeddedcoverageimageprovider.h"
 
+#include "elisatrace.h"
+
 #include <KFileMetaData/EmbeddedImageData>
 #include <QImage>
 
@@ -35,6 +37,8 @@ public:
 
     void run() override
     {
+        ELISA_TRACE_SCOPE_DETAIL("image", "embeddedCover", mId);
+
         KFileMetaData::EmbeddedImageData embeddedImage;
 
         auto imageData = embeddedImage.imageData(mId);
@@ -9,6 +9,7 @@
 #include "config-upnp-qt.h"
 
 #include "abstractfile/indexercommon.h"
+#include "elisatrace.h"
 
 #if defined KF5FileMetaData_FOUND && KF5FileMetaData_FOUND
 
@@ -58,7 +59,6 @@ public:
         {KFileMetaData::Property::TrackNumber, DataTypes::ColumnsRoles::TrackNumberRole},
         {KFileMetaData::Property::DiscNumber, DataTypes::ColumnsRoles::DiscNumberRole},
         {KFileMetaData::Property::ReleaseYear, DataTypes::ColumnsRoles::YearRole},
-        {KFileMetaData::Property::Lyrics, DataTypes::ColumnsRoles::LyricsRole},
         {KFileMetaData::Property::Comment, DataTypes::ColumnsRoles::CommentRole},
         {KFileMetaData::Property::Rating, DataTypes::ColumnsRoles::RatingRole},
         {KFileMetaData::Property::Channels, DataTypes::ColumnsRoles::ChannelsRole},
@@ -92,6 +92,8 @@ FileScanner::~FileScanner() = default;
 
 DataTypes::TrackDataType FileScanner::scanOneFile(const QUrl &scanFile, const QFileInfo &scanFileInfo)
 {
+    ELISA_TRACE_SCOPE_DETAIL("indexer", "scanOneFile", scanFile.toString());
+
     DataTypes::TrackDataType newTrack;
 
     if (!scanFile.isLocalFile() && !scanFile.scheme().isEmpty()) {
@@ -110,22 +112,10 @@ DataTypes::TrackDataType FileScanner::scanOneFile(const QUrl &scanFile, const QF
         return newTrack;
     }
 
-    const auto &mimetype = fileMimeType.name();
-
-    const QList<KFileMetaData::Extractor*> &exList = d->mAllExtractors.fetchExtractors(mimetype);
-
-    if (exList.isEmpty()) {
+    if (!extractProperties(localFileName, fileMimeType.name())) {
         return newTrack;
     }
 
-    KFileMetaData::Extractor* ex = exList.first();
-    KFileMetaData::SimpleExtractionResult result(localFileName, mimetype,
-                                                 KFileMetaData::ExtractionResult::ExtractMetaData);
-
-    ex->extract(&result);
-
-    d->mAllProperties = result.properties();
-
     scanProperties(localFileName, newTrack);
 
     qCDebug(orgKdeElisaIndexer()) << "scanOneFile" << scanFile << "using KFileMetaData" << newTrack;
@@ -201,10 +191,12 @@ void FileScanner::scanProperties(const QString &localFileName, DataTypes::TrackD
         } else {
             value = (*rangeBegin).second;
         }
-        const auto &translatedKey = d->propertyTranslation.find(key);
-        if (translatedKey.value() == DataTypes::DurationRole) {
+        const auto &translatedKey = d->propertyTranslation.constFind(key);
+        if (translatedKey == d->propertyTranslation.constEnd()) {
+            // lyrics and any other unused property are not part of the track data
+        } else if (translatedKey.value() == DataTypes::DurationRole) {
             trackData.insert(translatedKey.value(), QTime::fromMSecsSinceStartOfDay(int(1000 * (*rangeBegin).second.toDouble())));
-        } else if (translatedKey != d->propertyTranslation.end()) {
+        } else {
             trackData.insert(translatedKey.value(), (*rangeBegin).second);
         }
         rangeBegin = rangeEnd;
@@ -235,6 +227,75 @@ void FileScanner::scanProperties(const QString &localFileName, DataTypes::TrackD
 #endif
 }
 
+DataTypes::TrackDataType FileScanner::scanLongTextProperties(const QUrl &scanFile)
+{
+    ELISA_TRACE_SCOPE_DETAIL("indexer", "scanLongTextProperties", scanFile.toString());
+
+    DataTypes::TrackDataType longText;
+
+    if (!scanFile.isLocalFile()) {
+        return longText;
+    }
+
+#if defined KF5FileMetaData_FOUND && KF5FileMetaData_FOUND
+    const auto &localFileName = scanFile.toLocalFile();
+
+    const auto &fileMimeType = d->mMimeDb.mimeTypeForFile(localFileName);
+    if (!fileMimeType.name().startsWith(QLatin1String("audio/"))) {
+        return longText;
+    }
+
+    if (!extractProperties(localFileName, fileMimeType.name())) {
+        return longText;
+    }
+
+    const auto &lyrics = d->mAllProperties.value(KFileMetaData::Property::Lyrics).toString();
+    if (!lyrics.isEmpty()) {
+        longText[DataTypes::LyricsRole] = lyrics;
+    }
+
+    const auto &comment = d->mAllProperties.value(KFileMetaData::Property::Comment).toString();
+    if (!comment.isEmpty()) {
+        longText[DataTypes::CommentRole] = comment;
+    }
+
+#if !defined Q_OS_ANDROID && !defined Q_OS_WIN
+    const auto &userComment = KFileMetaData::UserMetaData(localFileName).userComment();
+    if (!userComment.isEmpty()) {
+        longText[DataTypes::CommentRole] = userComment;
+    }
+#endif
+#endif
+
+    return longText;
+}
+
+bool FileScanner::extractProperties(const QString &localFileName, const QString &mimetype)
+{
+#if defined KF5FileMetaData_FOUND && KF5FileMetaData_FOUND
+    const QList<KFileMetaData::Extractor*> &exList = d->mAllExtractors.fetchExtractors(mimetype);
+
+    if (exList.isEmpty()) {
+        return false;
+    }
+
+    KFileMetaData::Extractor* ex = exList.first();
+    KFileMetaData::SimpleExtractionResult result(localFileName, mimetype,
+                                                 KFileMetaData::ExtractionResult::ExtractMetaData);
+
+    ex->extract(&result);
+
+    d->mAllProperties = result.properties();
+
+    return true;
+#else
+    Q_UNUSED(localFileName)
+    Q_UNUSED(mimetype)
+
+    return false;
+#endif
+}
+
 QUrl FileScanner::searchForCoverFile(const QString &localFileName)
 {
     const QFileInfo trackFilePath(localFileName);
@@ -33,10 +33,19 @@ public:
 
     DataTypes::TrackDataType scanOneBalooFile(const QUrl &scanFile, const QFileInfo &scanFileInfo);
 
+    /**
+     * read the lyrics and the comment of a file
+     *
+     * The lyrics can be a long text and are not part of the data returned by scanOneFile().
+     */
+    DataTypes::TrackDataType scanLongTextProperties(const QUrl &scanFile);
+
     QUrl searchForCoverFile(const QString &localFileName);
 
 private:
 
+    bool extractProperties(const QString &localFileName, const QString &mimetype);
+
     void scanProperties(const QString &localFileName, DataTypes::TrackDataType &trackData);
 
     bool checkEmbeddedCoverImage(const QString &localFileName);
@@ -56,6 +56,11 @@ FileWriter::FileWriter() : d(std::make_unique<FileWriterPrivate>())
 FileWriter::~FileWriter() = default;
 
 bool FileWriter::writeSingleMetaDataToFile(const QUrl &url, const DataTypes::ColumnsRoles role, const QVariant &data)
+{
+    return writeMetaDataToFile(url, {{role, data}});
+}
+
+bool FileWriter::writeAllMetaDataToFile(const QUrl &url, const DataTypes::TrackDataType &data)
 {
 #if defined KF5FileMetaData_FOUND && KF5FileMetaData_FOUND
 
@@ -64,47 +69,44 @@ bool FileWriter::writeSingleMetaDataToFile(const QUrl &url, const DataTypes::Col
     }
     const auto &localFileName = url.toLocalFile();
     const auto &fileMimeType = d->mMimeDb.mimeTypeForFile(localFileName);
-    if (!fileMimeType.name().startsWith(QStringLiteral("audio/"))) {
+    if (!fileMimeType.name().startsWith(QLatin1String("audio/"))) {
         return false;
     }
 
+    KFileMetaData::UserMetaData md(localFileName);
+    md.setUserComment(data.value(DataTypes::ColumnsRoles::CommentRole).toString());
+    md.setRating(data.value(DataTypes::ColumnsRoles::RatingRole).toInt());
+
     const auto &mimetype = fileMimeType.name();
     const QList<KFileMetaData::Writer*> &writerList = d->mAllWriters.fetchWriters(mimetype);
 
     if (writerList.isEmpty()) {
         return false;
     }
+
     KFileMetaData::Writer *writer = writerList.first();
     KFileMetaData::WriteData writeData(localFileName, mimetype);
-    auto translatedKey = d->mPropertyTranslation.find(role);
-    if (translatedKey != d->mPropertyTranslation.end()) {
-        writeData.add(translatedKey.value(), data);
+    auto rangeBegin = data.constKeyValueBegin();
+    while (rangeBegin != data.constKeyValueEnd()) {
+        auto key = (*rangeBegin).first;
+        auto translatedKey = d->mPropertyTranslation.find(key);
+        if (translatedKey != d->mPropertyTranslation.end()) {
+            writeData.add(translatedKey.value(), (*rangeBegin).second);
+        }
+        rangeBegin++;
     }
     writer->write(writeData);
 
-#if !defined Q_OS_ANDROID && !defined Q_OS_WIN
-    auto fileData = KFileMetaData::UserMetaData(localFileName);
-
-    if (role == DataTypes::RatingRole) {
-        fileData.setRating(data.toInt());
-    }
-
-    if (role == DataTypes::CommentRole) {
-        fileData.setUserComment(data.toString());
-    }
-#endif
-
     return true;
 #else
     Q_UNUSED(url)
-    Q_UNUSED(role)
     Q_UNUSED(data)
 
     return false;
 #endif
 }
 
-bool FileWriter::writeAllMetaDataToFile(const QUrl &url, const DataTypes::TrackDataType &data)
+bool FileWriter::writeMetaDataToFile(const QUrl &url, const DataTypes::TrackDataType &data)
 {
 #if defined KF5FileMetaData_FOUND && KF5FileMetaData_FOUND
 
@@ -117,10 +119,6 @@ bool FileWriter::writeAllMetaDataToFile(const QUrl &url, const DataTypes::TrackD
         return false;
     }
 
-    KFileMetaData::UserMetaData md(localFileName);
-    md.setUserComment(data.value(DataTypes::ColumnsRoles::CommentRole).toString());
-    md.setRating(data.value(DataTypes::ColumnsRoles::RatingRole).toInt());
-
     const auto &mimetype = fileMimeType.name();
     const QList<KFileMetaData::Writer*> &writerList = d->mAllWriters.fetchWriters(mimetype);
 
@@ -130,17 +128,26 @@ bool FileWriter::writeAllMetaDataToFile(const QUrl &url, const DataTypes::TrackD
 
     KFileMetaData::Writer *writer = writerList.first();
     KFileMetaData::WriteData writeData(localFileName, mimetype);
-    auto rangeBegin = data.constKeyValueBegin();
-    while (rangeBegin != data.constKeyValueEnd()) {
-        auto key = (*rangeBegin).first;
-        auto translatedKey = d->mPropertyTranslation.find(key);
+    for (auto itValue = data.constKeyValueBegin(); itValue != data.constKeyValueEnd(); ++itValue) {
+        auto translatedKey = d->mPropertyTranslation.find((*itValue).first);
         if (translatedKey != d->mPropertyTranslation.end()) {
-            writeData.add(translatedKey.value(), (*rangeBegin).second);
+            writeData.add(translatedKey.value(), (*itValue).second);
         }
-        rangeBegin++;
     }
     writer->write(writeData);
 
+#if !defined Q_OS_ANDROID && !defined Q_OS_WIN
+    auto fileData = KFileMetaData::UserMetaData(localFileName);
+
+    if (data.contains(DataTypes::RatingRole)) {
+        fileData.setRating(data.value(DataTypes::RatingRole).toInt());
+    }
+
+    if (data.contains(DataTypes::CommentRole)) {
+        fileData.setUserComment(data.value(DataTypes::CommentRole).toString());
+    }
+#endif
+
     return true;
 #else
     Q_UNUSED(url)
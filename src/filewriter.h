@@ -27,6 +27,11 @@ public:
 
     bool writeAllMetaDataToFile(const QUrl &url, const DataTypes::TrackDataType &data);
 
+    /**
+     * write only the values present in data, the file is rewritten once whatever the number of values
+     */
+    bool writeMetaDataToFile(const QUrl &url, const DataTypes::TrackDataType &data);
+
 private:
 
     std::unique_ptr<FileWriterPrivate> d;
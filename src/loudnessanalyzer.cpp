@@ -0,0 +1,321 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "loudnessanalyzer.h"
+
+#include "audiofiledecoder.h"
+#include "loudnessmeter.h"
+#include "waveformcache.h"
+#include "waveformpeaks.h"
+#include "loudnessLogging.h"
+
+#include <QAudioDecoder>
+#include <QFileInfo>
+#include <QRunnable>
+#include <QThread>
+#include <QThreadPool>
+
+#include <algorithm>
+#include <atomic>
+#include <optional>
+#include <vector>
+
+namespace {
+
+/* number of tracks still needing an analysis requested at once,
+ * albums of those tracks are always analyzed completely
+ */
+constexpr int TracksBatchSize = 100;
+
+bool analyzeTrack(const QUrl &trackUrl, std::optional<LoudnessMeter> &meter, const std::atomic<bool> &stopRequested)
+{
+    auto waveform = std::optional<WaveformPeaks>{};
+
+    const auto isValid = AudioFileDecoder::decode(trackUrl, [&meter, &waveform](const QAudioBuffer &buffer) {
+        const auto format = buffer.format();
+
+        if (!meter) {
+            meter.emplace(format.channelCount(), format.sampleRate());
+            waveform.emplace(format.channelCount(), format.sampleRate());
+        }
+
+        if (meter->channelsCount() != format.channelCount() || meter->sampleRate() != format.sampleRate()) {
+            return false;
+        }
+
+        return AudioFileDecoder::forwardSamples(buffer, *meter) && AudioFileDecoder::forwardSamples(buffer, *waveform);
+    }, &stopRequested);
+
+    if (!isValid || !meter) {
+        return false;
+    }
+
+    // the file has been decoded anyway, keep its waveform for the seek bar
+    const auto trackFileInfo = QFileInfo(trackUrl.toLocalFile());
+    WaveformCache().storePeaks(trackFileInfo.filePath(), trackFileInfo.lastModified(), waveform->peaks());
+
+    return true;
+}
+
+class LoudnessAnalysisJob : public QRunnable
+{
+
+public:
+
+    LoudnessAnalysisJob(LoudnessAnalyzer *analyzer, qulonglong sessionId, DataTypes::ListTrackDataType tracks,
+                        std::shared_ptr<std::atomic<bool>> stopRequested)
+        : mAnalyzer(analyzer), mSessionId(sessionId), mTracks(std::move(tracks)), mStopRequested(std::move(stopRequested))
+    {
+    }
+
+    void run() override
+    {
+        QThread::currentThread()->setPriority(QThread::IdlePriority);
+
+        // a completion is always sent, the analyzer counts its running jobs
+        sendResult(analyze());
+    }
+
+private:
+
+    DataTypes::ListTrackDataType analyze() const
+    {
+        std::vector<std::optional<LoudnessMeter>> meters(mTracks.size());
+        std::vector<const LoudnessMeter*> validMeters;
+
+        for (int trackIndex = 0; trackIndex < mTracks.size(); ++trackIndex) {
+            if (*mStopRequested) {
+                return {};
+            }
+
+            const auto trackUrl = mTracks[trackIndex].resourceURI();
+            if (!trackUrl.isLocalFile() || !analyzeTrack(trackUrl, meters[trackIndex], *mStopRequested)) {
+                meters[trackIndex].reset();
+                continue;
+            }
+
+            validMeters.push_back(&meters[trackIndex].value());
+        }
+
+        if (*mStopRequested) {
+            return {};
+        }
+
+        const auto albumGain = LoudnessMeter::replayGain(LoudnessMeter::integratedLoudness(validMeters));
+        const auto albumPeak = LoudnessMeter::samplePeak(validMeters);
+
+        auto result = DataTypes::ListTrackDataType{};
+        result.reserve(mTracks.size());
+
+        for (int trackIndex = 0; trackIndex < mTracks.size(); ++trackIndex) {
+            auto oneResult = DataTypes::TrackDataType{};
+            oneResult[DataTypes::DatabaseIdRole] = mTracks[trackIndex].databaseId();
+            oneResult[DataTypes::ResourceRole] = mTracks[trackIndex].resourceURI();
+
+            // tracks that could not be decoded are stored with a neutral gain to not analyze them again
+            const auto &meter = meters[trackIndex];
+            oneResult[DataTypes::ReplayGainTrackGainRole] = (meter ? LoudnessMeter::replayGain(meter->integratedLoudness()) : 0.);
+            oneResult[DataTypes::ReplayGainTrackPeakRole] = (meter ? meter->samplePeak() : 0.);
+            oneResult[DataTypes::ReplayGainAlbumGainRole] = albumGain;
+            oneResult[DataTypes::ReplayGainAlbumPeakRole] = albumPeak;
+
+            result.push_back(oneResult);
+        }
+
+        return result;
+    }
+
+    void sendResult(const DataTypes::ListTrackDataType &result) const
+    {
+        QMetaObject::invokeMethod(mAnalyzer, "albumAnalyzed", Qt::QueuedConnection,
+                                  Q_ARG(qulonglong, mSessionId), Q_ARG(DataTypes::ListTrackDataType, result));
+    }
+
+    LoudnessAnalyzer *mAnalyzer = nullptr;
+
+    qulonglong mSessionId = 0;
+
+    DataTypes::ListTrackDataType mTracks;
+
+    std::shared_ptr<std::atomic<bool>> mStopRequested;
+
+};
+
+}
+
+class LoudnessAnalyzerPrivate
+{
+
+public:
+
+    QThreadPool mThreadPool;
+
+    std::shared_ptr<std::atomic<bool>> mStopRequested = std::make_shared<std::atomic<bool>>(false);
+
+    int mRunningJobs = 0;
+
+    /**
+     * incremented at each start to ignore the jobs of the previous sessions
+     */
+    qulonglong mSessionId = 0;
+
+    bool mIsActive = false;
+
+    bool mIsWaitingForTracks = false;
+
+    bool mLibraryChangedMeanwhile = false;
+
+};
+
+LoudnessAnalyzer::LoudnessAnalyzer(QObject *parent)
+    : QObject(parent), d(std::make_unique<LoudnessAnalyzerPrivate>())
+{
+    d->mThreadPool.setMaxThreadCount(std::max(1, QThread::idealThreadCount() / 2));
+}
+
+LoudnessAnalyzer::~LoudnessAnalyzer()
+{
+    *d->mStopRequested = true;
+    d->mThreadPool.clear();
+    d->mThreadPool.waitForDone();
+}
+
+bool LoudnessAnalyzer::isActive() const
+{
+    return d->mIsActive;
+}
+
+bool LoudnessAnalyzer::isAvailable()
+{
+    QAudioDecoder decoder;
+
+    return decoder.isAvailable();
+}
+
+void LoudnessAnalyzer::start()
+{
+    if (d->mIsActive) {
+        return;
+    }
+
+    if (!isAvailable()) {
+        qCInfo(orgKdeElisaLoudness()) << "LoudnessAnalyzer::start" << "no audio decoder available";
+        return;
+    }
+
+    qCInfo(orgKdeElisaLoudness()) << "LoudnessAnalyzer::start";
+
+    d->mStopRequested = std::make_shared<std::atomic<bool>>(false);
+    ++d->mSessionId;
+    d->mRunningJobs = 0;
+    d->mIsActive = true;
+    Q_EMIT activeChanged();
+
+    requestTracks();
+}
+
+void LoudnessAnalyzer::stop()
+{
+    if (!d->mIsActive) {
+        return;
+    }
+
+    qCInfo(orgKdeElisaLoudness()) << "LoudnessAnalyzer::stop";
+
+    // running jobs drop their results, the albums will be analyzed again on next start
+    *d->mStopRequested = true;
+    d->mThreadPool.clear();
+    d->mRunningJobs = 0;
+
+    d->mIsActive = false;
+    Q_EMIT activeChanged();
+}
+
+void LoudnessAnalyzer::analyzeTracks(const DataTypes::ListTrackDataType &tracks)
+{
+    d->mIsWaitingForTracks = false;
+
+    if (!d->mIsActive) {
+        return;
+    }
+
+    if (tracks.isEmpty()) {
+        qCDebug(orgKdeElisaLoudness()) << "LoudnessAnalyzer::analyzeTracks" << "all tracks are analyzed";
+
+        if (d->mLibraryChangedMeanwhile) {
+            d->mLibraryChangedMeanwhile = false;
+            requestTracks();
+        }
+
+        return;
+    }
+
+    qCDebug(orgKdeElisaLoudness()) << "LoudnessAnalyzer::analyzeTracks" << tracks.size() << "tracks";
+
+    // tracks are sorted by album, a track without album is analyzed alone
+    auto albumTracks = DataTypes::ListTrackDataType{};
+    for (const auto &oneTrack : tracks) {
+        const auto albumId = oneTrack.albumId();
+
+        if (!albumTracks.isEmpty() && (albumId == 0 || albumTracks.constLast().albumId() != albumId)) {
+            d->mThreadPool.start(new LoudnessAnalysisJob(this, d->mSessionId, albumTracks, d->mStopRequested));
+            ++d->mRunningJobs;
+            albumTracks.clear();
+        }
+
+        albumTracks.push_back(oneTrack);
+    }
+
+    if (!albumTracks.isEmpty()) {
+        d->mThreadPool.start(new LoudnessAnalysisJob(this, d->mSessionId, albumTracks, d->mStopRequested));
+        ++d->mRunningJobs;
+    }
+}
+
+void LoudnessAnalyzer::libraryChanged()
+{
+    if (!d->mIsActive) {
+        return;
+    }
+
+    if (d->mIsWaitingForTracks || d->mRunningJobs > 0) {
+        d->mLibraryChangedMeanwhile = true;
+        return;
+    }
+
+    requestTracks();
+}
+
+void LoudnessAnalyzer::requestTracks()
+{
+    if (d->mIsWaitingForTracks) {
+        return;
+    }
+
+    d->mIsWaitingForTracks = true;
+    d->mLibraryChangedMeanwhile = false;
+    Q_EMIT askTracksPendingAnalysis(TracksBatchSize);
+}
+
+void LoudnessAnalyzer::albumAnalyzed(qulonglong sessionId, const DataTypes::ListTrackDataType &tracks)
+{
+    if (!d->mIsActive || sessionId != d->mSessionId) {
+        return;
+    }
+
+    --d->mRunningJobs;
+
+    if (!tracks.isEmpty()) {
+        Q_EMIT tracksAnalyzed(tracks);
+    }
+
+    if (d->mRunningJobs == 0) {
+        requestTracks();
+    }
+}
+
+
+#include "moc_loudnessanalyzer.cpp"
@@ -0,0 +1,81 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef LOUDNESSANALYZER_H
+#define LOUDNESSANALYZER_H
+
+#include "elisaLib_export.h"
+
+#include "datatypes.h"
+
+#include <QObject>
+
+#include <memory>
+
+class LoudnessAnalyzerPrivate;
+
+/**
+ * Background computation of ReplayGain values.
+ *
+ * Tracks without loudness information are requested from the database in small
+ * batches, decoded on a low priority thread pool and measured album by album.
+ * Results are only sent back once a whole album is done so that an interrupted
+ * analysis restarts from the first album that was not stored.
+ */
+class ELISALIB_EXPORT LoudnessAnalyzer : public QObject
+{
+
+    Q_OBJECT
+
+    Q_PROPERTY(bool active
+               READ isActive
+               NOTIFY activeChanged)
+
+public:
+
+    explicit LoudnessAnalyzer(QObject *parent = nullptr);
+
+    ~LoudnessAnalyzer() override;
+
+    bool isActive() const;
+
+    static bool isAvailable();
+
+Q_SIGNALS:
+
+    void activeChanged();
+
+    void askTracksPendingAnalysis(int maximumCount);
+
+    void tracksAnalyzed(const DataTypes::ListTrackDataType &tracks);
+
+public Q_SLOTS:
+
+    void start();
+
+    void stop();
+
+    void analyzeTracks(const DataTypes::ListTrackDataType &tracks);
+
+    void libraryChanged();
+
+private Q_SLOTS:
+
+    /**
+     * @param sessionId session of the job, results of a session stopped since are ignored
+     * @param tracks analyzed tracks, empty if the job was stopped
+     */
+    void albumAnalyzed(qulonglong sessionId, const DataTypes::ListTrackDataType &tracks);
+
+private:
+
+    void requestTracks();
+
+    std::unique_ptr<LoudnessAnalyzerPrivate> d;
+
+};
+
+#endif // LOUDNESSANALYZER_H
@@ -0,0 +1,376 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "loudnessmeter.h"
+
+#include <QtMath>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+constexpr double LoudnessOffset = -0.691;
+
+constexpr double AbsoluteGate = -70.0;
+
+constexpr double RelativeGate = -10.0;
+
+constexpr int SubBlocksPerBlock = 4;
+
+constexpr qsizetype ChunkFrames = 1024;
+
+struct Biquad
+{
+    double b0 = 1.;
+    double b1 = 0.;
+    double b2 = 0.;
+    double a1 = 0.;
+    double a2 = 0.;
+};
+
+double energyToLoudness(double energy)
+{
+    return LoudnessOffset + 10. * std::log10(energy);
+}
+
+double loudnessToEnergy(double loudness)
+{
+    return std::pow(10., (loudness - LoudnessOffset) / 10.);
+}
+
+/* coefficients of the two stages of the K-weighting filter for any sample rate,
+ * they match the ones tabulated by ITU-R BS.1770 at 48 kHz
+ */
+std::array<Biquad, 2> kWeightingFilters(int sampleRate)
+{
+    std::array<Biquad, 2> result;
+
+    {
+        const double f0 = 1681.974450955533;
+        const double gain = 3.999843853973347;
+        const double q = 0.7071752369554196;
+
+        const double k = std::tan(M_PI * f0 / sampleRate);
+        const double vh = std::pow(10., gain / 20.);
+        const double vb = std::pow(vh, 0.4996667741545416);
+        const double a0 = 1. + k / q + k * k;
+
+        result[0].b0 = (vh + vb * k / q + k * k) / a0;
+        result[0].b1 = 2. * (k * k - vh) / a0;
+        result[0].b2 = (vh - vb * k / q + k * k) / a0;
+        result[0].a1 = 2. * (k * k - 1.) / a0;
+        result[0].a2 = (1. - k / q + k * k) / a0;
+    }
+
+    {
+        const double f0 = 38.13547087602444;
+        const double q = 0.5003270373238773;
+
+        const double k = std::tan(M_PI * f0 / sampleRate);
+        const double a0 = 1. + k / q + k * k;
+
+        result[1].b0 = 1.;
+        result[1].b1 = -2.;
+        result[1].b2 = 1.;
+        result[1].a1 = 2. * (k * k - 1.) / a0;
+        result[1].a2 = (1. - k / q + k * k) / a0;
+    }
+
+    return result;
+}
+
+}
+
+class LoudnessMeterPrivate
+{
+
+public:
+
+    LoudnessMeterPrivate(int channelsCount, int sampleRate)
+        : mChannelsCount(std::max(channelsCount, 1)), mSampleRate(std::max(sampleRate, 1)),
+          mFilters(kWeightingFilters(mSampleRate)), mFilterStates(mChannelsCount),
+          mChannelWeights(mChannelsCount, 1.), mSubBlockSums(mChannelsCount, 0.),
+          mSubBlockFrames(std::max<qsizetype>(qRound(mSampleRate * 0.1), 1)),
+          mChannelBuffer(ChunkFrames), mFilteredBuffer(ChunkFrames)
+    {
+        // 5.1: the LFE channel is ignored and the surround channels are boosted
+        if (mChannelsCount == 6) {
+            mChannelWeights = {1., 1., 1., 0., 1.41, 1.41};
+        }
+    }
+
+    void processChunk(const float *interleavedSamples, qsizetype framesCount);
+
+    void finishSubBlock();
+
+    int mChannelsCount = 1;
+
+    int mSampleRate = 1;
+
+    std::array<Biquad, 2> mFilters;
+
+    std::vector<std::array<double, 4>> mFilterStates;
+
+    std::vector<double> mChannelWeights;
+
+    std::vector<double> mSubBlockSums;
+
+    qsizetype mSubBlockFrames = 1;
+
+    qsizetype mSubBlockPosition = 0;
+
+    std::array<double, SubBlocksPerBlock> mLastSubBlocks = {};
+
+    qsizetype mSubBlocksCount = 0;
+
+    std::vector<double> mBlockEnergies;
+
+    float mPeak = 0.f;
+
+    std::vector<float> mChannelBuffer;
+
+    std::vector<double> mFilteredBuffer;
+
+    std::vector<float> mConversionBuffer;
+
+};
+
+void LoudnessMeterPrivate::processChunk(const float *interleavedSamples, qsizetype framesCount)
+{
+    const auto channelsCount = mChannelsCount;
+    auto *channelSamples = mChannelBuffer.data();
+    auto *filteredSamples = mFilteredBuffer.data();
+
+    for (int channel = 0; channel < channelsCount; ++channel) {
+        for (qsizetype frame = 0; frame < framesCount; ++frame) {
+            channelSamples[frame] = interleavedSamples[frame * channelsCount + channel];
+        }
+
+        auto peak = mPeak;
+        for (qsizetype frame = 0; frame < framesCount; ++frame) {
+            peak = std::max(peak, std::abs(channelSamples[frame]));
+        }
+        mPeak = peak;
+
+        // the recursive filter is inherently serial, it is kept apart from the loops above and below
+        // so that those stay simple enough to be vectorized by the compiler
+        const auto &shelf = mFilters[0];
+        const auto &highPass = mFilters[1];
+        auto state = mFilterStates[channel];
+        for (qsizetype frame = 0; frame < framesCount; ++frame) {
+            const double input = channelSamples[frame];
+
+            const double shelfOutput = shelf.b0 * input + state[0];
+            state[0] = shelf.b1 * input - shelf.a1 * shelfOutput + state[1];
+            state[1] = shelf.b2 * input - shelf.a2 * shelfOutput;
+
+            const double output = highPass.b0 * shelfOutput + state[2];
+            state[2] = highPass.b1 * shelfOutput - highPass.a1 * output + state[3];
+            state[3] = highPass.b2 * shelfOutput - highPass.a2 * output;
+
+            filteredSamples[frame] = output;
+        }
+        mFilterStates[channel] = state;
+
+        std::array<double, 4> partialSums = {};
+        qsizetype frame = 0;
+        for (; frame + 4 <= framesCount; frame += 4) {
+            partialSums[0] += filteredSamples[frame] * filteredSamples[frame];
+            partialSums[1] += filteredSamples[frame + 1] * filteredSamples[frame + 1];
+            partialSums[2] += filteredSamples[frame + 2] * filteredSamples[frame + 2];
+            partialSums[3] += filteredSamples[frame + 3] * filteredSamples[frame + 3];
+        }
+        for (; frame < framesCount; ++frame) {
+            partialSums[0] += filteredSamples[frame] * filteredSamples[frame];
+        }
+
+        mSubBlockSums[channel] += (partialSums[0] + partialSums[1]) + (partialSums[2] + partialSums[3]);
+    }
+
+    mSubBlockPosition += framesCount;
+    if (mSubBlockPosition == mSubBlockFrames) {
+        finishSubBlock();
+    }
+}
+
+void LoudnessMeterPrivate::finishSubBlock()
+{
+    auto subBlockEnergy = 0.;
+    for (int channel = 0; channel < mChannelsCount; ++channel) {
+        subBlockEnergy += mChannelWeights[channel] * mSubBlockSums[channel];
+        mSubBlockSums[channel] = 0.;
+    }
+    subBlockEnergy /= static_cast<double>(mSubBlockFrames);
+
+    mLastSubBlocks[mSubBlocksCount % SubBlocksPerBlock] = subBlockEnergy;
+    ++mSubBlocksCount;
+    mSubBlockPosition = 0;
+
+    // gating blocks are 400 ms long and overlap by 75 %
+    if (mSubBlocksCount >= SubBlocksPerBlock) {
+        auto blockEnergy = 0.;
+        for (auto oneSubBlock : mLastSubBlocks) {
+            blockEnergy += oneSubBlock;
+        }
+        mBlockEnergies.push_back(blockEnergy / SubBlocksPerBlock);
+    }
+}
+
+LoudnessMeter::LoudnessMeter(int channelsCount, int sampleRate)
+    : d(std::make_unique<LoudnessMeterPrivate>(channelsCount, sampleRate))
+{
+}
+
+LoudnessMeter::LoudnessMeter(LoudnessMeter &&other) noexcept = default;
+
+LoudnessMeter& LoudnessMeter::operator=(LoudnessMeter &&other) noexcept = default;
+
+LoudnessMeter::~LoudnessMeter()
+= default;
+
+int LoudnessMeter::channelsCount() const
+{
+    return d->mChannelsCount;
+}
+
+int LoudnessMeter::sampleRate() const
+{
+    return d->mSampleRate;
+}
+
+void LoudnessMeter::addFrames(const float *interleavedSamples, qsizetype framesCount)
+{
+    while (framesCount > 0) {
+        const auto chunkFrames = std::min({framesCount, ChunkFrames, d->mSubBlockFrames - d->mSubBlockPosition});
+
+        d->processChunk(interleavedSamples, chunkFrames);
+
+        interleavedSamples += chunkFrames * d->mChannelsCount;
+        framesCount -= chunkFrames;
+    }
+}
+
+void LoudnessMeter::addFrames(const qint16 *interleavedSamples, qsizetype framesCount)
+{
+    d->mConversionBuffer.resize(ChunkFrames * d->mChannelsCount);
+
+    while (framesCount > 0) {
+        const auto chunkFrames = std::min(framesCount, ChunkFrames);
+        const auto chunkSamples = chunkFrames * d->mChannelsCount;
+
+        auto *convertedSamples = d->mConversionBuffer.data();
+        for (qsizetype sample = 0; sample < chunkSamples; ++sample) {
+            convertedSamples[sample] = static_cast<float>(interleavedSamples[sample]) * (1.f / 32768.f);
+        }
+
+        addFrames(convertedSamples, chunkFrames);
+
+        interleavedSamples += chunkSamples;
+        framesCount -= chunkFrames;
+    }
+}
+
+void LoudnessMeter::addFrames(const qint32 *interleavedSamples, qsizetype framesCount)
+{
+    d->mConversionBuffer.resize(ChunkFrames * d->mChannelsCount);
+
+    while (framesCount > 0) {
+        const auto chunkFrames = std::min(framesCount, ChunkFrames);
+        const auto chunkSamples = chunkFrames * d->mChannelsCount;
+
+        auto *convertedSamples = d->mConversionBuffer.data();
+        for (qsizetype sample = 0; sample < chunkSamples; ++sample) {
+            convertedSamples[sample] = static_cast<float>(interleavedSamples[sample]) * (1.f / 2147483648.f);
+        }
+
+        addFrames(convertedSamples, chunkFrames);
+
+        interleavedSamples += chunkSamples;
+        framesCount -= chunkFrames;
+    }
+}
+
+double LoudnessMeter::integratedLoudness() const
+{
+    return integratedLoudness({this});
+}
+
+double LoudnessMeter::samplePeak() const
+{
+    return d->mPeak;
+}
+
+double LoudnessMeter::integratedLoudness(const std::vector<const LoudnessMeter*> &meters)
+{
+    const auto absoluteThreshold = loudnessToEnergy(AbsoluteGate);
+
+    auto gatedEnergy = 0.;
+    qsizetype gatedCount = 0;
+    for (const auto *oneMeter : meters) {
+        for (auto oneBlock : oneMeter->d->mBlockEnergies) {
+            if (oneBlock > absoluteThreshold) {
+                gatedEnergy += oneBlock;
+                ++gatedCount;
+            }
+        }
+    }
+
+    if (gatedCount == 0) {
+        return -std::numeric_limits<double>::infinity();
+    }
+
+    const auto threshold = std::max(absoluteThreshold,
+                                    loudnessToEnergy(energyToLoudness(gatedEnergy / gatedCount) + RelativeGate));
+
+    gatedEnergy = 0.;
+    gatedCount = 0;
+    for (const auto *oneMeter : meters) {
+        for (auto oneBlock : oneMeter->d->mBlockEnergies) {
+            if (oneBlock > threshold) {
+                gatedEnergy += oneBlock;
+                ++gatedCount;
+            }
+        }
+    }
+
+    if (gatedCount == 0) {
+        return -std::numeric_limits<double>::infinity();
+    }
+
+    return energyToLoudness(gatedEnergy / gatedCount);
+}
+
+double LoudnessMeter::samplePeak(const std::vector<const LoudnessMeter*> &meters)
+{
+    auto result = 0.;
+
+    for (const auto *oneMeter : meters) {
+        result = std::max(result, oneMeter->samplePeak());
+    }
+
+    return result;
+}
+
+double LoudnessMeter::replayGain(double loudness)
+{
+    if (!std::isfinite(loudness)) {
+        return 0.;
+    }
+
+    return ReferenceLoudness - loudness;
+}
+
+double LoudnessMeter::clippingSafeGain(double gain, double peak)
+{
+    if (peak <= 0.) {
+        return gain;
+    }
+
+    return std::min(gain, -20. * std::log10(peak));
+}
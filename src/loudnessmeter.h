@@ -0,0 +1,84 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef LOUDNESSMETER_H
+#define LOUDNESSMETER_H
+
+#include "elisaLib_export.h"
+
+#include <QtGlobal>
+
+#include <memory>
+#include <vector>
+
+class LoudnessMeterPrivate;
+
+/**
+ * Integrated loudness (EBU R128 / ITU-R BS.1770) and sample peak of an audio stream.
+ *
+ * Samples are K-weighted per channel, accumulated in 100 ms sub-blocks and
+ * combined into overlapping 400 ms gating blocks. The gating blocks are kept
+ * so that the loudness of several meters (an album) can be computed together.
+ */
+class ELISALIB_EXPORT LoudnessMeter
+{
+
+public:
+
+    /**
+     * loudness targeted by ReplayGain 2.0 in LUFS
+     */
+    static constexpr double ReferenceLoudness = -18.0;
+
+    LoudnessMeter(int channelsCount, int sampleRate);
+
+    LoudnessMeter(LoudnessMeter &&other) noexcept;
+
+    LoudnessMeter& operator=(LoudnessMeter &&other) noexcept;
+
+    ~LoudnessMeter();
+
+    int channelsCount() const;
+
+    int sampleRate() const;
+
+    void addFrames(const float *interleavedSamples, qsizetype framesCount);
+
+    void addFrames(const qint16 *interleavedSamples, qsizetype framesCount);
+
+    void addFrames(const qint32 *interleavedSamples, qsizetype framesCount);
+
+    /**
+     * gated loudness in LUFS, -infinity when the stream is shorter than one block or silent
+     */
+    double integratedLoudness() const;
+
+    /**
+     * highest absolute sample value, 1.0 being full scale
+     */
+    double samplePeak() const;
+
+    static double integratedLoudness(const std::vector<const LoudnessMeter*> &meters);
+
+    static double samplePeak(const std::vector<const LoudnessMeter*> &meters);
+
+    /**
+     * gain in dB bringing loudness to ReferenceLoudness
+     */
+    static double replayGain(double loudness);
+
+    /**
+     * gain reduced so that the peak does not exceed full scale once the gain is applied
+     */
+    static double clippingSafeGain(double gain, double peak);
+
+private:
+
+    std::unique_ptr<LoudnessMeterPrivate> d;
+
+};
+
+#endif // LOUDNESSMETER_H
@@ -10,6 +10,7 @@
 #include "elisaarguments.h"
 #include "elisaapplication.h"
 #include "elisa_settings.h"
+#include "startuptrace.h"
 
 #include "localFileConfiguration/elisaconfigurationdialog.h"
 
@@ -59,6 +60,8 @@ int __attribute__((visibility("default"))) main(int argc, char *argv[])
 int main(int argc, char *argv[])
 #endif
 {
+    StartupTrace::start();
+
 #if defined Q_OS_ANDROID
     if(argc > 1 && strcmp(argv[1], "-service") == 0){
         QAndroidService app(argc, argv);
@@ -124,6 +127,8 @@ int main(int argc, char *argv[])
     parser.process(app);
     aboutData.processCommandLine(&parser);
 
+    StartupTrace::markPhase(QStringLiteral("application"));
+
     QQuickStyle::setStyle(QStringLiteral("org.kde.desktop"));
     QQuickStyle::setFallbackStyle(QStringLiteral("Fusion"));
 
@@ -163,5 +168,7 @@ int main(int argc, char *argv[])
 
     engine.load(QUrl(QStringLiteral("qrc:/qml/ElisaMainWindow.qml")));
 
+    StartupTrace::markPhase(QStringLiteral("main window"));
+
     return app.exec();
 }
@@ -144,6 +144,27 @@ void ManageAudioPlayer::setCurrentTrack(const QPersistentModelIndex &currentTrac
         Q_EMIT currentTrackChanged();
     }
 
+    if (mSwitchingToNextTrack) {
+        mSwitchingToNextTrack = false;
+
+        const auto newUrlValue = mCurrentTrack.data(mUrlRole);
+        if (mCurrentTrack.isValid() && newUrlValue.toUrl() == mNextPlayerSource) {
+            // the player is already playing this track, no need to stop and reload it
+            mOldPlayerSource = newUrlValue;
+            mNextPlayerSource.clear();
+
+            if (mPlayListModel) {
+                if (mOldCurrentTrack.isValid()) {
+                    mPlayListModel->setData(mOldCurrentTrack, MediaPlayList::NotPlaying, mIsPlayingRole);
+                }
+                mPlayListModel->setData(mCurrentTrack, MediaPlayList::IsPlaying, mIsPlayingRole);
+                Q_EMIT startedPlayingTrack(mCurrentTrack.data(mUrlRole).toUrl(), QDateTime::currentDateTime());
+            }
+
+            return;
+        }
+    }
+
     switch (mPlayerPlaybackState) {
     case QMediaPlayer::StoppedState:
         Q_EMIT playerSourceChanged(mCurrentTrack.data(mUrlRole).toUrl());
@@ -159,6 +180,27 @@ void ManageAudioPlayer::setCurrentTrack(const QPersistentModelIndex &currentTrac
     }
 }
 
+void ManageAudioPlayer::setNextTrack(const QPersistentModelIndex &nextTrack)
+{
+    mNextTrack = nextTrack;
+
+    auto newNextSource = (mNextTrack.isValid() ? mNextTrack.data(mUrlRole).toUrl() : QUrl{});
+    if (mNextPlayerSource == newNextSource) {
+        return;
+    }
+
+    mNextPlayerSource = newNextSource;
+    Q_EMIT playerNextSourceChanged(mNextPlayerSource);
+}
+
+void ManageAudioPlayer::playerSwitchedToNextSource(const QUrl &source)
+{
+    mNextPlayerSource = source;
+    mSwitchingToNextTrack = true;
+
+    Q_EMIT skipNextTrack();
+}
+
 void ManageAudioPlayer::saveForUndoClearPlaylist(){
     mUndoPlayingState = mPlayingState;
 
@@ -403,15 +445,38 @@ void ManageAudioPlayer::setPlayerPosition(qint64 playerPosition)
 
     mPlayerPosition = playerPosition;
     Q_EMIT playerPositionChanged();
-    QTimer::singleShot(0, this, [this]() {Q_EMIT playControlPositionChanged();});
+
+    if (!mPlayControlPositionPending) {
+        mPlayControlPositionPending = true;
+        QTimer::singleShot(0, this, [this]() {
+            mPlayControlPositionPending = false;
+            Q_EMIT playControlPositionChanged();
+        });
+    }
 }
 
 void ManageAudioPlayer::setCurrentPlayingForRadios(const QString &title, const QString &nowPlaying)
 {
-    if (mPlayListModel && mCurrentTrack.isValid()) {
-        Q_EMIT updateData(mCurrentTrack, title, MediaPlayList::TitleRole);
-        Q_EMIT updateData(mCurrentTrack, nowPlaying, MediaPlayList::ArtistRole);
+    if (!mPlayListModel || !mCurrentTrack.isValid()) {
+        return;
+    }
+
+    if (mCurrentTrack.data(MediaPlayList::ElementTypeRole).value<ElisaUtils::PlayListEntryType>() != ElisaUtils::Radio) {
+        return;
     }
+
+    // stations without stream meta data keep the title stored for the radio
+    if (title.isEmpty() && nowPlaying.isEmpty()) {
+        return;
+    }
+
+    if (mCurrentTrack.data(MediaPlayList::TitleRole).toString() == title &&
+            mCurrentTrack.data(MediaPlayList::ArtistRole).toString() == nowPlaying) {
+        return;
+    }
+
+    Q_EMIT updateItemData(mCurrentTrack, {{MediaPlayList::TitleRole, title}, {MediaPlayList::ArtistRole, nowPlaying}});
+    Q_EMIT radioNowPlayingChanged(mCurrentTrack.data(mUrlRole).toUrl(), title, nowPlaying, QDateTime::currentDateTime());
 }
 
 void ManageAudioPlayer::setPlayControlPosition(int playerPosition)
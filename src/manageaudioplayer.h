@@ -146,6 +146,8 @@ Q_SIGNALS:
 
     void playerSourceChanged(const QUrl &url);
 
+    void playerNextSourceChanged(const QUrl &url);
+
     void urlRoleChanged();
 
     void isPlayingRoleChanged();
@@ -192,12 +194,24 @@ Q_SIGNALS:
 
     void startedPlayingTrack(const QUrl &fileName, const QDateTime &time);
 
-    void updateData(const QPersistentModelIndex &index, const QVariant &value, int role);
+    void updateItemData(const QPersistentModelIndex &index, const QMap<int, QVariant> &roles);
+
+    void radioNowPlayingChanged(const QUrl &radioUrl, const QString &title, const QString &nowPlaying, const QDateTime &time);
 
 public Q_SLOTS:
 
     void setCurrentTrack(const QPersistentModelIndex &currentTrack);
 
+    /**
+     * track that will follow the current one, its url is forwarded to the player to be preloaded
+     */
+    void setNextTrack(const QPersistentModelIndex &nextTrack);
+
+    /**
+     * the player continued on the preloaded source without stopping
+     */
+    void playerSwitchedToNextSource(const QUrl &source);
+
     void saveForUndoClearPlaylist();
 
     void restoreForUndoClearPlaylist();
@@ -264,6 +278,10 @@ private:
 
     QPersistentModelIndex mOldCurrentTrack;
 
+    QPersistentModelIndex mNextTrack;
+
+    QUrl mNextPlayerSource;
+
     QAbstractItemModel *mPlayListModel = nullptr;
 
     int mTitleRole = Qt::DisplayRole;
@@ -288,12 +306,16 @@ private:
 
     bool mSkippingCurrentTrack = false;
 
+    bool mSwitchingToNextTrack = false;
+
     int mAudioDuration = 0;
 
     bool mPlayerIsSeekable = false;
 
     qint64 mPlayerPosition = 0;
 
+    bool mPlayControlPositionPending = false;
+
     QVariantMap mPersistentState;
 
     bool mUndoPlayingState = false;
@@ -176,6 +176,17 @@ QUrl ManageHeaderBar::image() const
     return mCurrentTrack.data(mImageRole).toUrl();
 }
 
+QString ManageHeaderBar::waveform() const
+{
+    const auto currentFileUrl = fileUrl();
+
+    if (!currentFileUrl.isLocalFile()) {
+        return {};
+    }
+
+    return QStringLiteral("image://waveform/") + QString::fromLatin1(QUrl::toPercentEncoding(currentFileUrl.toLocalFile(), "/"));
+}
+
 qulonglong ManageHeaderBar::databaseId() const
 {
     if (!mCurrentTrack.isValid()) {
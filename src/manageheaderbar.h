@@ -98,6 +98,10 @@ class ELISALIB_EXPORT ManageHeaderBar : public QObject
                READ image
                NOTIFY imageChanged)
 
+    Q_PROPERTY(QString waveform
+               READ waveform
+               NOTIFY fileUrlChanged)
+
     Q_PROPERTY(qulonglong databaseId
                READ databaseId
                NOTIFY databaseIdChanged)
@@ -152,6 +156,8 @@ public:
 
     QUrl image() const;
 
+    QString waveform() const;
+
     qulonglong databaseId() const;
 
     ElisaUtils::PlayListEntryType trackType() const;
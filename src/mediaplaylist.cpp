@@ -244,6 +244,55 @@ bool MediaPlayList::setData(const QModelIndex &index, const QVariant &value, int
     return modelModified;
 }
 
+bool MediaPlayList::setItemData(const QModelIndex &index, const QMap<int, QVariant> &roles)
+{
+    if (!index.isValid()) {
+        return false;
+    }
+
+    if (index.row() < 0 || index.row() >= d->mData.size()) {
+        return false;
+    }
+
+    auto &playListEntry = d->mData[index.row()];
+    auto &trackData = d->mTrackData[index.row()];
+    auto modifiedRoles = QVector<int>{};
+
+    for (auto itRole = roles.constBegin(); itRole != roles.constEnd(); ++itRole) {
+        switch(itRole.key())
+        {
+        case ColumnsRoles::TitleRole:
+            if (playListEntry.mTitle == itRole.value()) {
+                break;
+            }
+
+            playListEntry.mTitle = itRole.value();
+            trackData[TrackDataType::key_type::TitleRole] = itRole.value();
+            modifiedRoles.push_back(itRole.key());
+            break;
+        case ColumnsRoles::ArtistRole:
+            if (playListEntry.mArtist == itRole.value()) {
+                break;
+            }
+
+            playListEntry.mArtist = itRole.value();
+            trackData[TrackDataType::key_type::ArtistRole] = itRole.value();
+            modifiedRoles.push_back(itRole.key());
+            break;
+        default:
+            break;
+        }
+    }
+
+    if (modifiedRoles.isEmpty()) {
+        return false;
+    }
+
+    Q_EMIT dataChanged(index, index, modifiedRoles);
+
+    return true;
+}
+
 bool MediaPlayList::removeRows(int row, int count, const QModelIndex &parent)
 {
     beginRemoveRows(parent, row, row + count - 1);
@@ -74,6 +74,10 @@ public:
         IsDirectoryRole,
         IsPlayListRole,
         FilePathRole,
+        ReplayGainTrackGainRole,
+        ReplayGainTrackPeakRole,
+        ReplayGainAlbumGainRole,
+        ReplayGainAlbumPeakRole,
         IsValidRole,
         CountRole,
         IsPlayingRole,
@@ -104,6 +108,14 @@ public:
 
     bool setData(const QModelIndex &index, const QVariant &value, int role = Qt::EditRole) override;
 
+    /**
+     * update several roles of one entry with a single dataChanged signal
+     *
+     * Only the title and artist roles can be modified, values that did not
+     * change are ignored.
+     */
+    bool setItemData(const QModelIndex &index, const QMap<int, QVariant> &roles) override;
+
     QHash<int, QByteArray> roleNames() const override;
 
     bool removeRows(int row, int count, const QModelIndex &parent = QModelIndex()) override;
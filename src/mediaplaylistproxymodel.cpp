@@ -109,6 +109,16 @@ QModelIndex MediaPlayListProxyModel::mapToSource(const QModelIndex &proxyIndex)
     return d->mPlayListModel->index(mapRowToSource(proxyIndex.row()), proxyIndex.column());
 }
 
+bool MediaPlayListProxyModel::setItemData(const QModelIndex &index, const QMap<int, QVariant> &roles)
+{
+    if (!index.isValid()) {
+        return false;
+    }
+
+    // forward all roles at once so that the play list emits a single dataChanged
+    return d->mPlayListModel->setItemData(mapToSource(index), roles);
+}
+
 int MediaPlayListProxyModel::mapRowToSource(const int proxyRow) const
 {
     if (d->mShufflePlayList) {
@@ -92,6 +92,8 @@ public:
 
     bool hasChildren(const QModelIndex &parent) const override;
 
+    bool setItemData(const QModelIndex &index, const QMap<int, QVariant> &roles) override;
+
     void setPlayListModel(MediaPlayList* playListModel);
 
     QPersistentModelIndex previousTrack() const;
@@ -7,7 +7,7 @@
 #include "modeldataloader.h"
 
 #include "filescanner.h"
-#include "filewriter.h"
+#include "elisatrace.h"
 
 class ModelDataLoaderPrivate
 {
@@ -30,8 +30,6 @@ public:
     qulonglong mDatabaseId = 0;
 
     FileScanner mFileScanner;
-
-    FileWriter mFileWriter;
 };
 
 ModelDataLoader::ModelDataLoader(QObject *parent) : QObject(parent), d(std::make_unique<ModelDataLoaderPrivate>())
@@ -78,6 +76,8 @@ void ModelDataLoader::setDatabase(DatabaseInterface *database)
 
 void ModelDataLoader::loadData(ElisaUtils::PlayListEntryType dataType)
 {
+    ELISA_TRACE_SCOPE("model", "ModelDataLoader::loadData");
+
     if (!d->mDatabase) {
         return;
     }
@@ -112,8 +112,47 @@ void ModelDataLoader::loadData(ElisaUtils::PlayListEntryType dataType)
     }
 }
 
+void ModelDataLoader::loadDataWithSortFilter(ElisaUtils::PlayListEntryType dataType,
+                                             const DataTypes::SortFilterParameters &parameters)
+{
+    ELISA_TRACE_SCOPE("model", "ModelDataLoader::loadDataWithSortFilter");
+
+    if (!d->mDatabase) {
+        return;
+    }
+
+    d->mFilterType = ModelDataLoader::FilterType::NoFilter;
+
+    switch (dataType)
+    {
+    case ElisaUtils::Album:
+        Q_EMIT allAlbumsData(d->mDatabase->allAlbumsData(parameters));
+        break;
+    case ElisaUtils::Artist:
+        Q_EMIT allArtistsData(d->mDatabase->allArtistsData(parameters));
+        break;
+    case ElisaUtils::Genre:
+        Q_EMIT allGenresData(d->mDatabase->allGenresData(parameters));
+        break;
+    case ElisaUtils::Track:
+        Q_EMIT allTracksData(d->mDatabase->allTracksData(parameters));
+        break;
+    case ElisaUtils::Radio:
+        Q_EMIT allRadiosData(d->mDatabase->allRadiosData());
+        break;
+    case ElisaUtils::Composer:
+    case ElisaUtils::Lyricist:
+    case ElisaUtils::FileName:
+    case ElisaUtils::Unknown:
+    case ElisaUtils::Container:
+        break;
+    }
+}
+
 void ModelDataLoader::loadDataByAlbumId(ElisaUtils::PlayListEntryType dataType, qulonglong databaseId)
 {
+    ELISA_TRACE_SCOPE("model", "ModelDataLoader::loadDataByAlbumId");
+
     if (!d->mDatabase) {
         return;
     }
@@ -146,6 +185,8 @@ void ModelDataLoader::loadDataByAlbumId(ElisaUtils::PlayListEntryType dataType,
 
 void ModelDataLoader::loadDataByGenre(ElisaUtils::PlayListEntryType dataType, const QString &genre)
 {
+    ELISA_TRACE_SCOPE("model", "ModelDataLoader::loadDataByGenre");
+
     if (!d->mDatabase) {
         return;
     }
@@ -173,6 +214,8 @@ void ModelDataLoader::loadDataByGenre(ElisaUtils::PlayListEntryType dataType, co
 
 void ModelDataLoader::loadDataByArtist(ElisaUtils::PlayListEntryType dataType, const QString &artist)
 {
+    ELISA_TRACE_SCOPE("model", "ModelDataLoader::loadDataByArtist");
+
     if (!d->mDatabase) {
         return;
     }
@@ -200,6 +243,8 @@ void ModelDataLoader::loadDataByArtist(ElisaUtils::PlayListEntryType dataType, c
 
 void ModelDataLoader::loadDataByGenreAndArtist(ElisaUtils::PlayListEntryType dataType, const QString &genre, const QString &artist)
 {
+    ELISA_TRACE_SCOPE("model", "ModelDataLoader::loadDataByGenreAndArtist");
+
     if (!d->mDatabase) {
         return;
     }
@@ -229,6 +274,8 @@ void ModelDataLoader::loadDataByGenreAndArtist(ElisaUtils::PlayListEntryType dat
 void ModelDataLoader::loadDataByDatabaseIdAndUrl(ElisaUtils::PlayListEntryType dataType,
                                                  qulonglong databaseId, const QUrl &url)
 {
+    ELISA_TRACE_SCOPE("model", "ModelDataLoader::loadDataByDatabaseIdAndUrl");
+
     if (!d->mDatabase) {
         return;
     }
@@ -258,6 +305,8 @@ void ModelDataLoader::loadDataByDatabaseIdAndUrl(ElisaUtils::PlayListEntryType d
 
 void ModelDataLoader::loadDataByUrl(ElisaUtils::PlayListEntryType dataType, const QUrl &url)
 {
+    ELISA_TRACE_SCOPE("model", "ModelDataLoader::loadDataByUrl");
+
     if (!d->mDatabase) {
         return;
     }
@@ -274,6 +323,8 @@ void ModelDataLoader::loadDataByUrl(ElisaUtils::PlayListEntryType dataType, cons
             Q_EMIT allTrackData(d->mDatabase->trackDataFromDatabaseIdAndUrl(databaseId, url));
         } else {
             auto result = d->mFileScanner.scanOneFile(url);
+            // like for tracks from the database, the comment is only read on demand
+            result.remove(DataTypes::CommentRole);
             Q_EMIT allTrackData(result);
         }
         break;
@@ -300,8 +351,21 @@ void ModelDataLoader::loadDataByUrl(ElisaUtils::PlayListEntryType dataType, cons
     }
 }
 
+void ModelDataLoader::loadDataByFileNames(const QUrl &directoryUrl, const QList<QUrl> &fileNames)
+{
+    ELISA_TRACE_SCOPE_DETAIL("model", "ModelDataLoader::loadDataByFileNames", directoryUrl.toString());
+
+    if (!d->mDatabase) {
+        return;
+    }
+
+    Q_EMIT allTracksDataFromFileNames(directoryUrl, d->mDatabase->tracksDataFromFileNames(fileNames));
+}
+
 void ModelDataLoader::loadRecentlyPlayedData(ElisaUtils::PlayListEntryType dataType)
 {
+    ELISA_TRACE_SCOPE("model", "ModelDataLoader::loadRecentlyPlayedData");
+
     if (!d->mDatabase) {
         return;
     }
@@ -328,6 +392,8 @@ void ModelDataLoader::loadRecentlyPlayedData(ElisaUtils::PlayListEntryType dataT
 
 void ModelDataLoader::loadFrequentlyPlayedData(ElisaUtils::PlayListEntryType dataType)
 {
+    ELISA_TRACE_SCOPE("model", "ModelDataLoader::loadFrequentlyPlayedData");
+
     if (!d->mDatabase) {
         return;
     }
@@ -449,14 +515,4 @@ void ModelDataLoader::databaseAlbumsAdded(const ListAlbumDataType &newData)
     }
 }
 
-void ModelDataLoader::updateFileMetaData(const DataTypes::TrackDataType &trackDataType, const QUrl &url)
-{
-    d->mFileWriter.writeAllMetaDataToFile(url, trackDataType);
-}
-
-void ModelDataLoader::updateSingleFileMetaData(const QUrl &url, DataTypes::ColumnsRoles role, const QVariant &data)
-{
-    d->mFileWriter.writeSingleMetaDataToFile(url, role, data);
-}
-
 #include "moc_modeldataloader.cpp"
@@ -53,6 +53,8 @@ Q_SIGNALS:
 
     void allTracksData(const ModelDataLoader::ListTrackDataType &allData);
 
+    void allTracksDataFromFileNames(const QUrl &directoryUrl, const ModelDataLoader::ListTrackDataType &allData);
+
     void allRadiosData(const ModelDataLoader::ListRadioDataType &radiosData);
 
     void radioAdded(const ModelDataLoader::TrackDataType &radiosData);
@@ -93,6 +95,9 @@ public Q_SLOTS:
 
     void loadData(ElisaUtils::PlayListEntryType dataType);
 
+    void loadDataWithSortFilter(ElisaUtils::PlayListEntryType dataType,
+                                const DataTypes::SortFilterParameters &parameters);
+
     void loadDataByAlbumId(ElisaUtils::PlayListEntryType dataType, qulonglong databaseId);
 
     void loadDataByGenre(ElisaUtils::PlayListEntryType dataType,
@@ -110,14 +115,12 @@ public Q_SLOTS:
     void loadDataByUrl(ElisaUtils::PlayListEntryType dataType,
                        const QUrl &url);
 
+    void loadDataByFileNames(const QUrl &directoryUrl, const QList<QUrl> &fileNames);
+
     void loadRecentlyPlayedData(ElisaUtils::PlayListEntryType dataType);
 
     void loadFrequentlyPlayedData(ElisaUtils::PlayListEntryType dataType);
 
-    void updateFileMetaData(const DataTypes::TrackDataType &trackDataType, const QUrl &url);
-
-    void updateSingleFileMetaData(const QUrl &url, DataTypes::ColumnsRoles role, const QVariant &data);
-
 private Q_SLOTS:
 
     void databaseTracksAdded(const ModelDataLoader::ListTrackDataType &newData);
@@ -8,6 +8,7 @@
 #include "abstractmediaproxymodel.h"
 
 #include "mediaplaylistproxymodel.h"
+#include "datamodel.h"
 
 #include <QWriteLocker>
 #include <QReadLocker>
@@ -47,6 +48,8 @@ void AbstractMediaProxyModel::setFilterText(const QString &filterText)
 
     invalidate();
 
+    pushSortFilterToSource();
+
     Q_EMIT filterTextChanged(mFilterText);
 }
 
@@ -62,6 +65,8 @@ void AbstractMediaProxyModel::setFilterRating(int filterRating)
 
     invalidate();
 
+    pushSortFilterToSource();
+
     Q_EMIT filterRatingChanged(filterRating);
 }
 
@@ -75,12 +80,72 @@ MediaPlayListProxyModel *AbstractMediaProxyModel::playList() const
     return mPlayList;
 }
 
+void AbstractMediaProxyModel::setSourceModel(QAbstractItemModel *sourceModel)
+{
+    if (mDataModel) {
+        disconnect(mDataModel, &DataModel::sortFilterInSourceChanged,
+                   this, &AbstractMediaProxyModel::sourceSortFilterChanged);
+    }
+
+    mDataModel = qobject_cast<DataModel*>(sourceModel);
+
+    QSortFilterProxyModel::setSourceModel(sourceModel);
+
+    if (mDataModel) {
+        connect(mDataModel, &DataModel::sortFilterInSourceChanged,
+                this, &AbstractMediaProxyModel::sourceSortFilterChanged);
+    }
+
+    sourceSortFilterChanged();
+}
+
 void AbstractMediaProxyModel::sortModel(Qt::SortOrder order)
 {
-    sort(0, order);
+    if (sortFilterInSource()) {
+        sort(-1, order);
+        pushSortFilterToSource();
+    } else {
+        sort(0, order);
+    }
+
     Q_EMIT sortedAscendingChanged();
 }
 
+bool AbstractMediaProxyModel::sortFilterInSource() const
+{
+    return mDataModel && mDataModel->sortFilterInSource();
+}
+
+void AbstractMediaProxyModel::pushSortFilterToSource()
+{
+    if (!sortFilterInSource()) {
+        return;
+    }
+
+    auto parameters = DataTypes::SortFilterParameters{};
+    parameters.mSortRole = sortRole();
+    parameters.mSortOrder = sortOrder();
+    parameters.mFilterText = mFilterText;
+    parameters.mFilterRating = mFilterRating;
+
+    mDataModel->setSortFilter(parameters);
+}
+
+void AbstractMediaProxyModel::sourceSortFilterChanged()
+{
+    if (!sortFilterInSource()) {
+        return;
+    }
+
+    if (sortColumn() != -1) {
+        sort(-1, sortOrder());
+    }
+
+    invalidateFilter();
+
+    pushSortFilterToSource();
+}
+
 void AbstractMediaProxyModel::setPlayList(MediaPlayListProxyModel *playList)
 {
     disconnectPlayList();
@@ -19,6 +19,7 @@
 #include <QThreadPool>
 
 class MediaPlayListProxyModel;
+class DataModel;
 
 class ELISALIB_EXPORT AbstractMediaProxyModel : public QSortFilterProxyModel
 {
@@ -55,6 +56,8 @@ public:
 
     MediaPlayListProxyModel* playList() const;
 
+    void setSourceModel(QAbstractItemModel *sourceModel) override;
+
 public Q_SLOTS:
 
     void setFilterText(const QString &filterText);
@@ -96,6 +99,10 @@ protected:
 
     void connectPlayList();
 
+    bool sortFilterInSource() const;
+
+    void pushSortFilterToSource();
+
     QString mFilterText;
 
     int mFilterRating = 0;
@@ -108,6 +115,12 @@ protected:
 
     MediaPlayListProxyModel* mPlayList = nullptr;
 
+    DataModel* mDataModel = nullptr;
+
+private Q_SLOTS:
+
+    void sourceSortFilterChanged();
+
 private:
 
     void genericEnqueueToPlayList(QModelIndex rootIndex,
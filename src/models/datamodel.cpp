@@ -8,11 +8,95 @@
 
 #include "modeldataloader.h"
 #include "musiclistenersmanager.h"
+#include "elisatrace.h"
 
 #include "models/modelLogging.h"
 
 #include <algorithm>
 
+namespace {
+
+QVariant sortFilterValue(const DataTypes::MusicDataType &entry, int role)
+{
+    if (role == Qt::DisplayRole) {
+        return entry[DataTypes::TitleRole];
+    }
+
+    return entry[static_cast<DataTypes::ColumnsRoles>(role)];
+}
+
+bool sortFilterValueLessThan(const QVariant &left, const QVariant &right)
+{
+    if (left.type() == QVariant::String || right.type() == QVariant::String) {
+        return QString::compare(left.toString(), right.toString(), Qt::CaseInsensitive) < 0;
+    }
+
+    if (left.type() == QVariant::DateTime || right.type() == QVariant::DateTime) {
+        return left.toDateTime() < right.toDateTime();
+    }
+
+    return left.toDouble() < right.toDouble();
+}
+
+class SortFilterLessThan
+{
+public:
+
+    explicit SortFilterLessThan(const DataTypes::SortFilterParameters &parameters) : mParameters(parameters)
+    {
+    }
+
+    bool operator()(const DataTypes::MusicDataType &left, const DataTypes::MusicDataType &right) const
+    {
+        const auto &leftValue = sortFilterValue(left, mParameters.mSortRole);
+        const auto &rightValue = sortFilterValue(right, mParameters.mSortRole);
+
+        if (mParameters.mSortOrder == Qt::AscendingOrder) {
+            return sortFilterValueLessThan(leftValue, rightValue);
+        }
+
+        return sortFilterValueLessThan(rightValue, leftValue);
+    }
+
+private:
+
+    const DataTypes::SortFilterParameters &mParameters;
+
+};
+
+bool matchSortFilter(const DataTypes::MusicDataType &entry, const DataTypes::SortFilterParameters &parameters)
+{
+    if (parameters.mFilterRating > 0) {
+        auto ratingValue = entry[DataTypes::HighestTrackRating];
+        if (!ratingValue.isValid()) {
+            ratingValue = entry[DataTypes::RatingRole];
+        }
+
+        if (!ratingValue.isValid() || ratingValue.toInt() < parameters.mFilterRating) {
+            return false;
+        }
+    }
+
+    if (parameters.mFilterText.isEmpty()) {
+        return true;
+    }
+
+    if (entry[DataTypes::TitleRole].toString().contains(parameters.mFilterText, Qt::CaseInsensitive)) {
+        return true;
+    }
+
+    if (entry[DataTypes::ArtistRole].toString().contains(parameters.mFilterText, Qt::CaseInsensitive)) {
+        return true;
+    }
+
+    const auto &allArtists = entry[DataTypes::AllArtistsRole].toStringList();
+    return std::any_of(allArtists.begin(), allArtists.end(), [&parameters](const auto &oneArtist) {
+        return oneArtist.contains(parameters.mFilterText, Qt::CaseInsensitive);
+    });
+}
+
+}
+
 class DataModelPrivate
 {
 public:
@@ -43,6 +127,12 @@ public:
 
     qulonglong mDatabaseId = 0;
 
+    DataTypes::SortFilterParameters mSortFilter;
+
+    bool mSortFilterInSource = false;
+
+    bool mUseSortFilter = false;
+
     bool mIsBusy = false;
 
 };
@@ -360,6 +450,11 @@ bool DataModel::isBusy() const
     return d->mIsBusy;
 }
 
+bool DataModel::sortFilterInSource() const
+{
+    return d->mSortFilterInSource;
+}
+
 void DataModel::initializeByData(MusicListenersManager *manager, DatabaseInterface *database,
                                  ElisaUtils::PlayListEntryType modelType, ElisaUtils::FilterType filter,
                                  const DataTypes::DataType &dataFilter)
@@ -373,6 +468,37 @@ void DataModel::initializeByData(MusicListenersManager *manager, DatabaseInterfa
     initializeModel(manager, database, modelType, filter);
 }
 
+void DataModel::setSortFilter(const DataTypes::SortFilterParameters &parameters)
+{
+    if (!d->mSortFilterInSource) {
+        return;
+    }
+
+    if (d->mUseSortFilter && d->mSortFilter == parameters) {
+        return;
+    }
+
+    d->mSortFilter = parameters;
+    d->mUseSortFilter = true;
+
+    if (d->mModelType == ElisaUtils::Unknown) {
+        return;
+    }
+
+    ELISA_TRACE_SCOPE("model", "DataModel::setSortFilter");
+
+    beginResetModel();
+    d->mAllAlbumData.clear();
+    d->mAllGenreData.clear();
+    d->mAllTrackData.clear();
+    d->mAllArtistData.clear();
+    endResetModel();
+
+    setBusy(true);
+
+    askModelData();
+}
+
 void DataModel::setBusy(bool value)
 {
     if (d->mIsBusy == value) {
@@ -386,6 +512,11 @@ void DataModel::setBusy(bool value)
 void DataModel::initializeModel(MusicListenersManager *manager, DatabaseInterface *database,
                                 ElisaUtils::PlayListEntryType modelType, DataModel::FilterType type)
 {
+    d->mSortFilterInSource = (type == ElisaUtils::NoFilter &&
+                              (modelType == ElisaUtils::Track || modelType == ElisaUtils::Album ||
+                               modelType == ElisaUtils::Artist || modelType == ElisaUtils::Genre));
+    Q_EMIT sortFilterInSourceChanged();
+
     d->mModelType = modelType;
     d->mFilterType = type;
 
@@ -406,6 +537,8 @@ void DataModel::initializeModel(MusicListenersManager *manager, DatabaseInterfac
     case ElisaUtils::NoFilter:
         connect(this, &DataModel::needData,
                 d->mDataLoader, &ModelDataLoader::loadData);
+        connect(this, &DataModel::needDataWithSortFilter,
+                d->mDataLoader, &ModelDataLoader::loadDataWithSortFilter);
         break;
     case ElisaUtils::FilterById:
         connect(this, &DataModel::needDataById,
@@ -446,7 +579,11 @@ void DataModel::askModelData()
     switch(d->mFilterType)
     {
     case ElisaUtils::NoFilter:
-        Q_EMIT needData(d->mModelType);
+        if (d->mUseSortFilter) {
+            Q_EMIT needDataWithSortFilter(d->mModelType, d->mSortFilter);
+        } else {
+            Q_EMIT needData(d->mModelType);
+        }
         break;
     case ElisaUtils::FilterById:
         Q_EMIT needDataById(d->mModelType, d->mDatabaseId);
@@ -532,6 +669,8 @@ void DataModel::connectModel(DatabaseInterface *database)
 
 void DataModel::tracksAdded(ListTrackDataType newData)
 {
+    ELISA_TRACE_SCOPE("model", "DataModel::tracksAdded");
+
     if (newData.isEmpty() && d->mModelType == ElisaUtils::Track) {
         setBusy(false);
     }
@@ -540,6 +679,11 @@ void DataModel::tracksAdded(ListTrackDataType newData)
         return;
     }
 
+    if (d->mUseSortFilter) {
+        insertSortFilteredData(d->mAllTrackData, newData);
+        return;
+    }
+
     if (d->mFilterType == ElisaUtils::FilterById && !d->mAllTrackData.isEmpty()) {
         for (const auto &newTrack : newData) {
             auto trackIndex = indexFromId(newTrack.databaseId());
@@ -593,6 +737,8 @@ void DataModel::tracksAdded(ListTrackDataType newData)
 
 void DataModel::radiosAdded(ListRadioDataType newData)
 {
+    ELISA_TRACE_SCOPE("model", "DataModel::radiosAdded");
+
     if (newData.isEmpty() && d->mModelType == ElisaUtils::Radio) {
         setBusy(false);
     }
@@ -782,6 +928,8 @@ void DataModel::removeRadios()
 
 void DataModel::genresAdded(DataModel::ListGenreDataType newData)
 {
+    ELISA_TRACE_SCOPE("model", "DataModel::genresAdded");
+
     if (newData.isEmpty() && d->mModelType == ElisaUtils::Genre) {
         setBusy(false);
     }
@@ -790,6 +938,11 @@ void DataModel::genresAdded(DataModel::ListGenreDataType newData)
         return;
     }
 
+    if (d->mUseSortFilter) {
+        insertSortFilteredData(d->mAllGenreData, newData);
+        return;
+    }
+
     if (d->mAllGenreData.isEmpty()) {
         beginInsertRows({}, d->mAllGenreData.size(), newData.size() - 1);
         d->mAllGenreData.swap(newData);
@@ -805,6 +958,8 @@ void DataModel::genresAdded(DataModel::ListGenreDataType newData)
 
 void DataModel::artistsAdded(DataModel::ListArtistDataType newData)
 {
+    ELISA_TRACE_SCOPE("model", "DataModel::artistsAdded");
+
     if (newData.isEmpty() && d->mModelType == ElisaUtils::Artist) {
         setBusy(false);
     }
@@ -813,6 +968,11 @@ void DataModel::artistsAdded(DataModel::ListArtistDataType newData)
         return;
     }
 
+    if (d->mUseSortFilter) {
+        insertSortFilteredData(d->mAllArtistData, newData);
+        return;
+    }
+
     if (d->mAllArtistData.isEmpty()) {
         beginInsertRows({}, d->mAllArtistData.size(), newData.size() - 1);
         d->mAllArtistData.swap(newData);
@@ -852,6 +1012,8 @@ void DataModel::artistRemoved(qulonglong removedDatabaseId)
 
 void DataModel::albumsAdded(DataModel::ListAlbumDataType newData)
 {
+    ELISA_TRACE_SCOPE("model", "DataModel::albumsAdded");
+
     if (newData.isEmpty() && d->mModelType == ElisaUtils::Album) {
         setBusy(false);
     }
@@ -860,6 +1022,11 @@ void DataModel::albumsAdded(DataModel::ListAlbumDataType newData)
         return;
     }
 
+    if (d->mUseSortFilter) {
+        insertSortFilteredData(d->mAllAlbumData, newData);
+        return;
+    }
+
     if (d->mAllAlbumData.isEmpty()) {
         beginInsertRows({}, d->mAllAlbumData.size(), newData.size() - 1);
         d->mAllAlbumData.swap(newData);
@@ -933,8 +1100,45 @@ void DataModel::initialize(MusicListenersManager *manager, DatabaseInterface *da
     initializeModel(manager, database, modelType, filter);
 }
 
+template <typename DataListType>
+void DataModel::insertSortFilteredData(DataListType &allData, DataListType newData)
+{
+    newData.erase(std::remove_if(newData.begin(), newData.end(), [this](const auto &oneEntry) {
+        return !matchSortFilter(oneEntry, d->mSortFilter);
+    }), newData.end());
+
+    const auto lessThan = SortFilterLessThan{d->mSortFilter};
+
+    if (allData.isEmpty()) {
+        if (!newData.isEmpty()) {
+            // data loaded from the database is already in order, only new entries need sorting
+            if (!std::is_sorted(newData.begin(), newData.end(), lessThan)) {
+                std::stable_sort(newData.begin(), newData.end(), lessThan);
+            }
+
+            beginInsertRows({}, 0, newData.size() - 1);
+            allData.swap(newData);
+            endInsertRows();
+        }
+
+        setBusy(false);
+
+        return;
+    }
+
+    for (const auto &oneEntry : newData) {
+        const auto position = std::upper_bound(allData.begin(), allData.end(), oneEntry, lessThan) - allData.begin();
+
+        beginInsertRows({}, position, position);
+        allData.insert(position, oneEntry);
+        endInsertRows();
+    }
+}
+
 void DataModel::cleanedDatabase()
 {
+    ELISA_TRACE_SCOPE("model", "DataModel::cleanedDatabase");
+
     beginResetModel();
     d->mAllAlbumData.clear();
     d->mAllGenreData.clear();
@@ -80,6 +80,8 @@ public:
 
     bool isBusy() const;
 
+    bool sortFilterInSource() const;
+
 Q_SIGNALS:
 
     void titleChanged();
@@ -88,6 +90,9 @@ Q_SIGNALS:
 
     void needData(ElisaUtils::PlayListEntryType dataType);
 
+    void needDataWithSortFilter(ElisaUtils::PlayListEntryType dataType,
+                                const DataTypes::SortFilterParameters &parameters);
+
     void needDataById(ElisaUtils::PlayListEntryType dataType, qulonglong databaseId);
 
     void needDataByGenre(ElisaUtils::PlayListEntryType dataType, const QString &genre);
@@ -103,6 +108,8 @@ Q_SIGNALS:
 
     void isBusyChanged();
 
+    void sortFilterInSourceChanged();
+
 public Q_SLOTS:
 
     void tracksAdded(DataModel::ListTrackDataType newData);
@@ -136,6 +143,8 @@ public Q_SLOTS:
                           ElisaUtils::PlayListEntryType modelType, ElisaUtils::FilterType filter,
                           const DataTypes::DataType &dataFilter);
 
+    void setSortFilter(const DataTypes::SortFilterParameters &parameters);
+
 private Q_SLOTS:
 
     void cleanedDatabase();
@@ -159,6 +168,9 @@ private:
 
     void removeRadios();
 
+    template <typename DataListType>
+    void insertSortFilteredData(DataListType &allData, DataListType newData);
+
     std::unique_ptr<DataModelPrivate> d;
 
 };
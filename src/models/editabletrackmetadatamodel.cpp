@@ -57,9 +57,9 @@ void EditableTrackMetadataModel::filterDataFromTrackData()
     validData();
 }
 
-void EditableTrackMetadataModel::fillLyricsDataFromTrack()
+void EditableTrackMetadataModel::fillLongTextDataFromTrack(const QString &lyrics, const QString &comment)
 {
-    TrackMetadataModel::fillLyricsDataFromTrack();
+    TrackMetadataModel::fillLongTextDataFromTrack(lyrics, comment);
     validData();
 }
 
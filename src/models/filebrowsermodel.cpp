@@ -6,15 +6,51 @@
 
 #include "filebrowsermodel.h"
 #include "datatypes.h"
+#include "elisatrace.h"
+#include "modeldataloader.h"
+#include "musiclistenersmanager.h"
 
 #include <QUrl>
 #include <QString>
+#include <QCache>
+#include <QHash>
 #include <QMimeDatabase>
 #include <KIOWidgets/KDirLister>
 
 #include "models/modelLogging.h"
 
-FileBrowserModel::FileBrowserModel(QObject *parent) : KDirModel(parent)
+#include <algorithm>
+
+namespace {
+
+/**
+ * number of directories whose tracks are kept when browsing away from them
+ */
+constexpr int CachedDirectoriesCount = 32;
+
+QUrl directoryOfFile(const QUrl &fileUrl)
+{
+    return fileUrl.adjusted(QUrl::RemoveFilename | QUrl::StripTrailingSlash);
+}
+
+}
+
+class FileBrowserModelPrivate
+{
+public:
+
+    ModelDataLoader *mDataLoader = nullptr;
+
+    /**
+     * tracks of the files already asked to the database by directory, files not in it have an empty entry
+     */
+    QCache<QUrl, QHash<QUrl, DataTypes::TrackDataType>> mDirectoriesTracks{CachedDirectoriesCount};
+
+    mutable QHash<QString, bool> mIsPlayListByMimeType;
+
+};
+
+FileBrowserModel::FileBrowserModel(QObject *parent) : KDirModel(parent), d(std::make_unique<FileBrowserModelPrivate>())
 {
     QMimeDatabase db;
     const QList<QMimeType> mimeList = db.allMimeTypes();
@@ -26,6 +62,11 @@ FileBrowserModel::FileBrowserModel(QObject *parent) : KDirModel(parent)
     }
 
     dirLister()->setMimeFilter(mimeTypes);
+
+    connect(dirLister(), QOverload<const QUrl &, const KFileItemList &>::of(&KCoreDirLister::itemsAdded),
+            this, &FileBrowserModel::directoryItemsAdded);
+    connect(dirLister(), &KCoreDirLister::refreshItems,
+            this, &FileBrowserModel::directoryItemsRefreshed);
 }
 
 FileBrowserModel::~FileBrowserModel()
@@ -38,6 +79,8 @@ void FileBrowserModel::setUrl(const QUrl &url)
         return;
     }
 
+    ELISA_TRACE_SCOPE_DETAIL("model", "FileBrowserModel::setUrl", url.toString());
+
     beginResetModel();
     dirLister()->openUrl(url);
 
@@ -95,13 +138,35 @@ QVariant FileBrowserModel::data(const QModelIndex &index, int role) const
     case DataTypes::ColumnsRoles::ImageUrlRole:
     {
         KFileItem item = itemForIndex(index);
+        const auto track = trackData(item);
         if (item.isDir()) {
             result = QUrl(QStringLiteral("image://icon/folder"));
+        } else if (track && !track->albumCover().isEmpty()) {
+            result = track->albumCover();
         } else {
             result = QUrl(QStringLiteral("image://icon/audio-x-generic"));
         }
         break;
     }
+    case DataTypes::ColumnsRoles::TitleRole:
+    case DataTypes::ColumnsRoles::ArtistRole:
+    case DataTypes::ColumnsRoles::AlbumRole:
+    case DataTypes::ColumnsRoles::AlbumArtistRole:
+    case DataTypes::ColumnsRoles::GenreRole:
+    case DataTypes::ColumnsRoles::DurationRole:
+    case DataTypes::ColumnsRoles::TrackNumberRole:
+    case DataTypes::ColumnsRoles::DiscNumberRole:
+    case DataTypes::ColumnsRoles::RatingRole:
+    case DataTypes::ColumnsRoles::DatabaseIdRole:
+    {
+        const auto track = trackData(itemForIndex(index));
+        if (track && track->contains(static_cast<DataTypes::ColumnsRoles>(role))) {
+            result = track->value(static_cast<DataTypes::ColumnsRoles>(role));
+        } else {
+            result = KDirModel::data(index, role);
+        }
+        break;
+    }
     case DataTypes::ColumnsRoles::IsDirectoryRole:
     {
         KFileItem item = itemForIndex(index);
@@ -111,7 +176,7 @@ QVariant FileBrowserModel::data(const QModelIndex &index, int role) const
     case DataTypes::ColumnsRoles::IsPlayListRole:
     {
         KFileItem item = itemForIndex(index);
-        result = (item.currentMimeType().inherits(QStringLiteral("audio/x-mpegurl")));
+        result = isPlayList(item);
         break;
     }
     case DataTypes::ColumnsRoles::ElementTypeRole:
@@ -128,8 +193,12 @@ QVariant FileBrowserModel::data(const QModelIndex &index, int role) const
                                                                   {DataTypes::ColumnsRoles::ElementTypeRole, ElisaUtils::Container},
                                                                   {DataTypes::TitleRole, item.name()},
                                                                   {DataTypes::ImageUrlRole, QUrl(QStringLiteral("image://icon/folder"))}});
+        } else if (const auto track = trackData(item)) {
+            DataTypes::MusicDataType fullData = *track;
+            fullData[DataTypes::ColumnsRoles::ElementTypeRole] = ElisaUtils::Track;
+            result = QVariant::fromValue(fullData);
         } else {
-            if (item.currentMimeType().inherits(QStringLiteral("audio/x-mpegurl"))) {
+            if (isPlayList(item)) {
             } else {
                 result = QVariant::fromValue(DataTypes::MusicDataType{{DataTypes::ColumnsRoles::ResourceRole, item.url()},
                                                                       {DataTypes::ColumnsRoles::ElementTypeRole, ElisaUtils::Track},
@@ -157,14 +226,14 @@ void FileBrowserModel::initialize(MusicListenersManager *manager, DatabaseInterf
                                   const QString &genre, const QString &artist, qulonglong databaseId,
                                   const QUrl &pathFilter)
 {
-    Q_UNUSED(manager)
-    Q_UNUSED(database)
     Q_UNUSED(modelType)
     Q_UNUSED(filter)
     Q_UNUSED(genre)
     Q_UNUSED(artist)
     Q_UNUSED(databaseId)
 
+    connectDatabase(manager, database);
+
     setUrl(pathFilter);
 }
 
@@ -172,13 +241,172 @@ void FileBrowserModel::initializeByData(MusicListenersManager *manager, Database
                                         ElisaUtils::PlayListEntryType modelType, ElisaUtils::FilterType filter,
                                         const DataTypes::DataType &dataFilter)
 {
-    Q_UNUSED(manager)
-    Q_UNUSED(database)
     Q_UNUSED(modelType)
     Q_UNUSED(filter)
 
+    connectDatabase(manager, database);
+
     setUrl(dataFilter[DataTypes::FilePathRole].toUrl());
 }
 
+void FileBrowserModel::connectDatabase(MusicListenersManager *manager, DatabaseInterface *database)
+{
+    if (d->mDataLoader) {
+        return;
+    }
+
+    if (manager) {
+        database = manager->viewDatabase();
+    }
+
+    if (!database) {
+        return;
+    }
+
+    d->mDataLoader = new ModelDataLoader;
+    connect(this, &FileBrowserModel::destroyed, d->mDataLoader, &ModelDataLoader::deleteLater);
+
+    d->mDataLoader->setDatabase(database);
+
+    if (manager) {
+        manager->connectModel(d->mDataLoader);
+    }
+
+    connect(this, &FileBrowserModel::needDataByFileNames,
+            d->mDataLoader, &ModelDataLoader::loadDataByFileNames);
+    connect(d->mDataLoader, &ModelDataLoader::allTracksDataFromFileNames,
+            this, &FileBrowserModel::tracksFromFileNames);
+}
+
+void FileBrowserModel::directoryItemsAdded(const QUrl &directoryUrl, const KFileItemList &items)
+{
+    requestTracks(directoryUrl, items);
+}
+
+void FileBrowserModel::directoryItemsRefreshed(const QList<QPair<KFileItem, KFileItem>> &items)
+{
+    auto modifiedItems = KFileItemList{};
+
+    for (const auto &oneItem : items) {
+        const auto &newItem = oneItem.second;
+
+        auto directoryTracks = d->mDirectoriesTracks.object(directoryOfFile(newItem.url()));
+        if (directoryTracks) {
+            directoryTracks->remove(newItem.url());
+        }
+
+        modifiedItems.push_back(newItem);
+    }
+
+    if (!modifiedItems.isEmpty()) {
+        requestTracks(dirLister()->url(), modifiedItems);
+    }
+}
+
+void FileBrowserModel::requestTracks(const QUrl &directoryUrl, const KFileItemList &items)
+{
+    if (!d->mDataLoader) {
+        return;
+    }
+
+    auto newFiles = QList<QUrl>{};
+
+    for (const auto &oneItem : items) {
+        if (oneItem.isDir() || !oneItem.isLocalFile()) {
+            continue;
+        }
+
+        const auto fileUrl = oneItem.url();
+        const auto fileDirectory = directoryOfFile(fileUrl);
+
+        auto directoryTracks = d->mDirectoriesTracks.object(fileDirectory);
+        if (!directoryTracks) {
+            directoryTracks = new QHash<QUrl, DataTypes::TrackDataType>;
+            d->mDirectoriesTracks.insert(fileDirectory, directoryTracks);
+        }
+
+        if (directoryTracks->contains(fileUrl)) {
+            continue;
+        }
+
+        // a file is asked once, the result fills this entry if the file is known to the database
+        directoryTracks->insert(fileUrl, {});
+        newFiles.push_back(fileUrl);
+    }
+
+    if (newFiles.isEmpty()) {
+        return;
+    }
+
+    Q_EMIT needDataByFileNames(directoryUrl, newFiles);
+}
+
+void FileBrowserModel::tracksFromFileNames(const QUrl &directoryUrl, const DataTypes::ListTrackDataType &tracks)
+{
+    Q_UNUSED(directoryUrl)
+
+    auto firstRow = rowCount();
+    auto lastRow = -1;
+    auto parentIndex = QModelIndex{};
+
+    for (const auto &oneTrack : tracks) {
+        const auto fileUrl = oneTrack.resourceURI();
+
+        auto directoryTracks = d->mDirectoriesTracks.object(directoryOfFile(fileUrl));
+        if (!directoryTracks) {
+            continue;
+        }
+
+        directoryTracks->insert(fileUrl, oneTrack);
+
+        const auto fileIndex = indexForUrl(fileUrl);
+        if (!fileIndex.isValid()) {
+            continue;
+        }
+
+        parentIndex = fileIndex.parent();
+        firstRow = std::min(firstRow, fileIndex.row());
+        lastRow = std::max(lastRow, fileIndex.row());
+    }
+
+    // all the files of one result are in the same directory, one signal covers them
+    if (lastRow >= firstRow) {
+        Q_EMIT dataChanged(index(firstRow, 0, parentIndex), index(lastRow, 0, parentIndex));
+    }
+}
+
+const DataTypes::TrackDataType *FileBrowserModel::trackData(const KFileItem &item) const
+{
+    if (item.isNull() || item.isDir()) {
+        return nullptr;
+    }
+
+    const auto fileUrl = item.url();
+
+    const auto directoryTracks = d->mDirectoriesTracks.object(directoryOfFile(fileUrl));
+    if (!directoryTracks) {
+        return nullptr;
+    }
+
+    const auto itTrack = directoryTracks->constFind(fileUrl);
+    if (itTrack == directoryTracks->constEnd() || itTrack->isEmpty()) {
+        return nullptr;
+    }
+
+    return &(*itTrack);
+}
+
+bool FileBrowserModel::isPlayList(const KFileItem &item) const
+{
+    const auto mimeTypeName = item.mimetype();
+
+    auto itMimeType = d->mIsPlayListByMimeType.constFind(mimeTypeName);
+    if (itMimeType == d->mIsPlayListByMimeType.constEnd()) {
+        itMimeType = d->mIsPlayListByMimeType.insert(mimeTypeName, item.currentMimeType().inherits(QStringLiteral("audio/x-mpegurl")));
+    }
+
+    return *itMimeType;
+}
+
 
 #include "moc_filebrowsermodel.cpp"
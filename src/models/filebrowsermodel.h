@@ -14,8 +14,11 @@
 
 #include <KIOWidgets/KDirModel>
 
+#include <memory>
+
 class MusicListenersManager;
 class DatabaseInterface;
+class FileBrowserModelPrivate;
 
 class ELISALIB_EXPORT FileBrowserModel : public KDirModel
 {
@@ -41,6 +44,8 @@ Q_SIGNALS:
 
     void isBusyChanged();
 
+    void needDataByFileNames(const QUrl &directoryUrl, const QList<QUrl> &fileNames);
+
 public Q_SLOTS:
 
     void initialize(MusicListenersManager *manager, DatabaseInterface *database,
@@ -51,6 +56,26 @@ public Q_SLOTS:
     void initializeByData(MusicListenersManager *manager, DatabaseInterface *database,
                           ElisaUtils::PlayListEntryType modelType, ElisaUtils::FilterType filter,
                           const DataTypes::DataType &dataFilter);
+
+private Q_SLOTS:
+
+    void directoryItemsAdded(const QUrl &directoryUrl, const KFileItemList &items);
+
+    void directoryItemsRefreshed(const QList<QPair<KFileItem, KFileItem>> &items);
+
+    void tracksFromFileNames(const QUrl &directoryUrl, const DataTypes::ListTrackDataType &tracks);
+
+private:
+
+    void connectDatabase(MusicListenersManager *manager, DatabaseInterface *database);
+
+    void requestTracks(const QUrl &directoryUrl, const KFileItemList &items);
+
+    const DataTypes::TrackDataType *trackData(const KFileItem &item) const;
+
+    bool isPlayList(const KFileItem &item) const;
+
+    std::unique_ptr<FileBrowserModelPrivate> d;
 };
 
 
@@ -13,8 +13,49 @@
 
 #include "models/modelLogging.h"
 
+#include <QFileInfo>
+#include <QHash>
+
 #include <stack>
 
+namespace {
+
+/**
+ * audio or not audio by file name suffix, built once from the mime types database
+ */
+const QHash<QString, bool> &audioSuffixes()
+{
+    static const auto allSuffixes = []() {
+        auto result = QHash<QString, bool>{};
+
+        QMimeDatabase mimeDatabase;
+        const auto allMimeTypes = mimeDatabase.allMimeTypes();
+
+        for (const auto &oneMimeType : allMimeTypes) {
+            const auto isAudio = oneMimeType.name().startsWith(QLatin1String("audio/"));
+
+            const auto suffixes = oneMimeType.suffixes();
+            for (const auto &oneSuffix : suffixes) {
+                const auto suffix = oneSuffix.toLower();
+
+                // a suffix shared by audio and other mime types is considered as audio
+                auto itSuffix = result.find(suffix);
+                if (itSuffix == result.end()) {
+                    result.insert(suffix, isAudio);
+                } else if (isAudio) {
+                    *itSuffix = true;
+                }
+            }
+        }
+
+        return result;
+    }();
+
+    return allSuffixes;
+}
+
+}
+
 FileBrowserProxyModel::FileBrowserProxyModel(QObject *parent)
     : KDirSortFilterProxyModel(parent)
 {
@@ -47,11 +88,18 @@ void FileBrowserProxyModel::setFilterText(const QString &filterText)
     Q_EMIT filterTextChanged(mFilterText);
 }
 
-void FileBrowserProxyModel::listRecursiveResult(KJob *)
+void FileBrowserProxyModel::listRecursiveResult(KJob *job)
 {
+    if (job != mCurrentJob) {
+        return;
+    }
+
+    mCurrentJob = nullptr;
+
+    sendPendingData();
+
     if (mPendingEntries.empty()) {
-        mEnqueueInProgress = false;
-        Q_EMIT entriesToEnqueue(mAllData, mEnqueueMode, mTriggerPlay);
+        finishEnqueue();
         return;
     }
 
@@ -60,39 +108,53 @@ void FileBrowserProxyModel::listRecursiveResult(KJob *)
 
 void FileBrowserProxyModel::listRecursiveNewEntries(KIO::Job *job, const KIO::UDSEntryList &list)
 {
-    Q_UNUSED(job)
+    if (job != mCurrentJob) {
+        return;
+    }
 
     for (const auto &oneEntry : list) {
         if (oneEntry.isDir()) {
             continue;
         }
 
-        auto returnedPath = oneEntry.stringValue(KIO::UDSEntry::UDS_NAME);
-        auto fullPath = QStringLiteral("%0/%1").arg(mCurentUrl.toString(), returnedPath);
-        auto fullPathUrl = QUrl { fullPath };
+        const auto returnedPath = oneEntry.stringValue(KIO::UDSEntry::UDS_NAME);
 
-        auto mimeType = mMimeDatabase.mimeTypeForUrl(fullPathUrl);
+        auto fullPathUrl = mCurentUrl;
+        fullPathUrl.setPath(mCurrentPath + returnedPath, QUrl::DecodedMode);
 
-        if (!mimeType.name().startsWith(QLatin1String("audio/"))) {
+        if (!isAudioFile(fullPathUrl, returnedPath)) {
             continue;
         }
 
         mAllData.push_back({{{DataTypes::ElementTypeRole, ElisaUtils::FileName},
-                             {DataTypes::ResourceRole, fullPathUrl}}, fullPath, {}});
+                             {DataTypes::ResourceRole, fullPathUrl}}, fullPathUrl.toString(), {}});
     }
+
+    // each batch listed by KIO goes to the playlist at once, playback can start before the listing is done
+    sendPendingData();
+}
+
+bool FileBrowserProxyModel::isAudioFile(const QUrl &fileUrl, const QString &fileName) const
+{
+    const auto &allSuffixes = audioSuffixes();
+
+    const auto itSuffix = allSuffixes.constFind(QFileInfo(fileName).suffix().toLower());
+    if (itSuffix != allSuffixes.constEnd()) {
+        return *itSuffix;
+    }
+
+    // only files with an unknown suffix need their content to be read
+    const auto mimeType = (fileUrl.isLocalFile() ? mMimeDatabase.mimeTypeForFile(fileUrl.toLocalFile())
+                                                 : mMimeDatabase.mimeTypeForUrl(fileUrl));
+
+    return mimeType.name().startsWith(QLatin1String("audio/"));
 }
 
 void FileBrowserProxyModel::genericEnqueueToPlayList(QModelIndex rootIndex,
                                                      ElisaUtils::PlayListEnqueueMode enqueueMode,
                                                      ElisaUtils::PlayListEnqueueTriggerPlay triggerPlay)
 {
-    if (mEnqueueInProgress) {
-        // display error
-        return;
-    }
-
-    mPendingEntries = {};
-    mAllData.clear();
+    cancelEnqueue();
 
     for (int rowIndex = 0, maxRowCount = rowCount(); rowIndex < maxRowCount; ++rowIndex) {
         auto currentIndex = index(rowIndex, 0, rootIndex);
@@ -100,10 +162,7 @@ void FileBrowserProxyModel::genericEnqueueToPlayList(QModelIndex rootIndex,
                                 currentIndex.data(DataTypes::ElementTypeRole).value<ElisaUtils::PlayListEntryType>() == ElisaUtils::Container);
     }
 
-    mEnqueueInProgress = true;
-    mEnqueueMode = enqueueMode;
-    mTriggerPlay = triggerPlay;
-    recursiveEnqueue();
+    startEnqueue(enqueueMode, triggerPlay);
 }
 
 void FileBrowserProxyModel::enqueueToPlayList(QModelIndex rootIndex)
@@ -120,21 +179,14 @@ void FileBrowserProxyModel::enqueue(const DataTypes::MusicDataType &newEntry,
 {
     Q_UNUSED(newEntryTitle)
 
-    if (mEnqueueInProgress) {
-        // display error
-        return;
-    }
+    cancelEnqueue();
 
-    mPendingEntries = {};
-    mAllData.clear();
+    const auto isDirectory = (newEntry.elementType() == ElisaUtils::Container);
 
-    mPendingEntries.emplace(newEntry[DataTypes::ResourceRole].toUrl(),
-            newEntry.elementType() == ElisaUtils::Container);
+    // directories only have a file path
+    mPendingEntries.emplace(newEntry[isDirectory ? DataTypes::FilePathRole : DataTypes::ResourceRole].toUrl(), isDirectory);
 
-    mEnqueueInProgress = true;
-    mEnqueueMode = enqueueMode;
-    mTriggerPlay = triggerPlay;
-    recursiveEnqueue();
+    startEnqueue(enqueueMode, triggerPlay);
 }
 
 void FileBrowserProxyModel::replaceAndPlayOfPlayList(QModelIndex rootIndex)
@@ -160,34 +212,101 @@ void FileBrowserProxyModel::connectPlayList()
     }
 }
 
+void FileBrowserProxyModel::startEnqueue(ElisaUtils::PlayListEnqueueMode enqueueMode,
+                                         ElisaUtils::PlayListEnqueueTriggerPlay triggerPlay)
+{
+    if (mPendingEntries.empty()) {
+        return;
+    }
+
+    mEnqueueInProgress = true;
+    mEnqueueMode = enqueueMode;
+    mTriggerPlay = triggerPlay;
+    Q_EMIT enqueueInProgressChanged();
+
+    recursiveEnqueue();
+}
+
 void FileBrowserProxyModel::recursiveEnqueue()
 {
-    auto [rootUrl, isDirectory] = mPendingEntries.front();
-    mPendingEntries.pop();
-    if (isDirectory) {
-        mCurentUrl = rootUrl;
-        mCurrentJob = KIO::listRecursive(rootUrl, { KIO::HideProgressInfo });
+    while (!mPendingEntries.empty()) {
+        auto [rootUrl, isDirectory] = mPendingEntries.front();
+        mPendingEntries.pop();
+
+        if (isDirectory) {
+            sendPendingData();
+
+            mCurentUrl = rootUrl;
+            // the listed names are not encoded, the folder path must not be either
+            mCurrentPath = rootUrl.path(QUrl::FullyDecoded);
+            if (!mCurrentPath.endsWith(QLatin1Char('/'))) {
+                mCurrentPath += QLatin1Char('/');
+            }
+
+            mCurrentJob = KIO::listRecursive(rootUrl, { KIO::HideProgressInfo });
+
+            connect(mCurrentJob, &KJob::result, this, &FileBrowserProxyModel::listRecursiveResult);
 
-        connect(mCurrentJob, &KJob::result, this, &FileBrowserProxyModel::listRecursiveResult);
+            connect(dynamic_cast<KIO::ListJob*>(mCurrentJob), &KIO::ListJob::entries,
+                    this, &FileBrowserProxyModel::listRecursiveNewEntries);
+
+            return;
+        }
 
-        connect(dynamic_cast<KIO::ListJob*>(mCurrentJob), &KIO::ListJob::entries,
-                this, &FileBrowserProxyModel::listRecursiveNewEntries);
-    } else {
         if (mPlayList) {
             mAllData.push_back({{{DataTypes::ElementTypeRole, ElisaUtils::FileName},
                                  {DataTypes::ResourceRole, rootUrl}},
                                 rootUrl.toString(),
                                 rootUrl});
+        }
+    }
 
-            if (mPendingEntries.empty()) {
-                mEnqueueInProgress = false;
-                Q_EMIT entriesToEnqueue(mAllData, mEnqueueMode, mTriggerPlay);
-                return;
-            }
+    sendPendingData();
+    finishEnqueue();
+}
 
-            recursiveEnqueue();
-        }
+void FileBrowserProxyModel::sendPendingData()
+{
+    if (mAllData.isEmpty()) {
+        return;
+    }
+
+    Q_EMIT entriesToEnqueue(mAllData, mEnqueueMode, mTriggerPlay);
+    mAllData.clear();
+
+    // only the first entries replace the playlist and start playing, the next ones are appended
+    mEnqueueMode = ElisaUtils::AppendPlayList;
+    mTriggerPlay = ElisaUtils::DoNotTriggerPlay;
+}
+
+void FileBrowserProxyModel::finishEnqueue()
+{
+    if (!mEnqueueInProgress) {
+        return;
+    }
+
+    mEnqueueInProgress = false;
+    Q_EMIT enqueueInProgressChanged();
+}
+
+void FileBrowserProxyModel::cancelEnqueue()
+{
+    if (mCurrentJob) {
+        auto currentJob = mCurrentJob;
+        mCurrentJob = nullptr;
+
+        currentJob->kill(KJob::Quietly);
     }
+
+    mPendingEntries = {};
+    mAllData.clear();
+
+    finishEnqueue();
+}
+
+bool FileBrowserProxyModel::enqueueInProgress() const
+{
+    return mEnqueueInProgress;
 }
 
 void FileBrowserProxyModel::setSourceModel(QAbstractItemModel *sourceModel)
@@ -46,6 +46,8 @@ class ELISALIB_EXPORT FileBrowserProxyModel : public KDirSortFilterProxyModel
 
     Q_PROPERTY(MediaPlayListProxyModel* playList READ playList WRITE setPlayList NOTIFY playListChanged)
 
+    Q_PROPERTY(bool enqueueInProgress READ enqueueInProgress NOTIFY enqueueInProgressChanged)
+
 public:
 
     explicit FileBrowserProxyModel(QObject *parent = nullptr);
@@ -60,6 +62,8 @@ public:
 
     MediaPlayListProxyModel* playList() const;
 
+    bool enqueueInProgress() const;
+
     void setSourceModel(QAbstractItemModel *sourceModel) override;
 
 public Q_SLOTS:
@@ -81,6 +85,8 @@ public Q_SLOTS:
 
     void sortModel(Qt::SortOrder order);
 
+    void cancelEnqueue();
+
 Q_SIGNALS:
 
     void entriesToEnqueue(const DataTypes::EntryDataList &newEntries,
@@ -95,6 +101,8 @@ Q_SIGNALS:
 
     void playListChanged();
 
+    void enqueueInProgressChanged();
+
 protected:
 
 private Q_SLOTS:
@@ -113,8 +121,17 @@ private:
 
     void connectPlayList();
 
+    void startEnqueue(ElisaUtils::PlayListEnqueueMode enqueueMode,
+                      ElisaUtils::PlayListEnqueueTriggerPlay triggerPlay);
+
     void recursiveEnqueue();
 
+    void finishEnqueue();
+
+    void sendPendingData();
+
+    bool isAudioFile(const QUrl &fileUrl, const QString &fileName) const;
+
     QString mFilterText;
 
     QRegularExpression mFilterExpression;
@@ -137,6 +154,8 @@ private:
 
     QUrl mCurentUrl;
 
+    QString mCurrentPath;
+
     KIO::Job *mCurrentJob = nullptr;
 
 };
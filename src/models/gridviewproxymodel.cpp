@@ -25,6 +25,11 @@ bool GridViewProxyModel::filterAcceptsRow(int source_row, const QModelIndex &sou
 {
     bool result = false;
 
+    if (sortFilterInSource()) {
+        result = true;
+        return result;
+    }
+
     auto currentIndex = sourceModel()->index(source_row, 0, source_parent);
 
     const auto &mainValue = sourceModel()->data(currentIndex, Qt::DisplayRole).toString();
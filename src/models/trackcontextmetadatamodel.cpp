@@ -23,8 +23,12 @@ void TrackContextMetaDataModel::filterDataFromTrackData()
     }
 }
 
-void TrackContextMetaDataModel::fillLyricsDataFromTrack()
+void TrackContextMetaDataModel::fillLongTextDataFromTrack(const QString &lyrics, const QString &comment)
 {
+    // lyrics are displayed on their own by the context view
+    Q_UNUSED(lyrics)
+
+    TrackMetadataModel::fillLongTextDataFromTrack({}, comment);
 }
 
 
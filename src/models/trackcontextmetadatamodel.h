@@ -24,7 +24,7 @@ protected:
 
     void filterDataFromTrackData() override;
 
-    void fillLyricsDataFromTrack() override;
+    void fillLongTextDataFromTrack(const QString &lyrics, const QString &comment) override;
 
 };
 
@@ -10,21 +10,12 @@
 
 #include <KI18n/KLocalizedString>
 
-#include <QtConcurrent>
-
 TrackMetadataModel::TrackMetadataModel(QObject *parent)
     : QAbstractListModel(parent)
 {
-    connect(&mLyricsValueWatcher, &QFutureWatcher<QString>::finished,
-            this, &TrackMetadataModel::lyricsValueIsReady);
 }
 
-TrackMetadataModel::~TrackMetadataModel()
-{
-    if (mLyricsValueWatcher.isRunning() && !mLyricsValueWatcher.isFinished()) {
-        mLyricsValueWatcher.waitForFinished();
-    }
-}
+TrackMetadataModel::~TrackMetadataModel() = default;
 
 int TrackMetadataModel::rowCount(const QModelIndex &parent) const
 {
@@ -180,6 +171,10 @@ QVariant TrackMetadataModel::data(const QModelIndex &index, int role) const
         case DataTypes::IsDirectoryRole:
         case DataTypes::IsPlayListRole:
         case DataTypes::FilePathRole:
+        case DataTypes::ReplayGainTrackGainRole:
+        case DataTypes::ReplayGainTrackPeakRole:
+        case DataTypes::ReplayGainAlbumGainRole:
+        case DataTypes::ReplayGainAlbumPeakRole:
             break;
         }
         break;
@@ -262,6 +257,10 @@ QVariant TrackMetadataModel::data(const QModelIndex &index, int role) const
         case DataTypes::IsDirectoryRole:
         case DataTypes::IsPlayListRole:
         case DataTypes::FilePathRole:
+        case DataTypes::ReplayGainTrackGainRole:
+        case DataTypes::ReplayGainTrackPeakRole:
+        case DataTypes::ReplayGainAlbumGainRole:
+        case DataTypes::ReplayGainAlbumPeakRole:
             break;
         }
         break;
@@ -344,6 +343,8 @@ void TrackMetadataModel::trackData(const TrackMetadataModel::TrackDataType &trac
                                                                  DataTypes::LastPlayDate, DataTypes::PlayCounter});
 
     fillDataFromTrackData(trackData, fieldsForTrack);
+
+    fetchLongText();
 }
 
 void TrackMetadataModel::fillDataFromTrackData(const TrackMetadataModel::TrackDataType &trackData,
@@ -363,8 +364,6 @@ void TrackMetadataModel::fillDataFromTrackData(const TrackMetadataModel::TrackDa
     filterDataFromTrackData();
     endResetModel();
 
-    fetchLyrics();
-
     mDatabaseId = trackData[DataTypes::DatabaseIdRole].toULongLong();
     Q_EMIT databaseIdChanged();
 
@@ -397,11 +396,30 @@ TrackMetadataModel::TrackDataType::mapped_type TrackMetadataModel::dataFromType(
     return mFullData[metaData];
 }
 
-void TrackMetadataModel::fillLyricsDataFromTrack()
+void TrackMetadataModel::fillLongTextDataFromTrack(const QString &lyrics, const QString &comment)
 {
-    beginInsertRows({}, mTrackData.size(), mTrackData.size());
-    mTrackKeys.push_back(DataTypes::LyricsRole);
-    mTrackData[DataTypes::LyricsRole] = mLyricsValueWatcher.result();
+    if (!comment.isEmpty()) {
+        setLongTextEntry(DataTypes::CommentRole, comment);
+    }
+
+    if (!lyrics.isEmpty()) {
+        setLongTextEntry(DataTypes::LyricsRole, lyrics);
+    }
+}
+
+void TrackMetadataModel::setLongTextEntry(DataTypes::ColumnsRoles role, const QString &value)
+{
+    const auto entryRow = mTrackKeys.indexOf(role);
+
+    if (entryRow != -1) {
+        mTrackData[role] = value;
+        Q_EMIT dataChanged(index(entryRow), index(entryRow));
+        return;
+    }
+
+    beginInsertRows({}, mTrackKeys.size(), mTrackKeys.size());
+    mTrackKeys.push_back(role);
+    mTrackData[role] = value;
     endInsertRows();
 }
 
@@ -410,12 +428,20 @@ const TrackMetadataModel::TrackDataType &TrackMetadataModel::allTrackData() cons
     return mTrackData;
 }
 
-void TrackMetadataModel::lyricsValueIsReady()
+void TrackMetadataModel::longTextIsReady(const QUrl &url, const QString &lyrics, const QString &comment)
 {
-    if (!mLyricsValueWatcher.result().isEmpty()) {
-        fillLyricsDataFromTrack();
+    if (url != mFileUrl || mFullData.isEmpty()) {
+        return;
+    }
+
+    fillLongTextDataFromTrack(lyrics, comment);
 
-        mFullData[DataTypes::LyricsRole] = mLyricsValueWatcher.result();
+    if (!comment.isEmpty()) {
+        mFullData[DataTypes::CommentRole] = comment;
+    }
+
+    if (!lyrics.isEmpty()) {
+        mFullData[DataTypes::LyricsRole] = lyrics;
 
         Q_EMIT lyricsChanged();
     }
@@ -447,6 +473,8 @@ void TrackMetadataModel::initialize(MusicListenersManager *newManager, DatabaseI
         mDataLoader.setDatabase(trackDatabase);
     }
 
+    setLongTextProvider(mManager ? mManager->trackLongTextProvider() : nullptr);
+
     if (mManager) {
         mManager->connectModel(&mDataLoader);
     }
@@ -471,17 +499,37 @@ void TrackMetadataModel::initialize(MusicListenersManager *newManager, DatabaseI
             this, &TrackMetadataModel::radioData);
 }
 
-void TrackMetadataModel::fetchLyrics()
+void TrackMetadataModel::setLongTextProvider(TrackLongTextProvider *provider)
 {
-    auto lyricicsValue = QtConcurrent::run(QThreadPool::globalInstance(), [=]() {
-        auto trackData = mFileScanner.scanOneFile(mFullData[DataTypes::ResourceRole].toUrl());
-        if (!trackData.lyrics().isEmpty()) {
-            return trackData.lyrics();
+    if (mLongTextProvider) {
+        disconnect(mLongTextProvider, &TrackLongTextProvider::longTextReady,
+                   this, &TrackMetadataModel::longTextIsReady);
+    }
+
+    if (!provider) {
+        if (!mOwnLongTextProvider) {
+            mOwnLongTextProvider = std::make_unique<TrackLongTextProvider>();
         }
-        return QString{};
-    });
+        provider = mOwnLongTextProvider.get();
+    }
+
+    mLongTextProvider = provider;
+
+    connect(mLongTextProvider, &TrackLongTextProvider::longTextReady,
+            this, &TrackMetadataModel::longTextIsReady);
+}
+
+void TrackMetadataModel::fetchLongText()
+{
+    if (mFileUrl.isEmpty()) {
+        return;
+    }
+
+    if (!mLongTextProvider) {
+        setLongTextProvider(nullptr);
+    }
 
-    mLyricsValueWatcher.setFuture(lyricicsValue);
+    mLongTextProvider->requestLongText(mFileUrl);
 }
 
 void TrackMetadataModel::initializeForNewRadio()
@@ -13,11 +13,12 @@
 #include "trackslistener.h"
 #include "datatypes.h"
 #include "modeldataloader.h"
-#include "filescanner.h"
+#include "tracklongtextprovider.h"
 
 #include <QUrl>
 #include <QAbstractListModel>
-#include <QFutureWatcher>
+
+#include <memory>
 
 class MusicListenersManager;
 
@@ -142,20 +143,24 @@ protected:
 
     TrackDataType::mapped_type dataFromType(TrackDataType::key_type metaData) const;
 
-    virtual void fillLyricsDataFromTrack();
+    virtual void fillLongTextDataFromTrack(const QString &lyrics, const QString &comment);
 
     const TrackDataType& allTrackData() const;
 
 private Q_SLOTS:
 
-    void lyricsValueIsReady();
+    void longTextIsReady(const QUrl &url, const QString &lyrics, const QString &comment);
 
 private:
 
     void initialize(MusicListenersManager *newManager,
                     DatabaseInterface *trackDatabase);
 
-    void fetchLyrics();
+    void setLongTextProvider(TrackLongTextProvider *provider);
+
+    void setLongTextEntry(DataTypes::ColumnsRoles role, const QString &value);
+
+    void fetchLongText();
 
     TrackDataType mFullData;
 
@@ -173,9 +178,12 @@ private:
 
     MusicListenersManager *mManager = nullptr;
 
-    FileScanner mFileScanner;
+    TrackLongTextProvider *mLongTextProvider = nullptr;
 
-    QFutureWatcher<QString> mLyricsValueWatcher;
+    /**
+     * used when there is no manager to share its provider
+     */
+    std::unique_ptr<TrackLongTextProvider> mOwnLongTextProvider;
 };
 
 #endif // TRACKMETADATAMODEL_H
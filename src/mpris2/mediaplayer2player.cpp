@@ -30,6 +30,9 @@
 static const double MAX_RATE = 1.0;
 static const double MIN_RATE = 1.0;
 
+/* position updates further than this from the extrapolated position are announced as seeks */
+static const qlonglong SEEKED_TOLERANCE = 1000000;
+
 MediaPlayer2Player::MediaPlayer2Player(MediaPlayListProxyModel *playListControler, ManageAudioPlayer *manageAudioPlayer,
                                        ManageMediaPlayerControl *manageMediaPlayerControl, ManageHeaderBar *manageHeaderBar,
                                        AudioWrapper *audioPlayer, bool showProgressOnTaskBar, QObject* parent)
@@ -40,6 +43,12 @@ MediaPlayer2Player::MediaPlayer2Player(MediaPlayListProxyModel *playListControle
                                                           QStringLiteral("Update"))),
       mShowProgressOnTaskBar(showProgressOnTaskBar)
 {
+    // all properties changed during one event loop iteration are sent in one PropertiesChanged signal
+    mPropertiesChangeTimer.setSingleShot(true);
+    mPropertiesChangeTimer.setInterval(0);
+    connect(&mPropertiesChangeTimer, &QTimer::timeout,
+            this, &MediaPlayer2Player::sendPropertiesChange);
+
     if (!m_playListControler) {
         return;
     }
@@ -201,14 +210,32 @@ QVariantMap MediaPlayer2Player::Metadata() const
 
 qlonglong MediaPlayer2Player::Position() const
 {
+    if (m_audioPlayer) {
+        return m_audioPlayer->estimatedPosition() * 1000;
+    }
+
     return m_position;
 }
 
 void MediaPlayer2Player::setPropertyPosition(int newPositionInMs)
 {
-    m_position = qlonglong(newPositionInMs) * 1000;
+    const auto newPosition = qlonglong(newPositionInMs) * 1000;
 
-    Q_EMIT Seeked(m_position);
+    /* clients extrapolate the position from Rate,
+     * Seeked is only needed when playback jumped
+     */
+    auto expectedPosition = m_position;
+    if (mPositionReference.isValid() && m_manageAudioPlayer->playerPlaybackState() == QMediaPlayer::PlayingState) {
+        expectedPosition += mPositionReference.elapsed() * 1000;
+    }
+
+    m_position = newPosition;
+
+    if (!mPositionReference.isValid() || qAbs(newPosition - expectedPosition) > SEEKED_TOLERANCE) {
+        Q_EMIT Seeked(m_position);
+    }
+
+    mPositionReference.start();
 
     /* only sent new progress when it has advanced more than 1 %
      * to limit DBus traffic
@@ -267,7 +294,7 @@ bool MediaPlayer2Player::CanControl() const
 void MediaPlayer2Player::Seek(qlonglong Offset)
 {
     if (mediaPlayerPresent()) {
-        auto offset = (m_position + Offset) / 1000;
+        auto offset = (Position() + Offset) / 1000;
         m_manageAudioPlayer->playerSeek(int(offset));
     }
 }
@@ -360,8 +387,7 @@ void MediaPlayer2Player::audioPositionChanged()
 
 void MediaPlayer2Player::audioDurationChanged()
 {
-    m_metadata = getMetadataOfCurrentTrack();
-    signalPropertiesChange(QStringLiteral("Metadata"), Metadata());
+    updateMetadata();
 
     skipBackwardControlEnabledChanged();
     skipForwardControlEnabledChanged();
@@ -387,6 +413,21 @@ void MediaPlayer2Player::setCurrentTrack(int newTrackPosition)
 
     emit currentTrackChanged();
 
+    updateMetadata();
+}
+
+void MediaPlayer2Player::updateMetadata()
+{
+    // building the metadata may read and encode an embedded cover, only do it when one of its inputs changed
+    const auto metadataInputs = QVariantList{m_currentTrackId, m_manageAudioPlayer->audioDuration(), m_manageAudioPlayer->playerSource(),
+                                             m_manageHeaderBar->title(), m_manageHeaderBar->album(),
+                                             m_manageHeaderBar->artist(), m_manageHeaderBar->image()};
+
+    if (metadataInputs == mMetadataInputs) {
+        return;
+    }
+
+    mMetadataInputs = metadataInputs;
     m_metadata = getMetadataOfCurrentTrack();
     signalPropertiesChange(QStringLiteral("Metadata"), Metadata());
 }
@@ -480,9 +521,34 @@ void MediaPlayer2Player::setMediaPlayerPresent(int status)
 }
 
 void MediaPlayer2Player::signalPropertiesChange(const QString &property, const QVariant &value)
+{
+    mPendingProperties[property] = value;
+
+    if (!mPropertiesChangeTimer.isActive()) {
+        mPropertiesChangeTimer.start();
+    }
+}
+
+void MediaPlayer2Player::sendPropertiesChange()
 {
     QVariantMap properties;
-    properties[property] = value;
+
+    for (auto itProperty = mPendingProperties.cbegin(); itProperty != mPendingProperties.cend(); ++itProperty) {
+        auto itPublished = mPublishedProperties.find(itProperty.key());
+        if (itPublished != mPublishedProperties.end() && *itPublished == itProperty.value()) {
+            continue;
+        }
+
+        mPublishedProperties[itProperty.key()] = itProperty.value();
+        properties[itProperty.key()] = itProperty.value();
+    }
+
+    mPendingProperties.clear();
+
+    if (properties.isEmpty()) {
+        return;
+    }
+
     const int ifaceIndex = metaObject()->indexOfClassInfo("D-Bus Interface");
     QDBusMessage msg = QDBusMessage::createSignal(QStringLiteral("/org/mpris/MediaPlayer2"),
                                                   QStringLiteral("org.freedesktop.DBus.Properties"), QStringLiteral("PropertiesChanged"));
@@ -14,6 +14,9 @@
 #include <QDBusAbstractAdaptor>
 #include <QDBusObjectPath>
 #include <QDBusMessage>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QVariantMap>
 
 class MediaPlayListProxyModel;
 class ManageAudioPlayer;
@@ -124,9 +127,13 @@ private Q_SLOTS:
 
     void playerVolumeChanged();
 
+    void sendPropertiesChange();
+
 private:
     void signalPropertiesChange(const QString &property, const QVariant &value);
 
+    void updateMetadata();
+
     void setMediaPlayerPresent(int status);
     void setRate(double newRate);
     void setVolume(double volume);
@@ -136,6 +143,10 @@ private:
     QVariantMap getMetadataOfCurrentTrack();
 
     QVariantMap m_metadata;
+    QVariantList mMetadataInputs;
+    QVariantMap mPendingProperties;
+    QVariantMap mPublishedProperties;
+    QTimer mPropertiesChangeTimer;
     QString m_currentTrack;
     QString m_currentTrackId;
     double m_rate = 1.0;
@@ -145,6 +156,7 @@ private:
     bool m_canGoNext = false;
     bool m_canGoPrevious = false;
     qlonglong m_position = 0;
+    QElapsedTimer mPositionReference;
     MediaPlayListProxyModel *m_playListControler = nullptr;
     bool m_playerIsSeekableChanged = false;
     ManageAudioPlayer* m_manageAudioPlayer = nullptr;
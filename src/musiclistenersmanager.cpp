@@ -24,6 +24,7 @@
 #endif
 
 #include "databaseinterface.h"
+#include "loudnessanalyzer.h"
 #include "mediaplaylist.h"
 #include "file/filelistener.h"
 #include "file/localfilelisting.h"
@@ -31,6 +32,9 @@
 #include "elisaapplication.h"
 #include "elisa_settings.h"
 #include "modeldataloader.h"
+#include "tracklongtextprovider.h"
+#include "radiohistoryrecorder.h"
+#include "startuptrace.h"
 
 #include <KI18n/KLocalizedString>
 
@@ -69,6 +73,12 @@ public:
 
     DatabaseInterface mDatabaseInterface;
 
+    LoudnessAnalyzer mLoudnessAnalyzer;
+
+    TrackLongTextProvider mTrackLongTextProvider;
+
+    RadioHistoryRecorder mRadioHistoryRecorder;
+
     std::unique_ptr<TracksListener> mTracksListener;
 
     QFileSystemWatcher mConfigFileWatcher;
@@ -91,6 +101,12 @@ public:
 
     bool mAndroidIndexerAvailable = false;
 
+    bool mDatabaseIsReady = false;
+
+    bool mBackgroundTasksAllowed = true;
+
+    bool mBackgroundTasksStarted = false;
+
 };
 
 MusicListenersManager::MusicListenersManager(QObject *parent)
@@ -111,17 +127,34 @@ MusicListenersManager::MusicListenersManager(QObject *parent)
     connect(&d->mDatabaseInterface, &DatabaseInterface::cleanedDatabase,
             this, &MusicListenersManager::cleanedDatabase);
 
+    connect(&d->mLoudnessAnalyzer, &LoudnessAnalyzer::askTracksPendingAnalysis,
+            &d->mDatabaseInterface, &DatabaseInterface::askTracksPendingLoudnessAnalysis);
+    connect(&d->mDatabaseInterface, &DatabaseInterface::tracksPendingLoudnessAnalysis,
+            &d->mLoudnessAnalyzer, &LoudnessAnalyzer::analyzeTracks);
+    connect(&d->mLoudnessAnalyzer, &LoudnessAnalyzer::tracksAnalyzed,
+            &d->mDatabaseInterface, &DatabaseInterface::updateLoudnessAnalysis);
+    connect(&d->mDatabaseInterface, &DatabaseInterface::finishInsertingTracksList,
+            &d->mLoudnessAnalyzer, &LoudnessAnalyzer::libraryChanged);
+
+    connect(&d->mRadioHistoryRecorder, &RadioHistoryRecorder::radiosHistoryReady,
+            &d->mDatabaseInterface, &DatabaseInterface::insertRadiosHistory);
+
     connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit,
             this, &MusicListenersManager::applicationAboutToQuit);
 
     connect(&d->mConfigFileWatcher, &QFileSystemWatcher::fileChanged,
             this, &MusicListenersManager::configChanged);
 
+    d->mListenerThread.setObjectName(QStringLiteral("listeners"));
+    d->mDatabaseThread.setObjectName(QStringLiteral("database"));
+
     d->mListenerThread.start();
     d->mDatabaseThread.start();
 
     d->mDatabaseInterface.moveToThread(&d->mDatabaseThread);
 
+    d->mTrackLongTextProvider.setDatabase(&d->mDatabaseInterface);
+
     const auto &localDataPaths = QStandardPaths::standardLocations(QStandardPaths::AppDataLocation);
     auto databaseFileName = QString();
     if (!localDataPaths.isEmpty()) {
@@ -178,6 +211,16 @@ TracksListener *MusicListenersManager::tracksListener() const
     return d->mTracksListener.get();
 }
 
+TrackLongTextProvider *MusicListenersManager::trackLongTextProvider() const
+{
+    return &d->mTrackLongTextProvider;
+}
+
+RadioHistoryRecorder *MusicListenersManager::radioHistoryRecorder() const
+{
+    return &d->mRadioHistoryRecorder;
+}
+
 bool MusicListenersManager::indexerBusy() const
 {
     return d->mIndexerBusy;
@@ -225,8 +268,35 @@ auto MusicListenersManager::initializeRootPath()
     return initialRootPath;
 }
 
+void MusicListenersManager::delayBackgroundTasks()
+{
+    d->mBackgroundTasksAllowed = false;
+}
+
 void MusicListenersManager::databaseReady()
 {
+    StartupTrace::markPhase(QStringLiteral("database"));
+
+    d->mDatabaseIsReady = true;
+
+    startBackgroundTasksWhenReady();
+}
+
+void MusicListenersManager::startBackgroundTasks()
+{
+    d->mBackgroundTasksAllowed = true;
+
+    startBackgroundTasksWhenReady();
+}
+
+void MusicListenersManager::startBackgroundTasksWhenReady()
+{
+    if (!d->mDatabaseIsReady || !d->mBackgroundTasksAllowed || d->mBackgroundTasksStarted) {
+        return;
+    }
+
+    d->mBackgroundTasksStarted = true;
+
     auto initialRootPath = Elisa::ElisaConfiguration::rootPath();
     if (initialRootPath.isEmpty()) {
         initializeRootPath();
@@ -235,10 +305,23 @@ void MusicListenersManager::databaseReady()
     d->mConfigFileWatcher.addPath(Elisa::ElisaConfiguration::self()->config()->name());
 
     configChanged();
+
+    StartupTrace::markPhase(QStringLiteral("indexers"));
+    StartupTrace::finish();
 }
 
 void MusicListenersManager::applicationAboutToQuit()
 {
+    d->mLoudnessAnalyzer.stop();
+
+    // the last titles played by radios are written while the database thread still runs
+    const auto pendingRadiosHistory = d->mRadioHistoryRecorder.takePendingEntries();
+    if (!pendingRadiosHistory.isEmpty()) {
+        QMetaObject::invokeMethod(&d->mDatabaseInterface, [this, pendingRadiosHistory]() {
+            d->mDatabaseInterface.insertRadiosHistory(pendingRadiosHistory);
+        }, Qt::BlockingQueuedConnection);
+    }
+
     d->mDatabaseInterface.applicationAboutToQuit();
 
     Q_EMIT applicationIsTerminating();
@@ -246,6 +329,11 @@ void MusicListenersManager::applicationAboutToQuit()
     d->mDatabaseThread.exit();
     d->mDatabaseThread.wait();
 
+    const auto queryStatisticsFile = Elisa::ElisaConfiguration::queryStatisticsFile();
+    if (!queryStatisticsFile.isEmpty()) {
+        d->mDatabaseInterface.exportStatementsStatistics(queryStatisticsFile);
+    }
+
     d->mListenerThread.exit();
     d->mListenerThread.wait();
 }
@@ -322,6 +410,17 @@ void MusicListenersManager::configChanged()
     currentConfiguration->load();
     currentConfiguration->read();
 
+    QMetaObject::invokeMethod(&d->mDatabaseInterface, "setSlowQueryThreshold", Qt::QueuedConnection,
+                              Q_ARG(int, currentConfiguration->slowQueryThreshold()));
+
+    if (currentConfiguration->analyzeLoudness()) {
+        d->mLoudnessAnalyzer.start();
+    } else {
+        d->mLoudnessAnalyzer.stop();
+    }
+
+    d->mRadioHistoryRecorder.setEnabled(currentConfiguration->recordRadiosHistory());
+
     bool configurationHasChanged = false;
 #if defined KF5Baloo_FOUND && KF5Baloo_FOUND
     if (d->mBalooIndexerAvailable && d->mBalooIndexerActive && d->mBalooListener.canHandleRootPaths() && !currentConfiguration->forceUsageOfFastFileSearch()) {
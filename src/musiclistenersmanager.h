@@ -23,6 +23,8 @@ class MediaPlayList;
 class ElisaApplication;
 class ModelDataLoader;
 class TracksListener;
+class TrackLongTextProvider;
+class RadioHistoryRecorder;
 
 class ELISALIB_EXPORT MusicListenersManager : public QObject
 {
@@ -86,6 +88,10 @@ public:
 
     TracksListener* tracksListener() const;
 
+    TrackLongTextProvider* trackLongTextProvider() const;
+
+    RadioHistoryRecorder* radioHistoryRecorder() const;
+
     bool indexerBusy() const;
 
     bool fileSystemIndexerActive() const;
@@ -98,6 +104,11 @@ public:
 
     bool androidIndexerAvailable() const;
 
+    /**
+     * keep the indexers stopped until startBackgroundTasks() is called, even if the database is ready
+     */
+    void delayBackgroundTasks();
+
 Q_SIGNALS:
 
     void viewDatabaseChanged();
@@ -134,6 +145,8 @@ public Q_SLOTS:
 
     void databaseReady();
 
+    void startBackgroundTasks();
+
     void applicationAboutToQuit();
 
     void showConfiguration();
@@ -166,6 +179,8 @@ private Q_SLOTS:
 
 private:
 
+    void startBackgroundTasksWhenReady();
+
     void testBalooIndexerAvailability();
 
     void startLocalFileSystemIndexing();
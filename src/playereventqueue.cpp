@@ -0,0 +1,103 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "playereventqueue.h"
+
+#include <cstdint>
+
+static_assert((PlayerEventQueue::Capacity & (PlayerEventQueue::Capacity - 1)) == 0, "the capacity must be a power of two");
+
+namespace {
+
+constexpr std::size_t PositionMask = PlayerEventQueue::Capacity - 1;
+
+}
+
+PlayerEventQueue::PlayerEventQueue()
+{
+    for (std::size_t index = 0; index < Capacity; ++index) {
+        mSlots[index].mSequence.store(index, std::memory_order_relaxed);
+    }
+}
+
+bool PlayerEventQueue::push(EventType type, qint64 value)
+{
+    switch (type)
+    {
+    case EventType::Position:
+        storeLatestValue(mLatestPosition, value);
+        return true;
+    case EventType::Volume:
+        storeLatestValue(mLatestVolume, value);
+        return true;
+    case EventType::PlaybackState:
+    case EventType::MediaStatus:
+    case EventType::Error:
+    case EventType::Duration:
+    case EventType::Seekable:
+    case EventType::Muted:
+        break;
+    }
+
+    auto position = mEnqueuePosition.load(std::memory_order_relaxed);
+
+    while (true) {
+        auto &slot = mSlots[position & PositionMask];
+        const auto sequence = slot.mSequence.load(std::memory_order_acquire);
+        const auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+
+        if (difference == 0) {
+            if (mEnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                slot.mEvent = Event{type, value};
+                slot.mSequence.store(position + 1, std::memory_order_release);
+
+                return true;
+            }
+        } else if (difference < 0) {
+            mDroppedEventsCount.fetch_add(1, std::memory_order_relaxed);
+
+            return false;
+        } else {
+            position = mEnqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void PlayerEventQueue::storeLatestValue(LatestValue &latestValue, qint64 value)
+{
+    latestValue.mValue.store(value);
+    latestValue.mSequence.store(mEnqueuePosition.load());
+    latestValue.mPending.store(true);
+}
+
+bool PlayerEventQueue::requestWakeup()
+{
+    return !mWakeupRequested.exchange(true);
+}
+
+quint64 PlayerEventQueue::droppedEventsCount() const
+{
+    return mDroppedEventsCount.load(std::memory_order_relaxed);
+}
+
+bool PlayerEventQueue::pop(Event &event)
+{
+    // only one consumer: the dequeue position is not contended
+    const auto position = mDequeuePosition.load(std::memory_order_relaxed);
+
+    auto &slot = mSlots[position & PositionMask];
+    const auto sequence = slot.mSequence.load(std::memory_order_acquire);
+
+    if (sequence != position + 1) {
+        return false;
+    }
+
+    event = slot.mEvent;
+    slot.mSequence.store(position + Capacity, std::memory_order_release);
+    mDequeuePosition.store(position + 1, std::memory_order_relaxed);
+
+    return true;
+}
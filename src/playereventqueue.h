@@ -0,0 +1,168 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef PLAYEREVENTQUEUE_H
+#define PLAYEREVENTQUEUE_H
+
+#include "elisaLib_export.h"
+
+#include <QtGlobal>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <limits>
+
+/**
+ * Fixed size lock-free queue of compact player events.
+ *
+ * Events are pushed from the threads of the playback engine and drained by a
+ * single consumer, usually the GUI thread. Pushing never allocates nor blocks.
+ * Position and volume events only keep their latest value until the next drain.
+ * That value is delivered before the first other event pushed after it, so a
+ * position never arrives after a later stop or media change. All other events
+ * are delivered in order. They are dropped, and counted, if the
+ * consumer lets the queue fill up.
+ *
+ * The queue is a bounded multi-producer queue with per-slot sequence numbers.
+ * The engine may report events from more than one thread.
+ */
+class ELISALIB_EXPORT PlayerEventQueue
+{
+
+public:
+
+    enum class EventType : quint8 {
+        PlaybackState,
+        MediaStatus,
+        Error,
+        Duration,
+        Seekable,
+        Muted,
+        Position,
+        Volume,
+    };
+
+    struct Event
+    {
+        EventType mType = EventType::PlaybackState;
+
+        qint64 mValue = 0;
+    };
+
+    static constexpr std::size_t Capacity = 256;
+
+    PlayerEventQueue();
+
+    /**
+     * @return false if the event was dropped because the queue is full
+     */
+    bool push(EventType type, qint64 value);
+
+    /**
+     * to be called after push(), only one caller gets true until the next drain()
+     *
+     * @return true if the consumer needs to be woken up
+     */
+    bool requestWakeup();
+
+    /**
+     * pass all pending events to handler, in order
+     *
+     * The latest position and volume are passed before the first event pushed after them.
+     *
+     * @return number of events passed to handler
+     */
+    template <typename Handler>
+    int drain(Handler &&handler)
+    {
+        mWakeupRequested.store(false);
+
+        auto eventsCount = 0;
+        auto oneEvent = Event{};
+
+        for (auto eventIndex = mDequeuePosition.load(std::memory_order_relaxed); pop(oneEvent); ++eventIndex) {
+            eventsCount += flushLatestValue(mLatestPosition, EventType::Position, eventIndex, handler);
+            eventsCount += flushLatestValue(mLatestVolume, EventType::Volume, eventIndex, handler);
+
+            handler(static_cast<const Event&>(oneEvent));
+            ++eventsCount;
+        }
+
+        eventsCount += flushLatestValue(mLatestPosition, EventType::Position, std::numeric_limits<std::size_t>::max(), handler);
+        eventsCount += flushLatestValue(mLatestVolume, EventType::Volume, std::numeric_limits<std::size_t>::max(), handler);
+
+        return eventsCount;
+    }
+
+    quint64 droppedEventsCount() const;
+
+private:
+
+    /**
+     * latest value of a coalesced event
+     */
+    struct LatestValue
+    {
+        std::atomic<qint64> mValue{0};
+
+        /**
+         * index of the next ordered event when the value was pushed
+         */
+        std::atomic<std::size_t> mSequence{0};
+
+        std::atomic<bool> mPending{false};
+    };
+
+    void storeLatestValue(LatestValue &latestValue, qint64 value);
+
+    /**
+     * pass the latest value to handler if it was pushed before the ordered event at eventIndex
+     *
+     * @return number of events passed to handler
+     */
+    template <typename Handler>
+    static int flushLatestValue(LatestValue &latestValue, EventType type, std::size_t eventIndex, Handler &&handler)
+    {
+        if (!latestValue.mPending.load() || latestValue.mSequence.load() > eventIndex) {
+            return 0;
+        }
+
+        if (!latestValue.mPending.exchange(false)) {
+            return 0;
+        }
+
+        handler(Event{type, latestValue.mValue.load()});
+
+        return 1;
+    }
+
+    bool pop(Event &event);
+
+    struct Slot
+    {
+        std::atomic<std::size_t> mSequence{0};
+
+        Event mEvent;
+    };
+
+    std::array<Slot, Capacity> mSlots;
+
+    alignas(64) std::atomic<std::size_t> mEnqueuePosition{0};
+
+    alignas(64) std::atomic<std::size_t> mDequeuePosition{0};
+
+    alignas(64) LatestValue mLatestPosition;
+
+    LatestValue mLatestVolume;
+
+    std::atomic<bool> mWakeupRequested{false};
+
+    std::atomic<quint64> mDroppedEventsCount{0};
+
+};
+
+#endif // PLAYEREVENTQUEUE_H
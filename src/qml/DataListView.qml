@@ -84,6 +84,7 @@ FocusScope {
         listView.contentModel = proxyModel
 
         if (!displaySingleAlbum) {
+            proxyModel.sortRole = sortRole
             proxyModel.sortModel(sortAscending)
         }
 
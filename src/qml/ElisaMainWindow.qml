@@ -121,6 +121,11 @@ ApplicationWindow {
             persistentSettings.height = mainWindow.height;
 
             persistentSettings.playListState = ElisaApplication.mediaPlayListProxyModel.persistentState;
+
+            // the published position is stale while the window is hidden
+            if (ElisaApplication.audioPlayer) {
+                ElisaApplication.audioControl.playerPosition = ElisaApplication.audioPlayer.estimatedPosition()
+            }
             persistentSettings.audioPlayerState = ElisaApplication.audioControl.persistentState
 
             persistentSettings.playControlItemVolume = headerBar.playerControl.volume
@@ -157,6 +162,14 @@ ApplicationWindow {
         }
     }
 
+    Binding {
+        target: ElisaApplication.audioPlayer
+        property: "positionUpdateRate"
+        // nothing shows the playback progress while the window is hidden
+        value: mainWindow.visible ? ElisaApplication.positionUpdateRate : 0
+        when: ElisaApplication.audioPlayer
+    }
+
     Connections {
         target: ElisaApplication.audioPlayer
         function onVolumeChanged() {
@@ -196,6 +209,7 @@ ApplicationWindow {
 
                 playerControl.duration: ElisaApplication.audioControl.audioDuration
                 playerControl.seekable: ElisaApplication.audioPlayer.seekable
+                playerControl.waveform: ElisaApplication.manageHeaderBar.waveform
 
                 playerControl.volume: persistentSettings.playControlItemVolume
                 playerControl.muted: persistentSettings.playControlItemMuted
@@ -328,5 +342,7 @@ ApplicationWindow {
         mprisloader.active = true
 
         ElisaApplication.arguments = ElisaArguments.arguments
+
+        ElisaApplication.startBackgroundTasksAfterFirstFrame(mainWindow)
     }
 }
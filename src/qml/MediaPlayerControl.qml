@@ -22,6 +22,7 @@ FocusScope {
     property bool skipForwardEnabled
     property bool skipBackwardEnabled
     property bool isMaximized
+    property string waveform
 
     property bool shuffle
     property bool repeat
@@ -135,6 +136,24 @@ FocusScope {
                 }
             }
 
+            // waveform of the current track, computed once and then cached
+            Image {
+                anchors.left: musicProgress.left
+                anchors.right: musicProgress.right
+                anchors.verticalCenter: musicProgress.verticalCenter
+                height: Math.round(seekWheelHandler.height * 0.6)
+
+                source: (musicWidget.waveform !== '' ?
+                             musicWidget.waveform + '?color=' + encodeURIComponent(myPalette.mid) : '')
+                sourceSize.width: Math.round(width)
+                sourceSize.height: Math.round(height)
+
+                asynchronous: true
+                cache: false
+                opacity: 0.6
+                visible: status === Image.Ready
+            }
+
             // Synthesized slider background that's not actually a part of the
             // slider. This is done so the slider's own background can be full
             // height yet transparent, for easier clicking
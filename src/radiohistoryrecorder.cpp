@@ -0,0 +1,92 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "radiohistoryrecorder.h"
+
+#include <QTimer>
+
+#include <utility>
+
+class RadioHistoryRecorderPrivate
+{
+
+public:
+
+    DataTypes::ListTrackDataType mPendingEntries;
+
+    QTimer mFlushTimer;
+
+    bool mIsEnabled = false;
+
+};
+
+RadioHistoryRecorder::RadioHistoryRecorder(QObject *parent)
+    : QObject(parent), d(std::make_unique<RadioHistoryRecorderPrivate>())
+{
+    d->mFlushTimer.setSingleShot(true);
+    d->mFlushTimer.setInterval(FlushDelay);
+
+    connect(&d->mFlushTimer, &QTimer::timeout,
+            this, &RadioHistoryRecorder::flush);
+}
+
+RadioHistoryRecorder::~RadioHistoryRecorder() = default;
+
+bool RadioHistoryRecorder::isEnabled() const
+{
+    return d->mIsEnabled;
+}
+
+DataTypes::ListTrackDataType RadioHistoryRecorder::takePendingEntries()
+{
+    d->mFlushTimer.stop();
+
+    return std::exchange(d->mPendingEntries, {});
+}
+
+void RadioHistoryRecorder::setEnabled(bool enabled)
+{
+    if (d->mIsEnabled == enabled) {
+        return;
+    }
+
+    d->mIsEnabled = enabled;
+
+    if (!d->mIsEnabled) {
+        d->mFlushTimer.stop();
+        d->mPendingEntries.clear();
+    }
+}
+
+void RadioHistoryRecorder::recordNowPlaying(const QUrl &radioUrl, const QString &title, const QString &nowPlaying, const QDateTime &time)
+{
+    if (!d->mIsEnabled || radioUrl.isEmpty()) {
+        return;
+    }
+
+    d->mPendingEntries.push_back({{DataTypes::ResourceRole, radioUrl},
+                                  {DataTypes::TitleRole, title},
+                                  {DataTypes::ArtistRole, nowPlaying},
+                                  {DataTypes::LastPlayDate, time}});
+
+    if (d->mPendingEntries.size() >= MaximumPendingEntries) {
+        flush();
+    } else if (!d->mFlushTimer.isActive()) {
+        d->mFlushTimer.start();
+    }
+}
+
+void RadioHistoryRecorder::flush()
+{
+    if (d->mPendingEntries.isEmpty()) {
+        return;
+    }
+
+    Q_EMIT radiosHistoryReady(takePendingEntries());
+}
+
+
+#include "moc_radiohistoryrecorder.cpp"
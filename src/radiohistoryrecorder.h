@@ -0,0 +1,75 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef RADIOHISTORYRECORDER_H
+#define RADIOHISTORYRECORDER_H
+
+#include "elisaLib_export.h"
+
+#include "datatypes.h"
+
+#include <QObject>
+#include <QUrl>
+#include <QDateTime>
+
+#include <memory>
+
+class RadioHistoryRecorderPrivate;
+
+/**
+ * Buffer of the titles played by radios.
+ *
+ * Stations send new stream meta data for each title, the entries are kept in
+ * memory and written to the database in batches, when enough of them are
+ * pending, after a delay or when flush() is called.
+ */
+class ELISALIB_EXPORT RadioHistoryRecorder : public QObject
+{
+
+    Q_OBJECT
+
+public:
+
+    /**
+     * number of pending entries triggering a write to the database
+     */
+    static constexpr int MaximumPendingEntries = 20;
+
+    /**
+     * maximum delay in milliseconds before pending entries are written
+     */
+    static constexpr int FlushDelay = 60000;
+
+    explicit RadioHistoryRecorder(QObject *parent = nullptr);
+
+    ~RadioHistoryRecorder() override;
+
+    bool isEnabled() const;
+
+    /**
+     * remove the pending entries without sending them
+     */
+    DataTypes::ListTrackDataType takePendingEntries();
+
+Q_SIGNALS:
+
+    void radiosHistoryReady(const DataTypes::ListTrackDataType &entries);
+
+public Q_SLOTS:
+
+    void setEnabled(bool enabled);
+
+    void recordNowPlaying(const QUrl &radioUrl, const QString &title, const QString &nowPlaying, const QDateTime &time);
+
+    void flush();
+
+private:
+
+    std::unique_ptr<RadioHistoryRecorderPrivate> d;
+
+};
+
+#endif // RADIOHISTORYRECORDER_H
@@ -0,0 +1,289 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "readaheadstream.h"
+
+#include <QElapsedTimer>
+#include <QFile>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ReadAheadStreamPrivate
+{
+
+public:
+
+    enum class OpenState {
+        Pending,
+        Opened,
+        Failed,
+    };
+
+    void ioLoop();
+
+    void copyToRing(qint64 offset, const char *data, qint64 length);
+
+    void copyFromRing(qint64 offset, char *data, qint64 length) const;
+
+    QString mFileName;
+
+    std::vector<char> mRing;
+
+    qint64 mCapacity = 0;
+
+    qint64 mChunkSize = 0;
+
+    mutable std::mutex mMutex;
+
+    std::condition_variable mIoCondition;
+
+    std::condition_variable mReaderCondition;
+
+    OpenState mOpenState = OpenState::Pending;
+
+    qint64 mFileSize = 0;
+
+    /**
+     * file offsets: mBufferStart <= mReadOffset <= mFilledEnd <= mBufferStart + mCapacity
+     */
+    qint64 mBufferStart = 0;
+
+    qint64 mReadOffset = 0;
+
+    qint64 mFilledEnd = 0;
+
+    /**
+     * incremented each time the buffered data are dropped, lets the I/O thread discard a read in flight
+     */
+    quint64 mGeneration = 0;
+
+    bool mHasError = false;
+
+    bool mIsStreaming = false;
+
+    bool mStopRequested = false;
+
+    ReadAheadStream::Statistics mStatistics;
+
+};
+
+ReadAheadStream::ReadAheadStream(const QString &fileName, qint64 bufferSize)
+    : d(std::make_shared<ReadAheadStreamPrivate>())
+{
+    d->mFileName = fileName;
+    d->mCapacity = std::max(bufferSize, ReadChunkSize);
+    // the I/O thread never fills more than three quarters of the ring, the rest keeps already read data
+    d->mChunkSize = std::min(ReadChunkSize, d->mCapacity / 4);
+    d->mRing.resize(static_cast<std::size_t>(d->mCapacity));
+
+    // the thread keeps its own reference to the shared data to be detached on destruction
+    std::thread([sharedData = d]() {sharedData->ioLoop();}).detach();
+}
+
+ReadAheadStream::~ReadAheadStream()
+{
+    {
+        std::lock_guard<std::mutex> lock(d->mMutex);
+        d->mStopRequested = true;
+    }
+
+    d->mIoCondition.notify_all();
+    d->mReaderCondition.notify_all();
+}
+
+bool ReadAheadStream::open()
+{
+    std::unique_lock<std::mutex> lock(d->mMutex);
+
+    d->mReaderCondition.wait(lock, [this]() {return d->mOpenState != ReadAheadStreamPrivate::OpenState::Pending;});
+
+    if (d->mOpenState == ReadAheadStreamPrivate::OpenState::Failed) {
+        return false;
+    }
+
+    lock.unlock();
+
+    return seek(0);
+}
+
+qint64 ReadAheadStream::size() const
+{
+    std::lock_guard<std::mutex> lock(d->mMutex);
+
+    return d->mFileSize;
+}
+
+qint64 ReadAheadStream::read(char *data, qint64 maximumSize)
+{
+    std::unique_lock<std::mutex> lock(d->mMutex);
+
+    if (d->mReadOffset >= d->mFileSize || maximumSize <= 0) {
+        return 0;
+    }
+
+    if (d->mReadOffset == d->mFilledEnd && !d->mHasError) {
+        QElapsedTimer waitTimer;
+        waitTimer.start();
+
+        d->mReaderCondition.wait(lock, [this]() {
+            return d->mStopRequested || d->mHasError || d->mFilledEnd > d->mReadOffset || d->mReadOffset >= d->mFileSize;
+        });
+
+        // waiting for the first bytes after opening or seeking is expected
+        if (d->mIsStreaming) {
+            ++d->mStatistics.mUnderruns;
+            d->mStatistics.mUnderrunsDuration += waitTimer.elapsed();
+        }
+    }
+
+    if (d->mFilledEnd <= d->mReadOffset) {
+        return (d->mHasError || d->mStopRequested) ? -1 : 0;
+    }
+
+    const auto length = std::min(maximumSize, d->mFilledEnd - d->mReadOffset);
+
+    d->copyFromRing(d->mReadOffset, data, length);
+    d->mReadOffset += length;
+    d->mStatistics.mBytesRead += length;
+    d->mIsStreaming = true;
+
+    lock.unlock();
+    d->mIoCondition.notify_one();
+
+    return length;
+}
+
+bool ReadAheadStream::seek(qint64 offset)
+{
+    {
+        std::lock_guard<std::mutex> lock(d->mMutex);
+
+        if (offset < 0 || offset > d->mFileSize) {
+            return false;
+        }
+
+        if (offset >= d->mBufferStart && offset <= d->mFilledEnd) {
+            d->mReadOffset = offset;
+        } else {
+            d->mBufferStart = offset;
+            d->mReadOffset = offset;
+            d->mFilledEnd = offset;
+            d->mHasError = false;
+            d->mIsStreaming = false;
+            ++d->mGeneration;
+            ++d->mStatistics.mRefills;
+        }
+    }
+
+    d->mIoCondition.notify_one();
+
+    return true;
+}
+
+void ReadAheadStream::close()
+{
+    std::lock_guard<std::mutex> lock(d->mMutex);
+
+    d->mIsStreaming = false;
+}
+
+ReadAheadStream::Statistics ReadAheadStream::statistics() const
+{
+    std::lock_guard<std::mutex> lock(d->mMutex);
+
+    return d->mStatistics;
+}
+
+QString ReadAheadStream::fileName() const
+{
+    return d->mFileName;
+}
+
+void ReadAheadStreamPrivate::ioLoop()
+{
+    QFile file(mFileName);
+
+    const auto isOpened = file.open(QIODevice::ReadOnly);
+
+    std::unique_lock<std::mutex> lock(mMutex);
+
+    mOpenState = isOpened ? OpenState::Opened : OpenState::Failed;
+    mFileSize = isOpened ? file.size() : 0;
+    mReaderCondition.notify_all();
+
+    if (!isOpened) {
+        return;
+    }
+
+    auto chunk = std::vector<char>(static_cast<std::size_t>(mChunkSize));
+    const auto highWaterMark = mCapacity - mChunkSize;
+
+    while (!mStopRequested) {
+        if (mHasError || mFilledEnd >= mFileSize || mFilledEnd - mReadOffset >= highWaterMark) {
+            mIoCondition.wait(lock);
+            continue;
+        }
+
+        const auto generation = mGeneration;
+        const auto offset = mFilledEnd;
+        const auto length = std::min(mChunkSize, mFileSize - offset);
+
+        // the lock is not held during the actual I/O, a stalled mount only blocks this thread
+        lock.unlock();
+
+        auto readLength = qint64{-1};
+        if (file.pos() == offset || file.seek(offset)) {
+            readLength = file.read(chunk.data(), length);
+        }
+
+        lock.lock();
+
+        if (generation != mGeneration) {
+            continue;
+        }
+
+        if (readLength <= 0) {
+            if (readLength == 0) {
+                // the file was truncated since it was opened
+                mFileSize = offset;
+            } else {
+                mHasError = true;
+            }
+
+            mReaderCondition.notify_all();
+            continue;
+        }
+
+        copyToRing(offset, chunk.data(), readLength);
+        mFilledEnd += readLength;
+        mBufferStart = std::max(mBufferStart, mFilledEnd - mCapacity);
+
+        mReaderCondition.notify_all();
+    }
+}
+
+void ReadAheadStreamPrivate::copyToRing(qint64 offset, const char *data, qint64 length)
+{
+    const auto ringOffset = offset % mCapacity;
+    const auto firstPart = std::min(length, mCapacity - ringOffset);
+
+    std::memcpy(mRing.data() + ringOffset, data, static_cast<std::size_t>(firstPart));
+    std::memcpy(mRing.data(), data + firstPart, static_cast<std::size_t>(length - firstPart));
+}
+
+void ReadAheadStreamPrivate::copyFromRing(qint64 offset, char *data, qint64 length) const
+{
+    const auto ringOffset = offset % mCapacity;
+    const auto firstPart = std::min(length, mCapacity - ringOffset);
+
+    std::memcpy(data, mRing.data() + ringOffset, static_cast<std::size_t>(firstPart));
+    std::memcpy(data + firstPart, mRing.data(), static_cast<std::size_t>(length - firstPart));
+}
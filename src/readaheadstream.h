@@ -0,0 +1,98 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef READAHEADSTREAM_H
+#define READAHEADSTREAM_H
+
+#include "elisaLib_export.h"
+
+#include <QString>
+#include <QtGlobal>
+
+#include <memory>
+
+class ReadAheadStreamPrivate;
+
+/**
+ * Sequential reader of a local file backed by a dedicated I/O thread.
+ *
+ * The I/O thread starts reading from the beginning of the file as soon as the
+ * object is created and keeps a large ring buffer filled ahead of the reader.
+ * A slow or stalled file system then only delays the I/O thread instead of the
+ * decoder. Already read data is partially kept so that short backward seeks,
+ * as done by demuxers probing a file, are served from memory.
+ *
+ * read(), seek() and open() may block and must not be called from the GUI thread.
+ * The destructor only asks the I/O thread to stop and never waits for it: a
+ * read stalled on an unresponsive mount finishes in the background.
+ */
+class ELISALIB_EXPORT ReadAheadStream
+{
+
+public:
+
+    struct Statistics
+    {
+        qint64 mBytesRead = 0;
+
+        /**
+         * number of reads that found the buffer empty after playback started
+         */
+        int mUnderruns = 0;
+
+        /**
+         * total time spent waiting for the I/O thread in milliseconds
+         */
+        qint64 mUnderrunsDuration = 0;
+
+        /**
+         * number of seeks outside of the buffered data
+         */
+        int mRefills = 0;
+    };
+
+    static constexpr qint64 DefaultBufferSize = 8 * 1024 * 1024;
+
+    static constexpr qint64 ReadChunkSize = 256 * 1024;
+
+    explicit ReadAheadStream(const QString &fileName, qint64 bufferSize = DefaultBufferSize);
+
+    ~ReadAheadStream();
+
+    /**
+     * wait for the file to be opened and rewind to its start
+     *
+     * @return false if the file cannot be read
+     */
+    bool open();
+
+    qint64 size() const;
+
+    /**
+     * copy up to maximumSize bytes, waiting for the I/O thread if the buffer is empty
+     *
+     * @return number of bytes copied, 0 at the end of the file and -1 on error
+     */
+    qint64 read(char *data, qint64 maximumSize);
+
+    bool seek(qint64 offset);
+
+    void close();
+
+    Statistics statistics() const;
+
+    QString fileName() const;
+
+private:
+
+    /**
+     * shared with the I/O thread that may outlive this object
+     */
+    std::shared_ptr<ReadAheadStreamPrivate> d;
+
+};
+
+#endif // READAHEADSTREAM_H
@@ -0,0 +1,124 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "rootpathsfilter.h"
+
+#include <QStringView>
+
+#include <algorithm>
+
+namespace {
+
+/**
+ * call function for each non empty component of path until it returns false
+ */
+template <typename Function>
+void forEachComponent(const QString &path, Function &&function)
+{
+    auto componentStart = 0;
+
+    while (componentStart <= path.size()) {
+        auto componentEnd = path.indexOf(QLatin1Char('/'), componentStart);
+        if (componentEnd == -1) {
+            componentEnd = path.size();
+        }
+
+        if (componentEnd > componentStart) {
+            if (!function(QStringView(path).mid(componentStart, componentEnd - componentStart))) {
+                return;
+            }
+        }
+
+        componentStart = componentEnd + 1;
+    }
+}
+
+}
+
+RootPathsFilter::RootPathsFilter() = default;
+
+RootPathsFilter::RootPathsFilter(const QStringList &rootPaths)
+{
+    mNodes.emplace_back();
+
+    for (const auto &oneRootPath : rootPaths) {
+        if (oneRootPath.isEmpty()) {
+            continue;
+        }
+
+        auto currentNode = 0;
+
+        forEachComponent(oneRootPath, [this, &currentNode](QStringView component) {
+            auto &children = mNodes[currentNode].mChildren;
+
+            auto itChild = std::lower_bound(children.begin(), children.end(), component,
+                                            [](const std::pair<QString, int> &child, QStringView name) {
+                                                return QStringView(child.first).compare(name) < 0;
+                                            });
+
+            if (itChild != children.end() && QStringView(itChild->first).compare(component) == 0) {
+                currentNode = itChild->second;
+            } else {
+                const auto newNode = static_cast<int>(mNodes.size());
+                children.insert(itChild, {component.toString(), newNode});
+                mNodes.emplace_back();
+                currentNode = newNode;
+            }
+
+            return true;
+        });
+
+        mNodes[currentNode].mIsRootPath = true;
+    }
+}
+
+bool RootPathsFilter::isEmpty() const
+{
+    return mNodes.empty() || (mNodes.front().mChildren.empty() && !mNodes.front().mIsRootPath);
+}
+
+bool RootPathsFilter::contains(const QString &filePath) const
+{
+    if (isEmpty()) {
+        return false;
+    }
+
+    auto currentNode = 0;
+    auto isContained = mNodes[currentNode].mIsRootPath;
+
+    forEachComponent(filePath, [this, &currentNode, &isContained](QStringView component) {
+        if (isContained) {
+            return false;
+        }
+
+        currentNode = findChild(currentNode, component);
+        if (currentNode == -1) {
+            return false;
+        }
+
+        isContained = mNodes[currentNode].mIsRootPath;
+
+        return true;
+    });
+
+    return isContained;
+}
+
+int RootPathsFilter::findChild(int node, QStringView component) const
+{
+    const auto &children = mNodes[node].mChildren;
+
+    auto itChild = std::lower_bound(children.cbegin(), children.cend(), component,
+                                    [](const std::pair<QString, int> &child, QStringView name) {
+                                        return QStringView(child.first).compare(name) < 0;
+                                    });
+
+    if (itChild == children.cend() || QStringView(itChild->first).compare(component) != 0) {
+        return -1;
+    }
+
+    return itChild->second;
+}
@@ -0,0 +1,57 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef ROOTPATHSFILTER_H
+#define ROOTPATHSFILTER_H
+
+#include "elisaLib_export.h"
+
+#include <QString>
+#include <QStringList>
+
+#include <utility>
+#include <vector>
+
+/**
+ * Tell if a local file is inside one of the music folders.
+ *
+ * The folders are stored as a tree of path components, so checking a file
+ * only costs one lookup per component of its path whatever the number of
+ * folders. A folder only matches whole components: /music does not contain
+ * /music2/track.ogg.
+ */
+class ELISALIB_EXPORT RootPathsFilter
+{
+
+public:
+
+    RootPathsFilter();
+
+    explicit RootPathsFilter(const QStringList &rootPaths);
+
+    bool isEmpty() const;
+
+    bool contains(const QString &filePath) const;
+
+private:
+
+    struct Node
+    {
+        /**
+         * sorted by component name
+         */
+        std::vector<std::pair<QString, int>> mChildren;
+
+        bool mIsRootPath = false;
+    };
+
+    int findChild(int node, QStringView component) const;
+
+    std::vector<Node> mNodes;
+
+};
+
+#endif // ROOTPATHSFILTER_H
@@ -0,0 +1,108 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "startuptrace.h"
+
+#include "startupLogging.h"
+
+#include "elisatrace.h"
+
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QStringList>
+
+namespace {
+
+struct StartupTraceData
+{
+    QMutex mMutex;
+
+    QElapsedTimer mTimer;
+
+    StartupTrace::PhasesList mPhases;
+
+    bool mIsFinished = false;
+};
+
+StartupTraceData &traceData()
+{
+    static StartupTraceData data;
+
+    return data;
+}
+
+}
+
+void StartupTrace::start()
+{
+    auto &data = traceData();
+    QMutexLocker locker(&data.mMutex);
+
+    data.mTimer.start();
+    data.mPhases.clear();
+    data.mIsFinished = false;
+}
+
+void StartupTrace::markPhase(const QString &phaseName)
+{
+    auto &data = traceData();
+    QMutexLocker locker(&data.mMutex);
+
+    if (data.mIsFinished) {
+        return;
+    }
+
+    if (!data.mTimer.isValid()) {
+        data.mTimer.start();
+    }
+
+    const auto previousEnd = data.mPhases.isEmpty() ? qint64{0} : data.mPhases.last().second;
+    const auto phaseEnd = data.mTimer.elapsed();
+
+    data.mPhases.push_back({phaseName, phaseEnd});
+
+    ELISA_TRACE_INSTANT("startup", "phase", phaseName);
+
+    qCDebug(orgKdeElisaStartup()) << "StartupTrace::markPhase" << phaseName << (phaseEnd - previousEnd) << "ms" << "total" << phaseEnd << "ms";
+}
+
+void StartupTrace::finish()
+{
+    auto &data = traceData();
+    QMutexLocker locker(&data.mMutex);
+
+    if (data.mIsFinished) {
+        return;
+    }
+
+    data.mIsFinished = true;
+
+    auto phasesDescription = QStringList{};
+    auto previousEnd = qint64{0};
+    for (const auto &onePhase : qAsConst(data.mPhases)) {
+        phasesDescription.push_back(QStringLiteral("%1: %2 ms").arg(onePhase.first).arg(onePhase.second - previousEnd));
+        previousEnd = onePhase.second;
+    }
+
+    qCInfo(orgKdeElisaStartup()) << "startup done in" << data.mTimer.elapsed() << "ms" << qPrintable(phasesDescription.join(QStringLiteral(", ")));
+}
+
+bool StartupTrace::isFinished()
+{
+    auto &data = traceData();
+    QMutexLocker locker(&data.mMutex);
+
+    return data.mIsFinished;
+}
+
+StartupTrace::PhasesList StartupTrace::phases()
+{
+    auto &data = traceData();
+    QMutexLocker locker(&data.mMutex);
+
+    return data.mPhases;
+}
@@ -0,0 +1,46 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef STARTUPTRACE_H
+#define STARTUPTRACE_H
+
+#include "elisaLib_export.h"
+
+#include <QString>
+#include <QVector>
+
+#include <utility>
+
+/**
+ * Timings of the startup phases of Elisa.
+ *
+ * Each phase is recorded with the time elapsed since start(). Phases can be
+ * recorded from any thread. finish() logs all of them in one line of the
+ * org.kde.elisa.startup category.
+ */
+class ELISALIB_EXPORT StartupTrace
+{
+
+public:
+
+    using PhasesList = QVector<std::pair<QString, qint64>>;
+
+    static void start();
+
+    static void markPhase(const QString &phaseName);
+
+    static void finish();
+
+    static bool isFinished();
+
+    /**
+     * recorded phases with their end time in milliseconds since start()
+     */
+    static PhasesList phases();
+
+};
+
+#endif // STARTUPTRACE_H
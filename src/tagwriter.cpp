@@ -0,0 +1,203 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "tagwriter.h"
+
+#include "filescanner.h"
+#include "filewriter.h"
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSet>
+#include <QThreadPool>
+
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <optional>
+#include <utility>
+
+class TagWriterPrivate
+{
+
+public:
+
+    std::optional<std::pair<QUrl, DataTypes::TrackDataType>> takeNextEdit();
+
+    QThreadPool mWorkers;
+
+    mutable QMutex mMutex;
+
+    /**
+     * values still to be written by file, edits of the same file are merged here
+     */
+    QHash<QUrl, DataTypes::TrackDataType> mPendingEdits;
+
+    QList<QUrl> mPendingFiles;
+
+    /**
+     * a file being written is not given to another worker, a new edit of it waits for the current write
+     */
+    QSet<QUrl> mFilesInProgress;
+
+    DataTypes::ListTrackDataType mWrittenTracks;
+
+    QHash<QString, QUrl> mCovers;
+
+    QList<QUrl> mFailedFiles;
+
+    int mRunningWorkersCount = 0;
+
+};
+
+std::optional<std::pair<QUrl, DataTypes::TrackDataType>> TagWriterPrivate::takeNextEdit()
+{
+    for (auto itFile = mPendingFiles.begin(); itFile != mPendingFiles.end(); ++itFile) {
+        if (mFilesInProgress.contains(*itFile)) {
+            continue;
+        }
+
+        auto oneFile = *itFile;
+        mPendingFiles.erase(itFile);
+        mFilesInProgress.insert(oneFile);
+
+        return std::make_pair(oneFile, mPendingEdits.take(oneFile));
+    }
+
+    return {};
+}
+
+TagWriter::TagWriter(QObject *parent)
+    : QObject(parent), d(std::make_unique<TagWriterPrivate>())
+{
+    // writes are disk bound, more workers would only compete for the same disk
+    d->mWorkers.setMaxThreadCount(DefaultWorkersCount);
+}
+
+TagWriter::~TagWriter()
+{
+    d->mWorkers.waitForDone();
+}
+
+int TagWriter::pendingFilesCount() const
+{
+    QMutexLocker locker(&d->mMutex);
+
+    return d->mPendingFiles.size() + d->mFilesInProgress.size();
+}
+
+void TagWriter::writeTrackMetaData(const QUrl &url, const DataTypes::TrackDataType &data)
+{
+    enqueueEdits({url}, data);
+}
+
+void TagWriter::writeSingleMetaData(const QUrl &url, DataTypes::ColumnsRoles role, const QVariant &data)
+{
+    enqueueEdits({url}, {{role, data}});
+}
+
+void TagWriter::writeMetaDataToFiles(const QList<QUrl> &urls, DataTypes::ColumnsRoles role, const QVariant &data)
+{
+    enqueueEdits(urls, {{role, data}});
+}
+
+void TagWriter::enqueueEdits(const QList<QUrl> &urls, const DataTypes::TrackDataType &data)
+{
+    QMutexLocker locker(&d->mMutex);
+
+    for (const auto &oneUrl : urls) {
+        auto itEdit = d->mPendingEdits.find(oneUrl);
+
+        if (itEdit == d->mPendingEdits.end()) {
+            d->mPendingEdits.insert(oneUrl, data);
+            d->mPendingFiles.push_back(oneUrl);
+            continue;
+        }
+
+        for (auto itValue = data.constKeyValueBegin(); itValue != data.constKeyValueEnd(); ++itValue) {
+            itEdit->insert((*itValue).first, (*itValue).second);
+        }
+    }
+
+    const auto workersCount = std::min(d->mWorkers.maxThreadCount(), static_cast<int>(d->mPendingFiles.size()));
+
+    while (d->mRunningWorkersCount < workersCount) {
+        ++d->mRunningWorkersCount;
+
+        QtConcurrent::run(&d->mWorkers, [this]() {writeFiles();});
+    }
+}
+
+void TagWriter::writeFiles()
+{
+    // metadata writers and extractors are loaded once for all the files written by this worker
+    FileWriter fileWriter;
+    FileScanner fileScanner;
+
+    QMutexLocker locker(&d->mMutex);
+
+    for (auto nextEdit = d->takeNextEdit(); nextEdit; nextEdit = d->takeNextEdit()) {
+        const auto &[fileUrl, fileEdit] = *nextEdit;
+
+        locker.unlock();
+
+        const auto isWritten = fileWriter.writeMetaDataToFile(fileUrl, fileEdit);
+
+        auto modifiedTrack = DataTypes::TrackDataType{};
+        auto coverUrl = QUrl{};
+        if (isWritten) {
+            modifiedTrack = fileScanner.scanOneFile(fileUrl);
+            coverUrl = fileScanner.searchForCoverFile(fileUrl.toLocalFile());
+        }
+
+        locker.relock();
+
+        d->mFilesInProgress.remove(fileUrl);
+
+        if (!modifiedTrack.isValid()) {
+            d->mFailedFiles.push_back(fileUrl);
+            continue;
+        }
+
+        if (!coverUrl.isEmpty()) {
+            d->mCovers[modifiedTrack.resourceURI().toString()] = coverUrl;
+        }
+        d->mWrittenTracks.push_back(modifiedTrack);
+    }
+
+    --d->mRunningWorkersCount;
+
+    if (d->mRunningWorkersCount == 0) {
+        QMetaObject::invokeMethod(this, &TagWriter::allFilesWritten, Qt::QueuedConnection);
+    }
+}
+
+void TagWriter::allFilesWritten()
+{
+    QMutexLocker locker(&d->mMutex);
+
+    // new edits may have started other workers in the meantime, they will send everything
+    if (d->mRunningWorkersCount > 0) {
+        return;
+    }
+
+    auto writtenTracks = std::exchange(d->mWrittenTracks, {});
+    auto covers = std::exchange(d->mCovers, {});
+    auto failedFiles = std::exchange(d->mFailedFiles, {});
+
+    locker.unlock();
+
+    if (!writtenTracks.isEmpty()) {
+        Q_EMIT tracksMetaDataWritten(writtenTracks, covers);
+    }
+
+    if (!failedFiles.isEmpty()) {
+        Q_EMIT filesNotWritten(failedFiles);
+    }
+}
+
+
+#include "moc_tagwriter.cpp"
@@ -0,0 +1,78 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef TAGWRITER_H
+#define TAGWRITER_H
+
+#include "elisaLib_export.h"
+
+#include "datatypes.h"
+
+#include <QObject>
+#include <QHash>
+#include <QList>
+#include <QUrl>
+
+#include <memory>
+
+class TagWriterPrivate;
+
+/**
+ * Asynchronous writing of metadata to music files.
+ *
+ * Edits are queued and written by a small pool of workers so that rewriting a
+ * file never blocks the thread asking for it. Edits of a file not yet written
+ * are merged and the file is only rewritten once. When the queue is empty, all
+ * written files are scanned again and reported at once with
+ * tracksMetaDataWritten(), ready for DatabaseInterface::insertTracksList().
+ *
+ * The write methods can be called from any thread. Nothing in Elisa edits the
+ * tags of music files yet, the track metadata editor only saves radios.
+ */
+class ELISALIB_EXPORT TagWriter : public QObject
+{
+
+    Q_OBJECT
+
+public:
+
+    static constexpr int DefaultWorkersCount = 2;
+
+    explicit TagWriter(QObject *parent = nullptr);
+
+    ~TagWriter() override;
+
+    int pendingFilesCount() const;
+
+Q_SIGNALS:
+
+    void tracksMetaDataWritten(const DataTypes::ListTrackDataType &tracks, const QHash<QString, QUrl> &covers);
+
+    void filesNotWritten(const QList<QUrl> &files);
+
+public Q_SLOTS:
+
+    void writeTrackMetaData(const QUrl &url, const DataTypes::TrackDataType &data);
+
+    void writeSingleMetaData(const QUrl &url, DataTypes::ColumnsRoles role, const QVariant &data);
+
+    void writeMetaDataToFiles(const QList<QUrl> &urls, DataTypes::ColumnsRoles role, const QVariant &data);
+
+private Q_SLOTS:
+
+    void allFilesWritten();
+
+private:
+
+    void enqueueEdits(const QList<QUrl> &urls, const DataTypes::TrackDataType &data);
+
+    void writeFiles();
+
+    std::unique_ptr<TagWriterPrivate> d;
+
+};
+
+#endif // TAGWRITER_H
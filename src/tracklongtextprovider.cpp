@@ -0,0 +1,168 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "tracklongtextprovider.h"
+
+#include "filescanner.h"
+#include "databaseinterface.h"
+
+#include <QCache>
+#include <QDateTime>
+#include <QFileInfo>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSet>
+#include <QThreadPool>
+
+#include <QtConcurrent>
+
+#include <algorithm>
+
+class TrackLongTextProviderPrivate
+{
+
+public:
+
+    struct LongText
+    {
+        QString mLyrics;
+
+        QString mComment;
+
+        QDateTime mFileModificationTime;
+    };
+
+    QThreadPool mWorker;
+
+    /**
+     * only used by the worker, there is never more than one of them
+     */
+    FileScanner mFileScanner;
+
+    QMutex mMutex;
+
+    QCache<QUrl, LongText> mCache;
+
+    QSet<QUrl> mPendingUrls;
+
+    DatabaseInterface *mDatabase = nullptr;
+
+};
+
+TrackLongTextProvider::TrackLongTextProvider(QObject *parent)
+    : QObject(parent), d(std::make_unique<TrackLongTextProviderPrivate>())
+{
+    d->mWorker.setMaxThreadCount(1);
+    d->mCache.setMaxCost(CacheMaximumCost);
+}
+
+TrackLongTextProvider::~TrackLongTextProvider()
+{
+    d->mWorker.clear();
+    d->mWorker.waitForDone();
+}
+
+void TrackLongTextProvider::setDatabase(DatabaseInterface *database)
+{
+    d->mDatabase = database;
+}
+
+void TrackLongTextProvider::requestLongText(const QUrl &url)
+{
+    if (!url.isLocalFile()) {
+        readLongTextFromDatabase(url);
+        return;
+    }
+
+    {
+        QMutexLocker locker(&d->mMutex);
+
+        if (d->mPendingUrls.contains(url)) {
+            return;
+        }
+
+        d->mPendingUrls.insert(url);
+    }
+
+    QtConcurrent::run(&d->mWorker, [this, url]() {
+        readLongText(url);
+    });
+}
+
+void TrackLongTextProvider::readLongText(const QUrl &url)
+{
+    const auto fileInfo = QFileInfo(url.toLocalFile());
+
+    if (!fileInfo.isReadable()) {
+        {
+            QMutexLocker locker(&d->mMutex);
+
+            d->mPendingUrls.remove(url);
+        }
+
+        readLongTextFromDatabase(url);
+        return;
+    }
+
+    const auto fileModificationTime = fileInfo.lastModified();
+
+    auto longText = TrackLongTextProviderPrivate::LongText{};
+    auto isCached = false;
+
+    {
+        QMutexLocker locker(&d->mMutex);
+
+        const auto *cachedText = d->mCache.object(url);
+        if (cachedText && cachedText->mFileModificationTime == fileModificationTime) {
+            longText = *cachedText;
+            isCached = true;
+        }
+    }
+
+    if (!isCached) {
+        const auto &longTextData = d->mFileScanner.scanLongTextProperties(url);
+
+        longText.mLyrics = longTextData.lyrics();
+        longText.mComment = longTextData.comment();
+        longText.mFileModificationTime = fileModificationTime;
+    }
+
+    {
+        QMutexLocker locker(&d->mMutex);
+
+        if (!isCached) {
+            d->mCache.insert(url, new TrackLongTextProviderPrivate::LongText(longText),
+                             std::max(1, longText.mLyrics.size() + longText.mComment.size()));
+        }
+
+        d->mPendingUrls.remove(url);
+    }
+
+    QMetaObject::invokeMethod(this, [this, url, longText]() {
+        Q_EMIT longTextReady(url, longText.mLyrics, longText.mComment);
+    }, Qt::QueuedConnection);
+}
+
+void TrackLongTextProvider::readLongTextFromDatabase(const QUrl &url)
+{
+    auto *database = d->mDatabase;
+
+    if (!database) {
+        return;
+    }
+
+    // the lyrics are never stored, only the comment indexed with the track is known
+    QMetaObject::invokeMethod(database, [this, database, url]() {
+        const auto comment = database->trackCommentFromFileName(url);
+
+        QMetaObject::invokeMethod(this, [this, url, comment]() {
+            Q_EMIT longTextReady(url, {}, comment);
+        }, Qt::QueuedConnection);
+    }, Qt::QueuedConnection);
+}
+
+
+#include "moc_tracklongtextprovider.cpp"
@@ -0,0 +1,71 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef TRACKLONGTEXTPROVIDER_H
+#define TRACKLONGTEXTPROVIDER_H
+
+#include "elisaLib_export.h"
+
+#include <QObject>
+#include <QString>
+#include <QUrl>
+
+#include <memory>
+
+class TrackLongTextProviderPrivate;
+class DatabaseInterface;
+
+/**
+ * On demand access to the lyrics and the comment of a track.
+ *
+ * Long texts are not part of the track data sent to models, they are read
+ * from the file only when a view needs them. The last read texts are kept in
+ * a small cache that is invalidated when the file is modified.
+ *
+ * Files are read by a dedicated worker, longTextReady() is emitted in the
+ * thread owning this object. When the file cannot be read, for example a
+ * remote or a content:// URL, the comment stored in the database is used.
+ */
+class ELISALIB_EXPORT TrackLongTextProvider : public QObject
+{
+
+    Q_OBJECT
+
+public:
+
+    /**
+     * maximum number of characters kept in the cache
+     */
+    static constexpr int CacheMaximumCost = 1024 * 1024;
+
+    explicit TrackLongTextProvider(QObject *parent = nullptr);
+
+    ~TrackLongTextProvider() override;
+
+    /**
+     * the database is only used from its own thread
+     */
+    void setDatabase(DatabaseInterface *database);
+
+Q_SIGNALS:
+
+    void longTextReady(const QUrl &url, const QString &lyrics, const QString &comment);
+
+public Q_SLOTS:
+
+    void requestLongText(const QUrl &url);
+
+private:
+
+    void readLongText(const QUrl &url);
+
+    void readLongTextFromDatabase(const QUrl &url);
+
+    std::unique_ptr<TrackLongTextProviderPrivate> d;
+
+};
+
+#endif // TRACKLONGTEXTPROVIDER_H
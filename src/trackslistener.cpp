@@ -10,7 +10,6 @@
 #include "databaseinterface.h"
 #include "datatypes.h"
 #include "filescanner.h"
-#include "filewriter.h"
 
 #include <QSet>
 #include <QList>
@@ -33,8 +32,6 @@ public:
     DatabaseInterface *mDatabase = nullptr;
 
     FileScanner mFileScanner;
-
-    FileWriter mFileWriter;
 };
 
 TracksListener::TracksListener(DatabaseInterface *database, QObject *parent) : QObject(parent), d(std::make_unique<TracksListenerPrivate>())
@@ -153,6 +150,8 @@ void TracksListener::trackByFileNameInList(ElisaUtils::PlayListEntryType type, c
         auto newTrackId = d->mDatabase->trackIdFromFileName(fileName);
         if (newTrackId == 0) {
             auto newTrack = d->mFileScanner.scanOneFile(fileName);
+            // like for tracks from the database, the comment is only read on demand
+            newTrack.remove(DataTypes::CommentRole);
 
             if (newTrack.isValid()) {
                 d->mTracksByFileNameSet.push_back(fileName);
@@ -310,9 +309,4 @@ void TracksListener::newGenreInList(qulonglong newDatabaseId, const QString &ent
     Q_EMIT tracksListAdded(newDatabaseId, entryTitle, ElisaUtils::Genre, newTracks);
 }
 
-void TracksListener::updateSingleFileMetaData(const QUrl &url, DataTypes::ColumnsRoles role, const QVariant &data)
-{
-    d->mFileWriter.writeSingleMetaDataToFile(url, role, data);
-}
-
 #include "moc_trackslistener.cpp"
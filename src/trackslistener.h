@@ -63,8 +63,6 @@ public Q_SLOTS:
     void newUrlInList(const QUrl &entryUrl,
                       ElisaUtils::PlayListEntryType databaseIdType);
 
-    void updateSingleFileMetaData(const QUrl &url, DataTypes::ColumnsRoles role, const QVariant &data);
-
 private:
 
     void newArtistInList(qulonglong newDatabaseId, const QString &artist);
@@ -10,12 +10,16 @@
 #include "upnpcontrolabstractservicereply.h"
 #include "upnpservicedescription.h"
 #include "upnpdevicedescription.h"
+#include "upnpcontentdirectorycache.h"
 
 #include <QVector>
 #include <QString>
+#include <QMap>
+#include <QXmlStreamReader>
 
-#include <QDomDocument>
-#include <QDomNode>
+#include <algorithm>
+#include <memory>
+#include <optional>
 
 class DidlParserPrivate
 {
@@ -49,8 +53,105 @@ public:
 
     QHash<QString, QUrl> mCovers;
 
+    /**
+     * index of the first result not yet requested
+     */
+    int mNextStartIndex = 0;
+
+    /**
+     * index of the first result not yet parsed, pages received before the previous ones wait in mReceivedPages
+     */
+    int mParsedEndIndex = 0;
+
+    /**
+     * number of results requested by page, the size of the first page returned by the server if none was asked for
+     */
+    int mPageSize = 0;
+
+    /**
+     * incremented each time the results are cleared, the replies to the requests of a previous fetch are ignored
+     */
+    quint64 mFetchGeneration = 0;
+
+    int mTotalMatches = 0;
+
+    int mPendingRequestsCount = 0;
+
+    /**
+     * the next pages are requested while the current one is parsed
+     */
+    static constexpr int MaximumPendingRequestsCount = 2;
+
+    std::unique_ptr<UpnpContentDirectoryCache> mCache;
+
+    struct ReceivedPage
+    {
+        QString mResult;
+
+        int mNumberReturned = 0;
+    };
+
+    /**
+     * raw DIDL-Lite results of the received pages by start index, stored in the cache once all are received
+     */
+    QMap<int, ReceivedPage> mReceivedPages;
+
+    /**
+     * SystemUpdateID of the server when the current results were requested
+     */
+    int mFetchSystemUpdateId = -1;
+
+    bool mFetchFailed = false;
+
+    void clear()
+    {
+        mNewAlbumIds.clear();
+        mNewAlbums.clear();
+        mNewMusicTracks.clear();
+        mNewMusicTrackIds.clear();
+        mNewTracksByAlbums.clear();
+        mNewTracksList.clear();
+        mCovers.clear();
+        mNextStartIndex = 0;
+        mParsedEndIndex = 0;
+        mTotalMatches = 0;
+        mPendingRequestsCount = 0;
+        mReceivedPages.clear();
+        mFetchFailed = false;
+        ++mFetchGeneration;
+    }
+
+    QString cacheKey(bool isSearch) const
+    {
+        if (!isSearch) {
+            return mParentId;
+        }
+
+        return mParentId + QLatin1Char('?') + mSearchCriteria;
+    }
+
 };
 
+static QTime parseDuration(QString durationValue)
+{
+    if (durationValue.startsWith(QLatin1String("0:"))) {
+        durationValue.remove(0, 2);
+    }
+    if (durationValue.contains(uint('.'))) {
+        durationValue = durationValue.split(QLatin1Char('.')).first();
+    }
+
+    auto duration = QTime::fromString(durationValue, QStringLiteral("mm:ss"));
+    if (!duration.isValid()) {
+        duration = QTime::fromString(durationValue, QStringLiteral("hh:mm:ss"));
+        if (!duration.isValid()) {
+            duration = QTime::fromString(durationValue, QStringLiteral("hh:mm:ss.z"));
+        }
+    }
+
+    return duration;
+}
+
 DidlParser::DidlParser(QObject *parent) : QObject(parent), d(new DidlParserPrivate)
 {
 }
@@ -114,13 +215,22 @@ void DidlParser::setSearchCriteria(const QString &criteria)
 
 void DidlParser::setContentDirectory(UpnpControlContentDirectory *directory)
 {
+    if (d->mContentDirectory) {
+        disconnect(d->mContentDirectory, &UpnpControlContentDirectory::containerUpdateIDsChanged, this, &DidlParser::containerUpdateIDsChanged);
+    }
+
     d->mContentDirectory = directory;
 
     if (!d->mContentDirectory) {
+        d->mCache.reset();
         Q_EMIT contentDirectoryChanged();
         return;
     }
 
+    d->mCache = std::make_unique<UpnpContentDirectoryCache>(d->mContentDirectory->description()->deviceDescription()->UDN().mid(5));
+
+    connect(d->mContentDirectory, &UpnpControlContentDirectory::containerUpdateIDsChanged, this, &DidlParser::containerUpdateIDsChanged);
+
     Q_EMIT contentDirectoryChanged();
 }
 
@@ -140,17 +250,17 @@ void DidlParser::systemUpdateIDChanged()
 
 void DidlParser::browse(int startIndex, int maximumNmberOfResults)
 {
-    auto upnpAnswer = d->mContentDirectory->browse(d->mParentId, d->mBrowseFlag, d->mFilter, startIndex, maximumNmberOfResults, d->mSortCriteria);
-
     if (startIndex == 0) {
-        d->mNewAlbumIds.clear();
-        d->mNewAlbums.clear();
-        d->mNewMusicTracks.clear();
-        d->mNewMusicTrackIds.clear();
-        d->mCovers.clear();
+        fetchAll(RequestType::Browse, maximumNmberOfResults);
+        return;
     }
 
-    connect(upnpAnswer, &UpnpControlAbstractServiceReply::finished, this, &DidlParser::browseFinished);
+    // a page asked for on its own is parsed as soon as it is received
+    if (d->mPendingRequestsCount == 0) {
+        d->mParsedEndIndex = startIndex;
+    }
+
+    requestPage(RequestType::Browse, startIndex, maximumNmberOfResults);
 }
 
 void DidlParser::search(int startIndex, int maximumNumberOfResults)
@@ -160,16 +270,116 @@ void DidlParser::search(int startIndex, int maximumNumberOfResults)
     }
 
     if (startIndex == 0) {
-        d->mNewAlbumIds.clear();
-        d->mNewAlbums.clear();
-        d->mNewMusicTracks.clear();
-        d->mNewMusicTrackIds.clear();
-        d->mCovers.clear();
+        fetchAll(RequestType::Search, maximumNumberOfResults);
+        return;
+    }
+
+    // a page asked for on its own is parsed as soon as it is received
+    if (d->mPendingRequestsCount == 0) {
+        d->mParsedEndIndex = startIndex;
+    }
+
+    requestPage(RequestType::Search, startIndex, maximumNumberOfResults);
+}
+
+void DidlParser::containerUpdateIDsChanged(const QString &ids)
+{
+    if (!d->mCache) {
+        return;
+    }
+
+    d->mCache->invalidateContainers(ids);
+
+    // a search result spans all the containers below its parent, any change may be part of it
+    d->mCache->removeEntry(d->cacheKey(true));
+}
+
+void DidlParser::fetchAll(RequestType requestType, int pageSize)
+{
+    auto cachedSystemUpdateId = std::optional<int>{};
+
+    // a cached result is parsed at once and is only fetched again if the server content changed since
+    if (d->mCache) {
+        const auto cachedEntry = d->mCache->entry(d->cacheKey(requestType == RequestType::Search));
+
+        if (cachedEntry) {
+            d->clear();
+
+            for (const auto &oneResult : cachedEntry->mResults) {
+                parseResult(oneResult);
+            }
+
+            cachedSystemUpdateId = cachedEntry->mSystemUpdateId;
+
+            d->mIsDataValid = true;
+            Q_EMIT isDataValidChanged(d->mContentDirectory->description()->deviceDescription()->UDN().mid(5), d->mParentId);
+        }
+    }
+
+    auto upnpAnswer = d->mContentDirectory->getSystemUpdateID();
+
+    connect(upnpAnswer, &UpnpControlAbstractServiceReply::finished, this, [this, requestType, pageSize, cachedSystemUpdateId](UpnpControlAbstractServiceReply *self) {
+        bool intConvert = false;
+        const auto systemUpdateId = self->result()[QStringLiteral("Id")].toInt(&intConvert);
+
+        if (self->success() && intConvert && cachedSystemUpdateId && *cachedSystemUpdateId == systemUpdateId) {
+            return;
+        }
+
+        d->mFetchSystemUpdateId = ((self->success() && intConvert) ? systemUpdateId : -1);
+
+        requestPage(requestType, 0, pageSize);
+    });
+}
+
+void DidlParser::requestPage(RequestType requestType, int startIndex, int maximumNumberOfResults)
+{
+    if (startIndex == 0) {
+        d->clear();
+        d->mPageSize = maximumNumberOfResults;
     }
 
-    auto upnpAnswer = d->mContentDirectory->search(d->mParentId, d->mSearchCriteria, d->mFilter, startIndex, maximumNumberOfResults, d->mSortCriteria);
+    UpnpControlAbstractServiceReply *upnpAnswer = nullptr;
+    const auto fetchGeneration = d->mFetchGeneration;
 
-    connect(upnpAnswer, &UpnpControlAbstractServiceReply::finished, this, &DidlParser::searchFinished);
+    if (requestType == RequestType::Browse) {
+        upnpAnswer = d->mContentDirectory->browse(d->mParentId, d->mBrowseFlag, d->mFilter, startIndex, maximumNumberOfResults, d->mSortCriteria);
+
+        connect(upnpAnswer, &UpnpControlAbstractServiceReply::finished, this, [this, startIndex, maximumNumberOfResults, fetchGeneration](UpnpControlAbstractServiceReply *self) {
+            if (fetchGeneration != d->mFetchGeneration) {
+                return;
+            }
+
+            browseFinished(self, startIndex, maximumNumberOfResults);
+        });
+    } else {
+        upnpAnswer = d->mContentDirectory->search(d->mParentId, d->mSearchCriteria, d->mFilter, startIndex, maximumNumberOfResults, d->mSortCriteria);
+
+        connect(upnpAnswer, &UpnpControlAbstractServiceReply::finished, this, [this, startIndex, maximumNumberOfResults, fetchGeneration](UpnpControlAbstractServiceReply *self) {
+            if (fetchGeneration != d->mFetchGeneration) {
+                return;
+            }
+
+            searchFinished(self, startIndex, maximumNumberOfResults);
+        });
+    }
+
+    ++d->mPendingRequestsCount;
+
+    if (maximumNumberOfResults > 0) {
+        d->mNextStartIndex = std::max(d->mNextStartIndex, startIndex + maximumNumberOfResults);
+    }
+}
+
+void DidlParser::requestNextPages(RequestType requestType)
+{
+    if (d->mPageSize <= 0) {
+        return;
+    }
+
+    while (d->mPendingRequestsCount < DidlParserPrivate::MaximumPendingRequestsCount && d->mNextStartIndex < d->mTotalMatches) {
+        requestPage(requestType, d->mNextStartIndex, d->mPageSize);
+    }
 }
 
 QString DidlParser::parentId() const
@@ -202,14 +412,27 @@ const QHash<QString, QUrl> &DidlParser::covers() const
     return d->mCovers;
 }
 
-void DidlParser::browseFinished(UpnpControlAbstractServiceReply *self)
+void DidlParser::browseFinished(UpnpControlAbstractServiceReply *self, int startIndex, int requestedCount)
+{
+    replyFinished(RequestType::Browse, self, startIndex, requestedCount);
+}
+
+void DidlParser::searchFinished(UpnpControlAbstractServiceReply *self, int startIndex, int requestedCount)
+{
+    replyFinished(RequestType::Search, self, startIndex, requestedCount);
+}
+
+void DidlParser::replyFinished(RequestType requestType, UpnpControlAbstractServiceReply *self, int startIndex, int requestedCount)
 {
+    --d->mPendingRequestsCount;
+
     const auto &resultData = self->result();
 
     bool success = self->success();
 
     if (!success) {
         d->mIsDataValid = false;
+        d->mFetchFailed = true;
         Q_EMIT isDataValidChanged(d->mContentDirectory->description()->deviceDescription()->UDN().mid(5), d->mParentId);
 
         return;
@@ -222,6 +445,7 @@ void DidlParser::browseFinished(UpnpControlAbstractServiceReply *self)
 
     if (!intConvert) {
         d->mIsDataValid = false;
+        d->mFetchFailed = true;
         Q_EMIT isDataValidChanged(d->mContentDirectory->description()->deviceDescription()->UDN().mid(5), d->mParentId);
 
         return;
@@ -231,118 +455,88 @@ void DidlParser::browseFinished(UpnpControlAbstractServiceReply *self)
 
     if (!intConvert) {
         d->mIsDataValid = false;
+        d->mFetchFailed = true;
         Q_EMIT isDataValidChanged(d->mContentDirectory->description()->deviceDescription()->UDN().mid(5), d->mParentId);
 
         return;
     }
 
-    if (totalMatches > numberReturned) {
-        browse(d->mNewMusicTracks.size() + numberReturned);
-    }
+    d->mTotalMatches = totalMatches;
 
-    QDomDocument browseDescription;
-    browseDescription.setContent(result);
+    const auto receivedEnd = startIndex + numberReturned;
+    const auto requestedEnd = (requestedCount > 0 ? std::min(startIndex + requestedCount, totalMatches) : totalMatches);
 
-    browseDescription.documentElement();
+    d->mNextStartIndex = std::max(d->mNextStartIndex, receivedEnd);
 
-    auto containerList = browseDescription.elementsByTagName(QStringLiteral("container"));
-    for (int containerIndex = 0; containerIndex < containerList.length(); ++containerIndex) {
-        const QDomNode &containerNode(containerList.at(containerIndex));
-        if (!containerNode.isNull()) {
-            decodeContainerNode(containerNode, d->mNewAlbums, d->mNewAlbumIds);
-        }
+    // servers may return less results than requested, the missing end of this page is requested again
+    if (numberReturned > 0 && receivedEnd < requestedEnd) {
+        requestPage(requestType, receivedEnd, requestedEnd - receivedEnd);
     }
 
-    auto itemList = browseDescription.elementsByTagName(QStringLiteral("item"));
-    for (int itemIndex = 0; itemIndex < itemList.length(); ++itemIndex) {
-        const QDomNode &itemNode(itemList.at(itemIndex));
-        if (!itemNode.isNull()) {
-            decodeAudioTrackNode(itemNode, d->mNewMusicTracks, d->mNewMusicTrackIds);
-        }
+    // without a requested page size, the following pages have the size chosen by the server for the first one
+    if (d->mPageSize <= 0) {
+        d->mPageSize = numberReturned;
     }
 
-    groupNewTracksByAlbums();
-    d->mIsDataValid = true;
-    Q_EMIT isDataValidChanged(d->mContentDirectory->description()->deviceDescription()->UDN().mid(5), d->mParentId);
-}
+    // the server prepares the next pages while this one is parsed
+    if (numberReturned > 0) {
+        requestNextPages(requestType);
 
-void DidlParser::groupNewTracksByAlbums()
-{
-    d->mNewTracksByAlbums.clear();
-    for(const auto &newTrack : qAsConst(d->mNewMusicTracks)) {
-        d->mNewTracksByAlbums[newTrack.albumName()].push_back(newTrack);
+        d->mReceivedPages[startIndex] = {result, numberReturned};
     }
-}
 
-void DidlParser::searchFinished(UpnpControlAbstractServiceReply *self)
-{
-    const auto &resultData = self->result();
-
-    bool success = self->success();
+    // pages may be received in any order, the results are parsed in the order of the server
+    auto hasNewResults = false;
+    auto itPage = d->mReceivedPages.constFind(d->mParsedEndIndex);
+    while (itPage != d->mReceivedPages.constEnd()) {
+        parseResult(itPage->mResult);
+        hasNewResults = true;
 
-    if (!success) {
-        d->mIsDataValid = false;
-        Q_EMIT isDataValidChanged(d->mContentDirectory->description()->deviceDescription()->UDN().mid(5), d->mParentId);
-
-        return;
+        d->mParsedEndIndex += itPage->mNumberReturned;
+        itPage = d->mReceivedPages.constFind(d->mParsedEndIndex);
     }
 
-    QString result = resultData[QStringLiteral("Result")].toString();
-
-    bool intConvert;
-    auto numberReturned = resultData[QStringLiteral("NumberReturned")].toInt(&intConvert);
-
-    if (!intConvert) {
-        d->mIsDataValid = false;
-        Q_EMIT isDataValidChanged(d->mContentDirectory->description()->deviceDescription()->UDN().mid(5), d->mParentId);
+    // a complete result is kept in the cache for the next start
+    if (d->mCache && !d->mFetchFailed && d->mPendingRequestsCount == 0 && d->mNextStartIndex >= d->mTotalMatches) {
+        auto allResults = QStringList{};
+        for (const auto &onePage : qAsConst(d->mReceivedPages)) {
+            allResults.push_back(onePage.mResult);
+        }
 
-        return;
+        d->mCache->storeEntry(d->cacheKey(requestType == RequestType::Search), {allResults, d->mFetchSystemUpdateId});
     }
 
-    auto totalMatches = resultData[QStringLiteral("TotalMatches")].toInt(&intConvert);
-
-    if (!intConvert) {
-        d->mIsDataValid = false;
-        Q_EMIT isDataValidChanged(d->mContentDirectory->description()->deviceDescription()->UDN().mid(5), d->mParentId);
-
+    if (!hasNewResults && d->mPendingRequestsCount > 0) {
         return;
     }
 
-    if (totalMatches > numberReturned) {
-        search(d->mNewMusicTracks.size() + numberReturned, numberReturned);
-    }
-
-    QDomDocument browseDescription;
-    browseDescription.setContent(result);
+    d->mIsDataValid = true;
+    Q_EMIT isDataValidChanged(d->mContentDirectory->description()->deviceDescription()->UDN().mid(5), d->mParentId);
+}
 
-    browseDescription.documentElement();
+void DidlParser::parseResult(const QString &result)
+{
+    QXmlStreamReader browseDescription(result);
 
-    auto containerList = browseDescription.elementsByTagName(QStringLiteral("container"));
-    for (int containerIndex = 0; containerIndex < containerList.length(); ++containerIndex) {
-        const QDomNode &containerNode(containerList.at(containerIndex));
-        if (!containerNode.isNull()) {
-            decodeContainerNode(containerNode, d->mNewAlbums, d->mNewAlbumIds);
+    while (browseDescription.readNextStartElement() || !browseDescription.atEnd()) {
+        if (!browseDescription.isStartElement()) {
+            continue;
         }
-    }
 
-    auto itemList = browseDescription.elementsByTagName(QStringLiteral("item"));
-    for (int itemIndex = 0; itemIndex < itemList.length(); ++itemIndex) {
-        const QDomNode &itemNode(itemList.at(itemIndex));
-        if (!itemNode.isNull()) {
-            decodeAudioTrackNode(itemNode, d->mNewMusicTracks, d->mNewMusicTrackIds);
+        if (browseDescription.qualifiedName() == QLatin1String("container")) {
+            decodeContainerNode(browseDescription, d->mNewAlbums, d->mNewAlbumIds);
+        } else if (browseDescription.qualifiedName() == QLatin1String("item")) {
+            decodeAudioTrackNode(browseDescription, d->mNewMusicTracks, d->mNewMusicTrackIds);
         }
     }
-
-    groupNewTracksByAlbums();
-    d->mIsDataValid = true;
-    Q_EMIT isDataValidChanged(d->mContentDirectory->description()->deviceDescription()->UDN().mid(5), d->mParentId);
 }
 
-void DidlParser::decodeContainerNode(const QDomNode &containerNode, QHash<QString, MusicAlbum> &newData,
+void DidlParser::decodeContainerNode(QXmlStreamReader &containerNode, QHash<QString, MusicAlbum> &newData,
                                      QVector<QString> &newDataIds)
 {
-    auto parentID = containerNode.toElement().attribute(QStringLiteral("parentID"));
-    const auto &id = containerNode.toElement().attribute(QStringLiteral("id"));
+    const auto &attributes = containerNode.attributes();
+    auto parentID = attributes.value(QStringLiteral("parentID")).toString();
+    const auto &id = attributes.value(QStringLiteral("id")).toString();
 
     newDataIds.push_back(id);
     auto &chilData = newData[id];
@@ -350,46 +544,42 @@ void DidlParser::decodeContainerNode(const QDomNode &containerNode, QHash<QStrin
     chilData.setParentId(parentID);
     chilData.setId(id);
 
-    const QString &childCount = containerNode.toElement().attribute(QStringLiteral("childCount"));
-    chilData.setTracksCount(childCount.toInt());
-
-    const QDomNode &titleNode = containerNode.firstChildElement(QStringLiteral("dc:title"));
-    if (!titleNode.isNull()) {
-        chilData.setTitle(titleNode.toElement().text());
-    }
-
-    const QDomNode &authorNode = containerNode.firstChildElement(QStringLiteral("upnp:artist"));
-    if (!authorNode.isNull()) {
-        chilData.setArtist(authorNode.toElement().text());
-    }
-
-    const QDomNode &resourceNode = containerNode.firstChildElement(QStringLiteral("res"));
-    if (!resourceNode.isNull()) {
-        chilData.setResourceURI(QUrl::fromUserInput(resourceNode.toElement().text()));
-    }
-
-#if 0
-    const QDomNode &classNode = containerNode.firstChildElement(QStringLiteral("upnp:class"));
-    if (classNode.toElement().text().startsWith(QLatin1String("object.container.album.musicAlbum"))) {
-        chilData[ColumnsRoles::ItemClassRole] = DidlParser::Album;
-    } else if (classNode.toElement().text().startsWith(QLatin1String("object.container.person.musicArtist"))) {
-        chilData[ColumnsRoles::ItemClassRole] = DidlParser::Artist;
-    } else if (classNode.toElement().text().startsWith(QLatin1String("object.container"))) {
-        chilData[ColumnsRoles::ItemClassRole] = DidlParser::Container;
-    }
-#endif
-
-    const QDomNode &albumArtNode = containerNode.firstChildElement(QStringLiteral("upnp:albumArtURI"));
-    if (!albumArtNode.isNull()) {
-        chilData.setAlbumArtURI(QUrl::fromUserInput(albumArtNode.toElement().text()));
+    chilData.setTracksCount(attributes.value(QStringLiteral("childCount")).toInt());
+
+    auto hasTitle = false;
+    auto hasArtist = false;
+    auto hasResource = false;
+    auto hasAlbumArt = false;
+
+    while (containerNode.readNextStartElement()) {
+        const auto elementName = containerNode.qualifiedName();
+
+        if (!hasTitle && elementName == QLatin1String("dc:title")) {
+            hasTitle = true;
+            chilData.setTitle(containerNode.readElementText(QXmlStreamReader::IncludeChildElements));
+        } else if (!hasArtist && elementName == QLatin1String("upnp:artist")) {
+            hasArtist = true;
+            chilData.setArtist(containerNode.readElementText(QXmlStreamReader::IncludeChildElements));
+        } else if (!hasResource && elementName == QLatin1String("res")) {
+            hasResource = true;
+            chilData.setResourceURI(QUrl::fromUserInput(containerNode.readElementText(QXmlStreamReader::IncludeChildElements)));
+        } else if (!hasAlbumArt && elementName == QLatin1String("upnp:albumArtURI")) {
+            hasAlbumArt = true;
+            chilData.setAlbumArtURI(QUrl::fromUserInput(containerNode.readElementText(QXmlStreamReader::IncludeChildElements)));
+        } else {
+            containerNode.skipCurrentElement();
+        }
     }
 }
 
-void DidlParser::decodeAudioTrackNode(const QDomNode &itemNode, QHash<QString, MusicAudioTrack> &newData,
+void DidlParser::decodeAudioTrackNode(QXmlStreamReader &itemNode, QHash<QString, MusicAudioTrack> &newData,
                                       QVector<QString> &newDataIds)
 {
-    const QString &parentID = itemNode.toElement().attribute(QStringLiteral("parentID"));
-    const QString &id = itemNode.toElement().attribute(QStringLiteral("id"));
+    const auto &attributes = itemNode.attributes();
+    const QString &parentID = attributes.value(QStringLiteral("parentID")).toString();
+    const QString &id = attributes.value(QStringLiteral("id")).toString();
+
+    const auto isNewTrack = !newData.contains(id);
 
     newDataIds.push_back(id);
     auto &chilData = newData[id];
@@ -397,19 +587,50 @@ void DidlParser::decodeAudioTrackNode(const QDomNode &itemNode, QHash<QString, M
     chilData.setParentId(parentID);
     chilData.setId(id);
 
-    const QDomNode &titleNode = itemNode.firstChildElement(QStringLiteral("dc:title"));
-    if (!titleNode.isNull()) {
-        chilData.setTitle(titleNode.toElement().text());
-    }
-
-    const QDomNode &authorNode = itemNode.firstChildElement(QStringLiteral("dc:creator"));
-    if (!authorNode.isNull()) {
-        chilData.setArtist(authorNode.toElement().text());
-    }
+    auto hasTitle = false;
+    auto hasArtist = false;
+    auto hasAlbumArtist = false;
+    auto hasAlbum = false;
+    auto hasResource = false;
+    auto hasTrackNumber = false;
+    auto albumArt = QUrl{};
+    auto trackNumber = 0;
+    auto hasAlbumArt = false;
+
+    while (itemNode.readNextStartElement()) {
+        const auto elementName = itemNode.qualifiedName();
+
+        if (!hasTitle && elementName == QLatin1String("dc:title")) {
+            hasTitle = true;
+            chilData.setTitle(itemNode.readElementText(QXmlStreamReader::IncludeChildElements));
+        } else if (!hasArtist && elementName == QLatin1String("dc:creator")) {
+            hasArtist = true;
+            chilData.setArtist(itemNode.readElementText(QXmlStreamReader::IncludeChildElements));
+        } else if (!hasAlbumArtist && elementName == QLatin1String("upnp:artist")) {
+            hasAlbumArtist = true;
+            chilData.setAlbumArtist(itemNode.readElementText(QXmlStreamReader::IncludeChildElements));
+        } else if (!hasAlbum && elementName == QLatin1String("upnp:album")) {
+            hasAlbum = true;
+            chilData.setAlbumName(itemNode.readElementText(QXmlStreamReader::IncludeChildElements));
+        } else if (!hasAlbumArt && elementName == QLatin1String("upnp:albumArtURI")) {
+            hasAlbumArt = true;
+            albumArt = QUrl::fromUserInput(itemNode.readElementText(QXmlStreamReader::IncludeChildElements));
+        } else if (!hasTrackNumber && elementName == QLatin1String("upnp:originalTrackNumber")) {
+            hasTrackNumber = true;
+            trackNumber = itemNode.readElementText(QXmlStreamReader::IncludeChildElements).toInt();
+        } else if (!hasResource && elementName == QLatin1String("res")) {
+            hasResource = true;
+
+            const auto &resourceAttributes = itemNode.attributes();
+            const auto durationValue = resourceAttributes.value(QStringLiteral("duration"));
+            if (!durationValue.isNull()) {
+                chilData.setDuration(parseDuration(durationValue.toString()));
+            }
 
-    const QDomNode &albumAuthorNode = itemNode.firstChildElement(QStringLiteral("upnp:artist"));
-    if (!albumAuthorNode.isNull()) {
-        chilData.setAlbumArtist(albumAuthorNode.toElement().text());
+            chilData.setResourceURI(QUrl::fromUserInput(itemNode.readElementText(QXmlStreamReader::IncludeChildElements)));
+        } else {
+            itemNode.skipCurrentElement();
+        }
     }
 
     if (chilData.albumArtist().isEmpty()) {
@@ -420,49 +641,19 @@ void DidlParser::decodeAudioTrackNode(const QDomNode &itemNode, QHash<QString, M
         chilData.setArtist(chilData.albumArtist());
     }
 
-    const QDomNode &albumNode = itemNode.firstChildElement(QStringLiteral("upnp:album"));
-    if (!albumNode.isNull()) {
-        chilData.setAlbumName(albumNode.toElement().text());
+    if (hasAlbumArt) {
+        d->mCovers[chilData.albumName()] = albumArt;
     }
 
-    const QDomNode &albumArtNode = itemNode.firstChildElement(QStringLiteral("upnp:albumArtURI"));
-    if (!albumArtNode.isNull()) {
-        d->mCovers[chilData.albumName()] = QUrl::fromUserInput(albumArtNode.toElement().text());
+    // the track number is only meaningful for an item with a resource
+    if (hasResource && hasTrackNumber) {
+        chilData.setTrackNumber(trackNumber);
     }
 
-    const QDomNode &resourceNode = itemNode.firstChildElement(QStringLiteral("res"));
-    if (!resourceNode.isNull()) {
-        chilData.setResourceURI(QUrl::fromUserInput(resourceNode.toElement().text()));
-        if (resourceNode.attributes().contains(QLatin1String("duration"))) {
-            const QDomNode &durationNode = resourceNode.attributes().namedItem(QStringLiteral("duration"));
-            QString durationValue = durationNode.nodeValue();
-            if (durationValue.startsWith(QLatin1String("0:"))) {
-                durationValue.remove(0, 2);
-            }
-            if (durationValue.contains(uint('.'))) {
-                durationValue = durationValue.split(QLatin1Char('.')).first();
-            }
-
-            chilData.setDuration(QTime::fromString(durationValue, QStringLiteral("mm:ss")));
-            if (!chilData.duration().isValid()) {
-                chilData.setDuration(QTime::fromString(durationValue, QStringLiteral("hh:mm:ss")));
-                if (!chilData.duration().isValid()) {
-                    chilData.setDuration(QTime::fromString(durationValue, QStringLiteral("hh:mm:ss.z")));
-                }
-            }
-        }
-
-        const QDomNode &trackNumberNode = itemNode.firstChildElement(QStringLiteral("upnp:originalTrackNumber"));
-        if (!trackNumberNode.isNull()) {
-            chilData.setTrackNumber(trackNumberNode.toElement().text().toInt());
-        }
-
-#if 0
-        if (resourceNode.attributes().contains(QLatin1String("artist"))) {
-            const QDomNode &artistNode = resourceNode.attributes().namedItem(QStringLiteral("artist"));
-            //chilData[ColumnsRoles::ArtistRole] = artistNode.nodeValue();
-        }
-#endif
+    // only the tracks of the current page are grouped, the previous pages are already grouped
+    if (isNewTrack) {
+        d->mNewTracksByAlbums[chilData.albumName()].push_back(chilData);
+        d->mNewTracksList.push_back(chilData);
     }
 }
 
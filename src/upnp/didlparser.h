@@ -18,7 +18,7 @@
 #include <memory>
 
 class UpnpControlAbstractServiceReply;
-class QDomNode;
+class QXmlStreamReader;
 class UpnpControlContentDirectory;
 class DidlParserPrivate;
 
@@ -127,17 +127,32 @@ public Q_SLOTS:
 
 private Q_SLOTS:
 
-    void browseFinished(UpnpControlAbstractServiceReply *self);
+    void browseFinished(UpnpControlAbstractServiceReply *self, int startIndex, int requestedCount);
 
-    void searchFinished(UpnpControlAbstractServiceReply *self);
+    void searchFinished(UpnpControlAbstractServiceReply *self, int startIndex, int requestedCount);
+
+    void containerUpdateIDsChanged(const QString &ids);
 
 private:
 
-    void decodeContainerNode(const QDomNode &containerNode, QHash<QString, MusicAudioTrack> &newData, QVector<QString> &newDataIds);
+    enum class RequestType {
+        Browse,
+        Search,
+    };
+
+    void fetchAll(RequestType requestType, int pageSize);
+
+    void requestPage(RequestType requestType, int startIndex, int maximumNumberOfResults);
+
+    void requestNextPages(RequestType requestType);
+
+    void replyFinished(RequestType requestType, UpnpControlAbstractServiceReply *self, int startIndex, int requestedCount);
+
+    void parseResult(const QString &result);
 
-    void decodeAudioTrackNode(const QDomNode &itemNode, QHash<QString, MusicAudioTrack> &newData, QVector<QString> &newDataIds);
+    void decodeContainerNode(QXmlStreamReader &containerNode, QHash<QString, MusicAlbum> &newData, QVector<QString> &newDataIds);
 
-    void groupNewTracksByAlbums();
+    void decodeAudioTrackNode(QXmlStreamReader &itemNode, QHash<QString, MusicAudioTrack> &newData, QVector<QString> &newDataIds);
 
     std::unique_ptr<DidlParserPrivate> d;
 
@@ -0,0 +1,140 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "upnpcontentdirectorycache.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+namespace {
+
+constexpr quint32 EntryMagic = 0x454c5550;
+
+constexpr quint32 EntryVersion = 2;
+
+}
+
+class UpnpContentDirectoryCachePrivate
+{
+
+public:
+
+    QString mDeviceUdn;
+
+    QString mCacheDirectory;
+
+};
+
+UpnpContentDirectoryCache::UpnpContentDirectoryCache(const QString &deviceUdn, const QString &cacheDirectory)
+    : d(std::make_unique<UpnpContentDirectoryCachePrivate>())
+{
+    d->mDeviceUdn = deviceUdn;
+
+    auto rootDirectory = cacheDirectory;
+    if (rootDirectory.isEmpty()) {
+        rootDirectory = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QStringLiteral("/upnp");
+    }
+
+    const auto deviceHash = QCryptographicHash::hash(deviceUdn.toUtf8(), QCryptographicHash::Sha1);
+    d->mCacheDirectory = rootDirectory + QLatin1Char('/') + QString::fromLatin1(deviceHash.toHex());
+}
+
+UpnpContentDirectoryCache::~UpnpContentDirectoryCache()
+= default;
+
+std::optional<UpnpContentDirectoryCache::Entry> UpnpContentDirectoryCache::entry(const QString &containerId) const
+{
+    QFile entryFile(entryFileName(containerId));
+
+    if (!entryFile.open(QIODevice::ReadOnly)) {
+        return {};
+    }
+
+    QDataStream entryStream(&entryFile);
+    entryStream.setVersion(QDataStream::Qt_5_12);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    QString entryDeviceUdn;
+    QString entryContainerId;
+    qint32 systemUpdateId = -1;
+    QStringList results;
+
+    entryStream >> magic >> version;
+
+    if (magic != EntryMagic || version != EntryVersion) {
+        return {};
+    }
+
+    entryStream >> entryDeviceUdn >> entryContainerId >> systemUpdateId >> results;
+
+    if (entryStream.status() != QDataStream::Ok) {
+        return {};
+    }
+
+    if (entryDeviceUdn != d->mDeviceUdn || entryContainerId != containerId) {
+        return {};
+    }
+
+    return Entry{results, systemUpdateId};
+}
+
+bool UpnpContentDirectoryCache::storeEntry(const QString &containerId, const Entry &entry) const
+{
+    if (!QDir().mkpath(d->mCacheDirectory)) {
+        qDebug() << "UpnpContentDirectoryCache::storeEntry" << "cannot create" << d->mCacheDirectory;
+        return false;
+    }
+
+    QSaveFile entryFile(entryFileName(containerId));
+
+    if (!entryFile.open(QIODevice::WriteOnly)) {
+        qDebug() << "UpnpContentDirectoryCache::storeEntry" << entryFile.fileName() << entryFile.errorString();
+        return false;
+    }
+
+    QDataStream entryStream(&entryFile);
+    entryStream.setVersion(QDataStream::Qt_5_12);
+
+    entryStream << EntryMagic << EntryVersion << d->mDeviceUdn << containerId
+                << static_cast<qint32>(entry.mSystemUpdateId) << entry.mResults;
+
+    return entryFile.commit();
+}
+
+void UpnpContentDirectoryCache::removeEntry(const QString &containerId) const
+{
+    QFile::remove(entryFileName(containerId));
+}
+
+QStringList UpnpContentDirectoryCache::invalidateContainers(const QString &containerUpdateIds) const
+{
+    auto changedContainers = QStringList{};
+
+    const auto values = containerUpdateIds.split(QLatin1Char(','));
+
+    // values alternate container ids and their new update id
+    for (int index = 0; index + 1 < values.size(); index += 2) {
+        const auto &containerId = values[index];
+
+        removeEntry(containerId);
+        changedContainers.push_back(containerId);
+    }
+
+    return changedContainers;
+}
+
+QString UpnpContentDirectoryCache::entryFileName(const QString &containerId) const
+{
+    const auto containerHash = QCryptographicHash::hash(containerId.toUtf8(), QCryptographicHash::Sha1);
+
+    return d->mCacheDirectory + QLatin1Char('/') + QString::fromLatin1(containerHash.toHex());
+}
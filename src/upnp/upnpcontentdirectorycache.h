@@ -0,0 +1,67 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef UPNPCONTENTDIRECTORYCACHE_H
+#define UPNPCONTENTDIRECTORYCACHE_H
+
+#include <QString>
+#include <QStringList>
+
+#include <memory>
+#include <optional>
+
+class UpnpContentDirectoryCachePrivate;
+
+/**
+ * On disk cache of the browse and search results of one media server.
+ *
+ * Each entry keeps the DIDL-Lite results of a request, one per received page,
+ * with the SystemUpdateID of the server when it was fetched. An entry with an older SystemUpdateID can
+ * still be displayed while the container is fetched again.
+ */
+class UpnpContentDirectoryCache
+{
+
+public:
+
+    struct Entry
+    {
+        QStringList mResults;
+
+        int mSystemUpdateId = -1;
+    };
+
+    /**
+     * @param deviceUdn UDN of the media server
+     * @param cacheDirectory directory holding the entries, defaults to a folder in the user cache location
+     */
+    explicit UpnpContentDirectoryCache(const QString &deviceUdn, const QString &cacheDirectory = {});
+
+    ~UpnpContentDirectoryCache();
+
+    std::optional<Entry> entry(const QString &containerId) const;
+
+    bool storeEntry(const QString &containerId, const Entry &entry) const;
+
+    void removeEntry(const QString &containerId) const;
+
+    /**
+     * remove the entries of the containers listed in a ContainerUpdateIDs event
+     *
+     * @param containerUpdateIds comma separated list of container id and update id pairs
+     * @return ids of the listed containers
+     */
+    QStringList invalidateContainers(const QString &containerUpdateIds) const;
+
+private:
+
+    QString entryFileName(const QString &containerId) const;
+
+    std::unique_ptr<UpnpContentDirectoryCachePrivate> d;
+
+};
+
+#endif // UPNPCONTENTDIRECTORYCACHE_H
@@ -25,7 +25,7 @@ public:
 
     QString mSortCapabilities;
 
-    int mSystemUpdateID;
+    int mSystemUpdateID = -1;
 
 };
 
@@ -247,6 +247,9 @@ void UpnpControlContentDirectory::parseEventNotification(const QString &eventNam
         d->mSystemUpdateID = eventValue.toInt();
         Q_EMIT systemUpdateIDChanged(d->mSystemUpdateID);
     }
+    if (eventName == QLatin1String("ContainerUpdateIDs")) {
+        Q_EMIT containerUpdateIDsChanged(eventValue);
+    }
 }
 
 #include "moc_upnpcontrolcontentdirectory.cpp"
@@ -83,6 +83,8 @@ Q_SIGNALS:
 
     void systemUpdateIDChanged(int id);
 
+    void containerUpdateIDsChanged(const QString &ids);
+
 private Q_SLOTS:
 
 protected:
@@ -0,0 +1,143 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "waveformcache.h"
+
+#include "audiofiledecoder.h"
+#include "waveformpeaks.h"
+
+#include "loudnessLogging.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QUrl>
+
+namespace {
+
+constexpr quint32 EntryMagic = 0x454c5746;
+
+constexpr quint32 EntryVersion = 1;
+
+}
+
+class WaveformCachePrivate
+{
+
+public:
+
+    QString mCacheDirectory;
+
+};
+
+WaveformCache::WaveformCache(const QString &cacheDirectory)
+    : d(std::make_unique<WaveformCachePrivate>())
+{
+    d->mCacheDirectory = cacheDirectory;
+
+    if (d->mCacheDirectory.isEmpty()) {
+        d->mCacheDirectory = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QStringLiteral("/waveforms");
+    }
+}
+
+WaveformCache::~WaveformCache()
+= default;
+
+QString WaveformCache::cacheDirectory() const
+{
+    return d->mCacheDirectory;
+}
+
+std::optional<QByteArray> WaveformCache::peaks(const QString &filePath, const QDateTime &fileModifiedTime) const
+{
+    QFile entryFile(entryFileName(filePath));
+
+    if (!entryFile.open(QIODevice::ReadOnly)) {
+        return {};
+    }
+
+    QDataStream entryStream(&entryFile);
+    entryStream.setVersion(QDataStream::Qt_5_12);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    QString entryFilePath;
+    qint64 entryModifiedTime = 0;
+    QByteArray entryPeaks;
+
+    entryStream >> magic >> version;
+    if (magic != EntryMagic || version != EntryVersion) {
+        return {};
+    }
+
+    entryStream >> entryFilePath >> entryModifiedTime >> entryPeaks;
+    if (entryStream.status() != QDataStream::Ok) {
+        return {};
+    }
+
+    if (entryFilePath != filePath || entryModifiedTime != fileModifiedTime.toMSecsSinceEpoch()) {
+        return {};
+    }
+
+    return entryPeaks;
+}
+
+bool WaveformCache::storePeaks(const QString &filePath, const QDateTime &fileModifiedTime, const QByteArray &peaks) const
+{
+    if (!QDir().mkpath(d->mCacheDirectory)) {
+        qCDebug(orgKdeElisaLoudness()) << "WaveformCache::storePeaks" << "cannot create" << d->mCacheDirectory;
+        return false;
+    }
+
+    QSaveFile entryFile(entryFileName(filePath));
+
+    if (!entryFile.open(QIODevice::WriteOnly)) {
+        qCDebug(orgKdeElisaLoudness()) << "WaveformCache::storePeaks" << entryFile.fileName() << entryFile.errorString();
+        return false;
+    }
+
+    QDataStream entryStream(&entryFile);
+    entryStream.setVersion(QDataStream::Qt_5_12);
+
+    entryStream << EntryMagic << EntryVersion << filePath << fileModifiedTime.toMSecsSinceEpoch() << peaks;
+
+    return entryFile.commit();
+}
+
+std::optional<QByteArray> WaveformCache::extractPeaks(const QString &filePath, const std::atomic<bool> *stopRequested)
+{
+    auto waveform = std::optional<WaveformPeaks>{};
+
+    const auto isValid = AudioFileDecoder::decode(QUrl::fromLocalFile(filePath), [&waveform](const QAudioBuffer &buffer) {
+        const auto format = buffer.format();
+
+        if (!waveform) {
+            waveform.emplace(format.channelCount(), format.sampleRate());
+        }
+
+        if (waveform->channelsCount() != format.channelCount()) {
+            return false;
+        }
+
+        return AudioFileDecoder::forwardSamples(buffer, *waveform);
+    }, stopRequested);
+
+    if (!isValid || !waveform) {
+        return {};
+    }
+
+    return waveform->peaks();
+}
+
+QString WaveformCache::entryFileName(const QString &filePath) const
+{
+    const auto pathHash = QCryptographicHash::hash(filePath.toUtf8(), QCryptographicHash::Sha1);
+
+    return d->mCacheDirectory + QLatin1Char('/') + QString::fromLatin1(pathHash.toHex()) + QStringLiteral(".peaks");
+}
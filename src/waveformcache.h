@@ -0,0 +1,60 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef WAVEFORMCACHE_H
+#define WAVEFORMCACHE_H
+
+#include "elisaLib_export.h"
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QString>
+
+#include <atomic>
+#include <memory>
+#include <optional>
+
+class WaveformCachePrivate;
+
+/**
+ * On disk cache of the peaks computed by WaveformPeaks.
+ *
+ * Entries are keyed by the path of the audio file and are only valid for the
+ * modification time they were computed for. Reading an entry never opens the
+ * audio file itself.
+ */
+class ELISALIB_EXPORT WaveformCache
+{
+
+public:
+
+    /**
+     * @param cacheDirectory directory holding the entries, defaults to a folder in the user cache location
+     */
+    explicit WaveformCache(const QString &cacheDirectory = {});
+
+    ~WaveformCache();
+
+    QString cacheDirectory() const;
+
+    std::optional<QByteArray> peaks(const QString &filePath, const QDateTime &fileModifiedTime) const;
+
+    bool storePeaks(const QString &filePath, const QDateTime &fileModifiedTime, const QByteArray &peaks) const;
+
+    /**
+     * decode filePath completely and compute its peaks
+     */
+    static std::optional<QByteArray> extractPeaks(const QString &filePath, const std::atomic<bool> *stopRequested = nullptr);
+
+private:
+
+    QString entryFileName(const QString &filePath) const;
+
+    std::unique_ptr<WaveformCachePrivate> d;
+
+};
+
+#endif // WAVEFORMCACHE_H
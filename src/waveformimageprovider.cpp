@@ -0,0 +1,149 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "waveformimageprovider.h"
+
+#include "waveformcache.h"
+#include "elisatrace.h"
+
+#include <QColor>
+#include <QFileInfo>
+#include <QImage>
+#include <QPainter>
+#include <QThread>
+#include <QUrl>
+#include <QUrlQuery>
+
+#include <algorithm>
+#include <atomic>
+
+class AsyncWaveformResponse : public QQuickImageResponse, public QRunnable
+{
+    Q_OBJECT
+
+public:
+    AsyncWaveformResponse(QString id, QSize requestedSize)
+        : QQuickImageResponse(), mId(std::move(id)), mRequestedSize(requestedSize)
+    {
+        setAutoDelete(false);
+
+        if (mRequestedSize.width() <= 0) {
+            mRequestedSize.setWidth(1024);
+        }
+
+        if (mRequestedSize.height() <= 0) {
+            mRequestedSize.setHeight(64);
+        }
+    }
+
+    QQuickTextureFactory *textureFactory() const override
+    {
+        return QQuickTextureFactory::textureFactoryForImage(mWaveformImage);
+    }
+
+    void cancel() override
+    {
+        mStopRequested = true;
+    }
+
+    void run() override
+    {
+        ELISA_TRACE_SCOPE_DETAIL("image", "waveform", mId);
+
+        // the waveform is only decoration, do not compete with the playback
+        QThread::currentThread()->setPriority(QThread::IdlePriority);
+
+        if (mStopRequested) {
+            Q_EMIT finished();
+            return;
+        }
+
+        const auto querySeparator = mId.indexOf(QLatin1Char('?'));
+        const auto filePath = QUrl::fromPercentEncoding(mId.left(querySeparator).toUtf8());
+        const auto query = QUrlQuery(querySeparator != -1 ? mId.mid(querySeparator + 1) : QString{});
+
+        auto color = QColor(query.queryItemValue(QStringLiteral("color")));
+        if (!color.isValid()) {
+            color = Qt::gray;
+        }
+
+        // only the metadata of the audio file are needed when the waveform is cached
+        const auto fileInfo = QFileInfo(filePath);
+        const auto fileModifiedTime = fileInfo.lastModified();
+
+        WaveformCache cache;
+
+        auto peaks = cache.peaks(filePath, fileModifiedTime);
+        if (!peaks && fileInfo.isFile()) {
+            peaks = WaveformCache::extractPeaks(filePath, &mStopRequested);
+
+            if (peaks) {
+                cache.storePeaks(filePath, fileModifiedTime, *peaks);
+            }
+        }
+
+        if (peaks && !peaks->isEmpty() && !mStopRequested) {
+            renderWaveform(*peaks, color);
+        }
+
+        Q_EMIT finished();
+    }
+
+    void renderWaveform(const QByteArray &peaks, const QColor &color)
+    {
+        mWaveformImage = QImage(mRequestedSize, QImage::Format_ARGB32_Premultiplied);
+        mWaveformImage.fill(Qt::transparent);
+
+        QPainter painter(&mWaveformImage);
+
+        const auto peaksCount = peaks.size() / 2;
+        const auto width = mRequestedSize.width();
+        const auto halfHeight = mRequestedSize.height() / 2.;
+
+        for (int column = 0; column < width; ++column) {
+            const auto firstPeak = static_cast<int>(static_cast<qint64>(column) * peaksCount / width);
+            const auto lastPeak = std::max(firstPeak + 1, static_cast<int>(static_cast<qint64>(column + 1) * peaksCount / width));
+
+            auto minimum = 127;
+            auto maximum = -127;
+            for (int peak = firstPeak; peak < lastPeak && peak < peaksCount; ++peak) {
+                minimum = std::min(minimum, static_cast<int>(static_cast<qint8>(peaks[2 * peak])));
+                maximum = std::max(maximum, static_cast<int>(static_cast<qint8>(peaks[2 * peak + 1])));
+            }
+
+            if (minimum > maximum) {
+                continue;
+            }
+
+            const auto top = qRound(halfHeight - maximum * halfHeight / 127.);
+            const auto bottom = qRound(halfHeight - minimum * halfHeight / 127.);
+
+            painter.fillRect(column, top, 1, std::max(bottom - top, 1), color);
+        }
+    }
+
+    QString mId;
+    QSize mRequestedSize;
+    QImage mWaveformImage;
+
+    std::atomic<bool> mStopRequested{false};
+};
+
+WaveformImageProvider::WaveformImageProvider()
+    : QQuickAsyncImageProvider()
+{
+    // decoding a track is expensive, do not run too many of them at the same time
+    pool.setMaxThreadCount(2);
+}
+
+QQuickImageResponse *WaveformImageProvider::requestImageResponse(const QString &id, const QSize &requestedSize)
+{
+    auto response = std::make_unique<AsyncWaveformResponse>(id, requestedSize);
+    pool.start(response.get());
+    return response.release();
+}
+
+#include "waveformimageprovider.moc"
@@ -0,0 +1,30 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef WAVEFORMIMAGEPROVIDER_H
+#define WAVEFORMIMAGEPROVIDER_H
+
+#include <QQuickAsyncImageProvider>
+#include <QThreadPool>
+
+/**
+ * Provide waveform images of local audio files as image://waveform/<percent encoded path>?color=<color>
+ */
+class WaveformImageProvider : public QQuickAsyncImageProvider
+{
+public:
+
+    WaveformImageProvider();
+
+    QQuickImageResponse *requestImageResponse(const QString &id, const QSize &requestedSize) override;
+
+private:
+
+    QThreadPool pool;
+
+};
+
+#endif // WAVEFORMIMAGEPROVIDER_H
@@ -0,0 +1,201 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "waveformpeaks.h"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <vector>
+
+namespace {
+
+constexpr qsizetype ConversionFrames = 1024;
+
+constexpr int SampleRangeLanes = 8;
+
+qint8 quantizePeak(float value)
+{
+    return static_cast<qint8>(qRound(std::clamp(value, -1.f, 1.f) * 127.f));
+}
+
+}
+
+class WaveformPeaksPrivate
+{
+
+public:
+
+    WaveformPeaksPrivate(int channelsCount, int sampleRate)
+        : mChannelsCount(std::max(channelsCount, 1)), mSampleRate(std::max(sampleRate, 1)),
+          mFramesPerSlice(std::max(mSampleRate / WaveformPeaks::PeaksPerSecond, 1))
+    {
+    }
+
+    void finishSlice()
+    {
+        mMinimums.push_back(mSliceMinimum);
+        mMaximums.push_back(mSliceMaximum);
+
+        mSliceMinimum = std::numeric_limits<float>::max();
+        mSliceMaximum = std::numeric_limits<float>::lowest();
+        mSlicePosition = 0;
+    }
+
+    int mChannelsCount = 1;
+
+    int mSampleRate = 1;
+
+    qsizetype mFramesPerSlice = 1;
+
+    qsizetype mSlicePosition = 0;
+
+    float mSliceMinimum = std::numeric_limits<float>::max();
+
+    float mSliceMaximum = std::numeric_limits<float>::lowest();
+
+    std::vector<float> mMinimums;
+
+    std::vector<float> mMaximums;
+
+    std::vector<float> mConversionBuffer;
+
+};
+
+WaveformPeaks::WaveformPeaks(int channelsCount, int sampleRate)
+    : d(std::make_unique<WaveformPeaksPrivate>(channelsCount, sampleRate))
+{
+}
+
+WaveformPeaks::WaveformPeaks(WaveformPeaks &&other) noexcept = default;
+
+WaveformPeaks& WaveformPeaks::operator=(WaveformPeaks &&other) noexcept = default;
+
+WaveformPeaks::~WaveformPeaks()
+= default;
+
+int WaveformPeaks::channelsCount() const
+{
+    return d->mChannelsCount;
+}
+
+int WaveformPeaks::sampleRate() const
+{
+    return d->mSampleRate;
+}
+
+void WaveformPeaks::addFrames(const float *interleavedSamples, qsizetype framesCount)
+{
+    while (framesCount > 0) {
+        const auto sliceFrames = std::min(framesCount, d->mFramesPerSlice - d->mSlicePosition);
+
+        sampleRange(interleavedSamples, sliceFrames * d->mChannelsCount, d->mSliceMinimum, d->mSliceMaximum);
+
+        d->mSlicePosition += sliceFrames;
+        if (d->mSlicePosition == d->mFramesPerSlice) {
+            d->finishSlice();
+        }
+
+        interleavedSamples += sliceFrames * d->mChannelsCount;
+        framesCount -= sliceFrames;
+    }
+}
+
+void WaveformPeaks::addFrames(const qint16 *interleavedSamples, qsizetype framesCount)
+{
+    d->mConversionBuffer.resize(ConversionFrames * d->mChannelsCount);
+
+    while (framesCount > 0) {
+        const auto chunkFrames = std::min(framesCount, ConversionFrames);
+        const auto chunkSamples = chunkFrames * d->mChannelsCount;
+
+        auto *convertedSamples = d->mConversionBuffer.data();
+        for (qsizetype sample = 0; sample < chunkSamples; ++sample) {
+            convertedSamples[sample] = static_cast<float>(interleavedSamples[sample]) * (1.f / 32768.f);
+        }
+
+        addFrames(convertedSamples, chunkFrames);
+
+        interleavedSamples += chunkSamples;
+        framesCount -= chunkFrames;
+    }
+}
+
+void WaveformPeaks::addFrames(const qint32 *interleavedSamples, qsizetype framesCount)
+{
+    d->mConversionBuffer.resize(ConversionFrames * d->mChannelsCount);
+
+    while (framesCount > 0) {
+        const auto chunkFrames = std::min(framesCount, ConversionFrames);
+        const auto chunkSamples = chunkFrames * d->mChannelsCount;
+
+        auto *convertedSamples = d->mConversionBuffer.data();
+        for (qsizetype sample = 0; sample < chunkSamples; ++sample) {
+            convertedSamples[sample] = static_cast<float>(interleavedSamples[sample]) * (1.f / 2147483648.f);
+        }
+
+        addFrames(convertedSamples, chunkFrames);
+
+        interleavedSamples += chunkSamples;
+        framesCount -= chunkFrames;
+    }
+}
+
+QByteArray WaveformPeaks::peaks() const
+{
+    auto minimums = d->mMinimums;
+    auto maximums = d->mMaximums;
+
+    if (d->mSlicePosition > 0) {
+        minimums.push_back(d->mSliceMinimum);
+        maximums.push_back(d->mSliceMaximum);
+    }
+
+    const auto slicesCount = static_cast<qsizetype>(minimums.size());
+    const auto mergedSlices = std::max<qsizetype>((slicesCount + MaximumPeaksCount - 1) / MaximumPeaksCount, 1);
+    const auto peaksCount = (slicesCount + mergedSlices - 1) / mergedSlices;
+
+    auto result = QByteArray(static_cast<int>(2 * peaksCount), Qt::Uninitialized);
+
+    for (qsizetype peak = 0; peak < peaksCount; ++peak) {
+        const auto firstSlice = peak * mergedSlices;
+        const auto lastSlice = std::min(firstSlice + mergedSlices, slicesCount);
+
+        const auto peakMinimum = *std::min_element(minimums.begin() + firstSlice, minimums.begin() + lastSlice);
+        const auto peakMaximum = *std::max_element(maximums.begin() + firstSlice, maximums.begin() + lastSlice);
+
+        result[static_cast<int>(2 * peak)] = static_cast<char>(quantizePeak(peakMinimum));
+        result[static_cast<int>(2 * peak + 1)] = static_cast<char>(quantizePeak(peakMaximum));
+    }
+
+    return result;
+}
+
+void WaveformPeaks::sampleRange(const float *samples, qsizetype samplesCount, float &minimum, float &maximum)
+{
+    // independent lanes without any data dependent branch let the compiler use vector min/max instructions
+    std::array<float, SampleRangeLanes> laneMinimums;
+    std::array<float, SampleRangeLanes> laneMaximums;
+    laneMinimums.fill(minimum);
+    laneMaximums.fill(maximum);
+
+    qsizetype sample = 0;
+    for (; sample + SampleRangeLanes <= samplesCount; sample += SampleRangeLanes) {
+        for (int lane = 0; lane < SampleRangeLanes; ++lane) {
+            const auto value = samples[sample + lane];
+            laneMinimums[lane] = value < laneMinimums[lane] ? value : laneMinimums[lane];
+            laneMaximums[lane] = value > laneMaximums[lane] ? value : laneMaximums[lane];
+        }
+    }
+
+    for (; sample < samplesCount; ++sample) {
+        laneMinimums[0] = std::min(laneMinimums[0], samples[sample]);
+        laneMaximums[0] = std::max(laneMaximums[0], samples[sample]);
+    }
+
+    minimum = *std::min_element(laneMinimums.begin(), laneMinimums.end());
+    maximum = *std::max_element(laneMaximums.begin(), laneMaximums.end());
+}
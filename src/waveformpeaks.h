@@ -0,0 +1,69 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef WAVEFORMPEAKS_H
+#define WAVEFORMPEAKS_H
+
+#include "elisaLib_export.h"
+
+#include <QByteArray>
+
+#include <memory>
+
+class WaveformPeaksPrivate;
+
+/**
+ * Reduction of an audio stream to the minimum and maximum sample values of
+ * consecutive slices, used to draw a waveform.
+ *
+ * All channels are mixed in the same slice. The result is a compact array of
+ * (minimum, maximum) pairs of qint8, a few kilobytes for a complete track.
+ */
+class ELISALIB_EXPORT WaveformPeaks
+{
+
+public:
+
+    static constexpr int PeaksPerSecond = 10;
+
+    static constexpr int MaximumPeaksCount = 2048;
+
+    WaveformPeaks(int channelsCount, int sampleRate);
+
+    WaveformPeaks(WaveformPeaks &&other) noexcept;
+
+    WaveformPeaks& operator=(WaveformPeaks &&other) noexcept;
+
+    ~WaveformPeaks();
+
+    int channelsCount() const;
+
+    int sampleRate() const;
+
+    void addFrames(const float *interleavedSamples, qsizetype framesCount);
+
+    void addFrames(const qint16 *interleavedSamples, qsizetype framesCount);
+
+    void addFrames(const qint32 *interleavedSamples, qsizetype framesCount);
+
+    /**
+     * interleaved minimum and maximum of each slice scaled from [-1, 1] to [-127, 127],
+     * slices are merged so that there are at most MaximumPeaksCount of them
+     */
+    QByteArray peaks() const;
+
+    /**
+     * extend [minimum, maximum] with samplesCount samples
+     */
+    static void sampleRange(const float *samples, qsizetype samplesCount, float &minimum, float &maximum);
+
+private:
+
+    std::unique_ptr<WaveformPeaksPrivate> d;
+
+};
+
+#endif // WAVEFORMPEAKS_H